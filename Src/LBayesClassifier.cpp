@@ -13,7 +13,7 @@ class CBayesClassifier
 {
 public:
     /// @brief 析构函数
-    virtual ~CBayesClassifier() = 0{}
+    virtual ~CBayesClassifier() {}
 
     /// @brief 训练模型
     /// @param[in] problem 贝叶斯问题
@@ -45,7 +45,7 @@ public:
     /// @param[in] featureValue 特征值
     /// @param[in] classValue 类别值
     /// @return 类别的计数
-    unsigned int GetCount(IN int featureValue, IN int classValue)
+    size_t GetCount(IN int featureValue, IN int classValue)
     {
         return m_featureClassMap[featureValue][classValue];
     }
@@ -53,10 +53,10 @@ public:
     /// @brief 获取指定特征的总计数
     /// @param[in] featureValue 特征值
     /// @return 特征值得总计数
-    unsigned int GetTotalCount(IN int featureValue)
+    size_t GetTotalCount(IN int featureValue)
     {
         auto classMap = m_featureClassMap[featureValue];
-        unsigned int totalCount = 0;
+        size_t totalCount = 0;
         for (auto iter = classMap.begin(); iter != classMap.end(); iter++)
         {
             totalCount += iter->second;
@@ -72,7 +72,7 @@ public:
     }
 
 private:
-    map<int, map<int, unsigned int>> m_featureClassMap; ///< 特征映射, <特征值, <类别值, 类别计数>>
+    map<int, map<int, size_t>> m_featureClassMap; ///< 特征映射, <特征值, <类别值, 类别计数>>
 };
 
 /// @brief 贝叶斯分类器(离散)实现类
@@ -111,17 +111,17 @@ public:
         m_featureClassCountList.clear();
         m_sampleCount = problem.XMatrix.RowLen;
         m_featureCount = problem.XMatrix.ColumnLen;
-        for (unsigned int i = 0; i < m_featureCount; i++)
+        for (size_t i = 0; i < m_featureCount; i++)
         {
             m_featureClassCountList.push_back(CFeatureClassCount());
         }
 
-        for (unsigned int row = 0; row < problem.XMatrix.RowLen; row++)
+        for (size_t row = 0; row < problem.XMatrix.RowLen; row++)
         {
             int classValue = problem.YVector[row][0];
             m_sampleClassCount[classValue]++;
 
-            for (unsigned int col = 0; col < problem.XMatrix.ColumnLen; col++)
+            for (size_t col = 0; col < problem.XMatrix.ColumnLen; col++)
             {
                 int featureValue = problem.XMatrix[row][col];
                 m_featureClassCountList[col].CountInc(featureValue, classValue);
@@ -183,15 +183,15 @@ private:
         // 因为各个特征独立所以
         // P(x|y) * P(y) = P(a1|y) * P(a2|y) * ... * P(an|y) * P(y)
 
-        unsigned int classCount = m_sampleClassCount[classValue];
+        size_t classCount = m_sampleClassCount[classValue];
 
         float prob = 1.0f;
-        for (unsigned int col = 0; col < sample.ColumnLen; col++)
+        for (size_t col = 0; col < sample.ColumnLen; col++)
         {
             int featureValue = sample[0][col];
-            unsigned int featureClassCount = m_featureClassCountList[col].GetCount(featureValue, classValue);
+            size_t featureClassCount = m_featureClassCountList[col].GetCount(featureValue, classValue);
             float basicProb = (float)featureClassCount/(float)classCount;
-            unsigned int featureTotalCount = m_featureClassCountList[col].GetTotalCount(featureValue);
+            size_t featureTotalCount = m_featureClassCountList[col].GetTotalCount(featureValue);
             // w = 0.5 + totalCount/(1 + totalCount) * (basicProb - 0.5)
             // 使用权重概率可以解决以下问题:
             // 特征值在指定分类出现次数为0导致概率为0的情况
@@ -207,16 +207,16 @@ private:
 
 private:
     vector<CFeatureClassCount> m_featureClassCountList; ///< 特征类别计数组
-    map<int, unsigned int> m_sampleClassCount; ///< 训练样本类别计数
-    unsigned int m_featureCount; ///< 样本特征数量
-    unsigned int m_sampleCount; ///< 训练样本总数
+    map<int, size_t> m_sampleClassCount; ///< 训练样本类别计数
+    size_t m_featureCount; ///< 样本特征数量
+    size_t m_sampleCount; ///< 训练样本总数
 };
 
 
 /// @brief 特征类别数据结构
 struct CFeatureClassData
 {
-    map<int, vector<int>> DataMap; ///< 类别数据映射, <类别值, 数据列表>
+    map<int, vector<float>> DataMap; ///< 类别数据映射, <类别值, 数据列表>
 };
 
 /// @brief 高斯分布结构
@@ -271,21 +271,21 @@ public:
         m_featureClassGaussList.clear();
         m_sampleCount = problem.XMatrix.RowLen;
         m_featureCount = problem.XMatrix.ColumnLen;
-        for (unsigned int i = 0; i < m_featureCount; i++)
+        for (size_t i = 0; i < m_featureCount; i++)
         {
             featureClassDataList.push_back(CFeatureClassData());
             m_featureClassGaussList.push_back(CFeatureClassGauss());
         }
 
         // 将每列特征值按类别归类
-        for (unsigned int row = 0; row < problem.XMatrix.RowLen; row++)
+        for (size_t row = 0; row < problem.XMatrix.RowLen; row++)
         {
             int classValue = problem.YVector[row][0];
             m_sampleClassCount[classValue]++;
 
-            for (unsigned int col = 0; col < problem.XMatrix.ColumnLen; col++)
+            for (size_t col = 0; col < problem.XMatrix.ColumnLen; col++)
             {
-                int featureValue = problem.XMatrix[row][col];
+                float featureValue = (float)problem.XMatrix[row][col];
                 CFeatureClassData& featureClassData = featureClassDataList[col];
                 featureClassData.DataMap[classValue].push_back(featureValue);
             }
@@ -294,7 +294,7 @@ public:
 
 
         // 计算数据的高斯分布
-        for (unsigned int i = 0; i < featureClassDataList.size(); i++)
+        for (size_t i = 0; i < featureClassDataList.size(); i++)
         {
             for (auto iter = m_sampleClassCount.begin(); iter != m_sampleClassCount.end(); iter++)
             {
@@ -370,10 +370,10 @@ private:
         // 因为各个特征独立所以
         // P(x|y) * P(y) = P(a1|y) * P(a2|y) * ... * P(an|y) * P(y)
 
-        unsigned int classCount = m_sampleClassCount[classValue];
+        size_t classCount = m_sampleClassCount[classValue];
 
         float prob = 1.0f;
-        for (unsigned int col = 0; col < sample.ColumnLen; col++)
+        for (size_t col = 0; col < sample.ColumnLen; col++)
         {
             int featureValue = sample[0][col];
             const CGauss& gauss = m_featureClassGaussList[col].GaussMap[classValue];
@@ -393,7 +393,7 @@ private:
     /// @brief 计算数据的高斯分布
     /// @param[in] dataList 数据列表
     /// @return 高斯分布结构
-    CGauss CalculateGauss(IN const vector<int>& dataList)
+    CGauss CalculateGauss(IN const vector<float>& dataList)
     {
         CGauss gauss;
         gauss.Mean = 0.0f;
@@ -402,20 +402,13 @@ private:
         if (dataList.size() < 1)
             return gauss;
 
-        float total = 0.0f;
-        for (unsigned int i = 0; i < dataList.size(); i++)
-        {
-            total += (float)dataList[i];
-        }
+        float total = LVectorKernel<float>::Sum(dataList.size(), dataList.data());
 
         gauss.Mean = total/dataList.size();
 
-        float div = 0.0f;
-        for (unsigned int i = 0; i < dataList.size(); i++)
-        {
-            float temp = (float)dataList[i]-gauss.Mean;
-            div += (temp * temp);
-        }
+        vector<float> disList(dataList.size());
+        LVectorKernel<float>::AddScalar(dataList.size(), -gauss.Mean, dataList.data(), disList.data());
+        float div = LVectorKernel<float>::Dot(disList.size(), disList.data(), disList.data());
         div = div/dataList.size();
 
         gauss.Div = sqrt(div);
@@ -425,9 +418,9 @@ private:
 
 private:
     vector<CFeatureClassGauss> m_featureClassGaussList; ///< 特征类别高斯分布列表
-    map<int, unsigned int> m_sampleClassCount; ///< 训练样本类别计数
-    unsigned int m_featureCount; ///< 样本特征数量
-    unsigned int m_sampleCount; ///< 训练样本总数
+    map<int, size_t> m_sampleClassCount; ///< 训练样本类别计数
+    size_t m_featureCount; ///< 样本特征数量
+    size_t m_sampleCount; ///< 训练样本总数
 };
 
 LBayesClassifier::LBayesClassifier()
@@ -67,7 +67,7 @@ classifier.Predict(newSample, &predictValue);
 #ifndef _LBAYESCLASSIFIER_H_
 #define _LBAYESCLASSIFIER_H_
 
-#include "LDataStruct/LMatrix.h"
+#include "LMatrix.h"
 
 typedef LMatrix<int> LBayesMatrix; ///< 贝叶斯矩阵
 
@@ -18,7 +18,7 @@ enum LSTUMP_CLASSIFY_RULE
 /// @brief 桩结构
 struct LStump
 {
-    unsigned int FeatureIndex; ///< 特征索引, 使用该特征索引对样本进行分类
+    size_t FeatureIndex; ///< 特征索引, 使用该特征索引对样本进行分类
     float FeatureThreshold; ///< 特征阈值, 使用该特征阈值对样本进行分类
     LSTUMP_CLASSIFY_RULE ClassifyRule; ///< 分类规则, 使用该分类规则对样本进行分类
 };
@@ -64,7 +64,7 @@ public:
         if (0 == pResultVector)
             return false;
 
-        for (unsigned int i = 0; i < problem.YVector.RowLen; i++)
+        for (size_t i = 0; i < problem.YVector.RowLen; i++)
         {
             if (problem.YVector[i][0] != LBOOST_SUN &&
                 problem.YVector[i][0] != LBOOST_MOON)
@@ -74,8 +74,8 @@ public:
         const LBoostMatrix& X = problem.XMatrix; // 样本矩阵
         const LBoostMatrix& Y = problem.YVector; // 标签矩阵
 
-        const unsigned int M = X.RowLen; // 样本数量
-        const unsigned int N = X.ColumnLen; // 样本特征数量
+        const size_t M = X.RowLen; // 样本数量
+        const size_t N = X.ColumnLen; // 样本特征数量
 
         const int StepNum = 10;
 
@@ -88,13 +88,13 @@ public:
         
 
         // 对每一个特征
-        for (unsigned int n = 0; n < N; n++)
+        for (size_t n = 0; n < N; n++)
         {
             stump.FeatureIndex = n;
 
             float rangeMin = X[0][n]; // 所有样本中列i(特征)中的最小值
             float rangeMax = X[0][n]; // 所有样本中列i(特征)中的最大值
-            for (unsigned int m = 0; m < M; m++)
+            for (size_t m = 0; m < M; m++)
             {
                 if (X[m][n] < rangeMin)
                     rangeMin = X[m][n];
@@ -111,7 +111,7 @@ public:
                 this->Classify(X, stump, &classisVector);
 
                 float weightError = 0.0f;
-                for (unsigned int m = 0; m < M; m++)
+                for (size_t m = 0; m < M; m++)
                 {
                     if (classisVector[m] != Y[m][0])
                         weightError += weightVector[m];
@@ -122,7 +122,7 @@ public:
                 {
                     stump.ClassifyRule = LARGER_MOON;
                     weightError = 1.0f - weightError;
-                    for (unsigned int m = 0; m < M; m++)
+                    for (size_t m = 0; m < M; m++)
                         classisVector[m] *= LBOOST_MOON;
                 }
 
@@ -154,12 +154,12 @@ public:
 
         // 使用alpha更新权重向量
         float sumWeight = 0.0f;
-        for (unsigned int m = 0; m < M; m++)
+        for (size_t m = 0; m < M; m++)
         {
             weightVector[m] = weightVector[m] * exp(-1 * m_alpha * bestClassisVector[m] * problem.YVector[m][0]);
             sumWeight += weightVector[m];
         }
-        for (unsigned int m = 0; m < M; m++)
+        for (size_t m = 0; m < M; m++)
         {
             weightVector[m] = weightVector[m]/sumWeight;
         }
@@ -190,7 +190,7 @@ public:
         vector<float> classisVector;
         this->Classify(sampleMatrix, m_stump, &classisVector);
         pResultVector->resize(classisVector.size());
-        for (unsigned int i = 0; i < classisVector.size(); i++)
+        for (size_t i = 0; i < classisVector.size(); i++)
         {
             (*pResultVector)[i] = classisVector[i] * m_alpha;
         }
@@ -210,7 +210,7 @@ private:
     {
         pClassisVector->resize(sampleMatrix.RowLen);
 
-        for (unsigned int i = 0; i < sampleMatrix.RowLen; i++)
+        for (size_t i = 0; i < sampleMatrix.RowLen; i++)
         {
             if (stump.ClassifyRule == LARGER_SUN)
             {
@@ -232,7 +232,7 @@ private:
 
 private:
     bool m_bTrained; ///< 标识该决策桩是否已经被训练
-    unsigned int m_featureNum; ///< 决策桩要求的样本特征数
+    size_t m_featureNum; ///< 决策桩要求的样本特征数
     
 
     LStump m_stump; ///< 桩结构
@@ -277,7 +277,7 @@ public:
         if (problem.YVector.RowLen != problem.XMatrix.RowLen)
             return false;
 
-        for (unsigned int i = 0; i < problem.YVector.RowLen; i++)
+        for (size_t i = 0; i < problem.YVector.RowLen; i++)
         {
             if (problem.YVector[i][0] != LBOOST_SUN &&
                 problem.YVector[i][0] != LBOOST_MOON)
@@ -288,7 +288,7 @@ public:
 
         // 构造并且初始化权重向量(列向量)
         vector<float> weightVector(problem.XMatrix.RowLen);
-        for (unsigned int i =0; i < weightVector.size(); i++)
+        for (size_t i =0; i < weightVector.size(); i++)
         {
             weightVector[i] = 1.0f/(float)weightVector.size();
         }
@@ -308,14 +308,14 @@ public:
             m_weakClassifierList.push_back(stumpClassifer);
 
             // 计算累加类别向量
-            for (unsigned int m = 0; m < sumClassisVector.size(); m++)
+            for (size_t m = 0; m < sumClassisVector.size(); m++)
             {
                 sumClassisVector[m] += resultVector[m];
             }
 
             // 计算累加错误率
             int errorCount = 0; // 错误分类计数
-            for (unsigned int m = 0; m < sumClassisVector.size(); m++)
+            for (size_t m = 0; m < sumClassisVector.size(); m++)
             {
                 if (sumClassisVector[m] * problem.YVector[m][0] < 0)
                     errorCount++;
@@ -364,17 +364,17 @@ public:
 
         vector<float> resultVector(sampleMatrix.RowLen);
         vector<float> sumResultVector(sampleMatrix.RowLen, 0.0f);
-        for (unsigned int i = 0; i < this->m_weakClassifierList.size(); i++)
+        for (size_t i = 0; i < this->m_weakClassifierList.size(); i++)
         {
             CStumpClassifer& stumpClassifer = m_weakClassifierList[i];
             stumpClassifer.Predict(sampleMatrix, &resultVector);
-            for (unsigned int j = 0; j < resultVector.size(); j++)
+            for (size_t j = 0; j < resultVector.size(); j++)
             {
                 sumResultVector[j] += resultVector[j];
             }
         }
 
-        for (unsigned int m = 0; m < sumResultVector.size(); m++)
+        for (size_t m = 0; m < sumResultVector.size(); m++)
         {
             if (sumResultVector[m] >= 0.0f)
                 (*pClassisVector)[m][0] = LBOOST_SUN;
@@ -388,7 +388,7 @@ public:
 private:
     vector<CStumpClassifer> m_weakClassifierList; ///< 弱分类器列表
     unsigned int m_maxWeakClassifierNum; ///< 最大弱分类器数量
-    unsigned int m_featureNum; ///< 分类器要求的样本特征数
+    size_t m_featureNum; ///< 分类器要求的样本特征数
 };
 
 LBoostTree::LBoostTree()
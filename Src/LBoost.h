@@ -45,8 +45,8 @@
     // 计算训练错误率
     LBoostMatrix resultVector;
     boostTree.Predict(sampleMatrix, &resultVector);
-    unsigned errorCount = 0;
-    for (unsigned int i = 0; i < resultVector.RowLen; i++)
+    size_t errorCount = 0;
+    for (size_t i = 0; i < resultVector.RowLen; i++)
     {
         if (resultVector[i][0] != labelVector[i][0])
             errorCount++;
@@ -59,7 +59,7 @@
 #ifndef _LBOOST_H_
 #define _LBOOST_H_
 
-#include "LDataStruct/LMatrix.h"
+#include "LMatrix.h"
 
 #ifndef IN
 #define IN
@@ -1,199 +1,1722 @@
 ﻿#include "LCSVIo.h"
+#include "LMappedFile.h"
+#include "LMatrixFile.h"
+#include "LThreadPool.h"
 
-#include <iostream>
-#include <fstream>
-#include <sstream>
+#include <cstdlib>
+#include <cstring>
+#include <random>
 #include <string>
 #include <vector>
 
-using std::ios;
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define LCSV_SSE2
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+using std::string;
 using std::wstring;
-using std::wifstream;
-using std::wstringstream;
 using std::vector;
 
-/// @brief 字符串分割
-/// @param[in] ch 分割字符
-/// @param[in] srcStr 源字符串
-/// @param[in] strList 分割后的字符串列表
-static void WStringSplit(IN const wchar_t ch, IN const wstring& srcStr, OUT vector<wstring>& strList)
+/// @brief 并行解析时每段数据的最小大小(字节), 小文件只用一个线程解析
+#ifndef LCSV_PARALLEL_CHUNK_SIZE
+#define LCSV_PARALLEL_CHUNK_SIZE (4 * 1024 * 1024)
+#endif
+
+/// @brief 缓存文件的扩展名
+#define LCSV_CACHE_EXTENSION L".lmx"
+
+namespace
+{
+    /// @brief 判断字符是否为空白字符(不包括换行符)
+    inline bool CSVSpace(IN char ch)
+    {
+        return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\v' || ch == '\f';
+    }
+
+    /// @brief 判断字符是否为数字
+    inline bool CSVDigit(IN char ch)
+    {
+        return (unsigned char)(ch - '0') < 10;
+    }
+
+#ifdef LCSV_SSE2
+    /// @brief 获取掩码中最低的置位
+    inline unsigned int CSVLowestBit(IN unsigned int mask)
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return (unsigned int)index;
+#else
+        return (unsigned int)__builtin_ctz(mask);
+#endif
+    }
+#endif
+
+    /// @brief 统计区域中指定字符的个数
+    /// @param[in] pBegin 区域开始
+    /// @param[in] pEnd 区域结束
+    /// @param[in] ch 字符
+    /// @return 字符个数
+    size_t CSVCountChar(IN const char* pBegin, IN const char* pEnd, IN char ch)
+    {
+        size_t count = 0;
+        const char* p = pBegin;
+#ifdef LCSV_SSE2
+        // 比较结果为-1, 每个字节的计数器最多累加255次, 然后用SAD指令水平求和
+        const __m128i target = _mm_set1_epi8(ch);
+        const __m128i zero = _mm_setzero_si128();
+        while (pEnd - p >= 16)
+        {
+            __m128i counter = zero;
+            for (size_t i = 0; i < 255 && pEnd - p >= 16; i++, p += 16)
+            {
+                const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+                counter = _mm_sub_epi8(counter, _mm_cmpeq_epi8(block, target));
+            }
+            const __m128i sum = _mm_sad_epu8(counter, zero);
+            count += (size_t)_mm_cvtsi128_si32(sum) + (size_t)_mm_cvtsi128_si32(_mm_srli_si128(sum, 8));
+        }
+#endif
+        for (; p < pEnd; p++)
+        {
+            if (*p == ch)
+                count++;
+        }
+        return count;
+    }
+
+    /// @brief 统计区域中的换行符个数
+    inline size_t CSVCountLines(IN const char* pBegin, IN const char* pEnd)
+    {
+        return CSVCountChar(pBegin, pEnd, '\n');
+    }
+
+    /// @brief 在一行中查找分隔符
+    /// 向量加载可以越过行尾, 但是不会越过pLimit
+    /// @param[in] p 开始位置
+    /// @param[in] pLineEnd 行尾
+    /// @param[in] pLimit 可读取的区域结束
+    /// @param[in] delimiter 分隔符
+    /// @return 分隔符的位置, 没有找到时返回pLineEnd
+    inline const char* CSVFindDelimiter(IN const char* p, IN const char* pLineEnd, IN const char* pLimit, IN char delimiter)
+    {
+#ifdef LCSV_SSE2
+        const __m128i target = _mm_set1_epi8(delimiter);
+        while (p < pLineEnd && pLimit - p >= 16)
+        {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            const unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(block, target));
+            if (mask != 0)
+            {
+                p += CSVLowestBit(mask);
+                return p < pLineEnd ? p : pLineEnd;
+            }
+            p += 16;
+        }
+        if (p >= pLineEnd)
+            return pLineEnd;
+#endif
+        for (; p < pLineEnd; p++)
+        {
+            if (*p == delimiter)
+                return p;
+        }
+        return pLineEnd;
+    }
+
+    /// @brief 快速转换十进制浮点数
+    /// 数字不超过19个, 有效数字不超过2^53并且10的指数不超过22时, 一次乘法或除法的结果就是正确舍入的值,
+    /// 其他情况返回0, 由CSVSlowDouble处理
+    /// @param[in] p 开始位置
+    /// @param[in] pLimit 可读取的区域结束, 数值在第一个不属于数值的字符处结束
+    /// @param[out] value 转换结果
+    /// @return 数值的结束位置, 失败返回0
+    inline const char* CSVFastDouble(IN const char* p, IN const char* pLimit, OUT double& value)
+    {
+        static const double POW10[23] = 
+        {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+
+        const bool negative = (*p == '-');
+        if (negative || *p == '+')
+            p++;
+
+        // 整数部分和小数部分的数字合并为一个整数, 小数位数作为负的指数
+        unsigned long long mantissa = 0;
+        const char* pDigit = p;
+        for (; p < pLimit && CSVDigit(*p); p++)
+            mantissa = mantissa * 10 + (unsigned int)(*p - '0');
+        int digitNum = (int)(p - pDigit);
+        int exponent = 0;
+        if (p < pLimit && *p == '.')
+        {
+            p++;
+            pDigit = p;
+            for (; p < pLimit && CSVDigit(*p); p++)
+                mantissa = mantissa * 10 + (unsigned int)(*p - '0');
+            exponent = (int)(pDigit - p);
+            digitNum -= exponent;
+        }
+        if (digitNum == 0 || digitNum > 19)
+            return 0;
+
+        if (p < pLimit && (*p == 'e' || *p == 'E'))
+        {
+            p++;
+            bool expNegative = false;
+            if (p < pLimit && (*p == '-' || *p == '+'))
+            {
+                expNegative = (*p == '-');
+                p++;
+            }
+            if (p >= pLimit || !CSVDigit(*p))
+                return 0;
+
+            int expValue = 0;
+            for (; p < pLimit && CSVDigit(*p); p++)
+            {
+                if (expValue < 10000)
+                    expValue = expValue * 10 + (*p - '0');
+            }
+            exponent += expNegative ? -expValue : expValue;
+        }
+
+        if (mantissa == 0)
+        {
+            value = negative ? -0.0 : 0.0;
+            return p;
+        }
+        if (mantissa > (1ULL << 53) || exponent < -22 || exponent > 22)
+            return 0;
+
+        double result = (double)mantissa;
+        result = exponent < 0 ? result / POW10[-exponent] : result * POW10[exponent];
+        value = negative ? -result : result;
+        return p;
+    }
+
+    /// @brief 使用strtod转换浮点数
+    /// 与原来的流转换一致, 只转换合法的前缀, 没有合法前缀时为0
+    double CSVSlowDouble(IN const char* p, IN const char* pEnd)
+    {
+        const size_t length = (size_t)(pEnd - p);
+        char buffer[64];
+        if (length < sizeof(buffer))
+        {
+            memcpy(buffer, p, length);
+            buffer[length] = '\0';
+            return strtod(buffer, 0);
+        }
+
+        string str(p, pEnd);
+        return strtod(str.c_str(), 0);
+    }
+
+    /// @brief 去除区域首尾的空白字符
+    inline void CSVTrim(INOUT const char*& pBegin, INOUT const char*& pEnd)
+    {
+        while (pBegin < pEnd && CSVSpace(*pBegin))
+            pBegin++;
+        while (pEnd > pBegin && CSVSpace(pEnd[-1]))
+            pEnd--;
+    }
+
+    /// @brief 获取行尾
+    /// @return 换行符的位置, 没有换行符时返回pEnd
+    inline const char* CSVLineEnd(IN const char* p, IN const char* pEnd)
+    {
+        const char* pLineEnd = static_cast<const char*>(memchr(p, '\n', (size_t)(pEnd - p)));
+        return pLineEnd != 0 ? pLineEnd : pEnd;
+    }
+
+    /// @brief 检查分隔符
+    /// 按字节解析, 分隔符必须为ASCII字符
+    /// @param[in] ch 设置的分隔符
+    /// @param[out] delimiter 字节分隔符
+    /// @return 分隔符不能使用时返回false
+    inline bool CSVDelimiter(IN wchar_t ch, OUT char& delimiter)
+    {
+        if (ch <= 0 || ch >= 0x80 || ch == L'\n')
+            return false;
+
+        delimiter = (char)ch;
+        return true;
+    }
+
+    /// @brief 获取数据开始的位置
+    /// 跳过UTF-8 BOM, 需要时跳过首行
+    /// @param[in] pBegin 文件开始
+    /// @param[in] pEnd 区域结束
+    /// @param[in] skipHeader 是否跳过首行
+    inline const char* CSVDataBegin(IN const char* pBegin, IN const char* pEnd, IN bool skipHeader)
+    {
+        if (pEnd - pBegin >= 3 && 
+            (unsigned char)pBegin[0] == 0xEF && (unsigned char)pBegin[1] == 0xBB && (unsigned char)pBegin[2] == 0xBF)
+            pBegin += 3;
+
+        if (skipHeader)
+        {
+            pBegin = CSVLineEnd(pBegin, pEnd);
+            if (pBegin < pEnd)
+                pBegin++;
+        }
+
+        return pBegin;
+    }
+
+    /// @brief 统计第一个非空行的列数
+    /// @return 没有非空行时返回0
+    size_t CSVColumnLength(IN const char* pBegin, IN const char* pEnd, IN char delimiter)
+    {
+        const char* p = pBegin;
+        while (p < pEnd)
+        {
+            const char* pLineEnd = CSVLineEnd(p, pEnd);
+            const char* pLineStart = p;
+            const char* pTrimEnd = pLineEnd;
+            p = pLineEnd < pEnd ? pLineEnd + 1 : pEnd;
+
+            CSVTrim(pLineStart, pTrimEnd);
+            if (pLineStart == pTrimEnd)
+                continue;
+
+            size_t colLength = 1;
+            for (const char* pField = pLineStart; ; colLength++)
+            {
+                const char* pFieldEnd = CSVFindDelimiter(pField, pTrimEnd, pEnd, delimiter);
+                if (pFieldEnd == pTrimEnd)
+                    break;
+                pField = pFieldEnd + 1;
+            }
+            return colLength;
+        }
+
+        return 0;
+    }
+
+    /// @brief 转换一个字段
+    /// 先直接转换数值, 数值之后只有空白字符时就是一个完整的字段, 否则查找分隔符, 使用strtod转换
+    /// @param[in] pField 字段开始
+    /// @param[in] pLineEnd 行尾(已去除行尾的空白字符)
+    /// @param[in] pLimit 可读取的区域结束
+    /// @param[in] delimiter 分隔符
+    /// @param[out] value 转换结果
+    /// @return 字段结束的位置(分隔符或者行尾), 字段为空时返回0
+    inline const char* CSVParseField(
+        IN const char* pField, 
+        IN const char* pLineEnd, 
+        IN const char* pLimit, 
+        IN char delimiter, 
+        OUT double& value)
+    {
+        // 分隔符本身是空白字符(如空格)时, 空白字符不能越过分隔符
+        while (pField < pLineEnd && *pField != delimiter && CSVSpace(*pField))
+            pField++;
+
+        const char* pFieldEnd = pField < pLineEnd ? CSVFastDouble(pField, pLimit, value) : 0;
+        if (pFieldEnd != 0)
+        {
+            while (pFieldEnd < pLineEnd && *pFieldEnd != delimiter && CSVSpace(*pFieldEnd))
+                pFieldEnd++;
+            if (pFieldEnd == pLineEnd || *pFieldEnd == delimiter)
+                return pFieldEnd;
+        }
+
+        // 快速转换失败时查找分隔符, 使用strtod转换
+        pFieldEnd = CSVFindDelimiter(pField, pLineEnd, pLimit, delimiter);
+        const char* pValueEnd = pFieldEnd;
+        CSVTrim(pField, pValueEnd);
+        if (pField == pValueEnd)
+            return 0;
+
+        value = CSVSlowDouble(pField, pValueEnd);
+        return pFieldEnd;
+    }
+
+    /// @brief 解析区域中的行, 直接写入矩阵数据
+    /// 空行被忽略, 每行的字段数必须为colLength, 字段去除首尾空白字符后不能为空
+    /// @param[in] pBegin 区域开始(行首)
+    /// @param[in] pEnd 区域结束
+    /// @param[in] delimiter 分隔符
+    /// @param[in] colLength 列数
+    /// @param[in] rowMax 最多写入的行数, 写满后停止解析
+    /// @param[in] rowStride 行步长(元素个数)
+    /// @param[out] pData 矩阵数据
+    /// @param[out] rowLength 写入的行数
+    /// @return 停止解析的位置(下一行的行首), 数据格式错误返回0
+    const char* CSVParseRows(
+        IN const char* pBegin, 
+        IN const char* pEnd, 
+        IN char delimiter, 
+        IN size_t colLength, 
+        IN size_t rowMax,
+        IN size_t rowStride,
+        OUT double* pData, 
+        OUT size_t& rowLength)
+    {
+        rowLength = 0;
+
+        const char* p = pBegin;
+        while (p < pEnd && rowLength < rowMax)
+        {
+            const char* pLineEnd = CSVLineEnd(p, pEnd);
+            const char* pLineStart = p;
+            p = pLineEnd < pEnd ? pLineEnd + 1 : pEnd;
+
+            CSVTrim(pLineStart, pLineEnd);
+            if (pLineStart == pLineEnd)
+                continue;
+
+            double* pRow = pData + rowLength * rowStride;
+            const char* pField = pLineStart;
+            for (size_t col = 0; ; col++)
+            {
+                if (col >= colLength)
+                    return 0;
+
+                const char* pFieldEnd = CSVParseField(pField, pLineEnd, pEnd, delimiter, pRow[col]);
+                if (pFieldEnd == 0)
+                    return 0;
+
+                if (pFieldEnd == pLineEnd)
+                {
+                    if (col + 1 != colLength)
+                        return 0;
+                    break;
+                }
+                pField = pFieldEnd + 1;
+            }
+
+            rowLength++;
+        }
+
+        return p;
+    }
+
+    /// @brief 列的目标: 忽略
+    const int CSV_COLUMN_SKIP = -1;
+
+    /// @brief 列的目标: 标签向量
+    const int CSV_COLUMN_LABEL = -2;
+
+    /// @brief 把转换后的数值写入目标类型
+    template<typename Type>
+    inline void CSVConvert(IN double value, OUT Type& target)
+    {
+        target = static_cast<Type>(value);
+    }
+
+    /// @brief 把转换后的数值写入int, 截断小数部分, 超出范围时取最近的边界, NaN为0
+    template<>
+    inline void CSVConvert<int>(IN double value, OUT int& target)
+    {
+        if (value >= 2147483647.0)
+            target = 2147483647;
+        else if (value <= -2147483648.0)
+            target = (-2147483647 - 1);
+        else if (value == value)
+            target = static_cast<int>(value);
+        else
+            target = 0;
+    }
+
+    /// @brief 按数据模式生成每一列的目标
+    /// @param[in] schema 数据模式
+    /// @param[in] colLength 文件的列数
+    /// @param[out] columnTarget 每一列的目标: 特征矩阵中的列, CSV_COLUMN_LABEL或者CSV_COLUMN_SKIP
+    /// @param[out] featureNum 特征数
+    /// @return 列索引超出范围, 重复或者没有特征列时返回false
+    bool CSVColumnTarget(IN const LCSVSchema& schema, IN size_t colLength, OUT vector<int>& columnTarget, OUT size_t& featureNum)
+    {
+        columnTarget.assign(colLength, CSV_COLUMN_SKIP);
+        featureNum = 0;
+
+        if (schema.LabelColumn != LCSV_NO_COLUMN)
+        {
+            if (schema.LabelColumn >= colLength)
+                return false;
+            columnTarget[schema.LabelColumn] = CSV_COLUMN_LABEL;
+        }
+
+        if (schema.FeatureColumns.empty())
+        {
+            for (size_t col = 0; col < colLength; col++)
+            {
+                if (columnTarget[col] == CSV_COLUMN_SKIP)
+                    columnTarget[col] = (int)featureNum++;
+            }
+        }
+        else
+        {
+            for (size_t i = 0; i < schema.FeatureColumns.size(); i++)
+            {
+                const size_t col = schema.FeatureColumns[i];
+                if (col >= colLength || columnTarget[col] != CSV_COLUMN_SKIP)
+                    return false;
+                columnTarget[col] = (int)featureNum++;
+            }
+        }
+
+        return featureNum > 0;
+    }
+
+    /// @brief 按数据模式解析区域中的行, 字段直接转换为目标类型写入特征矩阵和标签向量
+    /// 与CSVParseRows的规则相同, 忽略的列只查找分隔符, 不转换也不检查
+    /// @param[in] pBegin 区域开始(行首)
+    /// @param[in] pEnd 区域结束
+    /// @param[in] delimiter 分隔符
+    /// @param[in] pColumnTarget 每一列的目标(见CSVColumnTarget), 共colLength个
+    /// @param[in] colLength 列数
+    /// @param[in] rowMax 最多写入的行数, 写满后停止解析
+    /// @param[in] featureStride 特征矩阵的行步长(元素个数)
+    /// @param[out] pFeature 特征矩阵数据
+    /// @param[in] labelStride 标签向量的行步长(元素个数)
+    /// @param[out] pLabel 标签向量数据, 没有标签列时为0
+    /// @param[out] rowLength 写入的行数
+    /// @return 停止解析的位置(下一行的行首), 数据格式错误返回0
+    template<typename FeatureType, typename LabelType>
+    const char* CSVParseTypedRows(
+        IN const char* pBegin, 
+        IN const char* pEnd, 
+        IN char delimiter, 
+        IN const int* pColumnTarget,
+        IN size_t colLength, 
+        IN size_t rowMax,
+        IN size_t featureStride,
+        OUT FeatureType* pFeature, 
+        IN size_t labelStride,
+        OUT LabelType* pLabel, 
+        OUT size_t& rowLength)
+    {
+        rowLength = 0;
+
+        const char* p = pBegin;
+        while (p < pEnd && rowLength < rowMax)
+        {
+            const char* pLineEnd = CSVLineEnd(p, pEnd);
+            const char* pLineStart = p;
+            p = pLineEnd < pEnd ? pLineEnd + 1 : pEnd;
+
+            CSVTrim(pLineStart, pLineEnd);
+            if (pLineStart == pLineEnd)
+                continue;
+
+            FeatureType* pRow = pFeature + rowLength * featureStride;
+            const char* pField = pLineStart;
+            for (size_t col = 0; ; col++)
+            {
+                if (col >= colLength)
+                    return 0;
+
+                const int target = pColumnTarget[col];
+                const char* pFieldEnd = 0;
+                if (target == CSV_COLUMN_SKIP)
+                {
+                    pFieldEnd = CSVFindDelimiter(pField, pLineEnd, pEnd, delimiter);
+                }
+                else
+                {
+                    double value = 0.0;
+                    pFieldEnd = CSVParseField(pField, pLineEnd, pEnd, delimiter, value);
+                    if (pFieldEnd == 0)
+                        return 0;
+
+                    if (target == CSV_COLUMN_LABEL)
+                        CSVConvert(value, pLabel[rowLength * labelStride]);
+                    else
+                        CSVConvert(value, pRow[target]);
+                }
+
+                if (pFieldEnd == pLineEnd)
+                {
+                    if (col + 1 != colLength)
+                        return 0;
+                    break;
+                }
+                pField = pFieldEnd + 1;
+            }
+
+            rowLength++;
+        }
+
+        return p;
+    }
+
+    /// @brief 按行边界划分的数据段
+    struct CSVChunkList
+    {
+        vector<const char*> BeginList;  ///< 每段的开始, 最后一个元素为数据结束
+        vector<size_t> RowMaxList;      ///< 每段的行数上限(包括空行)
+        vector<size_t> RowStartList;    ///< 每段在矩阵中的起始行
+        vector<size_t> RowLengthList;   ///< 每段解析得到的行数
+        vector<char> SuccessList;       ///< 每段是否解析成功
+
+        /// @brief 段数
+        size_t Size() const
+        {
+            return RowMaxList.size();
+        }
+    };
+
+    /// @brief 把数据按行边界划分为多段, 并行统计每段的行数
+    /// 文件较大并且有多个线程时才划分, 否则只有一段
+    /// 每段的行数上限的前缀和就是该段在矩阵中的起始行, 没有空行时行数上限就是实际的行数
+    /// @param[in] pBegin 数据开始
+    /// @param[in] pEnd 数据结束
+    /// @param[out] chunkList 数据段
+    /// @return 总的行数上限
+    size_t CSVSplitChunks(IN const char* pBegin, IN const char* pEnd, OUT CSVChunkList& chunkList)
+    {
+        LThreadPool& threadPool = LThreadPool::Global();
+        size_t chunkNum = (size_t)(pEnd - pBegin) / LCSV_PARALLEL_CHUNK_SIZE;
+        if (chunkNum > threadPool.ThreadNum())
+            chunkNum = threadPool.ThreadNum();
+        if (chunkNum < 1)
+            chunkNum = 1;
+
+        vector<const char*>& beginList = chunkList.BeginList;
+        beginList.assign(chunkNum + 1, pBegin);
+        beginList[chunkNum] = pEnd;
+        for (size_t i = 1; i < chunkNum; i++)
+        {
+            const char* p = pBegin + (size_t)(pEnd - pBegin) / chunkNum * i;
+            if (p < beginList[i - 1])
+                p = beginList[i - 1];
+            p = CSVLineEnd(p, pEnd);
+            beginList[i] = p < pEnd ? p + 1 : pEnd;
+        }
+
+        vector<size_t>& rowMaxList = chunkList.RowMaxList;
+        rowMaxList.assign(chunkNum, 0);
+        threadPool.ParallelFor(chunkNum, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+                rowMaxList[i] = CSVCountLines(beginList[i], beginList[i + 1]);
+        });
+        if (pEnd > pBegin && pEnd[-1] != '\n')
+            rowMaxList[chunkNum - 1]++;
+
+        chunkList.RowStartList.assign(chunkNum, 0);
+        size_t rowMax = 0;
+        for (size_t i = 0; i < chunkNum; i++)
+        {
+            chunkList.RowStartList[i] = rowMax;
+            rowMax += rowMaxList[i];
+        }
+
+        chunkList.RowLengthList.assign(chunkNum, 0);
+        chunkList.SuccessList.assign(chunkNum, 0);
+        return rowMax;
+    }
+
+    /// @brief 检查所有段是否解析成功
+    /// @param[in] chunkList 数据段
+    /// @param[out] rowLength 总的行数
+    /// @return 有段解析失败时返回false
+    bool CSVChunkResult(IN const CSVChunkList& chunkList, OUT size_t& rowLength)
+    {
+        rowLength = 0;
+        for (size_t i = 0; i < chunkList.Size(); i++)
+        {
+            if (!chunkList.SuccessList[i])
+                return false;
+            rowLength += chunkList.RowLengthList[i];
+        }
+        return true;
+    }
+
+    /// @brief 有空行时把后面的段向前移动, 然后去掉多余的行
+    /// @param[in] chunkList 数据段
+    /// @param[in] rowLength 总的行数
+    /// @param[inout] M 矩阵, 行数为总的行数上限
+    template<typename Type>
+    void CSVCompactRows(IN const CSVChunkList& chunkList, IN size_t rowLength, INOUT LMatrix<Type>& M)
+    {
+        if (rowLength == M.RowLen)
+            return;
+
+        const size_t rowStride = M.RowStride();
+        Type* pData = M[0];
+        size_t row = 0;
+        for (size_t i = 0; i < chunkList.Size(); i++)
+        {
+            if (row != chunkList.RowStartList[i])
+                memmove(pData + row * rowStride, pData + chunkList.RowStartList[i] * rowStride, chunkList.RowLengthList[i] * rowStride * sizeof(Type));
+            row += chunkList.RowLengthList[i];
+        }
+
+        LMatrix<Type> result;
+        if (rowLength > 0)
+            M.SubMatrix(0, rowLength, 0, M.ColumnLen, result);
+        M = result;
+    }
+
+    /// @brief 转换一个完整的数值
+    /// 与CSVSlowDouble不同, 整个区域必须都是数值
+    /// @return 区域为空或者不是合法的数值返回false
+    bool CSVStrictDouble(IN const char* p, IN const char* pEnd, OUT double& value)
+    {
+        const size_t length = (size_t)(pEnd - p);
+        if (length == 0)
+            return false;
+
+        string str(p, pEnd);
+        char* pStop = 0;
+        value = strtod(str.c_str(), &pStop);
+        return pStop == str.c_str() + length;
+    }
+
+    /// @brief 把数值格式化为能够准确转换回来的最短文本
+    /// @param[in] value 数值
+    /// @param[out] buffer 文本, 至少32字节
+    /// @return 文本长度
+    int CSVFormatDouble(IN double value, OUT char* buffer)
+    {
+        int length = 0;
+        for (int precision = 15; precision <= 17; precision++)
+        {
+            length = sprintf(buffer, "%.*g", precision, value);
+            if (strtod(buffer, 0) == value || value != value)
+                break;
+        }
+        return length;
+    }
+
+    /// @brief svmlight格式解析得到的行(CSR格式)
+    struct SVMLightRows
+    {
+        vector<size_t> RowOffsetList;   ///< 行偏移表, 第一个值为0
+        vector<size_t> ColumnIndexList; ///< 非零元素的列索引列表
+        vector<double> ValueList;       ///< 非零元素的值列表
+        vector<double> LabelList;       ///< 标签列表
+        size_t ColumnLen;               ///< 最大的列索引加1
+
+        /// @brief 构造函数
+        SVMLightRows()
+        {
+            this->Clear();
+        }
+
+        /// @brief 清除所有行
+        void Clear()
+        {
+            RowOffsetList.assign(1, 0);
+            ColumnIndexList.clear();
+            ValueList.clear();
+            LabelList.clear();
+            ColumnLen = 0;
+        }
+
+        /// @brief 行数
+        size_t RowLen() const
+        {
+            return LabelList.size();
+        }
+    };
+
+    /// @brief 转换svmlight格式中的数值
+    /// 数值在空白字符或者行尾结束
+    /// @param[in] p 开始位置, 小于pLineEnd
+    /// @param[in] pLineEnd 行尾
+    /// @param[out] value 转换结果
+    /// @return 数值的结束位置, 不是合法的数值返回0
+    inline const char* SVMLightNumber(IN const char* p, IN const char* pLineEnd, OUT double& value)
+    {
+        const char* pEnd = CSVFastDouble(p, pLineEnd, value);
+        if (pEnd != 0 && (pEnd == pLineEnd || CSVSpace(*pEnd)))
+            return pEnd;
+
+        pEnd = p;
+        while (pEnd < pLineEnd && !CSVSpace(*pEnd))
+            pEnd++;
+        return CSVStrictDouble(p, pEnd, value) ? pEnd : 0;
+    }
+
+    /// @brief 解析区域中的svmlight格式的行, 追加到rows中
+    /// 每行为"<标签> <索引>:<值> ...", 索引在行内严格递增, "#"之后为注释, 空行和注释行被忽略, "qid:<n>"被忽略
+    /// @param[in] pBegin 区域开始(行首)
+    /// @param[in] pEnd 区域结束
+    /// @param[in] indexBase 最小的索引(1或者0), 列索引为索引减去indexBase
+    /// @param[in] featureNum 特征数, 列索引必须小于特征数, 为0表示不限制
+    /// @param[in] rowMax 最多解析的行数, 解析满后停止
+    /// @param[inout] rows 解析得到的行
+    /// @return 停止解析的位置(下一行的行首), 数据格式错误返回0
+    const char* SVMLightParseRows(
+        IN const char* pBegin,
+        IN const char* pEnd,
+        IN size_t indexBase,
+        IN size_t featureNum,
+        IN size_t rowMax,
+        INOUT SVMLightRows& rows)
+    {
+        // 索引不能超过该值, 避免溢出
+        const unsigned long long INDEX_MAX = 1ULL << 48;
+
+        size_t rowLength = 0;
+        const char* p = pBegin;
+        while (p < pEnd && rowLength < rowMax)
+        {
+            const char* pLineEnd = CSVLineEnd(p, pEnd);
+            const char* pLine = p;
+            p = pLineEnd < pEnd ? pLineEnd + 1 : pEnd;
+
+            const char* pComment = static_cast<const char*>(memchr(pLine, '#', (size_t)(pLineEnd - pLine)));
+            if (pComment != 0)
+                pLineEnd = pComment;
+            CSVTrim(pLine, pLineEnd);
+            if (pLine == pLineEnd)
+                continue;
+
+            double label = 0.0;
+            const char* q = SVMLightNumber(pLine, pLineEnd, label);
+            if (q == 0)
+                return 0;
+
+            size_t lastColumn = 0;
+            bool empty = true;
+            while (true)
+            {
+                while (q < pLineEnd && CSVSpace(*q))
+                    q++;
+                if (q == pLineEnd)
+                    break;
+
+                if (pLineEnd - q > 4 && memcmp(q, "qid:", 4) == 0)
+                {
+                    while (q < pLineEnd && !CSVSpace(*q))
+                        q++;
+                    continue;
+                }
+
+                unsigned long long index = 0;
+                const char* pDigit = q;
+                for (; q < pLineEnd && CSVDigit(*q); q++)
+                {
+                    index = index * 10 + (unsigned int)(*q - '0');
+                    if (index > INDEX_MAX)
+                        return 0;
+                }
+                if (q == pDigit || q + 1 >= pLineEnd || *q != ':' || index < indexBase)
+                    return 0;
+
+                const size_t column = (size_t)(index - indexBase);
+                if ((featureNum > 0 && column >= featureNum) || (!empty && column <= lastColumn))
+                    return 0;
+
+                double value = 0.0;
+                q = SVMLightNumber(q + 1, pLineEnd, value);
+                if (q == 0)
+                    return 0;
+
+                rows.ColumnIndexList.push_back(column);
+                rows.ValueList.push_back(value);
+                lastColumn = column;
+                empty = false;
+            }
+
+            if (!empty && lastColumn >= rows.ColumnLen)
+                rows.ColumnLen = lastColumn + 1;
+            rows.LabelList.push_back(label);
+            rows.RowOffsetList.push_back(rows.ColumnIndexList.size());
+            rowLength++;
+        }
+
+        return p;
+    }
+
+    /// @brief 使用解析得到的行生成稀疏矩阵和标签向量
+    /// 行中的数据被移动到稀疏矩阵中
+    /// @param[inout] rows 解析得到的行
+    /// @param[in] featureNum 特征数, 为0时使用最大的列索引加1(至少为1)
+    /// @param[out] featureMatrix 特征矩阵
+    /// @param[out] labelVector 标签向量
+    /// @return 没有行时返回false
+    bool SVMLightMatrix(
+        INOUT SVMLightRows& rows, 
+        IN size_t featureNum, 
+        OUT LSparseMatrix<double>& featureMatrix, 
+        OUT LDataMatrix& labelVector)
+    {
+        const size_t rowLength = rows.RowLen();
+        if (rowLength == 0)
+            return false;
+
+        size_t colLength = featureNum;
+        if (colLength == 0)
+            colLength = rows.ColumnLen > 0 ? rows.ColumnLen : 1;
+
+        labelVector.Reset(rowLength, 1);
+        for (size_t i = 0; i < rowLength; i++)
+            labelVector[i][0] = rows.LabelList[i];
+
+        return featureMatrix.Reset(
+            rowLength, colLength, 
+            std::move(rows.RowOffsetList), std::move(rows.ColumnIndexList), std::move(rows.ValueList));
+    }
+
+    /// @brief 文件窗口
+    /// 流式读取时每次只映射文件的一段区域(窗口), 窗口结束于最后一个完整的行(文件末尾除外)
+    class CSVFileWindow
+    {
+    public:
+        /// @brief 构造函数
+        CSVFileWindow()
+            : m_windowSize(16 * 1024 * 1024)
+        {
+            this->Close();
+        }
+
+        /// @brief 设置窗口大小
+        /// 一行数据大于窗口时自动扩大
+        void SetWindowSize(IN size_t bytes)
+        {
+            if (bytes > 0)
+                m_windowSize = bytes;
+        }
+
+        /// @brief 打开文件并映射第一个窗口
+        /// @return 文件不存在, 为空或者映射失败返回false
+        bool Open(IN const wstring& fileName)
+        {
+            this->Close();
+            m_fileName = fileName;
+            if (!LMappedFile::FileSize(m_fileName.c_str(), m_fileSize))
+            {
+                m_bFailed = true;
+                return false;
+            }
+
+            return this->MapNext();
+        }
+
+        /// @brief 映射下一个窗口
+        /// 窗口从当前位置开始, 窗口中没有完整的行时扩大窗口
+        /// @return 已经到达文件末尾或者映射失败(见Failed)返回false
+        bool MapNext()
+        {
+            if (Cursor != 0)
+                m_offset += (unsigned long long)(Cursor - static_cast<const char*>(m_file.Data()));
+
+            while (m_offset < m_fileSize)
+            {
+                const unsigned long long remain = m_fileSize - m_offset;
+                const size_t size = remain < m_windowSize ? (size_t)remain : m_windowSize;
+                if (!m_file.Open(m_fileName.c_str(), LMAPPED_FILE_READ_ONLY, (size_t)m_offset, size))
+                {
+                    m_bFailed = true;
+                    break;
+                }
+
+                Cursor = static_cast<const char*>(m_file.Data());
+                End = Cursor + size;
+                if (size == remain)
+                    return true;
+
+                const char* pLast = End;
+                while (pLast > Cursor && pLast[-1] != '\n')
+                    pLast--;
+                if (pLast > Cursor)
+                {
+                    End = pLast;
+                    return true;
+                }
+
+                m_windowSize *= 2;
+            }
+
+            m_file.Close();
+            Cursor = 0;
+            End = 0;
+            return false;
+        }
+
+        /// @brief 关闭文件, 回到文件开始
+        void Close()
+        {
+            m_file.Close();
+            Cursor = 0;
+            End = 0;
+            m_offset = 0;
+            m_fileSize = 0;
+            m_bFailed = false;
+        }
+
+        /// @brief 映射是否失败
+        bool Failed() const
+        {
+            return m_bFailed;
+        }
+
+    public:
+        const char* Cursor; ///< 当前窗口中下一个未解析的位置
+        const char* End; ///< 当前窗口的结束位置
+
+    private:
+        wstring m_fileName; ///< 文件名
+        size_t m_windowSize; ///< 窗口大小(字节)
+        LMappedFile m_file; ///< 当前窗口的映射
+        unsigned long long m_offset; ///< 当前窗口在文件中的位置
+        unsigned long long m_fileSize; ///< 文件大小
+        bool m_bFailed; ///< 映射是否失败
+    };
+
+    /// @brief 缓存文件的键值
+    /// 保存在缓存文件的附加数据中, 源文件或者解析选项改变后键值不同, 缓存失效
+    struct CSVCacheKey
+    {
+        char Magic[8];                  ///< 魔数"LCSVKEY"
+        unsigned int Version;           ///< 键值版本
+        unsigned int Delimiter;         ///< 分隔符
+        unsigned int SkipHeader;        ///< 是否跳过首行
+        unsigned int Reserved;          ///< 保留, 为0
+        unsigned long long SourceSize;  ///< 源文件大小
+        unsigned long long SourceTime;  ///< 源文件的最后修改时间
+    };
+
+    /// @brief 生成源文件的缓存键值
+    /// @return 源文件不存在返回false
+    bool CSVMakeCacheKey(IN const wchar_t* fileName, IN char delimiter, IN bool skipHeader, OUT CSVCacheKey& key)
+    {
+        memset(&key, 0, sizeof(key));
+        memcpy(key.Magic, "LCSVKEY", 8);
+        key.Version = 1;
+        key.Delimiter = (unsigned char)delimiter;
+        key.SkipHeader = skipHeader ? 1 : 0;
+
+        return LMappedFile::FileSize(fileName, key.SourceSize) && LMappedFile::FileTime(fileName, key.SourceTime);
+    }
+
+    /// @brief 把宽字符文件名转换为多字节文件名
+    bool CSVNarrowName(IN const wchar_t* fileName, OUT string& name)
+    {
+        size_t len = wcstombs(0, fileName, 0);
+        if (len == (size_t)-1)
+            return false;
+
+        vector<char> buffer(len + 1);
+        wcstombs(&buffer[0], fileName, len + 1);
+        name = &buffer[0];
+        return true;
+    }
+
+    /// @brief 打开文件
+    FILE* CSVOpenFile(IN const wchar_t* fileName, IN const wchar_t* mode)
+    {
+        if (fileName == 0)
+            return 0;
+
+#ifdef _WIN32
+        FILE* pFile = 0;
+        if (_wfopen_s(&pFile, fileName, mode) != 0)
+            return 0;
+        return pFile;
+#else
+        string name;
+        if (!CSVNarrowName(fileName, name))
+            return 0;
+
+        char modeName[4] = { (char)mode[0], (char)mode[1], 0, 0 };
+        return fopen(name.c_str(), modeName);
+#endif
+    }
+
+    /// @brief 删除文件
+    void CSVRemoveFile(IN const wchar_t* fileName)
+    {
+#ifdef _WIN32
+        _wremove(fileName);
+#else
+        string name;
+        if (CSVNarrowName(fileName, name))
+            remove(name.c_str());
+#endif
+    }
+
+    /// @brief 重命名文件, 目标文件存在时替换
+    /// POSIX系统上替换是原子的, 已经映射旧文件的矩阵不受影响
+    bool CSVRenameFile(IN const wchar_t* oldName, IN const wchar_t* newName)
+    {
+#ifdef _WIN32
+        // 目标文件正在被映射时无法删除, 此时放弃替换
+        _wremove(newName);
+        return _wrename(oldName, newName) == 0;
+#else
+        string oldNarrow;
+        string newNarrow;
+        if (!CSVNarrowName(oldName, oldNarrow) || !CSVNarrowName(newName, newNarrow))
+            return false;
+
+        return rename(oldNarrow.c_str(), newNarrow.c_str()) == 0;
+#endif
+    }
+
+    /// @brief 获取进程ID, 用于生成不冲突的临时文件名
+    unsigned long CSVProcessId()
+    {
+#ifdef _WIN32
+        return (unsigned long)_getpid();
+#else
+        return (unsigned long)getpid();
+#endif
+    }
+}
+
+/// @brief CSV文件解析器
+class CCSVParser
+{
+public:
+    /// @brief 构造函数
+    explicit CCSVParser(IN const wchar_t* fileName)
+    {
+        m_fileName = fileName;
+        m_bSkipHeader = false;
+        m_delimiter = L',';
+        m_bCache = false;
+    }
+
+    /// @brief 析构函数
+    ~CCSVParser()
+    {
+
+    }
+
+    /// @brief 设置是否跳过首行
+    void SetSkipHeader(IN bool skip)
+    {
+        m_bSkipHeader = skip;
+    }
+
+    /// @brief 设置分隔符
+    void SetDelimiter(IN wchar_t ch)
+    {
+        m_delimiter = ch;
+    }
+
+    /// @brief 设置是否使用缓存文件
+    void SetCache(IN bool cache)
+    {
+        m_bCache = cache;
+    }
+
+    /// @brief 加载所有数据
+    /// 使用缓存时先尝试映射缓存文件, 缓存无效时解析源文件, 然后重新生成缓存文件
+    bool LoadAllData(OUT LDataMatrix& dataMatrix)
+    {
+        if (!m_bCache)
+            return ParseData(dataMatrix);
+
+        char delimiter = ',';
+        if (!CSVDelimiter(m_delimiter, delimiter))
+            return false;
+
+        CSVCacheKey key;
+        if (!CSVMakeCacheKey(m_fileName.c_str(), delimiter, m_bSkipHeader, key))
+            return false;
+
+        const wstring cacheName = m_fileName + LCSV_CACHE_EXTENSION;
+        if (LoadCache(cacheName, key, dataMatrix))
+            return true;
+
+        if (!ParseData(dataMatrix))
+            return false;
+
+        // 解析期间源文件被修改时不生成缓存
+        CSVCacheKey parseKey;
+        if (CSVMakeCacheKey(m_fileName.c_str(), delimiter, m_bSkipHeader, parseKey) &&
+            memcmp(&key, &parseKey, sizeof(key)) == 0)
+            SaveCache(cacheName, key, dataMatrix);
+
+        return true;
+    }
+
+    /// @brief 按数据模式加载数据
+    /// 与ParseData相同, 分段并行解析, 每个字段直接转换为目标类型写入特征矩阵或者标签向量, 不使用的列不转换
+    template<typename FeatureType, typename LabelType>
+    bool LoadData(IN const LCSVSchema& schema, OUT LMatrix<FeatureType>& featureMatrix, OUT LMatrix<LabelType>& labelVector)
+    {
+        char delimiter = ',';
+        if (!CSVDelimiter(m_delimiter, delimiter))
+            return false;
+
+        LMappedFile file;
+        if (!file.Open(m_fileName.c_str(), LMAPPED_FILE_READ_ONLY))
+            return false;
+
+        const char* pEnd = static_cast<const char*>(file.Data()) + file.Size();
+        const char* pBegin = CSVDataBegin(static_cast<const char*>(file.Data()), pEnd, m_bSkipHeader);
+
+        const size_t colLength = CSVColumnLength(pBegin, pEnd, delimiter);
+        if (colLength < 1)
+            return false;
+
+        vector<int> columnTarget;
+        size_t featureNum = 0;
+        if (!CSVColumnTarget(schema, colLength, columnTarget, featureNum))
+            return false;
+
+        CSVChunkList chunkList;
+        const size_t rowMax = CSVSplitChunks(pBegin, pEnd, chunkList);
+
+        // 大小不变时重用矩阵的内存
+        LMatrix<FeatureType>& X = featureMatrix;
+        LMatrix<LabelType>& Y = labelVector;
+        X.Reset(rowMax, featureNum);
+        Y.Reset(schema.LabelColumn != LCSV_NO_COLUMN ? rowMax : 0, 1);
+
+        // 并行解析每一段, 直接写入特征矩阵和标签向量中该段的行
+        const size_t featureStride = X.RowStride();
+        const size_t labelStride = Y.RowStride();
+        FeatureType* pFeature = X[0];
+        LabelType* pLabel = Y.Empty() ? 0 : Y[0];
+        LThreadPool::Global().ParallelFor(chunkList.Size(), [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                const size_t rowStart = chunkList.RowStartList[i];
+                chunkList.SuccessList[i] = CSVParseTypedRows(
+                    chunkList.BeginList[i], chunkList.BeginList[i + 1], delimiter, &columnTarget[0], colLength,
+                    chunkList.RowMaxList[i], featureStride, pFeature + rowStart * featureStride,
+                    labelStride, pLabel != 0 ? pLabel + rowStart * labelStride : pLabel,
+                    chunkList.RowLengthList[i]) != 0;
+            }
+        });
+
+        size_t rowLength = 0;
+        if (!CSVChunkResult(chunkList, rowLength))
+        {
+            X.Reset(0, 0);
+            Y.Reset(0, 0);
+            return false;
+        }
+
+        CSVCompactRows(chunkList, rowLength, X);
+        if (!Y.Empty())
+            CSVCompactRows(chunkList, rowLength, Y);
+
+        return true;
+    }
+
+private:
+    /// @brief 从缓存文件加载数据
+    /// 缓存文件以写时复制方式映射, 修改矩阵不会修改缓存文件
+    /// @return 缓存文件不存在或者键值不匹配返回false, 矩阵不变
+    bool LoadCache(IN const wstring& cacheName, IN const CSVCacheKey& key, OUT LDataMatrix& dataMatrix)
+    {
+        vector<char> extra;
+        if (!LMatrixFile<double>::ReadExtra(cacheName.c_str(), extra))
+            return false;
+
+        if (extra.size() != sizeof(key) || memcmp(&extra[0], &key, sizeof(key)) != 0)
+            return false;
+
+        return LMatrixFile<double>::Map(cacheName.c_str(), LMAPPED_FILE_COPY_ON_WRITE, dataMatrix);
+    }
+
+    /// @brief 生成缓存文件
+    /// 先写入临时文件再替换缓存文件, 其他进程不会读到写了一半的缓存文件, 失败时忽略
+    void SaveCache(IN const wstring& cacheName, IN const CSVCacheKey& key, IN const LDataMatrix& dataMatrix)
+    {
+        const wstring tempName = cacheName + L"." + std::to_wstring(CSVProcessId()) + L".tmp";
+        if (!LMatrixFile<double>::Save(tempName.c_str(), dataMatrix, &key, sizeof(key)) ||
+            !CSVRenameFile(tempName.c_str(), cacheName.c_str()))
+            CSVRemoveFile(tempName.c_str());
+    }
+
+    /// @brief 解析源文件
+    /// 映射整个文件, 先统计行数和列数, 然后逐行解析直接写入矩阵, 不复制每个字段
+    /// 大文件按行边界分段, 使用全局线程池并行统计和解析, 每段写入矩阵中各自的行, 所以行的顺序不变
+    bool ParseData(OUT LDataMatrix& dataMatrix)
+    {
+        char delimiter = ',';
+        if (!CSVDelimiter(m_delimiter, delimiter))
+            return false;
+
+        // 文件不存在或者为空文件
+        LMappedFile file;
+        if (!file.Open(m_fileName.c_str(), LMAPPED_FILE_READ_ONLY))
+            return false;
+
+        const char* pEnd = static_cast<const char*>(file.Data()) + file.Size();
+        const char* pBegin = CSVDataBegin(static_cast<const char*>(file.Data()), pEnd, m_bSkipHeader);
+
+        // 列长度
+        const size_t colLength = CSVColumnLength(pBegin, pEnd, delimiter);
+        if (colLength < 1)
+            return false;
+
+        CSVChunkList chunkList;
+        const size_t rowMax = CSVSplitChunks(pBegin, pEnd, chunkList);
+
+        dataMatrix.Reset(rowMax, colLength);
+
+        // 并行解析每一段, 直接写入矩阵中该段的行
+        const size_t rowStride = dataMatrix.RowStride();
+        double* pData = dataMatrix[0];
+        LThreadPool::Global().ParallelFor(chunkList.Size(), [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                chunkList.SuccessList[i] = CSVParseRows(
+                    chunkList.BeginList[i], chunkList.BeginList[i + 1], delimiter, colLength, 
+                    chunkList.RowMaxList[i], rowStride, pData + chunkList.RowStartList[i] * rowStride, 
+                    chunkList.RowLengthList[i]) != 0;
+            }
+        });
+
+        size_t rowLength = 0;
+        if (!CSVChunkResult(chunkList, rowLength))
+        {
+            dataMatrix.Reset(0, 0);
+            return false;
+        }
+
+        CSVCompactRows(chunkList, rowLength, dataMatrix);
+        return true;
+    }
+
+private:
+    bool m_bSkipHeader; ///< 跳过首行
+    wchar_t m_delimiter; ///< 分隔符
+    bool m_bCache; ///< 使用缓存文件
+    wstring m_fileName; ///< 文件名
+
+};
+
+/// @brief CSV文件批量读取器
+class CCSVBatchReader
 {
-    strList.clear();
+public:
+    /// @brief 构造函数
+    explicit CCSVBatchReader(IN const wchar_t* fileName)
+    {
+        m_fileName = fileName;
+        m_bSkipHeader = false;
+        m_delimiter = L',';
+        m_batchSize = 256;
+        m_shuffleSize = 0;
+
+        this->Rewind();
+    }
+
+    /// @brief 析构函数
+    ~CCSVBatchReader()
+    {
+
+    }
+
+    /// @brief 设置是否跳过首行
+    void SetSkipHeader(IN bool skip)
+    {
+        m_bSkipHeader = skip;
+    }
 
-    size_t startPos = 0;
-    size_t length = 0;
+    /// @brief 设置分隔符
+    void SetDelimiter(IN wchar_t ch)
+    {
+        m_delimiter = ch;
+    }
+
+    /// @brief 设置批次的行数
+    void SetBatchSize(IN size_t rows)
+    {
+        if (rows > 0)
+            m_batchSize = rows;
+    }
 
-    size_t srcLen = srcStr.length();
-    for (size_t i = 0; i < srcLen; i++)
+    /// @brief 设置洗牌缓冲区
+    void SetShuffleBuffer(IN size_t rows, IN unsigned int seed)
     {
-        if (srcStr[i] == ch)
+        m_shuffleSize = rows;
+        m_random.seed(seed);
+    }
+
+    /// @brief 设置每次映射的文件区域大小
+    void SetWindowSize(IN size_t bytes)
+    {
+        m_window.SetWindowSize(bytes);
+    }
+
+    /// @brief 读取下一个批次
+    bool NextBatch(OUT LDataMatrix& batch)
+    {
+        if (m_bFailed || !this->Start())
+            return false;
+
+        size_t rowLength = 0;
+        if (m_shuffleSize == 0)
         {
-            strList.push_back(srcStr.substr(startPos, length));
-            startPos = i + 1;
-            length = 0;
+            batch.Reset(m_batchSize, m_colLength);
+            if (!this->ReadRows(m_batchSize, batch.RowStride(), batch[0], rowLength))
+                return false;
         }
         else
         {
-            length++;
+            // 补满缓冲区, 然后从缓冲区中随机取出行, 最后一行移到取出的位置
+            const size_t bufferSize = m_shuffleSize > m_batchSize ? m_shuffleSize : m_batchSize;
+            if (m_buffer.RowLen != bufferSize)
+                m_buffer.Reset(bufferSize, m_colLength);
+
+            size_t readLength = 0;
+            if (m_bufferLength < bufferSize && 
+                !this->ReadRows(bufferSize - m_bufferLength, m_buffer.RowStride(), m_buffer[m_bufferLength], readLength))
+                return false;
+            m_bufferLength += readLength;
+
+            rowLength = m_bufferLength < m_batchSize ? m_bufferLength : m_batchSize;
+            if (rowLength > 0)
+                batch.Reset(rowLength, m_colLength);
+            for (size_t i = 0; i < rowLength; i++)
+            {
+                std::uniform_int_distribution<size_t> distribution(0, m_bufferLength - 1);
+                const size_t row = distribution(m_random);
+                memcpy(batch[i], m_buffer[row], m_colLength * sizeof(double));
+                m_bufferLength--;
+                if (row != m_bufferLength)
+                    memcpy(m_buffer[row], m_buffer[m_bufferLength], m_colLength * sizeof(double));
+            }
         }
-    }
 
-    strList.push_back(srcStr.substr(startPos, length));
-}
+        if (rowLength == 0)
+        {
+            batch.Reset(0, 0);
+            return false;
+        }
 
-/// <SUMMARY>
-/// 字符串裁剪
-/// 去除字符串开始和结束的空白字符, 如: 空格, 换行, 回车, 制表符
-/// </SUMMARY>
-static void WStringTrimmed(INOUT wstring& str)
-{
-    if (str.empty())
-    {
-        return;
+        // 最后一个批次
+        if (rowLength < batch.RowLen)
+        {
+            LDataMatrix lastBatch;
+            batch.SubMatrix(0, rowLength, 0, m_colLength, lastBatch);
+            batch = lastBatch;
+        }
+
+        return true;
     }
 
-    size_t i = 0;
-    while (iswspace(str[i]) != 0)
+    /// @brief 回到文件开始
+    void Rewind()
     {
-        i++;
+        m_window.Close();
+        m_colLength = 0;
+        m_bufferLength = 0;
+        m_bStarted = false;
+        m_bFailed = false;
     }
-    str.erase(0, i);
 
-    if (str.empty())
+    /// @brief 是否出错
+    bool Failed() const
     {
-        return;
+        return m_bFailed;
     }
 
-    size_t j = str.length() - 1;
-    while (isspace(str[j]) != 0)
+private:
+    /// @brief 开始读取
+    /// 第一次调用时跳过首行, 并根据第一个非空行确定列数
+    /// @return 出错返回false
+    bool Start()
     {
-        if (j <= 0)
-            break;
+        if (m_bStarted)
+            return true;
+
+        m_bStarted = true;
+        m_bFailed = true;
+        if (!CSVDelimiter(m_delimiter, m_delimiterByte))
+            return false;
+
+        if (!m_window.Open(m_fileName))
+            return false;
+
+        m_window.Cursor = CSVDataBegin(m_window.Cursor, m_window.End, m_bSkipHeader);
+
+        // 列长度, 窗口中都是空行时查找下一个窗口
+        while (true)
+        {
+            m_colLength = CSVColumnLength(m_window.Cursor, m_window.End, m_delimiterByte);
+            if (m_colLength > 0)
+                break;
+
+            m_window.Cursor = m_window.End;
+            if (!m_window.MapNext())
+                return false;
+        }
 
-        j--;
+        m_bFailed = false;
+        return true;
     }
 
-    str.erase(j + 1);
+    /// @brief 读取最多rowMax行
+    /// @param[in] rowMax 最多读取的行数
+    /// @param[in] rowStride 行步长(元素个数)
+    /// @param[out] pData 矩阵数据
+    /// @param[out] rowLength 读取的行数, 到达文件末尾时小于rowMax
+    /// @return 出错返回false
+    bool ReadRows(IN size_t rowMax, IN size_t rowStride, OUT double* pData, OUT size_t& rowLength)
+    {
+        rowLength = 0;
+        while (rowLength < rowMax)
+        {
+            if (m_window.Cursor == m_window.End && !m_window.MapNext())
+            {
+                m_bFailed = m_window.Failed();
+                break;
+            }
 
-}
+            size_t length = 0;
+            const char* pNext = CSVParseRows(
+                m_window.Cursor, m_window.End, m_delimiterByte, m_colLength, 
+                rowMax - rowLength, rowStride, pData + rowLength * rowStride, length);
+            if (pNext == 0)
+            {
+                m_window.Close();
+                m_bFailed = true;
+                break;
+            }
+            m_window.Cursor = pNext;
+            rowLength += length;
+        }
 
-/// <SUMMARY>
-/// 字符串转换为浮点数
-/// </SUMMARY>
-static double StringToDouble(IN const wstring& str)
-{
-    double value;
-    wstringstream strStream(str);
-    strStream >> value;
-    return value;
-}
+        return !m_bFailed;
+    }
 
+private:
+    wstring m_fileName; ///< 文件名
+    bool m_bSkipHeader; ///< 跳过首行
+    wchar_t m_delimiter; ///< 分隔符
+    size_t m_batchSize; ///< 批次的行数
+    size_t m_shuffleSize; ///< 洗牌缓冲区的行数
+    std::mt19937 m_random; ///< 洗牌的随机数生成器
 
+    CSVFileWindow m_window; ///< 文件窗口
+    char m_delimiterByte; ///< 字节分隔符
+    size_t m_colLength; ///< 列数
+    LDataMatrix m_buffer; ///< 洗牌缓冲区
+    size_t m_bufferLength; ///< 洗牌缓冲区中的行数
+    bool m_bStarted; ///< 是否已经开始读取
+    bool m_bFailed; ///< 是否出错
+};
 
-/// @brief CSV文件解析器
-class CCSVParser
+/// @brief svmlight格式文件读取器
+class CSVMLightReader
 {
 public:
     /// @brief 构造函数
-    explicit CCSVParser(IN const wchar_t* fileName)
+    explicit CSVMLightReader(IN const wchar_t* fileName)
     {
         m_fileName = fileName;
-        m_bSkipHeader = false;
-        m_delimiter = L',';
+        m_indexBase = 1;
+        m_featureNum = 0;
+        m_batchSize = 256;
+
+        this->Rewind();
     }
 
     /// @brief 析构函数
-    ~CCSVParser()
+    ~CSVMLightReader()
     {
 
     }
 
-    /// @brief 设置是否跳过首行
-    void SetSkipHeader(IN bool skip)
+    /// @brief 设置索引是否从0开始
+    void SetZeroBased(IN bool zeroBased)
     {
-        m_bSkipHeader = skip;
+        m_indexBase = zeroBased ? 0 : 1;
     }
 
-    /// @brief 设置分隔符
-    void SetDelimiter(IN wchar_t ch)
+    /// @brief 设置特征数
+    void SetFeatureNum(IN size_t num)
     {
-        m_delimiter = ch;
+        m_featureNum = num;
+    }
+
+    /// @brief 设置批次的行数
+    void SetBatchSize(IN size_t rows)
+    {
+        if (rows > 0)
+            m_batchSize = rows;
+    }
+
+    /// @brief 设置每次映射的文件区域大小
+    void SetWindowSize(IN size_t bytes)
+    {
+        m_window.SetWindowSize(bytes);
     }
 
     /// @brief 加载所有数据
-    bool LoadAllData(OUT LDataMatrix& dataMatrix)
+    /// 与LCSVParser::LoadAllData相同, 大文件按行边界分段, 每段并行解析为各自的CSR数据, 最后按顺序合并
+    bool LoadAllData(OUT LSparseMatrix<double>& featureMatrix, OUT LDataMatrix& labelVector)
     {
-        wstring str;
-        wifstream fin(m_fileName, ios::in);
+        LMappedFile file;
+        if (!file.Open(m_fileName.c_str(), LMAPPED_FILE_READ_ONLY))
+            return false;
+
+        const char* pEnd = static_cast<const char*>(file.Data()) + file.Size();
+        const char* pBegin = CSVDataBegin(static_cast<const char*>(file.Data()), pEnd, false);
+
+        CSVChunkList chunkList;
+        CSVSplitChunks(pBegin, pEnd, chunkList);
 
-        // 文件不存在
-        if (!fin) 
+        const size_t chunkNum = chunkList.Size();
+        vector<SVMLightRows> rowsList(chunkNum);
+        LThreadPool::Global().ParallelFor(chunkNum, [&](size_t begin, size_t end)
         {
-            return false;
-        }
+            for (size_t i = begin; i < end; i++)
+            {
+                // 每个非零特征有一个冒号, 预先分配空间避免列表增长时的复制
+                SVMLightRows& rows = rowsList[i];
+                const size_t valueMax = CSVCountChar(chunkList.BeginList[i], chunkList.BeginList[i + 1], ':');
+                rows.RowOffsetList.reserve(chunkList.RowMaxList[i] + 1);
+                rows.LabelList.reserve(chunkList.RowMaxList[i]);
+                rows.ColumnIndexList.reserve(valueMax);
+                rows.ValueList.reserve(valueMax);
 
-        // 检查是否需要跳过首行
-        if (m_bSkipHeader)
-            getline(fin, str);
+                chunkList.SuccessList[i] = SVMLightParseRows(
+                    chunkList.BeginList[i], chunkList.BeginList[i + 1], m_indexBase, m_featureNum, 
+                    chunkList.RowMaxList[i], rows) != 0;
+            }
+        });
 
-        vector<vector<wstring>> strMatrix;
-        while (getline(fin, str))
+        for (size_t i = 0; i < chunkNum; i++)
         {
-            // 去除开头和结尾的空白字符
-            WStringTrimmed(str);
-            if (str.empty())
-                continue;
+            if (!chunkList.SuccessList[i])
+                return false;
+        }
+
+        if (chunkNum == 1)
+            return SVMLightMatrix(rowsList[0], m_featureNum, featureMatrix, labelVector);
 
-            // 分割字符串
-            vector<wstring> strList;
-            WStringSplit(m_delimiter, str, strList);
+        // 每段的行和非零元素在合并结果中的起始位置
+        vector<size_t> rowStartList(chunkNum);
+        vector<size_t> valueStartList(chunkNum);
+        SVMLightRows rows;
+        size_t rowLength = 0;
+        size_t valueLength = 0;
+        for (size_t i = 0; i < chunkNum; i++)
+        {
+            rowStartList[i] = rowLength;
+            valueStartList[i] = valueLength;
+            rowLength += rowsList[i].RowLen();
+            valueLength += rowsList[i].ValueList.size();
+            if (rowsList[i].ColumnLen > rows.ColumnLen)
+                rows.ColumnLen = rowsList[i].ColumnLen;
+        }
 
-            // 检查每个字符串是否为空
-            for (auto iter = strList.begin(); iter != strList.end(); iter++)
+        rows.RowOffsetList.resize(rowLength + 1);
+        rows.ColumnIndexList.resize(valueLength);
+        rows.ValueList.resize(valueLength);
+        rows.LabelList.resize(rowLength);
+        LThreadPool::Global().ParallelFor(chunkNum, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
             {
-                WStringTrimmed(*iter);
-                if (iter->empty())
-                    return false;
+                const SVMLightRows& chunk = rowsList[i];
+                for (size_t j = 0; j < chunk.RowLen(); j++)
+                {
+                    rows.RowOffsetList[rowStartList[i] + j + 1] = valueStartList[i] + chunk.RowOffsetList[j + 1];
+                    rows.LabelList[rowStartList[i] + j] = chunk.LabelList[j];
+                }
+                if (!chunk.ValueList.empty())
+                {
+                    memcpy(&rows.ColumnIndexList[valueStartList[i]], &chunk.ColumnIndexList[0], chunk.ColumnIndexList.size() * sizeof(size_t));
+                    memcpy(&rows.ValueList[valueStartList[i]], &chunk.ValueList[0], chunk.ValueList.size() * sizeof(double));
+                }
             }
+        });
+        rowsList.clear();
 
-            strMatrix.push_back(strList);
-        }
+        return SVMLightMatrix(rows, m_featureNum, featureMatrix, labelVector);
+    }
 
-        // 行长度
-        size_t rowLength = strMatrix.size();
-        if (rowLength < 1)
-            return false;
-        
-        // 列长度
-        size_t colLength = strMatrix[0].size();
-        if (colLength < 1)
+    /// @brief 读取下一个批次
+    bool NextBatch(OUT LSparseMatrix<double>& batch, OUT LDataMatrix& labelVector)
+    {
+        if (m_bFailed)
             return false;
 
-        dataMatrix.Reset((unsigned int)rowLength, (unsigned int)colLength, 0.0);
-
-        for (size_t row = 0; row < rowLength; row++)
+        if (!m_bStarted)
         {
-            // 检查每一行中的数据长度是否一致
-            if (strMatrix[row].size() != colLength)
+            m_bStarted = true;
+            if (!m_window.Open(m_fileName))
             {
-                dataMatrix.Reset(0, 0);
+                m_bFailed = true;
                 return false;
             }
+            m_window.Cursor = CSVDataBegin(m_window.Cursor, m_window.End, false);
+        }
+
+        m_rows.Clear();
+        while (m_rows.RowLen() < m_batchSize)
+        {
+            if (m_window.Cursor == m_window.End && !m_window.MapNext())
+            {
+                m_bFailed = m_window.Failed();
+                break;
+            }
 
-            for (size_t col = 0; col < colLength; col++)
+            const char* pNext = SVMLightParseRows(
+                m_window.Cursor, m_window.End, m_indexBase, m_featureNum, m_batchSize - m_rows.RowLen(), m_rows);
+            if (pNext == 0)
             {
-                dataMatrix[(unsigned int)row][(unsigned int)col] = StringToDouble(strMatrix[row][col]);
+                m_window.Close();
+                m_bFailed = true;
+                break;
             }
+            m_window.Cursor = pNext;
+        }
+
+        // 文件中没有数据时出错
+        m_rowTotal += m_rows.RowLen();
+        if (m_rowTotal == 0)
+            m_bFailed = true;
+
+        if (m_bFailed || !SVMLightMatrix(m_rows, m_featureNum, batch, labelVector))
+        {
+            batch.Reset(0, 0);
+            labelVector.Reset(0, 0);
+            return false;
         }
 
         return true;
     }
 
+    /// @brief 回到文件开始
+    void Rewind()
+    {
+        m_window.Close();
+        m_rowTotal = 0;
+        m_bStarted = false;
+        m_bFailed = false;
+    }
+
+    /// @brief 是否出错
+    bool Failed() const
+    {
+        return m_bFailed;
+    }
+
 private:
-    bool m_bSkipHeader; ///< 跳过首行
-    wchar_t m_delimiter; ///< 分隔符
     wstring m_fileName; ///< 文件名
+    size_t m_indexBase; ///< 最小的索引
+    size_t m_featureNum; ///< 特征数, 0表示使用最大的索引
+    size_t m_batchSize; ///< 批次的行数
 
+    CSVFileWindow m_window; ///< 文件窗口
+    SVMLightRows m_rows; ///< 当前批次解析得到的行
+    size_t m_rowTotal; ///< 已经读取的行数
+    bool m_bStarted; ///< 是否已经开始读取
+    bool m_bFailed; ///< 是否出错
 };
 
 LCSVParser::LCSVParser(IN const wchar_t* fileName)
@@ -221,7 +1744,180 @@ void LCSVParser::SetDelimiter(IN wchar_t ch)
     m_pParser->SetDelimiter(ch);
 }
 
+void LCSVParser::SetCache(IN bool cache)
+{
+    m_pParser->SetCache(cache);
+}
+
 bool LCSVParser::LoadAllData(OUT LDataMatrix& dataMatrix)
 {
     return m_pParser->LoadAllData(dataMatrix);
 }
+
+template<typename FeatureType, typename LabelType>
+bool LCSVParser::LoadData(IN const LCSVSchema& schema, OUT LMatrix<FeatureType>& featureMatrix, OUT LMatrix<LabelType>& labelVector)
+{
+    return m_pParser->LoadData(schema, featureMatrix, labelVector);
+}
+
+// 支持的元素类型组合
+template bool LCSVParser::LoadData(IN const LCSVSchema&, OUT LMatrix<double>&, OUT LMatrix<double>&);
+template bool LCSVParser::LoadData(IN const LCSVSchema&, OUT LMatrix<float>&, OUT LMatrix<float>&);
+template bool LCSVParser::LoadData(IN const LCSVSchema&, OUT LMatrix<int>&, OUT LMatrix<int>&);
+template bool LCSVParser::LoadData(IN const LCSVSchema&, OUT LMatrix<double>&, OUT LMatrix<int>&);
+template bool LCSVParser::LoadData(IN const LCSVSchema&, OUT LMatrix<float>&, OUT LMatrix<int>&);
+
+LCSVBatchReader::LCSVBatchReader(IN const wchar_t* fileName)
+{
+    m_pReader = nullptr;
+    m_pReader = new CCSVBatchReader(fileName);
+}
+
+LCSVBatchReader::~LCSVBatchReader()
+{
+    if (nullptr != m_pReader)
+    {
+        delete m_pReader;
+        m_pReader = nullptr;
+    }
+}
+
+void LCSVBatchReader::SetSkipHeader(IN bool skip)
+{
+    m_pReader->SetSkipHeader(skip);
+}
+
+void LCSVBatchReader::SetDelimiter(IN wchar_t ch)
+{
+    m_pReader->SetDelimiter(ch);
+}
+
+void LCSVBatchReader::SetBatchSize(IN size_t rows)
+{
+    m_pReader->SetBatchSize(rows);
+}
+
+void LCSVBatchReader::SetShuffleBuffer(IN size_t rows, IN unsigned int seed)
+{
+    m_pReader->SetShuffleBuffer(rows, seed);
+}
+
+void LCSVBatchReader::SetWindowSize(IN size_t bytes)
+{
+    m_pReader->SetWindowSize(bytes);
+}
+
+bool LCSVBatchReader::NextBatch(OUT LDataMatrix& batch)
+{
+    return m_pReader->NextBatch(batch);
+}
+
+void LCSVBatchReader::Rewind()
+{
+    m_pReader->Rewind();
+}
+
+bool LCSVBatchReader::Failed() const
+{
+    return m_pReader->Failed();
+}
+
+LSVMLightReader::LSVMLightReader(IN const wchar_t* fileName)
+{
+    m_pReader = nullptr;
+    m_pReader = new CSVMLightReader(fileName);
+}
+
+LSVMLightReader::~LSVMLightReader()
+{
+    if (nullptr != m_pReader)
+    {
+        delete m_pReader;
+        m_pReader = nullptr;
+    }
+}
+
+void LSVMLightReader::SetZeroBased(IN bool zeroBased)
+{
+    m_pReader->SetZeroBased(zeroBased);
+}
+
+void LSVMLightReader::SetFeatureNum(IN size_t num)
+{
+    m_pReader->SetFeatureNum(num);
+}
+
+void LSVMLightReader::SetBatchSize(IN size_t rows)
+{
+    m_pReader->SetBatchSize(rows);
+}
+
+void LSVMLightReader::SetWindowSize(IN size_t bytes)
+{
+    m_pReader->SetWindowSize(bytes);
+}
+
+bool LSVMLightReader::LoadAllData(OUT LDataSparseMatrix& featureMatrix, OUT LDataMatrix& labelVector)
+{
+    return m_pReader->LoadAllData(featureMatrix, labelVector);
+}
+
+bool LSVMLightReader::NextBatch(OUT LDataSparseMatrix& batch, OUT LDataMatrix& labelVector)
+{
+    return m_pReader->NextBatch(batch, labelVector);
+}
+
+void LSVMLightReader::Rewind()
+{
+    m_pReader->Rewind();
+}
+
+bool LSVMLightReader::Failed() const
+{
+    return m_pReader->Failed();
+}
+
+bool LSVMLightWriter::Save(
+    IN const wchar_t* fileName, 
+    IN const LDataSparseMatrix& featureMatrix, 
+    IN const LMatrixView<double>& labelVector, 
+    IN bool zeroBased)
+{
+    if (featureMatrix.Empty() || labelVector.RowLen != featureMatrix.RowLen || labelVector.ColumnLen != 1)
+        return false;
+
+    FILE* pFile = CSVOpenFile(fileName, L"wb");
+    if (pFile == 0)
+        return false;
+
+    // 逐行格式化到缓冲区, 缓冲区较大时写入文件
+    const size_t indexBase = zeroBased ? 0 : 1;
+    string text;
+    char buffer[64];
+    bool ok = true;
+    for (size_t i = 0; ok && i < featureMatrix.RowLen; i++)
+    {
+        text.append(buffer, (size_t)CSVFormatDouble(labelVector[i][0], buffer));
+
+        const size_t nonZeroNum = featureMatrix.RowNonZeroNum(i);
+        const size_t* pColumn = featureMatrix.RowColumnIndex(i);
+        const double* pValue = featureMatrix.RowValue(i);
+        for (size_t j = 0; j < nonZeroNum; j++)
+        {
+            text.append(buffer, (size_t)sprintf(buffer, " %llu:", (unsigned long long)(pColumn[j] + indexBase)));
+            text.append(buffer, (size_t)CSVFormatDouble(pValue[j], buffer));
+        }
+        text.push_back('\n');
+
+        if (text.size() >= 1024 * 1024 || i + 1 == featureMatrix.RowLen)
+        {
+            ok = fwrite(text.data(), 1, text.size(), pFile) == text.size();
+            text.clear();
+        }
+    }
+
+    if (fclose(pFile) != 0)
+        ok = false;
+
+    return ok;
+}
@@ -1,6 +1,9 @@
 ﻿/// @file LCSVIo.h
 /// @brief 本文声明了CSV文件操作类
 /// LCSVParser(CSV文件解析器)
+/// LCSVBatchReader(CSV文件批量读取器)
+/// LSVMLightReader(svmlight格式文件读取器)
+/// LSVMLightWriter(svmlight格式文件写入器)
 /// Detail:
 /// @author Jie Liu Email:coderjie@outlook.com
 /// @version   
@@ -9,15 +12,40 @@
 #ifndef _LCSVIO_H_
 #define _LCSVIO_H_
 
+#include <vector>
+
 #include "LMatrix.h"
+#include "LSparseMatrix.h"
 
 
 typedef LMatrix<double> LDataMatrix;     ///< 数据矩阵
+typedef LSparseMatrix<double> LDataSparseMatrix; ///< 稀疏数据矩阵
+
+/// @brief 表示没有该列
+#define LCSV_NO_COLUMN ((size_t)-1)
+
+/// @brief CSV数据模式
+/// 描述从CSV文件的哪些列取出特征和标签, 元素类型由加载的目标矩阵决定(见LCSVParser::LoadData)
+struct LCSVSchema
+{
+    std::vector<size_t> FeatureColumns; ///< 特征列在文件中的索引(从0开始), 按此顺序存入特征矩阵, 为空表示除标签列外的所有列
+    size_t LabelColumn;                 ///< 标签列在文件中的索引, LCSV_NO_COLUMN表示没有标签列
+
+    /// @brief 构造函数
+    /// 默认所有列都是特征列, 没有标签列
+    LCSVSchema()
+        : LabelColumn(LCSV_NO_COLUMN)
+    {
+    }
+};
 
 class CCSVParser;
+class CCSVBatchReader;
+class CSVMLightReader;
 
 /// @brief CSV文件解析器
 /// 本解析器只支持解析数值数据, 并且不能有缺失数据
+/// 文件按UTF-8(或ASCII)字节解析, 通过内存映射读取, 字段在映射的数据中直接转换, 不复制字符串
 class LCSVParser
 {
 public:
@@ -34,15 +62,191 @@ public:
 
     /// @brief 设置分隔符
     /// 默认分隔符为 ','
+    /// 分隔符必须为ASCII字符, 否则LoadAllData返回false
     /// @param[in] ch 设置的分隔符
     void SetDelimiter(IN wchar_t ch);
 
+    /// @brief 设置是否使用缓存文件
+    /// 默认不使用, 使用时第一次加载后在源文件旁生成二进制缓存文件(文件名加".lmx", 格式见LMatrixFile),
+    /// 以后加载时直接映射缓存文件, 不再解析源文件
+    /// 缓存记录了源文件的大小, 最后修改时间, 分隔符和是否跳过首行, 任意一项改变后缓存失效, 重新解析并生成缓存
+    /// 从缓存加载的矩阵以写时复制方式映射缓存文件(见LMatrix::Mapped), 修改矩阵不会修改缓存文件
+    /// 缓存文件写入失败时不影响加载结果
+    /// @param[in] cache true(使用), false(不使用)
+    void SetCache(IN bool cache);
+
     /// @brief 加载所有数据
-    /// @param[in] dataMatrix 存储数据
+    /// 空行被忽略, 每个字段去除首尾的空白字符, 非法的数值只转换合法的前缀(没有时为0)
+    /// @param[out] dataMatrix 存储数据
+    /// @return 文件不存在, 没有数据, 存在空字段或者每行的字段数不一致时返回false
     bool LoadAllData(OUT LDataMatrix& dataMatrix);
 
+    /// @brief 按数据模式加载特征矩阵和标签向量
+    /// 一次解析, 每个字段直接转换为目标矩阵的元素类型写入, 不需要先加载为LDataMatrix再转换和拆分,
+    /// 不使用的列只查找分隔符, 不转换也不检查是否为空, 其他规则与LoadAllData相同, 不使用缓存文件
+    /// 转换为int时截断小数部分, 超出范围时取最近的边界
+    /// 支持的元素类型组合(特征, 标签): (double, double), (float, float), (int, int), (double, int), (float, int)
+    /// 示例: breast_cancer.csv的前30列为特征, 第31列为标签, 直接加载为SVM使用的float矩阵
+    ///     LCSVSchema schema;
+    ///     schema.LabelColumn = 30;
+    ///     LSVMMatrix X, Y;
+    ///     parser.LoadData(schema, X, Y);
+    /// @param[in] schema 数据模式
+    /// @param[out] featureMatrix 特征矩阵, 每一行为文件中的一行
+    /// @param[out] labelVector 标签向量(列向量), 没有标签列时为空矩阵
+    /// @return 文件不存在, 没有数据, 列索引超出范围或者重复, 没有特征列, 
+    /// 使用的列存在空字段或者每行的字段数不一致时返回false
+    template<typename FeatureType, typename LabelType>
+    bool LoadData(IN const LCSVSchema& schema, OUT LMatrix<FeatureType>& featureMatrix, OUT LMatrix<LabelType>& labelVector);
+
 private:
     CCSVParser* m_pParser; ///< CSV文件解析器实现对象
 };
 
+/// @brief CSV文件批量读取器
+/// 按固定行数的批次流式读取CSV文件, 不需要预先知道行数, 也不需要把整个文件读入内存,
+/// 每次只映射文件的一段区域(窗口), 文件格式和解析规则与LCSVParser相同
+/// 批次的子矩阵视图可以直接用于训练, 如每个批次的前n列为特征, 最后一列为标签:
+///     while (reader.NextBatch(batch))
+///         model.TrainModel(batch.SubMatrix(0, batch.RowLen, 0, n), batch.SubMatrix(0, batch.RowLen, n, 1), alpha);
+/// LBPNetwork::Train等接受矩阵视图的训练接口同样可以使用
+class LCSVBatchReader
+{
+public:
+    /// @brief 构造函数
+    explicit LCSVBatchReader(IN const wchar_t* fileName);
+
+    /// @brief 析构函数
+    ~LCSVBatchReader();
+
+    /// @brief 设置是否跳过首行
+    /// 默认不跳过首行, 请在读取前设置
+    /// @param[in] skip true(跳过), false(不跳过)
+    void SetSkipHeader(IN bool skip);
+
+    /// @brief 设置分隔符
+    /// 默认分隔符为 ',', 分隔符必须为ASCII字符, 请在读取前设置
+    /// @param[in] ch 设置的分隔符
+    void SetDelimiter(IN wchar_t ch);
+
+    /// @brief 设置批次的行数
+    /// 默认为256行, 最后一个批次可能少于该行数
+    /// @param[in] rows 批次的行数, 不能为0
+    void SetBatchSize(IN size_t rows);
+
+    /// @brief 设置洗牌缓冲区
+    /// 读取的行先放入缓冲区, 每个批次从缓冲区中随机取出行, 缓冲区越大越接近整体随机
+    /// 默认不洗牌, 按文件中的顺序输出
+    /// @param[in] rows 缓冲区的行数, 为0表示不洗牌, 小于批次行数时使用批次行数
+    /// @param[in] seed 随机种子
+    void SetShuffleBuffer(IN size_t rows, IN unsigned int seed);
+
+    /// @brief 设置每次映射的文件区域大小
+    /// 默认为16MB, 一行数据大于该大小时自动扩大
+    /// @param[in] bytes 区域大小(字节), 不能为0
+    void SetWindowSize(IN size_t bytes);
+
+    /// @brief 读取下一个批次
+    /// @param[out] batch 存储数据, 每一行为文件中的一行
+    /// @return 没有更多数据或者出错时返回false, 使用Failed()区分
+    bool NextBatch(OUT LDataMatrix& batch);
+
+    /// @brief 回到文件开始, 用于下一轮训练
+    /// 洗牌的随机状态不会重置, 所以每一轮的顺序不同
+    void Rewind();
+
+    /// @brief 是否出错
+    /// 文件不存在, 没有数据, 存在空字段或者每行的字段数不一致时出错
+    /// @return 出错返回true
+    bool Failed() const;
+
+private:
+    LCSVBatchReader(const LCSVBatchReader&);
+    LCSVBatchReader& operator = (const LCSVBatchReader&);
+
+private:
+    CCSVBatchReader* m_pReader; ///< CSV文件批量读取器实现对象
+};
+
+/// @brief svmlight(LIBSVM)格式文件读取器
+/// 每行为一个样本: "<标签> <索引>:<值> <索引>:<值> ...", 索引默认从1开始, 在行内严格递增, 
+/// 空格或者制表符分隔, "#"之后为注释, 空行被忽略, "qid:<n>"被忽略
+/// 特征存储为稀疏矩阵(CSR格式), 不存储未出现的特征, 标签存储为列向量
+/// 可以一次加载整个文件(大文件按行分段并行解析), 也可以按批次流式读取
+class LSVMLightReader
+{
+public:
+    /// @brief 构造函数
+    explicit LSVMLightReader(IN const wchar_t* fileName);
+
+    /// @brief 析构函数
+    ~LSVMLightReader();
+
+    /// @brief 设置索引是否从0开始
+    /// 默认为false, 索引从1开始(svmlight和LIBSVM的格式), 特征索引i对应矩阵的第i - 1列
+    /// @param[in] zeroBased true(从0开始), false(从1开始)
+    void SetZeroBased(IN bool zeroBased);
+
+    /// @brief 设置特征数(稀疏矩阵的列数)
+    /// 默认为0, 使用读取到的最大特征索引确定列数(至少为1), 此时不同批次的列数可能不同, 
+    /// 按批次训练时请设置特征数, 索引超出特征数时出错
+    /// @param[in] num 特征数
+    void SetFeatureNum(IN size_t num);
+
+    /// @brief 设置批次的行数
+    /// 默认为256行, 最后一个批次可能少于该行数
+    /// @param[in] rows 批次的行数, 不能为0
+    void SetBatchSize(IN size_t rows);
+
+    /// @brief 设置流式读取时每次映射的文件区域大小
+    /// 默认为16MB, 一行数据大于该大小时自动扩大
+    /// @param[in] bytes 区域大小(字节), 不能为0
+    void SetWindowSize(IN size_t bytes);
+
+    /// @brief 加载所有数据
+    /// @param[out] featureMatrix 特征矩阵, 每一行为文件中的一行
+    /// @param[out] labelVector 标签向量(列向量)
+    /// @return 文件不存在, 没有数据或者数据格式错误时返回false
+    bool LoadAllData(OUT LDataSparseMatrix& featureMatrix, OUT LDataMatrix& labelVector);
+
+    /// @brief 读取下一个批次
+    /// @param[out] batch 特征矩阵, 每一行为文件中的一行
+    /// @param[out] labelVector 标签向量(列向量)
+    /// @return 没有更多数据或者出错时返回false, 使用Failed()区分
+    bool NextBatch(OUT LDataSparseMatrix& batch, OUT LDataMatrix& labelVector);
+
+    /// @brief 回到文件开始, 用于下一轮训练
+    void Rewind();
+
+    /// @brief 是否出错
+    /// 文件不存在, 没有数据或者数据格式错误时出错
+    /// @return 出错返回true
+    bool Failed() const;
+
+private:
+    LSVMLightReader(const LSVMLightReader&);
+    LSVMLightReader& operator = (const LSVMLightReader&);
+
+private:
+    CSVMLightReader* m_pReader; ///< svmlight格式文件读取器实现对象
+};
+
+/// @brief svmlight(LIBSVM)格式文件写入器
+/// 只写入稀疏矩阵中存储的元素, 数值使用能够准确读回的最短文本
+class LSVMLightWriter
+{
+public:
+    /// @brief 保存数据
+    /// @param[in] fileName 文件名
+    /// @param[in] featureMatrix 特征矩阵
+    /// @param[in] labelVector 标签向量(列向量), 行数与特征矩阵相同
+    /// @param[in] zeroBased 索引是否从0开始, 默认从1开始
+    /// @return 矩阵为空, 大小不匹配或者写入失败返回false
+    static bool Save(
+        IN const wchar_t* fileName, 
+        IN const LDataSparseMatrix& featureMatrix, 
+        IN const LMatrixView<double>& labelVector, 
+        IN bool zeroBased = false);
+};
+
 #endif
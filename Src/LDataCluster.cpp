@@ -6,6 +6,8 @@
 
 #include <list>
 using std::list;
+#include <vector>
+using std::vector;
 
 #ifndef SAFE_DELETE
 #define SAFE_DELETE(p) \
@@ -50,10 +52,10 @@ void LBiClusterTree::Init()
         m_pDataSimilar = new LEuclideanDistance();
         break;
     case PEARSON_CORRETATIO:
-        m_pDataSimilar = new LPearsonCorretation();
+        m_pDataSimilar = new LPearsonCorrelation();
         break;
     default:
-        m_pDataSimilar = new LPearsonCorretation();
+        m_pDataSimilar = new LPearsonCorrelation();
     }
 }
 
@@ -62,30 +64,23 @@ void LBiClusterTree::Cluster(IN const LDCDataMatrix& dataMatrix)
 {
     Clear(m_pRootNode);
    
-    if (dataMatrix.Length <= 0)
+    if (dataMatrix.RowLen <= 0)
         return;
 
-    LDCDataMatrix disMatrix; // 记录数据之间的距离值
-    disMatrix.Reset(dataMatrix.Length * 2);
-    for (int i = 0; i < disMatrix.Length; i++)
-    {
-        disMatrix.Data[i].Reset(dataMatrix.Length * 2);
-        for (int j = 0; j < disMatrix.Data[i].Length; j++)
-            disMatrix.Data[i].Data[j] = 100.0f;
-    }
+    LDCDataMatrix disMatrix(dataMatrix.RowLen * 2, dataMatrix.RowLen * 2, 100.0f); // 记录数据之间的距离值
 
     list<LBiClusterTNode*> nodeList; // 结点指针列表
 
     // 生成所有的叶子聚类结点
-    for (int i = 0; i < dataMatrix.Length; i++)
+    for (size_t i = 0; i < dataMatrix.RowLen; i++)
     {
         LBiClusterTNode* pNode = new LBiClusterTNode();
-        pNode->DataList = dataMatrix.Data[i];
-        pNode->Id = i;
+        dataMatrix.GetRow(i, pNode->DataList);
+        pNode->Id = (int)i;
         nodeList.push_back(pNode);
     }
 
-    int currentId = dataMatrix.Length;
+    int currentId = (int)dataMatrix.RowLen;
     while (nodeList.size() > 1)
     {
         auto iterA = nodeList.begin();
@@ -102,13 +97,13 @@ void LBiClusterTree::Cluster(IN const LDCDataMatrix& dataMatrix)
             {
                 int oneId = (*iterOne)->Id;
                 int twoId = (*iterTwo)->Id;
-                if (disMatrix.Data[oneId].Data[twoId] == 100.0f)
+                if (disMatrix[oneId][twoId] == 100.0f)
                 {
                     float similar = m_pDataSimilar->Calculate((*iterOne)->DataList, (*iterTwo)->DataList);
-                    disMatrix.Data[oneId].Data[twoId] = 1.0f - similar;
+                    disMatrix[oneId][twoId] = 1.0f - similar;
                 }
 
-                float dis = disMatrix.Data[oneId].Data[twoId];
+                float dis = disMatrix[oneId][twoId];
 
                 if (dis < minDis)
                 {
@@ -126,10 +121,10 @@ void LBiClusterTree::Cluster(IN const LDCDataMatrix& dataMatrix)
         pNewNode->Distance =minDis;
         pNewNode->PLChild = *iterA;
         pNewNode->PRChild = *iterB;
-        pNewNode->DataList.Reset((*iterA)->DataList.Length);
-        for (int i = 0; i < (*iterA)->DataList.Length; i++)
+        pNewNode->DataList.Reset(1, (*iterA)->DataList.ColumnLen);
+        for (size_t i = 0; i < (*iterA)->DataList.ColumnLen; i++)
         {
-            pNewNode->DataList.Data[i] = (pNewNode->PLChild->DataList.Data[i] + pNewNode->PRChild->DataList.Data[i])/2.0f;
+            pNewNode->DataList[0][i] = (pNewNode->PLChild->DataList[0][i] + pNewNode->PRChild->DataList[0][i])/2.0f;
         }
 
         currentId += 1;
@@ -194,85 +189,87 @@ void LKMeansCluster::Init()
         m_pDataSimilar = new LEuclideanDistance();
         break;
     case PEARSON_CORRETATIO:
-        m_pDataSimilar = new LPearsonCorretation();
+        m_pDataSimilar = new LPearsonCorrelation();
         break;
     default:
-        m_pDataSimilar = new LPearsonCorretation();
+        m_pDataSimilar = new LPearsonCorrelation();
     }
 
-    m_resultMatrix.Reset(m_k);
+    m_resultMatrix.resize(m_k);
 }
 
 void LKMeansCluster::Cluster(IN const LDCDataMatrix& dataMatrix, OUT LDCResultMatrix& resultMatrix)
 {
-    if (dataMatrix.Length <= 0)
+    if (dataMatrix.RowLen <= 0)
         return;
 
-    LDCDataMatrix rangeList; ///< 范围列表
-    rangeList.Reset(dataMatrix.Data[0].Length);
+    const size_t dataLen = dataMatrix.ColumnLen;
+
+    // 相似度接口以行向量为参数, 预先取出每行数据
+    vector<LDCDataList> dataList(dataMatrix.RowLen);
+    for (size_t row = 0; row < dataMatrix.RowLen; row++)
+        dataMatrix.GetRow(row, dataList[row]);
+
+    LDCDataMatrix rangeList(dataLen, 2); ///< 范围列表
     // 确定每个点的最大值和最小值
-    for (int col = 0; col < dataMatrix.Data[0].Length; col++)
+    for (size_t col = 0; col < dataLen; col++)
     {
-        float min = dataMatrix.Data[0].Data[col];
-        float max = dataMatrix.Data[0].Data[col];
+        float min = dataMatrix[0][col];
+        float max = dataMatrix[0][col];
 
-        for (int row = 0; row < dataMatrix.Length; row++)
+        for (size_t row = 0; row < dataMatrix.RowLen; row++)
         {
-            float value = dataMatrix.Data[row].Data[col];
+            float value = dataMatrix[row][col];
             if (value < min)
                 min = value;
             if (value > max)
                 max = value;
         }
 
-        rangeList.Data[col].Reset(2);
-        rangeList.Data[col].Data[0] = min;
-        rangeList.Data[col].Data[1] = max;
+        rangeList[col][0] = min;
+        rangeList[col][1] = max;
     }
 
     // 随机创造K个中心点
-    LDCDataMatrix centerPointList;
-    centerPointList.Reset(m_k);
-    for (int i = 0; i < centerPointList.Length; i++)
+    vector<LDCDataList> centerPointList(m_k);
+    for (size_t i = 0; i < centerPointList.size(); i++)
     {
-        centerPointList.Data[i].Reset(dataMatrix.Data[0].Length);
-        for (int j = 0; j < dataMatrix.Data[0].Length; j++)
+        centerPointList[i].Reset(1, dataLen);
+        for (size_t j = 0; j < dataLen; j++)
         {
-            centerPointList.Data[i].Data[j] = RandFloat() * (rangeList.Data[j].Data[1] - rangeList.Data[j].Data[0]) 
-                + rangeList.Data[j].Data[0];
+            centerPointList[i][0][j] = RandFloat() * (rangeList[j][1] - rangeList[j][0]) + rangeList[j][0];
         }
     }
 
     
-    LArray<list<int>> clusterList; // 分类列表
-    clusterList.Reset(m_k);
-    float bestTotalDis = dataMatrix.Length * 2.0f;// 2为最远距离值即1 - similar, similar的范围为-1~1
+    vector<list<int>> clusterList(m_k); // 分类列表
+    float bestTotalDis = dataMatrix.RowLen * 2.0f;// 2为最远距离值即1 - similar, similar的范围为-1~1
     while (true)
     {
-        for (int i = 0; i < clusterList.Length; i++)
+        for (size_t i = 0; i < clusterList.size(); i++)
         {
-            clusterList.Data[i].clear();
+            clusterList[i].clear();
         }
 
         float totalDis = 0.0f;
-        for (int row = 0; row < dataMatrix.Length; row++)
+        for (size_t row = 0; row < dataList.size(); row++)
         {
-            LDCDataList& dataRow = dataMatrix.Data[row];
+            const LDCDataList& dataRow = dataList[row];
 
-            float minDis = 1.0f - m_pDataSimilar->Calculate(dataRow, centerPointList.Data[0]);
+            float minDis = 1.0f - m_pDataSimilar->Calculate(dataRow, centerPointList[0]);
             int bestMatchIndex = 0;
-            for (int i = 1; i< centerPointList.Length; i++)
+            for (size_t i = 1; i< centerPointList.size(); i++)
             {
-                float dis = 1.0f - m_pDataSimilar->Calculate(dataRow, centerPointList.Data[i]);
+                float dis = 1.0f - m_pDataSimilar->Calculate(dataRow, centerPointList[i]);
                 if (dis < minDis)
                 {
                     minDis = dis;
-                    bestMatchIndex = i;
+                    bestMatchIndex = (int)i;
                 }
             }
 
             totalDis += minDis;
-            clusterList.Data[bestMatchIndex].push_back(row);
+            clusterList[bestMatchIndex].push_back((int)row);
         }
 
         if (totalDis >= bestTotalDis)
@@ -280,41 +277,37 @@ void LKMeansCluster::Cluster(IN const LDCDataMatrix& dataMatrix, OUT LDCResultMa
 
         bestTotalDis = totalDis;
 
-        LDCDataList centerPointTotal;
-        centerPointTotal.Reset(dataMatrix.Data[0].Length);
+        LDCDataList centerPointTotal(1, dataLen);
         //移动中心点
-        for (int i = 0; i < clusterList.Length; i++)
+        for (size_t i = 0; i < clusterList.size(); i++)
         {
-            for (int j = 0; j < centerPointTotal.Length; j++)
-                centerPointTotal.Data[j] = 0.0f;
+            // 没有数据的中心点保持不动
+            if (clusterList[i].empty())
+                continue;
 
-            for (auto iter = clusterList.Data[i].begin(); iter != clusterList.Data[i].end(); iter++)
+            for (size_t j = 0; j < dataLen; j++)
+                centerPointTotal[0][j] = 0.0f;
+
+            for (auto iter = clusterList[i].begin(); iter != clusterList[i].end(); iter++)
             {
-                LDCDataList& dataList = dataMatrix.Data[*iter];
-                for (int j = 0; j < dataList.Length; j++)
-                    centerPointTotal.Data[j] += dataList.Data[j];
+                for (size_t j = 0; j < dataLen; j++)
+                    centerPointTotal[0][j] += dataMatrix[*iter][j];
             }
 
-            for (int j = 0; j < centerPointTotal.Length; j++)
+            for (size_t j = 0; j < dataLen; j++)
             {
-                centerPointList.Data[i].Data[j] = centerPointTotal.Data[j]/(float)clusterList.Data[i].size();
+                centerPointList[i][0][j] = centerPointTotal[0][j]/(float)clusterList[i].size();
             }
 
         }
         
     }
 
-    resultMatrix.Reset(m_k);
+    resultMatrix.resize(m_k);
     for (int i = 0; i < m_k; i++)
     {
-        list<int>& resultList = clusterList.Data[i];
-        resultMatrix.Data[i].Reset(resultList.size());
-
-        int k = 0;
-        for (auto iter = resultList.begin(); iter != resultList.end(); iter++)
-        {
-            resultMatrix.Data[i].Data[k++] = *iter;
-        }
+        list<int>& resultList = clusterList[i];
+        resultMatrix[i].assign(resultList.begin(), resultList.end());
     }
 
 }
@@ -14,9 +14,9 @@
 #ifndef _LDATACLUSTER_H_
 #define _LDATACLUSTER_H_
 
-#include "LDataStruct/include/LArray.h"
+#include <vector>
 
-#include "LMachineLearning/LDataCorretation.h"
+#include "LDataCorrelation.h"
 
 #ifndef IN
 #define IN
@@ -30,8 +30,8 @@
 #define OUT
 #endif
 
-typedef LArray<float> LDCDataList; // 聚类数据列表
-typedef LArray<LDCDataList> LDCDataMatrix; // 聚类数据矩阵
+typedef LDCVector LDCDataList; // 聚类数据列表(行向量)
+typedef LMatrix<float> LDCDataMatrix; // 聚类数据矩阵(每行为一个数据)
 
 
 /// @数据相似度评价方法
@@ -90,7 +90,7 @@ public:
     /// @brief 对数据进行聚类
     ///
     /// 聚类后可使用Receive()方法来访问聚类后的结果
-    /// @param[in] dataMatrix 数据矩阵(要求数据每行长度相等)
+    /// @param[in] dataMatrix 数据矩阵(每行为一个数据)
     void Cluster(IN const LDCDataMatrix& dataMatrix);
 
     /// @brief 接受一个访问者
@@ -104,13 +104,13 @@ private:
 
 private:
     LDATA_SIMILAR_METHOD m_dataSimilarMethod; ///< 数据相似度评价方法
-    LDataSimilar* m_pDataSimilar; ///< 数据相似度接口指针
+    LDataCorrelation* m_pDataSimilar; ///< 数据相似度接口指针
     LBiClusterTNode* m_pRootNode; ///< 根结点
 };
 
 
-typedef LArray<int> LDCResultList; // 聚类结果列表
-typedef LArray<LDCResultList> LDCResultMatrix; // 聚类结果矩阵
+typedef std::vector<int> LDCResultList; // 聚类结果列表(数据行索引)
+typedef std::vector<LDCResultList> LDCResultMatrix; // 聚类结果矩阵
 
 /// @brief K均值聚类
 class LKMeansCluster
@@ -135,7 +135,8 @@ public:
     /// @brief 对数据进行聚类
     ///
     /// 聚类后可使用Receive()方法来访问聚类后的结果
-    /// @param[in] dataMatrix 数据矩阵(要求数据每行长度相等)
+    /// @param[in] dataMatrix 数据矩阵(每行为一个数据)
+    /// @param[out] resultMatrix 聚类结果, 每个聚类中为数据的行索引
     void Cluster(IN const LDCDataMatrix& dataMatrix, OUT LDCResultMatrix& resultMatrix);
 
 private:
@@ -144,7 +145,7 @@ private:
 private:
     int m_k; ///< K值
     LDCResultMatrix m_resultMatrix; ///< 聚类结果矩阵
-    LDataSimilar* m_pDataSimilar; ///< 数据相似度接口指针
+    LDataCorrelation* m_pDataSimilar; ///< 数据相似度接口指针
     LDATA_SIMILAR_METHOD m_dataSimilarMethod; ///< 数据相似度评价方法
 };
 
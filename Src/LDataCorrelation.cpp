@@ -16,7 +16,7 @@ float LEuclideanDistance::Calculate(IN const LDCVector& dataVecA, IN const LDCVe
         return 0;
 
     float sqrSum = 0.0f;
-    for (unsigned int i = 0; i < dataVecA.ColumnLen; i++)
+    for (size_t i = 0; i < dataVecA.ColumnLen; i++)
     {
         float dif = dataVecA[0][i] - dataVecB[0][i];
         sqrSum += dif * dif;
@@ -36,7 +36,7 @@ float LPearsonCorrelation::Calculate(IN const LDCVector& dataVecA, IN const LDCV
     if (dataVecA.ColumnLen != dataVecB.ColumnLen)
         return 0;
 
-    unsigned int length = dataVecA.ColumnLen;
+    size_t length = dataVecA.ColumnLen;
     if (length < 1)
         return 0;
 
@@ -45,7 +45,7 @@ float LPearsonCorrelation::Calculate(IN const LDCVector& dataVecA, IN const LDCV
     float sqrSumA = 0.0f;
     float sqrSumB = 0.0f;
     float proSum = 0.0f;
-    for (unsigned int i = 0; i < length; i++)
+    for (size_t i = 0; i < length; i++)
     {
         const float& a = dataVecA[0][i];
         const float& b = dataVecB[0][i];
@@ -80,10 +80,10 @@ float LTanimotoCoefficient::Calculate(IN const LDCVector& dataVecA, IN const LDC
     if (dataVecA.ColumnLen != dataVecB.ColumnLen)
         return 0;
 
-    int coutA = 0;
-    int countB = 0;
-    int countAB = 0;
-    for (unsigned int i = 0; i < dataVecA.ColumnLen; i++)
+    size_t coutA = 0;
+    size_t countB = 0;
+    size_t countAB = 0;
+    for (size_t i = 0; i < dataVecA.ColumnLen; i++)
     {
         if (dataVecA[0][i] == m_sameValue)
             coutA++;
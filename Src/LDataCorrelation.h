@@ -19,7 +19,7 @@
 #ifndef _LDATACORRELATION_H_
 #define _LDATACORRELATION_H_
 
-#include "LDataStruct/LMatrix.h"
+#include "LMatrix.h"
 
 #ifndef IN
 #define IN
@@ -39,6 +39,9 @@ typedef LMatrix<float> LDCVector; // 行向量
 class LDataCorrelation
 {
 public:
+    /// @brief 析构函数
+    virtual ~LDataCorrelation() {}
+
     /// @brief 计算数据向量A和B的相似度
     /// 要求A向量和B向量长度相同, 并且每列数据对应的含义相同
     virtual float Calculate(IN const LDCVector& dataVecA, IN const LDCVector& dataVecB) = 0;
@@ -0,0 +1,244 @@
+﻿/// @file LDataLoader.h
+/// @brief 预取数据加载器头文件
+///
+/// Detail: 训练接口(LBPNetwork::Train, LLogisticRegression::TrainModel等)每次处理一个批次,
+/// 加载器在后台线程中调用生产函数读取和预处理下一个批次, 同时调用线程使用当前批次训练, 读取和计算重叠执行
+/// 批次存放在固定个数的缓冲区(环形队列)中并被重复使用, 内存大小固定:
+/// 调用线程持有一个缓冲区, 后台线程最多预先填充其余的缓冲区, 默认2个缓冲区即双缓冲
+/// 注意: 生产函数在后台线程中执行, 加载期间调用线程不能访问生产函数使用的数据源(如读取器)
+/// @author Jie Liu Email:coderjie@outlook.com
+/// @version
+/// @date 2026/10/17
+
+/*  使用预取数据加载器的示例代码如下
+
+// 批次类型: 后台线程中把每个批次拆分为样本矩阵和标签向量
+struct LTrainBatch
+{
+    LMatrix<double> XMatrix;
+    LMatrix<double> YVector;
+    LMatrix<double> Data;
+};
+
+LCSVBatchReader reader(L"train.csv");
+LDataLoader<LTrainBatch> loader([&](LTrainBatch& batch)
+{
+    if (!reader.NextBatch(batch.Data))
+        return false;
+
+    const size_t n = batch.Data.ColumnLen - 1;
+    batch.Data.SubMatrix(0, batch.Data.RowLen, 0, n, batch.XMatrix);
+    batch.Data.SubMatrix(0, batch.Data.RowLen, n, 1, batch.YVector);
+    return true;
+});
+
+for (size_t epoch = 0; epoch < epochCount; epoch++)
+{
+    // 上一轮已经结束, 后台线程不再访问读取器
+    reader.Rewind();
+    loader.Start();
+    while (LTrainBatch* pBatch = loader.Next())
+        model.TrainModel(pBatch->XMatrix, pBatch->YVector, alpha);
+}
+*/
+
+#ifndef _LDATALOADER_H_
+#define _LDATALOADER_H_
+
+#include <cstddef>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+#ifndef IN
+#define IN
+#endif
+
+#ifndef INOUT
+#define INOUT
+#endif
+
+#ifndef OUT
+#define OUT
+#endif
+
+/// @brief 预取数据加载器
+/// @param Batch 批次类型, 需要可以默认构造, 缓冲区中的批次被重复使用,
+/// 生产函数每次得到的是上一次使用过的批次, 可以重用其中的矩阵内存(大小不变时LMatrix::Reset不重新分配)
+template<typename Batch>
+class LDataLoader
+{
+public:
+    /// @brief 生产函数
+    /// 在后台线程中填充批次, 返回false表示没有更多数据(包括出错), 本轮加载结束
+    typedef std::function<bool(INOUT Batch& batch)> Producer;
+
+public:
+    /// @brief 构造函数
+    /// 构造后不会开始加载, 请调用Start()
+    /// @param[in] producer 生产函数
+    /// @param[in] bufferNum 缓冲区个数, 小于2时视为2
+    explicit LDataLoader(IN const Producer& producer, IN size_t bufferNum = 2)
+        : m_producer(producer),
+        m_bufferList(bufferNum < 2 ? 2 : bufferNum),
+        m_head(0),
+        m_readyNum(0),
+        m_bHolding(false),
+        m_bEnd(true),
+        m_bStop(false)
+    {
+    }
+
+    /// @brief 析构函数
+    /// 停止后台线程
+    ~LDataLoader()
+    {
+        this->Stop();
+    }
+
+    /// @brief 开始一轮加载
+    /// 正在加载时先停止(见Stop), 然后启动后台线程, 从空的缓冲区开始填充
+    void Start()
+    {
+        this->Stop();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_head = 0;
+            m_readyNum = 0;
+            m_bHolding = false;
+            m_bEnd = false;
+            m_bStop = false;
+            m_error = std::exception_ptr();
+        }
+
+        m_thread = std::thread(&LDataLoader::ProduceLoop, this);
+    }
+
+    /// @brief 停止加载
+    /// 等待正在执行的生产函数返回, 然后丢弃已经填充的批次, 停止后可以安全地访问数据源
+    /// 提前结束一轮加载(如训练提前收敛)时调用
+    void Stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_bStop = true;
+        }
+        m_freeCondition.notify_all();
+
+        if (m_thread.joinable())
+            m_thread.join();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_readyNum = 0;
+        m_bHolding = false;
+        m_bEnd = true;
+    }
+
+    /// @brief 获取下一个批次
+    /// 先归还上一次获取的批次(之后不能再使用), 然后等待后台线程填充下一个批次
+    /// 生产函数抛出异常时在这里重新抛出
+    /// @return 批次, 本轮没有更多数据或者没有开始加载时返回0
+    Batch* Next()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_bHolding)
+        {
+            m_head = (m_head + 1) % m_bufferList.size();
+            m_readyNum--;
+            m_bHolding = false;
+            m_freeCondition.notify_one();
+        }
+
+        m_readyCondition.wait(lock, [this]() { return m_readyNum > 0 || m_bEnd; });
+        if (m_readyNum == 0)
+        {
+            if (m_error)
+            {
+                std::exception_ptr error = m_error;
+                m_error = std::exception_ptr();
+                std::rethrow_exception(error);
+            }
+            return 0;
+        }
+
+        m_bHolding = true;
+        return &m_bufferList[m_head];
+    }
+
+    /// @brief 获取缓冲区个数
+    size_t BufferNum() const
+    {
+        return m_bufferList.size();
+    }
+
+private:
+    LDataLoader(const LDataLoader&);
+    LDataLoader& operator = (const LDataLoader&);
+
+    /// @brief 后台线程的循环
+    /// 有空闲的缓冲区时调用生产函数填充, 填充在锁外执行, 调用线程同时使用已经填充的批次
+    void ProduceLoop()
+    {
+        while (true)
+        {
+            size_t index = 0;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_freeCondition.wait(lock, [this]() { return m_bStop || m_readyNum < m_bufferList.size(); });
+                if (m_bStop)
+                    return;
+
+                index = (m_head + m_readyNum) % m_bufferList.size();
+            }
+
+            // 队列中的批次和调用线程持有的批次都不是该缓冲区, 不需要加锁
+            bool produced = false;
+            std::exception_ptr error;
+            try
+            {
+                produced = m_producer(m_bufferList[index]);
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!produced || m_bStop)
+                {
+                    m_error = error;
+                    m_bEnd = true;
+                }
+                else
+                {
+                    m_readyNum++;
+                }
+            }
+            m_readyCondition.notify_one();
+
+            if (!produced)
+                return;
+        }
+    }
+
+private:
+    Producer m_producer; ///< 生产函数
+    std::vector<Batch> m_bufferList; ///< 缓冲区(环形队列)
+    size_t m_head; ///< 队列中第一个批次的位置, 由m_mutex保护
+    size_t m_readyNum; ///< 队列中已经填充的批次数(包括调用线程持有的批次), 由m_mutex保护
+    bool m_bHolding; ///< 调用线程是否持有队列中的第一个批次, 由m_mutex保护
+    bool m_bEnd; ///< 本轮加载是否结束, 由m_mutex保护
+    bool m_bStop; ///< 停止标志, 由m_mutex保护
+    std::exception_ptr m_error; ///< 生产函数抛出的异常, 由m_mutex保护
+    std::thread m_thread; ///< 后台线程
+    std::mutex m_mutex; ///< 保护队列状态
+    std::condition_variable m_readyCondition; ///< 通知调用线程有填充好的批次或者加载结束
+    std::condition_variable m_freeCondition; ///< 通知后台线程有空闲的缓冲区或者停止
+};
+
+#endif
@@ -22,7 +22,7 @@ using std::map;
 /// @brief 决策树树节点
 struct CDecisionTreeNode
 {
-    unsigned int CheckColumn;           ///< 需要检验的列索引, 叶子结点该值无意义
+    size_t CheckColumn;                 ///< 需要检验的列索引, 叶子结点该值无意义
     double CheckValue;                  ///< 检验值, 为了使结果为true, 当前列必须匹配的值(如果是离散值则必须相等才为true, 如果是连续值则大于等于为true), 叶子结点该值无意义
     double FeatureDis;                  ///< 特征分布, 可以为DT_FEATURE_DISCRETE或DT_FEATURE_CONTINUUM, 叶子结点该值无意义
 
@@ -58,7 +58,7 @@ static CDecisionTreeNode* DecisionTreeCopy(IN const CDecisionTreeNode* pNode)
 /// @param[in] pNode 需要计算损失值的结点
 /// @param[out] lossValue 存储损失值
 /// @param[out] leafCount 存储叶子结点数量
-static void DecisionTreeLossValue(IN CDecisionTreeNode* pNode, OUT double& lossValue, OUT unsigned int& leafCount)
+static void DecisionTreeLossValue(IN CDecisionTreeNode* pNode, OUT double& lossValue, OUT size_t& leafCount)
 {
     if (pNode == nullptr)
         return;
@@ -103,8 +103,8 @@ static void DecisionTreeInsideNodes(IN CDecisionTreeNode* pNode, OUT vector<CDec
 /// @param[out] yVector 存储预测结果
 static void DecisionTreePredicty(
     IN CDecisionTreeNode* pNode,
-    IN const LDTMatrix& xMatrix,
-    IN unsigned int idx,
+    IN const LDTMatrixView& xMatrix,
+    IN size_t idx,
     OUT LDTMatrix& yVector)
 {
     if (pNode == nullptr)
@@ -166,7 +166,7 @@ static void DecisionTreePrint(IN const CDecisionTreeNode* pNode, IN string space
         return;
     }
 
-    printf(" %d : %.2f ?\n", pNode->CheckColumn, pNode->CheckValue);
+    printf(" %llu : %.2f ?\n", (unsigned long long)pNode->CheckColumn, pNode->CheckValue);
 
     printf("%sTrue->  ", space.c_str());
     DecisionTreePrint(pNode->PTrueChildren, space + "  ");
@@ -203,7 +203,7 @@ public:
     }
 
     /// @brief 训练模型
-    bool TrainModel(IN const LDTMatrix& xMatrix, IN const LDTMatrix& nVector, IN const LDTMatrix& yVector)
+    bool TrainModel(IN const LDTMatrixView& xMatrix, IN const LDTMatrixView& nVector, IN const LDTMatrixView& yVector)
     {
         // 检查参数
         if (xMatrix.RowLen < 1)
@@ -218,7 +218,7 @@ public:
             return false;
         if (yVector.RowLen != xMatrix.RowLen)
             return false;
-        for (unsigned int i = 0; i < nVector.ColumnLen; i++)
+        for (size_t i = 0; i < nVector.ColumnLen; i++)
         {
             if (nVector[0][i] != DT_FEATURE_DISCRETE && nVector[0][i] != DT_FEATURE_CONTINUUM)
                 return false;
@@ -232,15 +232,12 @@ public:
         }
 
         // 将样本集拆分为训练集和验证集, 30%作为验证集
-        unsigned int verifySampleCount = (unsigned int)(xMatrix.RowLen * 0.3);
-        LDTMatrix verifyXMatrix;
-        LDTMatrix trainXMatrix;
-        xMatrix.SubMatrix(0, verifySampleCount, 0, xMatrix.ColumnLen, verifyXMatrix);
-        xMatrix.SubMatrix(verifySampleCount, xMatrix.RowLen - verifySampleCount, 0, xMatrix.ColumnLen, trainXMatrix);
-        LDTMatrix verifyYVector;
-        LDTMatrix trainYVector;
-        yVector.SubMatrix(0, verifySampleCount, 0, yVector.ColumnLen, verifyYVector);
-        yVector.SubMatrix(verifySampleCount, yVector.RowLen - verifySampleCount, 0, yVector.ColumnLen, trainYVector);
+        size_t verifySampleCount = (size_t)(xMatrix.RowLen * 0.3);
+        // 训练集和验证集都是样本矩阵的视图, 不复制数据
+        LDTMatrixView verifyXMatrix = xMatrix.SubMatrix(0, verifySampleCount, 0, xMatrix.ColumnLen);
+        LDTMatrixView trainXMatrix = xMatrix.SubMatrix(verifySampleCount, xMatrix.RowLen - verifySampleCount, 0, xMatrix.ColumnLen);
+        LDTMatrixView verifyYVector = yVector.SubMatrix(0, verifySampleCount, 0, yVector.ColumnLen);
+        LDTMatrixView trainYVector = yVector.SubMatrix(verifySampleCount, yVector.RowLen - verifySampleCount, 0, yVector.ColumnLen);
 
         m_pXMatrix = &trainXMatrix;
         m_pYVector = &trainYVector;
@@ -248,9 +245,9 @@ public:
         m_featureNum = xMatrix.ColumnLen;
 
         // 提取样本标签
-        vector<unsigned int> xIdxList;
+        vector<size_t> xIdxList;
         xIdxList.reserve(m_pXMatrix->RowLen);
-        for (unsigned int i = 0; i < m_pXMatrix->RowLen; i++)
+        for (size_t i = 0; i < m_pXMatrix->RowLen; i++)
         {
             xIdxList.push_back(i);
         }
@@ -290,7 +287,7 @@ public:
             for (auto iter = nodeList.begin(); iter != nodeList.end(); iter++)
             {
                 lossValue = 0.0;
-                unsigned int leafCount = 0;
+                size_t leafCount = 0;
                 DecisionTreeLossValue(*iter, lossValue, leafCount);
                 double alpha = ((*iter)->LossValue - lossValue) / (leafCount - 1);
                 
@@ -322,7 +319,7 @@ public:
         {
             double errorSum = 0.0;
             LDTMatrix predictY(verifyYVector.RowLen, 1, 0.0);
-            for (unsigned int i = 0; i < verifyXMatrix.RowLen; i++)
+            for (size_t i = 0; i < verifyXMatrix.RowLen; i++)
             {
                 DecisionTreePredicty(*iter, verifyXMatrix, i, predictY);
 
@@ -375,7 +372,7 @@ public:
     }
 
     /// @brief 使用训练好的模型预测数据
-    bool Predict(IN const LDTMatrix& xMatrix, OUT LDTMatrix& yVector) const
+    bool Predict(IN const LDTMatrixView& xMatrix, OUT LDTMatrix& yVector) const
     {
         // 检查参数
         if (nullptr == m_pRootNode)
@@ -387,7 +384,7 @@ public:
 
         yVector.Reset(xMatrix.RowLen, 1, 0.0);
 
-        for (unsigned int i = 0; i < xMatrix.RowLen; i++)
+        for (size_t i = 0; i < xMatrix.RowLen; i++)
         {
             DecisionTreePredicty(m_pRootNode, xMatrix, i, yVector);
         }
@@ -396,7 +393,7 @@ public:
     }
 
     /// @brief 计算模型得分
-    double Score(IN const LDTMatrix& xMatrix, IN const LDTMatrix& yVector) const
+    double Score(IN const LDTMatrixView& xMatrix, IN const LDTMatrixView& yVector) const
     {
         if (m_treeType == REGRESSION_TREE)
             return this->ScoreRSquare(xMatrix, yVector);
@@ -420,7 +417,7 @@ private:
     /// @brief 递归构造决策树
     /// @param[in] xIdxList 样本索引列表
     /// @return 决策树节点
-    CDecisionTreeNode* RecursionBuildTree(IN const vector<unsigned int>& xIdxList, double targetValue, double lossValue)
+    CDecisionTreeNode* RecursionBuildTree(IN const vector<size_t>& xIdxList, double targetValue, double lossValue)
     {
         CDecisionTreeNode* pNode = new CDecisionTreeNode();
 
@@ -437,25 +434,25 @@ private:
         }
 
         double minLossValue = lossValue;     // 最小损失值
-        unsigned int bestCheckCol = 0;       // 最佳检查列
+        size_t bestCheckCol = 0;             // 最佳检查列
         double bestCheckValue;               // 最佳检查值
         double bestColFeaturDis;             // 最佳列特征分布
-        vector<unsigned int> xBestTrueList;  // 最佳true分支样本索引列表
-        vector<unsigned int> xBestFalseList; // 最佳false分支样本索引列表
+        vector<size_t> xBestTrueList;        // 最佳true分支样本索引列表
+        vector<size_t> xBestFalseList; // 最佳false分支样本索引列表
         double bestTrueTargetValue;
         double bestTrueLossValue;
         double bestFalseTargetValue;
         double bestFalseLossValue;
 
          // 针对每个列
-        for (unsigned int col = 0; col < m_pXMatrix->ColumnLen; col++)
+        for (size_t col = 0; col < m_pXMatrix->ColumnLen; col++)
         {
             set<double> columnValueSet; // 列中不重复的值集合
 
              // 当前列中生成一个由不同值构成的序列
-            for (unsigned int i = 0; i < xIdxList.size(); i++)
+            for (size_t i = 0; i < xIdxList.size(); i++)
             {
-                unsigned int idx = xIdxList[i];
+                size_t idx = xIdxList[i];
 
                 columnValueSet.insert((*m_pXMatrix)[idx][col]);
             }
@@ -464,8 +461,8 @@ private:
             for (auto iter = columnValueSet.begin(); iter != columnValueSet.end(); iter++)
             {
                 double checkValue = *iter;       // 检查值
-                vector<unsigned int> xTrueList;  // true分支样本索引列表
-                vector<unsigned int> xFalseList; // false分支样本索引列表
+                vector<size_t> xTrueList;        // true分支样本索引列表
+                vector<size_t> xFalseList; // false分支样本索引列表
                 this->DevideSample(xIdxList, col, checkValue, xTrueList, xFalseList);
                 if (xTrueList.size() == 0 ||
                     xFalseList.size() == 0)
@@ -515,20 +512,20 @@ private:
     /// @param[out] xTrueList 检查结果为true的样本索引列表
     /// @param[out] xFalseList 检查结果为false的样本索引列表
     void DevideSample(
-        IN const vector<unsigned int>& xIdxList,
-        IN unsigned int column,
+        IN const vector<size_t>& xIdxList,
+        IN size_t column,
         IN double checkValue,
-        OUT vector<unsigned int>& xTrueList,
-        OUT vector<unsigned int>& xFalseList)
+        OUT vector<size_t>& xTrueList,
+        OUT vector<size_t>& xFalseList)
     {
         xTrueList.clear();
         xFalseList.clear();
 
         if ((*m_pNVector)[0][column] == DT_FEATURE_DISCRETE)
         {
-            for (unsigned int i = 0; i < xIdxList.size(); i++)
+            for (size_t i = 0; i < xIdxList.size(); i++)
             {
-                unsigned int idx = xIdxList[i];
+                size_t idx = xIdxList[i];
 
                 if ((*m_pXMatrix)[idx][column] == checkValue)
                     xTrueList.push_back(idx);
@@ -541,9 +538,9 @@ private:
 
         if ((*m_pNVector)[0][column] == DT_FEATURE_CONTINUUM)
         {
-            for (unsigned int i = 0; i < xIdxList.size(); i++)
+            for (size_t i = 0; i < xIdxList.size(); i++)
             {
-                unsigned int idx = xIdxList[i];
+                size_t idx = xIdxList[i];
 
                 if ((*m_pXMatrix)[idx][column] >= checkValue)
                     xTrueList.push_back(idx);
@@ -559,7 +556,7 @@ private:
     /// @param[out] targetValue 目标值
     /// @param[out] lossValue 损失值
     /// @return 样本损失值
-    void CalculateLossValue(IN const vector<unsigned int>& xIdxList, OUT double& targetValue, OUT double& lossValue) const
+    void CalculateLossValue(IN const vector<size_t>& xIdxList, OUT double& targetValue, OUT double& lossValue) const
     {
         if (m_treeType == CLASSIFIER_TREE)
             this->CalculateLossValueGini(xIdxList, targetValue, lossValue);
@@ -572,14 +569,14 @@ private:
     /// @param[out] targetMean 目标均值
     /// @param[out] lossValue 损失值
     /// @return 样本损失值
-    void CalculateLossValueSquare(IN const vector<unsigned int>& xIdxList, OUT double& targetMean, OUT double& lossValue) const
+    void CalculateLossValueSquare(IN const vector<size_t>& xIdxList, OUT double& targetMean, OUT double& lossValue) const
     {
         targetMean = 0.0;
         lossValue = 0.0;
 
         for (auto iter = xIdxList.begin(); iter != xIdxList.end(); iter++)
         {
-            unsigned int idx = *iter;
+            size_t idx = *iter;
             targetMean += (*m_pYVector)[idx][0];
         }
 
@@ -587,7 +584,7 @@ private:
 
         for (auto iter = xIdxList.begin(); iter != xIdxList.end(); iter++)
         {
-            unsigned int idx = *iter;
+            size_t idx = *iter;
             double dif = (*m_pYVector)[idx][0] - targetMean;
             lossValue += dif * dif;
         }
@@ -598,13 +595,13 @@ private:
      /// @param[out] targetLabel 目标标签
      /// @param[out] lossValue 损失值
      /// @return 计算损失值(基尼指数)
-     void CalculateLossValueGini(IN const vector<unsigned int>& xIdxList, OUT double& targetLabel, OUT double& lossValue) const
+     void CalculateLossValueGini(IN const vector<size_t>& xIdxList, OUT double& targetLabel, OUT double& lossValue) const
      {
          map<double, int> labelMap;
      
-         for (unsigned int i = 0; i < xIdxList.size(); i++)
+         for (size_t i = 0; i < xIdxList.size(); i++)
          {
-             unsigned int idx = xIdxList[i];
+             size_t idx = xIdxList[i];
              ++labelMap[(*m_pYVector)[idx][0]];
          }
      
@@ -626,7 +623,7 @@ private:
      }
 
     /// @brief 计算模型得分(相关指数R^2)
-    double ScoreRSquare(IN const LDTMatrix& xMatrix, IN const LDTMatrix& yVector) const
+    double ScoreRSquare(IN const LDTMatrixView& xMatrix, IN const LDTMatrixView& yVector) const
     {
         // 检查参数
         if (nullptr == m_pRootNode)
@@ -644,7 +641,7 @@ private:
         this->Predict(xMatrix, predictY);
 
         double sumY = 0.0;
-        for (unsigned int i = 0; i < yVector.RowLen; i++)
+        for (size_t i = 0; i < yVector.RowLen; i++)
         {
             sumY += yVector[i][0];
         }
@@ -652,7 +649,7 @@ private:
 
         double lossValue = 0.0;
         double denominator = 0.0;
-        for (unsigned int i = 0; i < yVector.RowLen; i++)
+        for (size_t i = 0; i < yVector.RowLen; i++)
         {
             double dis = yVector[i][0] - predictY[i][0];
             lossValue += dis * dis;
@@ -667,7 +664,7 @@ private:
     }
 
      /// @brief 计算模型得分(正确率)
-     double ScoreAccuracy(IN const LDTMatrix& xMatrix, IN const LDTMatrix& yVector) const
+     double ScoreAccuracy(IN const LDTMatrixView& xMatrix, IN const LDTMatrixView& yVector) const
      {
          // 检查参数
          if (nullptr == m_pRootNode)
@@ -687,7 +684,7 @@ private:
              return -1.0;
      
          double trueCount = 0.0;
-         for (unsigned int row = 0; row < yVector.RowLen; row++)
+         for (size_t row = 0; row < yVector.RowLen; row++)
          {
              if (predictVector[row][0] == yVector[row][0])
                  trueCount += 1.0;
@@ -698,11 +695,11 @@ private:
 
 private:
 
-    const LDTMatrix* m_pXMatrix;   ///< 样本矩阵, 训练时所用临时变量
-    const LDTMatrix* m_pYVector;   ///< 标签向量(列向量), 训练时所用临时变量
-    const LDTMatrix* m_pNVector;   ///< 特征分布向量(行向量), 训练时所用临时变量
+    const LDTMatrixView* m_pXMatrix;   ///< 样本矩阵, 训练时所用临时变量
+    const LDTMatrixView* m_pYVector;   ///< 标签向量(列向量), 训练时所用临时变量
+    const LDTMatrixView* m_pNVector;   ///< 特征分布向量(行向量), 训练时所用临时变量
 
-    unsigned int m_featureNum;      ///< 特征数
+    size_t m_featureNum;            ///< 特征数
 
     int m_treeType;                 ///< 树类型
     CDecisionTreeNode* m_pRootNode; ///< 决策树根结点
@@ -724,17 +721,17 @@ LDecisionTreeClassifier::~LDecisionTreeClassifier()
     }
 }
 
-bool LDecisionTreeClassifier::TrainModel(IN const LDTMatrix& xMatrix, IN const LDTMatrix& nVector, IN const LDTMatrix& yVector)
+bool LDecisionTreeClassifier::TrainModel(IN const LDTMatrixView& xMatrix, IN const LDTMatrixView& nVector, IN const LDTMatrixView& yVector)
 {
     return m_pClassifier->TrainModel(xMatrix, nVector, yVector);
 }
 
-bool LDecisionTreeClassifier::Predict(IN const LDTMatrix& xMatrix, OUT LDTMatrix& yVector) const
+bool LDecisionTreeClassifier::Predict(IN const LDTMatrixView& xMatrix, OUT LDTMatrix& yVector) const
 {
     return m_pClassifier->Predict(xMatrix, yVector);
 }
 
-double LDecisionTreeClassifier::Score(IN const LDTMatrix& xMatrix, IN const LDTMatrix& yVector) const
+double LDecisionTreeClassifier::Score(IN const LDTMatrixView& xMatrix, IN const LDTMatrixView& yVector) const
 {
     return m_pClassifier->Score(xMatrix, yVector);
 }
@@ -759,17 +756,17 @@ LDecisionTreeRegression::~LDecisionTreeRegression()
     }
 }
 
-bool LDecisionTreeRegression::TrainModel(IN const LDTMatrix& xMatrix, IN const LDTMatrix& nVector, IN const LDTMatrix& yVector)
+bool LDecisionTreeRegression::TrainModel(IN const LDTMatrixView& xMatrix, IN const LDTMatrixView& nVector, IN const LDTMatrixView& yVector)
 {
     return m_pRegressor->TrainModel(xMatrix, nVector, yVector);
 }
 
-bool LDecisionTreeRegression::Predict(IN const LDTMatrix& xMatrix, OUT LDTMatrix& yVector) const
+bool LDecisionTreeRegression::Predict(IN const LDTMatrixView& xMatrix, OUT LDTMatrix& yVector) const
 {
     return m_pRegressor->Predict(xMatrix, yVector);
 }
 
-double LDecisionTreeRegression::Score(IN const LDTMatrix& xMatrix, IN const LDTMatrix& yVector) const
+double LDecisionTreeRegression::Score(IN const LDTMatrixView& xMatrix, IN const LDTMatrixView& yVector) const
 {
     return m_pRegressor->Score(xMatrix, yVector);
 }
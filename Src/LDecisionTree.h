@@ -13,6 +13,7 @@
 
 
 typedef LMatrix<double> LDTMatrix;     ///< 决策树矩阵
+typedef LMatrixView<double> LDTMatrixView; ///< 决策树矩阵视图
 
 #ifndef DT_FEATURE_DISCRETE
 #define DT_FEATURE_DISCRETE  0.0       ///< 特征值为离散分布
@@ -41,19 +42,19 @@ public:
     /// @param[in] nVector 样本特征分布向量(行向量), 每一列代表一个特征的分布, 值只能为DT_FEATURE_DISCRETE和DT_FEATURE_CONTINUUM
     /// @param[in] yVector 样本标签向量(列向量), 每一行代表一个样本, 标签值应为离散值, 不同的值代表不同的类别
     /// @return 成功返回true, 失败返回false(参数错误的情况下会返回失败)
-    bool TrainModel(IN const LDTMatrix& xMatrix, IN const LDTMatrix& nVector, IN const LDTMatrix& yVector);
+    bool TrainModel(IN const LDTMatrixView& xMatrix, IN const LDTMatrixView& nVector, IN const LDTMatrixView& yVector);
 
     /// @brief 使用训练好的模型预测数据
     /// @param[in] xMatrix 需要预测的样本矩阵
     /// @param[out] yVector 存储预测的标签向量(列向量)
     /// @return 成功返回true, 失败返回false(模型未训练或参数错误的情况下会返回失败)
-    bool Predict(IN const LDTMatrix& xMatrix, OUT LDTMatrix& yVector) const;
+    bool Predict(IN const LDTMatrixView& xMatrix, OUT LDTMatrix& yVector) const;
 
     /// @brief 计算模型得分
     /// @param[in] xMatrix 样本矩阵
     /// @param[in] yVector 标签向量(列向量)
     /// @return 得分 值为0.0~1.0, 模型未训练或者参数有误返回-1.0
-    double Score(IN const LDTMatrix& xMatrix, IN const LDTMatrix& yVector) const;
+    double Score(IN const LDTMatrixView& xMatrix, IN const LDTMatrixView& yVector) const;
 
     /// @brief 打印树, 用于调试
     void PrintTree() const;
@@ -80,19 +81,19 @@ public:
     /// @param[in] nVector 样本特征分布向量(行向量), 每一列代表一个特征的分布, 值只能为DT_FEATURE_DISCRETE和DT_FEATURE_CONTINUUM
     /// @param[in] yVector 样本目标向量(列向量), 每一行代表一个样本
     /// @return 成功返回true, 失败返回false(参数错误的情况下会返回失败)
-    bool TrainModel(IN const LDTMatrix& xMatrix, IN const LDTMatrix& nVector, IN const LDTMatrix& yVector);
+    bool TrainModel(IN const LDTMatrixView& xMatrix, IN const LDTMatrixView& nVector, IN const LDTMatrixView& yVector);
 
     /// @brief 使用训练好的模型预测数据
     /// @param[in] xMatrix 需要预测的样本矩阵
     /// @param[out] yVector 存储预测的结果向量(列向量)
     /// @return 成功返回true, 失败返回false(模型未训练或参数错误的情况下会返回失败)
-    bool Predict(IN const LDTMatrix& xMatrix, OUT LDTMatrix& yVector) const;
+    bool Predict(IN const LDTMatrixView& xMatrix, OUT LDTMatrix& yVector) const;
 
     /// @brief 计算模型得分
     /// @param[in] xMatrix 样本矩阵
     /// @param[in] yVector 目标向量(列向量)
     /// 相关指数R ^ 2, 该值最大值为1, 该值越接近1, 表示回归的效果越好, 如果有错误则返回2.0
-    double Score(IN const LDTMatrix& xMatrix, IN const LDTMatrix& yVector) const;
+    double Score(IN const LDTMatrixView& xMatrix, IN const LDTMatrixView& yVector) const;
 
     /// @brief 打印树, 用于调试
     void PrintTree() const;
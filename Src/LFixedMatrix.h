@@ -0,0 +1,262 @@
+﻿/// @file LFixedMatrix.h
+/// @brief 固定大小矩阵模板头文件
+///
+/// Detail: 行数和列数为编译期常量的小矩阵, 数据存储在对象内部(栈上或者所属对象中), 不分配堆内存
+/// 所有逐元素运算的循环次数都是常量, 元素个数不超过LFIXEDMATRIX_UNROLL_SIZE时完全展开
+/// 适用于大小在模型生命周期内不变, 并且在最内层循环中反复使用的小对象(如临时行向量, 1x1的结果)
+/// 可以通过View()转换为LMatrixView, 作为LMatrix运算和模型接口的输入
+/// @author Jie Liu Email:coderjie@outlook.com
+/// @version
+/// @date 2026/10/17
+
+/*  使用固定大小矩阵的示例代码如下
+
+LFixedMatrix<float, 3, 3> A(1.0f);
+LFixedMatrix<float, 3, 1> x;
+x[0][0] = 1.0f; x[1][0] = 2.0f; x[2][0] = 3.0f;
+
+// y = A * x
+LFixedMatrix<float, 3, 1> y;
+LFixedMatrix<float, 3, 1>::MUL(A, x, y);
+
+// 作为普通矩阵运算的输入
+LMatrix<float> B;
+LMatrix<float>::MUL(A.View(), x.View(), B);
+*/
+
+#ifndef _LFIXEDMATRIX_H_
+#define _LFIXEDMATRIX_H_
+
+#include <cstddef>
+
+#include "LMatrix.h"
+
+/// @brief 完全展开循环的最大元素个数
+/// 超过该值时使用常量次数的普通循环, 由编译器决定是否展开, 避免代码膨胀
+#ifndef LFIXEDMATRIX_UNROLL_SIZE
+#define LFIXEDMATRIX_UNROLL_SIZE 64
+#endif
+
+/// @brief 编译期展开的循环, 依次执行func(0), func(1), ..., func(N - 1)
+template<size_t N, bool Unroll = (N <= LFIXEDMATRIX_UNROLL_SIZE)>
+struct LFixedMatrixLoop
+{
+    template<typename Func>
+    static void Apply(IN const Func& func)
+    {
+        LFixedMatrixLoop<N - 1, true>::Apply(func);
+        func(N - 1);
+    }
+};
+
+template<>
+struct LFixedMatrixLoop<0, true>
+{
+    template<typename Func>
+    static void Apply(IN const Func&)
+    {
+    }
+};
+
+/// @brief 元素较多时不展开的循环
+template<size_t N>
+struct LFixedMatrixLoop<N, false>
+{
+    template<typename Func>
+    static void Apply(IN const Func& func)
+    {
+        for (size_t i = 0; i < N; i++)
+            func(i);
+    }
+};
+
+/// @brief 固定大小矩阵
+/// 元素行优先连续存储, 行步长等于列数
+/// 默认构造函数不初始化元素, 与内置数组的行为一致
+/// @param[in] Type 元素类型
+/// @param[in] M 行数, 必须大于0
+/// @param[in] N 列数, 必须大于0
+template<typename Type, size_t M, size_t N>
+class LFixedMatrix
+{
+    static_assert(M > 0 && N > 0, "LFixedMatrix: dimensions must be positive");
+
+public:
+    static const size_t RowLen = M;         ///< 行长度
+    static const size_t ColumnLen = N;      ///< 列长度
+    static const size_t Size = M * N;       ///< 元素个数
+
+public:
+    /// @brief 默认构造函数, 不初始化元素
+    LFixedMatrix()
+    {
+    }
+
+    /// @brief 构造函数, 所有元素初始化为相同的值
+    /// @param[in] initValue 初始值
+    explicit LFixedMatrix(IN const Type& initValue)
+    {
+        this->Fill(initValue);
+    }
+
+    /// @brief []操作符
+    /// @param[in] row 行索引
+    /// @return 行首元素地址
+    Type* operator[](IN size_t row)
+    {
+        return m_dataList + row * N;
+    }
+
+    /// @brief []操作符
+    /// @param[in] row 行索引
+    /// @return 行首元素地址
+    const Type* operator[](IN size_t row) const
+    {
+        return m_dataList + row * N;
+    }
+
+    /// @brief 获取数据地址
+    /// @return 首元素地址
+    Type* Data()
+    {
+        return m_dataList;
+    }
+
+    /// @brief 获取数据地址
+    /// @return 首元素地址
+    const Type* Data() const
+    {
+        return m_dataList;
+    }
+
+    /// @brief 获取矩阵视图
+    /// 视图在矩阵对象存在时有效
+    /// @return 引用整个矩阵的视图
+    LMatrixView<Type> View() const
+    {
+        return LMatrixView<Type>(m_dataList, M, N, N, 1);
+    }
+
+    /// @brief 所有元素设为相同的值
+    /// @param[in] value 值
+    void Fill(IN const Type& value)
+    {
+        Type* pData = m_dataList;
+        LFixedMatrixLoop<Size>::Apply([=](size_t i) { pData[i] = value; });
+    }
+
+    /// @brief 从视图中复制数据
+    /// @param[in] src 源视图, 大小必须为M * N
+    /// @return 成功返回true, 大小不同返回false
+    bool Assign(IN const LMatrixView<Type>& src)
+    {
+        if (src.RowLen != M || src.ColumnLen != N)
+            return false;
+
+        for (size_t i = 0; i < M; i++)
+        {
+            const typename LMatrixView<Type>::Row srcRow = src[i];
+            Type* pRow = m_dataList + i * N;
+            LFixedMatrixLoop<N>::Apply([&](size_t j) { pRow[j] = srcRow[j]; });
+        }
+
+        return true;
+    }
+
+    /// @brief 转置, B = A.T()
+    /// @param[out] B 转置矩阵
+    void T(OUT LFixedMatrix<Type, N, M>& B) const
+    {
+        const Type* pA = m_dataList;
+        Type* pB = B.Data();
+        LFixedMatrixLoop<Size>::Apply([=](size_t i) { pB[(i % N) * M + i / N] = pA[i]; });
+    }
+
+    /// @brief 矩阵相加, C = A + B
+    /// C可以和A或B是相同矩阵
+    static void ADD(IN const LFixedMatrix& A, IN const LFixedMatrix& B, OUT LFixedMatrix& C)
+    {
+        const Type* pA = A.m_dataList;
+        const Type* pB = B.m_dataList;
+        Type* pC = C.m_dataList;
+        LFixedMatrixLoop<Size>::Apply([=](size_t i) { pC[i] = pA[i] + pB[i]; });
+    }
+
+    /// @brief 矩阵相减, C = A - B
+    /// C可以和A或B是相同矩阵
+    static void SUB(IN const LFixedMatrix& A, IN const LFixedMatrix& B, OUT LFixedMatrix& C)
+    {
+        const Type* pA = A.m_dataList;
+        const Type* pB = B.m_dataList;
+        Type* pC = C.m_dataList;
+        LFixedMatrixLoop<Size>::Apply([=](size_t i) { pC[i] = pA[i] - pB[i]; });
+    }
+
+    /// @brief 矩阵对应元素相乘, C = A .* B
+    /// C可以和A或B是相同矩阵
+    static void DOTMUL(IN const LFixedMatrix& A, IN const LFixedMatrix& B, OUT LFixedMatrix& C)
+    {
+        const Type* pA = A.m_dataList;
+        const Type* pB = B.m_dataList;
+        Type* pC = C.m_dataList;
+        LFixedMatrixLoop<Size>::Apply([=](size_t i) { pC[i] = pA[i] * pB[i]; });
+    }
+
+    /// @brief 矩阵数乘, C = A * b
+    /// C可以和A是相同矩阵
+    static void SCALARMUL(IN const LFixedMatrix& A, IN const Type& b, OUT LFixedMatrix& C)
+    {
+        const Type* pA = A.m_dataList;
+        Type* pC = C.m_dataList;
+        LFixedMatrixLoop<Size>::Apply([=](size_t i) { pC[i] = pA[i] * b; });
+    }
+
+    /// @brief 矩阵乘法, C = A * B
+    /// C不能和A或B是相同矩阵
+    /// @param[in] A 被乘数, 大小为R * K
+    /// @param[in] B 乘数, 大小为K * N
+    /// @param[out] C 结果矩阵
+    template<size_t K>
+    static void MUL(
+        IN const LFixedMatrix<Type, M, K>& A, 
+        IN const LFixedMatrix<Type, K, N>& B, 
+        OUT LFixedMatrix& C)
+    {
+        const Type* pA = A.Data();
+        const Type* pB = B.Data();
+        Type* pC = C.m_dataList;
+        LFixedMatrixLoop<Size>::Apply([=](size_t i)
+        {
+            const Type* pARow = pA + (i / N) * K;
+            const Type* pBColumn = pB + (i % N);
+            Type sum = pARow[0] * pBColumn[0];
+            LFixedMatrixLoop<K - 1>::Apply([&](size_t k) { sum += pARow[k + 1] * pBColumn[(k + 1) * N]; });
+            pC[i] = sum;
+        });
+    }
+
+    /// @brief 内积, sum(A .* B)
+    /// 对于行向量或列向量即为向量内积
+    static Type DOT(IN const LFixedMatrix& A, IN const LFixedMatrix& B)
+    {
+        const Type* pA = A.m_dataList;
+        const Type* pB = B.m_dataList;
+        Type sum = pA[0] * pB[0];
+        LFixedMatrixLoop<Size - 1>::Apply([&](size_t i) { sum += pA[i + 1] * pB[i + 1]; });
+        return sum;
+    }
+
+private:
+    Type m_dataList[M * N];     ///< 数据列表, 行优先存储
+};
+
+template<typename Type, size_t M, size_t N>
+const size_t LFixedMatrix<Type, M, N>::RowLen;
+
+template<typename Type, size_t M, size_t N>
+const size_t LFixedMatrix<Type, M, N>::ColumnLen;
+
+template<typename Type, size_t M, size_t N>
+const size_t LFixedMatrix<Type, M, N>::Size;
+
+#endif
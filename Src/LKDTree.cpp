@@ -3,9 +3,10 @@
 
 #include <vector>
 using std::vector;
+#include <set>
+using std::multiset;
 
 #include "LKDTree.h"
-#include "LDataStruct/LOrderedList.h"
 
 
 
@@ -17,7 +18,7 @@ struct LKDTreeNode
         UNDEFINE_SPLIT = -1 // 表示未定义的分割序号
     };
     int Split; ///< 垂直于分割超面的方向轴序号(如果值为UNDEFINE_SPLIT, 表示该节点为叶子节点)
-    unsigned int DataIndex; ///< 节点数据的索引
+    size_t DataIndex; ///< 节点数据的索引
     LKDTreeNode* Parent; ///< 父节点
     LKDTreeNode* LeftChildren; ///< 左孩子节点
     LKDTreeNode* RightChildren; ///< 右孩子 节点
@@ -26,7 +27,7 @@ struct LKDTreeNode
 /// @brief KD树节点与目标点的距离
 struct LKDTreeNodeDistance
 {
-    unsigned int DataIndex; ///< 数据索引
+    size_t DataIndex; ///< 数据索引
     float Distance; ///< 距离值
 
     bool operator < (IN const LKDTreeNodeDistance& B) const
@@ -67,13 +68,13 @@ public:
         if (dataSet.RowLen < 1 || dataSet.ColumnLen < 1)
             return;
 
-        // 复制数据集
+        // 共享数据集(不复制数据), 只通过const成员函数读取
         this->m_dataSet = dataSet;
 
         // 递归构建树
         this->m_pRootNode = new LKDTreeNode();
-        vector<unsigned int> dataIndexList(dataSet.RowLen);
-        for (unsigned int i = 0; i < dataIndexList.size(); i++)
+        vector<size_t> dataIndexList(dataSet.RowLen);
+        for (size_t i = 0; i < dataIndexList.size(); i++)
         {
             dataIndexList[i] = i;
         }
@@ -81,7 +82,7 @@ public:
     }
 
     /// @brief 在数据集中搜索与指定数据最邻近的数据索引
-    int SearchNearestNeighbor(IN const LKDTreeMatrix& data)
+    int SearchNearestNeighbor(IN const LKDTreeMatrix& data) const
     {
         LKDTreeList indexList;
         bool bRet = this->SearchKNearestNeighbors(data, 1, indexList);
@@ -94,7 +95,7 @@ public:
     }
 
     /// @brief 在数据集中搜索与指定数据最邻近的K个数据索引
-    bool SearchKNearestNeighbors(IN const LKDTreeMatrix& data, IN unsigned int k, OUT LKDTreeList& indexList)
+    bool SearchKNearestNeighbors(IN const LKDTreeMatrix& data, IN size_t k, OUT LKDTreeList& indexList) const
     {
         // 检查参数
         if (data.RowLen != 1 || data.ColumnLen != m_dataSet.ColumnLen)
@@ -107,40 +108,41 @@ public:
         if (searchPath.size() < 1)
             return false;
 
-        LOrderedList<LKDTreeNodeDistance> nearestDistanceList;
+        // 按距离从小到大排列的最近点列表
+        multiset<LKDTreeNodeDistance> nearestDistanceList;
 
         // 在搜索路径中查找是否存在比当前最近点还近的点
         for (int i = (int)searchPath.size() - 1; i >= 0; i--)
         {
             LKDTreeNode* node = searchPath[i];
 
-            if (nearestDistanceList.Size() < k)
+            if (nearestDistanceList.size() < k)
             {
                 LKDTreeNodeList nodeList;
                 this->TraverseTree(node, nodeList);
                 if (nodeList.size() >= k)
                 {
                     LKDTreeNodeDistance nodeDistance;
-                    for (unsigned int n = 0; n < nodeList.size(); n++)
+                    for (size_t n = 0; n < nodeList.size(); n++)
                     {
                         nodeDistance.DataIndex = nodeList[n]->DataIndex;
                         nodeDistance.Distance = this->CalculateDistance(data, nodeDistance.DataIndex);
-                        nearestDistanceList.Insert(nodeDistance);
+                        nearestDistanceList.insert(nodeDistance);
                     }
                 }
                 continue;
             }
 
-            while (nearestDistanceList.Size() > k)
+            while (nearestDistanceList.size() > k)
             {
-                nearestDistanceList.PopBack();
+                nearestDistanceList.erase(--nearestDistanceList.end());
             }
 
 
-            LKDTreeNodeDistance currentNearestDistanceMax = nearestDistanceList.End()->Data;
+            LKDTreeNodeDistance currentNearestDistanceMax = *nearestDistanceList.rbegin();
             // 以目标点和当前最近点的距离为半径作的圆如果和分割超面相交则搜索分割面的另一边区域
             float dif = data[0][node->Split] - m_dataSet[node->DataIndex][node->Split];
-            dif = abs(dif);
+            dif = fabs(dif);
             if (dif >= currentNearestDistanceMax.Distance)
             {
                 continue;
@@ -162,7 +164,7 @@ public:
                 this->TraverseTree(node->LeftChildren, nodeList);
             }
 
-            for (unsigned int n = 0; n < nodeList.size(); n++)
+            for (size_t n = 0; n < nodeList.size(); n++)
             {
                 float distance = this->CalculateDistance(data, nodeList[n]->DataIndex);
                 LKDTreeNodeDistance nodeDistance;
@@ -170,30 +172,25 @@ public:
                 {
                     nodeDistance.Distance = distance;
                     nodeDistance.DataIndex = nodeList[n]->DataIndex;
-                    nearestDistanceList.Insert(nodeDistance);
-                    nearestDistanceList.PopBack();
-                    currentNearestDistanceMax = nearestDistanceList.End()->Data;
+                    nearestDistanceList.insert(nodeDistance);
+                    nearestDistanceList.erase(--nearestDistanceList.end());
+                    currentNearestDistanceMax = *nearestDistanceList.rbegin();
                 }
             }
 
 
         }
 
-        if (nearestDistanceList.Size() < k)
+        if (nearestDistanceList.size() < k)
             return false;
 
 
         indexList.Reset(1, k, -1);
 
-        const LOrderedListNode<LKDTreeNodeDistance>* pCurrentNode = nearestDistanceList.Begin();
-
-        int col = 0;
-        while (pCurrentNode)
+        multiset<LKDTreeNodeDistance>::const_iterator iter = nearestDistanceList.begin();
+        for (size_t col = 0; col < k; col++, ++iter)
         {
-            indexList[0][col] = pCurrentNode->Data.DataIndex;
-            col++;
-
-            pCurrentNode = pCurrentNode->PNext;
+            indexList[0][col] = (int)iter->DataIndex;
         }
 
         return true;
@@ -207,7 +204,7 @@ private:
     void CreateTree(
         IN LKDTreeNode* pParent,
         IN LKDTreeNode* pNode,
-        IN const vector<unsigned int>& dataIndexList)
+        IN const vector<size_t>& dataIndexList)
     {
         if (pNode == 0)
             return;
@@ -225,8 +222,8 @@ private:
             return;
         }
 
-        unsigned int bestColIndex = 0; // 标记最大方差的维度索引
-        unsigned int midDataIndex = 0; // 标记最佳分割点的索引
+        size_t bestColIndex = 0; // 标记最大方差的维度索引
+        size_t midDataIndex = 0; // 标记最佳分割点的索引
 
         this->FindMaxVarianceColumn(dataIndexList, bestColIndex);
 
@@ -236,17 +233,18 @@ private:
         pNode->DataIndex = midDataIndex;
 
         // 将数据分为左右两部分
-        vector<unsigned int> leftDataIndexList;
+        const LKDTreeMatrix& dataSet = this->m_dataSet;
+        vector<size_t> leftDataIndexList;
         leftDataIndexList.reserve(dataIndexList.size() * 2 / 3); // 预先分配好内存, 防止在push_back过程中多次重复分配提高效率
-        vector<unsigned int> rightDataIndexList;
+        vector<size_t> rightDataIndexList;
         rightDataIndexList.reserve(dataIndexList.size() * 2 / 3); // 预先分配好内存, 防止在push_back过程中多次重复分配提高效率
-        for (unsigned int i = 0; i < dataIndexList.size(); i++)
+        for (size_t i = 0; i < dataIndexList.size(); i++)
         {
-            unsigned int m = dataIndexList[i];
+            size_t m = dataIndexList[i];
             if (m == midDataIndex)
                 continue;
 
-            if (this->m_dataSet[m][bestColIndex] <= this->m_dataSet[midDataIndex][bestColIndex])
+            if (dataSet[m][bestColIndex] <= dataSet[midDataIndex][bestColIndex])
                 leftDataIndexList.push_back(dataIndexList[i]);
             else
                 rightDataIndexList.push_back(dataIndexList[i]);
@@ -279,7 +277,7 @@ private:
     /// @param[in] dataIndexList 数据索引列表, 要求至少要有两行数据
     /// @param[out] col 存储列索引
     /// @return 成功返回true, 失败返回false
-    bool FindMaxVarianceColumn(IN const vector<unsigned int>& dataIndexList, OUT unsigned int& col)
+    bool FindMaxVarianceColumn(IN const vector<size_t>& dataIndexList, OUT size_t& col) const
     {
         if (dataIndexList.size() < 2)
             return false;
@@ -287,22 +285,22 @@ private:
 
         // 找出具有最大方差的维度
         float maxVariance = 0.0f; // 标记所有维度上的数据方差的最大值
-        unsigned int bestCol = 0; // 标记最大方差的维度索引
-        for (unsigned int n = 0; n < this->m_dataSet.ColumnLen; n++)
+        size_t bestCol = 0; // 标记最大方差的维度索引
+        for (size_t n = 0; n < this->m_dataSet.ColumnLen; n++)
         {
             float sumValue = 0.0f; // 指定列的数据和
-            for (unsigned int i = 0; i < dataIndexList.size(); i++)
+            for (size_t i = 0; i < dataIndexList.size(); i++)
             {
-                unsigned int m = dataIndexList[i];
+                size_t m = dataIndexList[i];
                 sumValue += this->m_dataSet[m][n];
             }
 
             float averageValue = sumValue / (float)dataIndexList.size(); // 计算指定列的平均值
 
             float variance = 0.0f; // 指定列的方差值
-            for (unsigned int i = 0; i < dataIndexList.size(); i++)
+            for (size_t i = 0; i < dataIndexList.size(); i++)
             {
-                unsigned int m = dataIndexList[i];
+                size_t m = dataIndexList[i];
                 float dif = averageValue - this->m_dataSet[m][n];
                 variance += dif * dif;
             }
@@ -325,28 +323,28 @@ private:
     /// @param[in] col 列索引
     /// @param[out] dataIndex 存储数据索引
     /// @return 成功返回true, 失败返回false
-    bool FindMidValueOnColumn(IN const vector<unsigned int>& dataIndexList, IN unsigned int col, OUT unsigned int& dataIndex)
+    bool FindMidValueOnColumn(IN const vector<size_t>& dataIndexList, IN size_t col, OUT size_t& dataIndex) const
     {
         if (dataIndexList.size() < 1)
             return false;
 
 
         float sum = 0.0f;
-        for (unsigned int i = 0; i < dataIndexList.size(); i++)
+        for (size_t i = 0; i < dataIndexList.size(); i++)
         {
-            unsigned int m = dataIndexList[i];
+            size_t m = dataIndexList[i];
 
             sum += m_dataSet[m][col];
         }
 
         float avg = sum / dataIndexList.size();
 
-        unsigned int midDataIndex = dataIndexList[0];
+        size_t midDataIndex = dataIndexList[0];
         float miniDif = abs(m_dataSet[midDataIndex][col] - avg);
 
-        for (unsigned int i = 0; i < dataIndexList.size(); i++)
+        for (size_t i = 0; i < dataIndexList.size(); i++)
         {
-            unsigned int m = dataIndexList[i];
+            size_t m = dataIndexList[i];
 
             float dif = abs(m_dataSet[m][col] - avg);
             if (dif < miniDif)
@@ -365,7 +363,7 @@ private:
     /// @brief 遍历树
     /// @param[in] pNode 树节点
     /// @param[out] nodeList 遍历出来的节点列表
-    void TraverseTree(IN LKDTreeNode* pNode, OUT LKDTreeNodeList& nodeList)
+    void TraverseTree(IN LKDTreeNode* pNode, OUT LKDTreeNodeList& nodeList) const
     {
         if (pNode == 0)
             return;
@@ -379,7 +377,7 @@ private:
     /// @brief 搜索树
     /// @param[in] data 源数据
     /// @param[out] searchPath 搜索出的路径
-    void SearchTree(IN const LKDTreeMatrix& data, OUT LKDTreeNodeList& searchPath)
+    void SearchTree(IN const LKDTreeMatrix& data, OUT LKDTreeNodeList& searchPath) const
     {
         searchPath.clear();
 
@@ -414,10 +412,10 @@ private:
     /// @param[in] data 指定的数据
     /// @param[in] index 数据集中的数据索引
     /// @return 返回距离值(欧几里得距离), 使用前请保证参数正确
-    float CalculateDistance(IN const LKDTreeMatrix& data, IN unsigned int index)
+    float CalculateDistance(IN const LKDTreeMatrix& data, IN size_t index) const
     {
         float sqrSum = 0.0f;
-        for (unsigned int i = 0; i < data.ColumnLen; i++)
+        for (size_t i = 0; i < data.ColumnLen; i++)
         {
             float dif = data[0][i] - m_dataSet[index][i];
             sqrSum += dif * dif;
@@ -472,7 +470,7 @@ int LKDTree::SearchNearestNeighbor(IN const LKDTreeMatrix& data)
     return m_pKDTree->SearchNearestNeighbor(data);
 }
 
-bool LKDTree::SearchKNearestNeighbors(IN const LKDTreeMatrix& data, IN unsigned int k, OUT LKDTreeList& indexList)
+bool LKDTree::SearchKNearestNeighbors(IN const LKDTreeMatrix& data, IN size_t k, OUT LKDTreeList& indexList)
 {
     return m_pKDTree->SearchKNearestNeighbors(data, k, indexList);
 }
\ No newline at end of file
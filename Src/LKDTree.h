@@ -10,7 +10,7 @@
 #ifndef _LKDTREE_H_
 #define _LKDTREE_H_
 
-#include "LDataStruct/LMatrix.h"
+#include "LMatrix.h"
 
 #ifndef IN
 #define IN
@@ -53,7 +53,7 @@ public:
     /// @param[in] k 需要搜索的最邻近的个数(k要求大于0的整数)
     /// @param[out] indexList 存储最邻近数据索引的列表(行向量, 1 * k), 从近到远
     /// @return 成功返回true, 失败返回false
-    bool SearchKNearestNeighbors(IN const LKDTreeMatrix& data, IN unsigned int k, OUT LKDTreeList& indexList);
+    bool SearchKNearestNeighbors(IN const LKDTreeMatrix& data, IN size_t k, OUT LKDTreeList& indexList);
 
 private:
     CKDTree* m_pKDTree; ///< KD树实现对象
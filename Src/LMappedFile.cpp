@@ -0,0 +1,340 @@
+﻿#include "LMappedFile.h"
+
+#include <cstdlib>
+#include <vector>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using std::vector;
+
+#ifndef _WIN32
+/// @brief 将宽字符文件名转换为多字节文件名(当前区域设置的编码)
+/// @param[in] fileName 宽字符文件名
+/// @param[out] name 多字节文件名
+/// @return 转换失败返回false
+static bool WideToMultiByte(IN const wchar_t* fileName, OUT vector<char>& name)
+{
+    size_t len = wcstombs(0, fileName, 0);
+    if (len == (size_t)-1)
+        return false;
+
+    name.resize(len + 1);
+    wcstombs(&name[0], fileName, len + 1);
+    return true;
+}
+#endif
+
+/// @brief 内存映射文件实现类
+class CMappedFile
+{
+public:
+    /// @brief 构造函数
+    CMappedFile()
+    {
+        m_pView = 0;
+        m_viewSize = 0;
+        m_pData = 0;
+        m_size = 0;
+        m_mode = LMAPPED_FILE_READ_ONLY;
+#ifdef _WIN32
+        m_hFile = INVALID_HANDLE_VALUE;
+        m_hMapping = 0;
+#else
+        m_fd = -1;
+#endif
+    }
+
+    /// @brief 析构函数
+    ~CMappedFile()
+    {
+        this->Close();
+    }
+
+    /// @brief 映射文件的一段区域
+    bool Open(IN const wchar_t* fileName, IN LMAPPED_FILE_MODE mode, IN size_t offset, IN size_t size)
+    {
+        this->Close();
+
+        if (fileName == 0)
+            return false;
+        if (mode != LMAPPED_FILE_READ_ONLY && mode != LMAPPED_FILE_COPY_ON_WRITE)
+            return false;
+
+        if (!this->OpenFile(fileName))
+            return false;
+
+        // 计算映射区域, 映射的起始位置需要按系统映射粒度对齐
+        unsigned long long fileSize = 0;
+        if (!this->GetFileSize(fileSize) || offset > fileSize)
+        {
+            this->Close();
+            return false;
+        }
+        if (size == 0)
+        {
+            if (fileSize - offset > (unsigned long long)((size_t)-1))
+            {
+                this->Close();
+                return false;
+            }
+            size = (size_t)(fileSize - offset);
+        }
+        if (size == 0 || size > fileSize - offset)
+        {
+            this->Close();
+            return false;
+        }
+
+        const size_t granularity = MapGranularity();
+        const size_t viewOffset = offset - offset % granularity;
+        const size_t viewSize = size + (offset - viewOffset);
+
+        if (!this->MapView(mode, viewOffset, viewSize))
+        {
+            this->Close();
+            return false;
+        }
+
+        m_pData = (char*)m_pView + (offset - viewOffset);
+        m_size = size;
+        m_mode = mode;
+        return true;
+    }
+
+    /// @brief 解除映射并关闭文件
+    void Close()
+    {
+#ifdef _WIN32
+        if (m_pView != 0)
+            UnmapViewOfFile(m_pView);
+        if (m_hMapping != 0)
+            CloseHandle(m_hMapping);
+        if (m_hFile != INVALID_HANDLE_VALUE)
+            CloseHandle(m_hFile);
+        m_hMapping = 0;
+        m_hFile = INVALID_HANDLE_VALUE;
+#else
+        if (m_pView != 0)
+            munmap(m_pView, m_viewSize);
+        if (m_fd >= 0)
+            close(m_fd);
+        m_fd = -1;
+#endif
+        m_pView = 0;
+        m_viewSize = 0;
+        m_pData = 0;
+        m_size = 0;
+        m_mode = LMAPPED_FILE_READ_ONLY;
+    }
+
+    /// @brief 获取映射区域的首地址
+    void* Data() const
+    {
+        return m_pData;
+    }
+
+    /// @brief 获取映射区域的大小
+    size_t Size() const
+    {
+        return m_size;
+    }
+
+    /// @brief 获取映射方式
+    LMAPPED_FILE_MODE Mode() const
+    {
+        return m_mode;
+    }
+
+    /// @brief 获取文件大小
+    static bool FileSize(IN const wchar_t* fileName, OUT unsigned long long& size)
+    {
+        CMappedFile file;
+        if (fileName == 0 || !file.OpenFile(fileName))
+            return false;
+
+        return file.GetFileSize(size);
+    }
+
+    /// @brief 获取文件的最后修改时间
+    static bool FileTime(IN const wchar_t* fileName, OUT unsigned long long& time)
+    {
+        CMappedFile file;
+        if (fileName == 0 || !file.OpenFile(fileName))
+            return false;
+
+        return file.GetModifyTime(time);
+    }
+
+private:
+    /// @brief 以只读方式打开文件
+    bool OpenFile(IN const wchar_t* fileName)
+    {
+#ifdef _WIN32
+        m_hFile = CreateFileW(fileName, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+        return m_hFile != INVALID_HANDLE_VALUE;
+#else
+        vector<char> name;
+        if (!WideToMultiByte(fileName, name))
+            return false;
+
+        m_fd = open(&name[0], O_RDONLY);
+        return m_fd >= 0;
+#endif
+    }
+
+    /// @brief 获取已打开文件的大小
+    bool GetFileSize(OUT unsigned long long& size) const
+    {
+#ifdef _WIN32
+        LARGE_INTEGER fileSize;
+        if (GetFileSizeEx(m_hFile, &fileSize) == 0)
+            return false;
+
+        size = (unsigned long long)fileSize.QuadPart;
+#else
+        struct stat fileStat;
+        if (fstat(m_fd, &fileStat) != 0)
+            return false;
+
+        size = (unsigned long long)fileStat.st_size;
+#endif
+        return true;
+    }
+
+    /// @brief 获取已打开文件的最后修改时间
+    /// Windows上为FILETIME(100纳秒), 其他系统为纳秒
+    bool GetModifyTime(OUT unsigned long long& time) const
+    {
+#ifdef _WIN32
+        FILETIME writeTime;
+        if (::GetFileTime(m_hFile, 0, 0, &writeTime) == 0)
+            return false;
+
+        time = ((unsigned long long)writeTime.dwHighDateTime << 32) | (unsigned long long)writeTime.dwLowDateTime;
+#else
+        struct stat fileStat;
+        if (fstat(m_fd, &fileStat) != 0)
+            return false;
+
+#ifdef __APPLE__
+        const struct timespec& modifyTime = fileStat.st_mtimespec;
+#else
+        const struct timespec& modifyTime = fileStat.st_mtim;
+#endif
+        time = (unsigned long long)modifyTime.tv_sec * 1000000000ULL + (unsigned long long)modifyTime.tv_nsec;
+#endif
+        return true;
+    }
+
+    /// @brief 映射已打开文件的一段区域
+    /// @param[in] viewOffset 起始位置, 按映射粒度对齐
+    /// @param[in] viewSize 区域大小
+    bool MapView(IN LMAPPED_FILE_MODE mode, IN size_t viewOffset, IN size_t viewSize)
+    {
+#ifdef _WIN32
+        // 写时复制的文件映射对象使用PAGE_WRITECOPY, 只需要文件的读权限
+        const DWORD protect = (mode == LMAPPED_FILE_COPY_ON_WRITE) ? PAGE_WRITECOPY : PAGE_READONLY;
+        m_hMapping = CreateFileMappingW(m_hFile, 0, protect, 0, 0, 0);
+        if (m_hMapping == 0)
+            return false;
+
+        const unsigned long long offset = viewOffset;
+        const DWORD access = (mode == LMAPPED_FILE_COPY_ON_WRITE) ? FILE_MAP_COPY : FILE_MAP_READ;
+        m_pView = MapViewOfFile(m_hMapping, access, (DWORD)(offset >> 32), (DWORD)(offset & 0xFFFFFFFF), viewSize);
+        if (m_pView == 0)
+            return false;
+#else
+        const int protect = (mode == LMAPPED_FILE_COPY_ON_WRITE) ? (PROT_READ | PROT_WRITE) : PROT_READ;
+        const int flags = (mode == LMAPPED_FILE_COPY_ON_WRITE) ? MAP_PRIVATE : MAP_SHARED;
+        void* pView = mmap(0, viewSize, protect, flags, m_fd, (off_t)viewOffset);
+        if (pView == MAP_FAILED)
+            return false;
+
+        m_pView = pView;
+#endif
+        m_viewSize = viewSize;
+        return true;
+    }
+
+    /// @brief 获取映射起始位置的对齐粒度
+    static size_t MapGranularity()
+    {
+#ifdef _WIN32
+        SYSTEM_INFO systemInfo;
+        GetSystemInfo(&systemInfo);
+        return (size_t)systemInfo.dwAllocationGranularity;
+#else
+        long pageSize = sysconf(_SC_PAGESIZE);
+        return pageSize > 0 ? (size_t)pageSize : 4096;
+#endif
+    }
+
+private:
+    void* m_pView;                  ///< 映射视图的首地址(按映射粒度对齐)
+    size_t m_viewSize;              ///< 映射视图的大小
+    void* m_pData;                  ///< 映射区域的首地址
+    size_t m_size;                  ///< 映射区域的大小
+    LMAPPED_FILE_MODE m_mode;       ///< 映射方式
+#ifdef _WIN32
+    HANDLE m_hFile;                 ///< 文件句柄
+    HANDLE m_hMapping;              ///< 文件映射对象句柄
+#else
+    int m_fd;                       ///< 文件描述符
+#endif
+};
+
+LMappedFile::LMappedFile()
+{
+    m_pMappedFile = new CMappedFile();
+}
+
+LMappedFile::~LMappedFile()
+{
+    if (m_pMappedFile != 0)
+    {
+        delete m_pMappedFile;
+        m_pMappedFile = 0;
+    }
+}
+
+bool LMappedFile::Open(IN const wchar_t* fileName, IN LMAPPED_FILE_MODE mode, IN size_t offset, IN size_t size)
+{
+    return m_pMappedFile->Open(fileName, mode, offset, size);
+}
+
+void LMappedFile::Close()
+{
+    m_pMappedFile->Close();
+}
+
+void* LMappedFile::Data() const
+{
+    return m_pMappedFile->Data();
+}
+
+size_t LMappedFile::Size() const
+{
+    return m_pMappedFile->Size();
+}
+
+LMAPPED_FILE_MODE LMappedFile::Mode() const
+{
+    return m_pMappedFile->Mode();
+}
+
+bool LMappedFile::FileSize(IN const wchar_t* fileName, OUT unsigned long long& size)
+{
+    return CMappedFile::FileSize(fileName, size);
+}
+
+bool LMappedFile::FileTime(IN const wchar_t* fileName, OUT unsigned long long& time)
+{
+    return CMappedFile::FileTime(fileName, time);
+}
@@ -0,0 +1,93 @@
+﻿/// @file LMappedFile.h
+/// @brief 本文声明了内存映射文件类
+/// LMappedFile(内存映射文件)
+/// Detail: 文件内容按需分页读入, 由操作系统的页缓存管理, 多个进程映射同一个文件时共享物理内存
+/// LMatrix使用映射文件作为数据存储(见LMatrix::Map), 可以处理大于物理内存的数据集
+/// @author Jie Liu Email:coderjie@outlook.com
+/// @version
+/// @date 2026/10/17
+
+#ifndef _LMAPPEDFILE_H_
+#define _LMAPPEDFILE_H_
+
+#include <cstddef>
+
+#ifndef IN
+#define IN
+#endif
+
+#ifndef INOUT
+#define INOUT
+#endif
+
+#ifndef OUT
+#define OUT
+#endif
+
+/// @brief 文件映射方式
+enum LMAPPED_FILE_MODE
+{
+    LMAPPED_FILE_READ_ONLY = 0,         ///< 只读, 写入映射数据会导致访问违例
+    LMAPPED_FILE_COPY_ON_WRITE = 1      ///< 写时复制, 写入的页变为进程私有, 不会修改文件
+};
+
+class CMappedFile;
+
+/// @brief 内存映射文件
+class LMappedFile
+{
+public:
+    /// @brief 构造函数
+    LMappedFile();
+
+    /// @brief 析构函数
+    /// 解除映射并关闭文件
+    ~LMappedFile();
+
+    /// @brief 映射文件的一段区域
+    /// 已经映射的文件会先被关闭, offset不需要按页对齐
+    /// @param[in] fileName 文件名
+    /// @param[in] mode 映射方式
+    /// @param[in] offset 区域在文件中的起始位置(字节)
+    /// @param[in] size 区域大小(字节), 为0表示映射到文件末尾
+    /// @return 文件不存在, 区域超出文件大小或者映射失败返回false
+    bool Open(IN const wchar_t* fileName, IN LMAPPED_FILE_MODE mode, IN size_t offset = 0, IN size_t size = 0);
+
+    /// @brief 解除映射并关闭文件
+    void Close();
+
+    /// @brief 获取映射区域的首地址
+    /// @return 首地址, 未映射时返回0
+    void* Data() const;
+
+    /// @brief 获取映射区域的大小
+    /// @return 区域大小(字节)
+    size_t Size() const;
+
+    /// @brief 获取映射方式
+    /// @return 映射方式
+    LMAPPED_FILE_MODE Mode() const;
+
+    /// @brief 获取文件大小
+    /// 不映射文件, 用于在映射前检查文件
+    /// @param[in] fileName 文件名
+    /// @param[out] size 文件大小(字节)
+    /// @return 文件不存在返回false
+    static bool FileSize(IN const wchar_t* fileName, OUT unsigned long long& size);
+
+    /// @brief 获取文件的最后修改时间
+    /// 时间的单位和起点与系统相关, 只用于判断文件是否被修改过
+    /// @param[in] fileName 文件名
+    /// @param[out] time 最后修改时间
+    /// @return 文件不存在返回false
+    static bool FileTime(IN const wchar_t* fileName, OUT unsigned long long& time);
+
+private:
+    LMappedFile(const LMappedFile&);
+    LMappedFile& operator = (const LMappedFile&);
+
+private:
+    CMappedFile* m_pMappedFile; ///< 内存映射文件实现对象
+};
+
+#endif
@@ -9,6 +9,23 @@
 #ifndef _DATASTRUCT_LMATRIX_H_
 #define _DATASTRUCT_LMATRIX_H_
 
+#include <new>
+#include <utility>
+#include <cstddef>
+#include <vector>
+#include <atomic>
+
+#if defined(_MSC_VER)
+#include <malloc.h>
+#else
+#include <stdlib.h>
+#endif
+
+#include "LThreadPool.h"
+#include "LVectorKernel.h"
+#include "LMappedFile.h"
+#include "LMatrixArena.h"
+
 #ifndef LTEMPLATE
 #define LTEMPLATE template<typename Type>
 #endif
@@ -21,13 +38,909 @@
 #define INOUT
 #endif
 
-#ifndef OUT
-#define OUT
-#endif
+#ifndef OUT
+#define OUT
+#endif
+
+/// @brief 矩阵数据的对齐字节数
+/// 同时也是行填充的宽度, 64字节为一个缓存行, 也是AVX-512向量的宽度
+#ifndef LMATRIX_ALIGNMENT
+#define LMATRIX_ALIGNMENT 64
+#endif
+
+/// @brief 矩阵对象内部缓冲区的字节数
+/// 数据不超过该大小的小矩阵(如短的行向量和列向量)直接存储在矩阵对象中, 不分配堆内存
+/// 定义为0时所有矩阵数据都分配在堆上
+#ifndef LMATRIX_INLINE_SIZE
+#define LMATRIX_INLINE_SIZE 256
+#endif
+
+/// @brief 逐元素运算和转置的并行阈值(元素个数)
+/// 结果矩阵的元素个数不小于该值时, 按行划分后在全局线程池(LThreadPool::Global())中并行计算
+#ifndef LMATRIX_PARALLEL_SIZE
+#define LMATRIX_PARALLEL_SIZE (64 * 1024)
+#endif
+
+/// @brief 矩阵乘法的并行阈值(乘加次数m * n * k)
+#ifndef LMATRIX_PARALLEL_GEMM_SIZE
+#define LMATRIX_PARALLEL_GEMM_SIZE (128 * 128 * 128)
+#endif
+
+/// @brief 按需并行执行矩阵内核
+/// 运算量小于阈值时在当前线程中执行func(0, count), 否则在全局线程池中划分[0, count)并行执行
+/// @param[in] count 可划分的循环次数(通常为行数)
+/// @param[in] work 运算量
+/// @param[in] threshold 并行阈值
+/// @param[in] func 循环体, 形式为void(size_t begin, size_t end)
+template<typename Func>
+inline void LMatrixParallelFor(
+    IN size_t count, 
+    IN unsigned long long work, 
+    IN unsigned long long threshold, 
+    IN const Func& func)
+{
+    if (work < threshold)
+        func(0, count);
+    else
+        LThreadPool::Global().ParallelFor(count, func);
+}
+
+/// @brief 矩阵数据存储
+/// 矩阵数据为一块按LMATRIX_ALIGNMENT对齐的连续内存, 行优先存储,
+/// 每行的起始位置间隔行步长个元素, 行步长可能大于列数(行尾有填充元素)
+/// 小矩阵的数据存储在矩阵对象内部的缓冲区中(见LMATRIX_INLINE_SIZE), 只按std::max_align_t对齐
+/// 堆内存的头部存储引用计数, 多个矩阵可以共享同一块数据(写入时复制)
+/// 在LMatrixArenaScope的作用域中分配的数据来自内存池, 头部同时记录所在的内存块
+LTEMPLATE
+struct LMatrixStorage
+{
+    /// @brief 引用计数类型
+    typedef std::atomic<size_t> RefCount;
+
+    /// @brief 堆内存头部
+    struct Header
+    {
+        RefCount Count;                 ///< 引用计数
+        LMatrixArenaBlock* PBlock;      ///< 所在的内存池内存块, 为0表示直接分配的堆内存
+    };
+
+    /// @brief 堆内存头部的字节数, 向上对齐到对齐宽度, 使数据地址仍然是对齐的
+    static const size_t HEADER_SIZE = 
+        ((sizeof(Header) + LMATRIX_ALIGNMENT - 1) / LMATRIX_ALIGNMENT) * LMATRIX_ALIGNMENT;
+
+    /// @brief 一个对齐宽度中的元素个数, 元素大小不能整除对齐宽度时为1
+    static const size_t VECTOR_SIZE = 
+        (sizeof(Type) <= LMATRIX_ALIGNMENT && LMATRIX_ALIGNMENT % sizeof(Type) == 0) ? 
+        (size_t)(LMATRIX_ALIGNMENT / sizeof(Type)) : 1;
+
+    /// @brief 计算行步长
+    /// 列数不小于一个对齐宽度时, 行步长向上对齐到对齐宽度, 使每一行的起始地址都是对齐的
+    /// 列数较少的矩阵(如列向量)不填充, 避免浪费大量内存
+    /// @param[in] col 列数
+    /// @return 行步长(元素个数)
+    static size_t RowStride(IN size_t col)
+    {
+        if (col < VECTOR_SIZE)
+            return col;
+
+        return ((col + VECTOR_SIZE - 1) / VECTOR_SIZE) * VECTOR_SIZE;
+    }
+
+    /// @brief 分配对齐的内存, 引用计数初始化为1, 并默认构造每个元素
+    /// 当前线程在内存池作用域中时从内存池分配, 否则分配堆内存
+    /// 内存不足时抛出std::bad_alloc, 与new的行为一致
+    /// @param[in] count 元素个数
+    /// @return 数据地址
+    static Type* Allocate(IN size_t count)
+    {
+        if (count > ((size_t)-1 - HEADER_SIZE) / sizeof(Type))
+            throw std::bad_alloc();
+
+        size_t size = HEADER_SIZE + count * sizeof(Type);
+        void* pMemory = 0;
+        LMatrixArenaBlock* pBlock = 0;
+        LMatrixArena* pArena = LMatrixArena::Current();
+        if (pArena != 0)
+        {
+            pMemory = pArena->Allocate(size, LMATRIX_ALIGNMENT, pBlock);
+        }
+        else
+        {
+            LMatrixAllocationCounter().fetch_add(1, std::memory_order_relaxed);
+#if defined(_MSC_VER)
+            pMemory = _aligned_malloc(size, LMATRIX_ALIGNMENT);
+#else
+            if (posix_memalign(&pMemory, LMATRIX_ALIGNMENT, size) != 0)
+                pMemory = 0;
+#endif
+            if (pMemory == 0)
+                throw std::bad_alloc();
+        }
+
+        Header* pHeader = new (pMemory) Header;
+        pHeader->Count.store(1, std::memory_order_relaxed);
+        pHeader->PBlock = pBlock;
+        return Construct(static_cast<char*>(pMemory) + HEADER_SIZE, count);
+    }
+
+    /// @brief 获取堆内存数据的引用计数
+    /// @param[in] pData 数据地址(由Allocate分配)
+    /// @return 引用计数
+    static RefCount* Counter(IN Type* pData)
+    {
+        return &reinterpret_cast<Header*>(reinterpret_cast<char*>(pData) - HEADER_SIZE)->Count;
+    }
+
+    /// @brief 判断数据能否存储在矩阵对象内部的缓冲区中
+    /// @param[in] count 元素个数
+    /// @return true, false
+    static bool Inline(IN size_t count)
+    {
+        return alignof(Type) <= alignof(std::max_align_t) && count <= LMATRIX_INLINE_SIZE / sizeof(Type);
+    }
+
+    /// @brief 在已有的内存中默认构造每个元素
+    /// @param[in] pMemory 内存地址
+    /// @param[in] count 元素个数
+    /// @return 数据地址
+    static Type* Construct(IN void* pMemory, IN size_t count)
+    {
+        Type* pData = static_cast<Type*>(pMemory);
+        for (size_t i = 0; i < count; i++)
+            new (&pData[i]) Type;
+
+        return pData;
+    }
+
+    /// @brief 析构每个元素, 不释放内存
+    /// @param[in] pData 数据地址
+    /// @param[in] count 元素个数
+    static void Destroy(IN Type* pData, IN size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+            pData[i].~Type();
+    }
+
+    /// @brief 析构每个元素, 并释放内存(内存池中的内存只释放内存块的引用)
+    /// 不检查引用计数, 由调用者保证没有其他矩阵共享该数据
+    /// @param[in] pData 数据地址(由Allocate分配)
+    /// @param[in] count 元素个数
+    static void Free(IN Type* pData, IN size_t count)
+    {
+        if (pData == 0)
+            return;
+
+        Destroy(pData, count);
+
+        Header* pHeader = reinterpret_cast<Header*>(reinterpret_cast<char*>(pData) - HEADER_SIZE);
+        LMatrixArenaBlock* pBlock = pHeader->PBlock;
+        pHeader->~Header();
+        if (pBlock != 0)
+        {
+            LMatrixArena::Release(pBlock);
+            return;
+        }
+#if defined(_MSC_VER)
+        _aligned_free(pHeader);
+#else
+        free(pHeader);
+#endif
+    }
+};
+
+/// @brief 线程局部的临时缓冲区
+/// 矩阵乘法的打包缓冲区等每次调用都需要的临时内存, 每个线程为每个用途保留一个只增大不缩小的缓冲区,
+/// 稳定后的调用中没有malloc和free调用, 缓冲区在线程结束时释放
+/// 缓冲区增大时计入LMatrixAllocationCounter
+/// 注意: 同一线程中同一用途的缓冲区在使用期间不能被再次获取(不能重入)
+/// @param Type 元素类型
+/// @param Slot 用途编号, 同时使用的缓冲区需要不同的编号
+template<typename Type, int Slot>
+class LMatrixScratch
+{
+public:
+    /// @brief 获取当前线程的缓冲区
+    /// 缓冲区中的数据没有初始化, 内存不足时抛出std::bad_alloc
+    /// @param[in] count 需要的元素个数
+    /// @return 缓冲区地址
+    static Type* Get(IN size_t count)
+    {
+        static thread_local LMatrixScratch s_scratch;
+        if (s_scratch.m_capacity < count)
+        {
+            LMatrixAllocationCounter().fetch_add(1, std::memory_order_relaxed);
+            delete[] s_scratch.m_pData;
+            s_scratch.m_pData = 0;
+            s_scratch.m_capacity = 0;
+            s_scratch.m_pData = new Type[count];
+            s_scratch.m_capacity = count;
+        }
+
+        return s_scratch.m_pData;
+    }
+
+private:
+    LMatrixScratch()
+        : m_pData(0), m_capacity(0)
+    {
+    }
+
+    ~LMatrixScratch()
+    {
+        delete[] m_pData;
+    }
+
+    LMatrixScratch(const LMatrixScratch&);
+    LMatrixScratch& operator = (const LMatrixScratch&);
+
+private:
+    Type* m_pData; ///< 缓冲区
+    size_t m_capacity; ///< 缓冲区的元素个数
+};
+
+/// @brief 矩阵乘法内核, C = A * B
+/// A为m*k, B为k*n, C为m*n, A和B可以有任意的行步长和列步长(元素A[i][p]位于pA[i * rsA + p * csA]),
+/// C为行优先存储, 行步长为ldc
+/// 通用类型使用朴素的三重循环, float和double特化为分块打包的GEMM内核
+LTEMPLATE
+struct LMatrixGemm
+{
+    static void Run(
+        IN size_t m,
+        IN size_t n,
+        IN size_t k,
+        IN const Type* pA,
+        IN size_t rsA,
+        IN size_t csA,
+        IN const Type* pB,
+        IN size_t rsB,
+        IN size_t csB,
+        OUT Type* pC,
+        IN size_t ldc)
+    {
+        for (size_t i = 0; i < m; i++)
+        {
+            for (size_t j = 0; j < n; j++)
+            {
+                Type sum = pA[i * rsA] * pB[j * csB];
+                for (size_t p = 1; p < k; p++)
+                {
+                    sum += pA[i * rsA + p * csA] * pB[p * rsB + j * csB];
+                }
+                pC[i * ldc + j] = sum;
+            }
+        }
+    }
+};
+
+/// @brief 分块打包的GEMM内核
+/// 参考GotoBLAS的分块方式: B按KC*NC打包为NR宽的列条, A按MC*KC打包为MR高的行条,
+/// 微内核在寄存器中累加MR*NR的C块, 打包后的数据在内层循环中都是连续访问的
+/// 打包时按步长读取A和B, 所以转置视图和子矩阵视图不需要先复制为连续矩阵
+/// A和B的元素类型可以与Type不同(如半精度浮点数), 打包时转换为Type, 在Type中累加
+/// @param Type 元素类型
+/// @param MR 微内核行数
+/// @param NR 微内核列数, 应为SIMD宽度的倍数
+/// @param MC A块的行数(A块常驻L2)
+/// @param KC 分块的公共维度长度(B条常驻L1)
+/// @param NC B块的列数(B块常驻L3)
+template<typename Type, size_t MR, size_t NR, size_t MC, size_t KC, size_t NC>
+struct LMatrixBlockedGemm
+{
+    /// @brief 乘法运算量小于该值时不打包, 直接使用i-k-j顺序的循环
+    static const size_t SMALL_SIZE = 48 * 48 * 48;
+
+    /// @brief A块的行数和B块的列数, 供分块调用内核的代码使用
+    static const size_t BLOCK_ROW = MC;
+    static const size_t BLOCK_COLUMN = NC;
+
+    template<typename AType, typename BType>
+    static void Run(
+        IN size_t m,
+        IN size_t n,
+        IN size_t k,
+        IN const AType* pA,
+        IN size_t rsA,
+        IN size_t csA,
+        IN const BType* pB,
+        IN size_t rsB,
+        IN size_t csB,
+        OUT Type* pC,
+        IN size_t ldc)
+    {
+        for (size_t i = 0; i < m; i++)
+        {
+            for (size_t j = 0; j < n; j++)
+                pC[i * ldc + j] = Type(0);
+        }
+
+        if ((unsigned long long)m * n * k < SMALL_SIZE)
+        {
+            RunSmall(m, n, k, pA, rsA, csA, pB, rsB, csB, pC, ldc);
+            return;
+        }
+
+        // 打包缓冲区的行(列)数向上对齐到MR(NR), 以容纳补0的边缘行条(列条)
+        // 缓冲区按实际的块大小获取, 使用线程局部的缓冲区, 稳定后不再分配内存
+        const size_t mcMax = m < MC ? m : MC;
+        const size_t ncMax = n < NC ? n : NC;
+        const size_t kcMax = k < KC ? k : KC;
+        Type* pBufferA = LMatrixScratch<Type, 0>::Get(((mcMax + MR - 1) / MR) * MR * kcMax);
+        Type* pBufferB = LMatrixScratch<Type, 1>::Get(((ncMax + NR - 1) / NR) * NR * kcMax);
+
+        for (size_t jc = 0; jc < n; jc += NC)
+        {
+            size_t nc = (n - jc) < NC ? (n - jc) : NC;
+            for (size_t pc = 0; pc < k; pc += KC)
+            {
+                size_t kc = (k - pc) < KC ? (k - pc) : KC;
+                PackB(kc, nc, &pB[pc * rsB + jc * csB], rsB, csB, pBufferB);
+
+                for (size_t ic = 0; ic < m; ic += MC)
+                {
+                    size_t mc = (m - ic) < MC ? (m - ic) : MC;
+                    PackA(mc, kc, &pA[ic * rsA + pc * csA], rsA, csA, pBufferA);
+
+                    for (size_t jr = 0; jr < nc; jr += NR)
+                    {
+                        size_t nr = (nc - jr) < NR ? (nc - jr) : NR;
+                        for (size_t ir = 0; ir < mc; ir += MR)
+                        {
+                            size_t mr = (mc - ir) < MR ? (mc - ir) : MR;
+                            MicroKernel(
+                                kc, 
+                                &pBufferA[ir * kc], 
+                                &pBufferB[jr * kc], 
+                                &pC[(ic + ir) * ldc + jc + jr], 
+                                ldc, 
+                                mr, 
+                                nr);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    /// @brief 小矩阵乘法, 使用i-k-j顺序使B和C按行连续访问
+    /// A的行和B的列都是连续的时(如A * B.T()), 使用i-j-k顺序, 每个元素为两个连续向量的内积
+    template<typename AType, typename BType>
+    static void RunSmall(
+        IN size_t m,
+        IN size_t n,
+        IN size_t k,
+        IN const AType* pA,
+        IN size_t rsA,
+        IN size_t csA,
+        IN const BType* pB,
+        IN size_t rsB,
+        IN size_t csB,
+        OUT Type* pC,
+        IN size_t ldc)
+    {
+        if (csA == 1 && rsB == 1 && csB != 1)
+        {
+            for (size_t i = 0; i < m; i++)
+            {
+                const AType* pARow = &pA[i * rsA];
+                for (size_t j = 0; j < n; j++)
+                {
+                    const BType* pBColumn = &pB[j * csB];
+                    Type sum = Type(0);
+                    for (size_t p = 0; p < k; p++)
+                        sum += Type(pARow[p]) * Type(pBColumn[p]);
+                    pC[i * ldc + j] = sum;
+                }
+            }
+            return;
+        }
+
+        for (size_t i = 0; i < m; i++)
+        {
+            Type* pCRow = &pC[i * ldc];
+            for (size_t p = 0; p < k; p++)
+            {
+                const Type a = Type(pA[i * rsA + p * csA]);
+                const BType* pBRow = &pB[p * rsB];
+                if (csB == 1)
+                {
+                    for (size_t j = 0; j < n; j++)
+                        pCRow[j] += a * Type(pBRow[j]);
+                }
+                else
+                {
+                    for (size_t j = 0; j < n; j++)
+                        pCRow[j] += a * Type(pBRow[j * csB]);
+                }
+            }
+        }
+    }
+
+    /// @brief 将A中mc*kc的块打包为MR高的行条, 每个行条内按列优先存储, 不足MR的行补0
+    template<typename AType>
+    static void PackA(
+        IN size_t mc, 
+        IN size_t kc, 
+        IN const AType* pA, 
+        IN size_t rsA, 
+        IN size_t csA, 
+        OUT Type* pBuffer)
+    {
+        for (size_t i = 0; i < mc; i += MR)
+        {
+            size_t mr = (mc - i) < MR ? (mc - i) : MR;
+            for (size_t p = 0; p < kc; p++)
+            {
+                for (size_t r = 0; r < mr; r++)
+                    pBuffer[r] = Type(pA[(i + r) * rsA + p * csA]);
+                for (size_t r = mr; r < MR; r++)
+                    pBuffer[r] = Type(0);
+
+                pBuffer += MR;
+            }
+        }
+    }
+
+    /// @brief 将B中kc*nc的块打包为NR宽的列条, 每个列条内按行优先存储, 不足NR的列补0
+    template<typename BType>
+    static void PackB(
+        IN size_t kc, 
+        IN size_t nc, 
+        IN const BType* pB, 
+        IN size_t rsB, 
+        IN size_t csB, 
+        OUT Type* pBuffer)
+    {
+        for (size_t j = 0; j < nc; j += NR)
+        {
+            size_t nr = (nc - j) < NR ? (nc - j) : NR;
+            for (size_t p = 0; p < kc; p++)
+            {
+                const BType* pBRow = &pB[p * rsB + j * csB];
+                if (csB == 1)
+                {
+                    for (size_t c = 0; c < nr; c++)
+                        pBuffer[c] = Type(pBRow[c]);
+                }
+                else
+                {
+                    for (size_t c = 0; c < nr; c++)
+                        pBuffer[c] = Type(pBRow[c * csB]);
+                }
+                for (size_t c = nr; c < NR; c++)
+                    pBuffer[c] = Type(0);
+
+                pBuffer += NR;
+            }
+        }
+    }
+
+    /// @brief 微内核, 在寄存器中累加MR*NR的结果块, 最后只写回有效的mr*nr部分
+    static void MicroKernel(
+        IN size_t kc,
+        IN const Type* pA,
+        IN const Type* pB,
+        INOUT Type* pC,
+        IN size_t ldc,
+        IN size_t mr,
+        IN size_t nr)
+    {
+        Type ab[MR][NR];
+        for (size_t i = 0; i < MR; i++)
+        {
+            for (size_t j = 0; j < NR; j++)
+                ab[i][j] = Type(0);
+        }
+
+        for (size_t p = 0; p < kc; p++)
+        {
+            for (size_t i = 0; i < MR; i++)
+            {
+                const Type a = pA[i];
+                for (size_t j = 0; j < NR; j++)
+                    ab[i][j] += a * pB[j];
+            }
+
+            pA += MR;
+            pB += NR;
+        }
+
+        for (size_t i = 0; i < mr; i++)
+        {
+            for (size_t j = 0; j < nr; j++)
+                pC[i * ldc + j] += ab[i][j];
+        }
+    }
+};
+
+/// @brief float矩阵乘法内核
+template<>
+struct LMatrixGemm<float> : public LMatrixBlockedGemm<float, 6, 32, 96, 256, 4096>
+{
+};
+
+/// @brief double矩阵乘法内核
+template<>
+struct LMatrixGemm<double> : public LMatrixBlockedGemm<double, 6, 32, 96, 256, 2048>
+{
+};
+
+LTEMPLATE
+class LMatrix;
+
+LTEMPLATE
+class LMatrixView;
+
+template<typename Type, typename Op, typename E>
+class LMatrixScalarExpr;
+
+/// @brief 连续存储的行上的向量运算
+/// float和double使用运行时按CPU特性选择的SIMD内核(见LVectorKernel), 其他类型逐个元素计算
+LTEMPLATE
+struct LMatrixRowKernel : public LVectorKernelImpl<LVectorScalar<Type> >
+{
+};
+
+template<>
+struct LMatrixRowKernel<float> : public LVectorKernel<float>
+{
+};
+
+template<>
+struct LMatrixRowKernel<double> : public LVectorKernel<double>
+{
+};
+
+/// @brief 逐元素加法运算
+LTEMPLATE
+struct LMatrixOpAdd
+{
+    static Type Apply(IN const Type& a, IN const Type& b) { return a + b; }
+    static void ApplyRow(IN size_t n, IN const Type* pA, IN const Type* pB, OUT Type* pC) { LMatrixRowKernel<Type>::Add(n, pA, pB, pC); }
+    static void ApplyRow(IN size_t n, IN const Type* pA, IN const Type& b, OUT Type* pC) { LMatrixRowKernel<Type>::AddScalar(n, b, pA, pC); }
+};
+
+/// @brief 逐元素减法运算
+LTEMPLATE
+struct LMatrixOpSub
+{
+    static Type Apply(IN const Type& a, IN const Type& b) { return a - b; }
+    static void ApplyRow(IN size_t n, IN const Type* pA, IN const Type* pB, OUT Type* pC) { LMatrixRowKernel<Type>::Sub(n, pA, pB, pC); }
+    static void ApplyRow(IN size_t n, IN const Type* pA, IN const Type& b, OUT Type* pC)
+    {
+        for (size_t j = 0; j < n; j++)
+            pC[j] = pA[j] - b;
+    }
+};
+
+/// @brief 逐元素乘法运算
+LTEMPLATE
+struct LMatrixOpMul
+{
+    static Type Apply(IN const Type& a, IN const Type& b) { return a * b; }
+    static void ApplyRow(IN size_t n, IN const Type* pA, IN const Type* pB, OUT Type* pC) { LMatrixRowKernel<Type>::Mul(n, pA, pB, pC); }
+    static void ApplyRow(IN size_t n, IN const Type* pA, IN const Type& b, OUT Type* pC) { LMatrixRowKernel<Type>::Scale(n, b, pA, pC); }
+};
+
+/// @brief 逐元素除法运算
+LTEMPLATE
+struct LMatrixOpDiv
+{
+    static Type Apply(IN const Type& a, IN const Type& b) { return a / b; }
+    static void ApplyRow(IN size_t n, IN const Type* pA, IN const Type* pB, OUT Type* pC) { LMatrixRowKernel<Type>::Div(n, pA, pB, pC); }
+    static void ApplyRow(IN size_t n, IN const Type* pA, IN const Type& b, OUT Type* pC) { LMatrixRowKernel<Type>::DivScalar(n, b, pA, pC); }
+};
+
+/// @brief 求和归约
+/// Reduce(n, pX): 归约一行, Merge(n, pX, pY): 逐元素合并到pY中(用于按列归约)
+LTEMPLATE
+struct LMatrixReduceSum
+{
+    typedef Type Result;
+    static Result Reduce(IN size_t n, IN const Type* pX) { return LMatrixRowKernel<Type>::Sum(n, pX); }
+    static void Merge(IN size_t n, IN const Type* pX, INOUT Type* pY) { LMatrixRowKernel<Type>::Add(n, pX, pY, pY); }
+};
+
+/// @brief 最大值归约
+LTEMPLATE
+struct LMatrixReduceMax
+{
+    typedef Type Result;
+    static Result Reduce(IN size_t n, IN const Type* pX) { return LMatrixRowKernel<Type>::Max(n, pX); }
+    static void Merge(IN size_t n, IN const Type* pX, INOUT Type* pY) { LMatrixRowKernel<Type>::Maximum(n, pX, pY, pY); }
+};
+
+/// @brief 最小值归约
+LTEMPLATE
+struct LMatrixReduceMin
+{
+    typedef Type Result;
+    static Result Reduce(IN size_t n, IN const Type* pX) { return LMatrixRowKernel<Type>::Min(n, pX); }
+    static void Merge(IN size_t n, IN const Type* pX, INOUT Type* pY) { LMatrixRowKernel<Type>::Minimum(n, pX, pY, pY); }
+};
+
+/// @brief 最大值索引归约, 只支持按行归约
+LTEMPLATE
+struct LMatrixReduceArgMax
+{
+    typedef size_t Result;
+    static Result Reduce(IN size_t n, IN const Type* pX) { return LMatrixRowKernel<Type>::ArgMax(n, pX); }
+};
+
+/// @brief 矩阵表达式基类
+/// 矩阵的逐元素运算(+, -, ScalarMul, ScalarDiv)不立即计算, 而是构造表达式对象,
+/// 表达式赋值给LMatrix时在一个循环中直接写入目标矩阵, 不产生中间矩阵
+/// 注意: 表达式中只保存矩阵的引用, 请在同一语句中将表达式赋值给LMatrix, 不要保存表达式对象
+/// 每个表达式类型需要提供以下接口:
+/// RowLen(): 结果行数, ColumnLen(): 结果列数, Valid(): 操作数的大小是否匹配,
+/// Value(row, col): 结果矩阵中指定位置的值,
+/// Overlap(pBegin, pEnd): 逐元素写入[pBegin, pEnd)时读取操作数是否不安全(操作数的数据与之重叠)
+/// @param Type 元素类型
+/// @param E 实际的表达式类型(LMatrix, LMatrixView或者表达式结点)
+template<typename Type, typename E>
+class LMatrixExpr
+{
+public:
+    /// @brief 获取实际的表达式对象
+    const E& Self() const
+    {
+        return static_cast<const E&>(*this);
+    }
+
+    /// @brief 矩阵数乘
+    /// @param[in] B 乘数
+    /// @return 结果表达式
+    LMatrixScalarExpr<Type, LMatrixOpMul<Type>, E> ScalarMul(IN const Type& B) const;
+
+    /// @brief 矩阵数除
+    /// @param[in] B 除数
+    /// @return 结果表达式
+    LMatrixScalarExpr<Type, LMatrixOpDiv<Type>, E> ScalarDiv(IN const Type& B) const;
+};
+
+/// @brief 判断两个数据区间[pBegin1, pEnd1)和[pBegin2, pEnd2)是否重叠
+LTEMPLATE
+inline bool LMatrixDataOverlap(IN const Type* pBegin1, IN const Type* pEnd1, IN const Type* pBegin2, IN const Type* pEnd2)
+{
+    return pBegin1 < pEnd1 && pBegin2 < pEnd2 && pBegin1 < pEnd2 && pBegin2 < pEnd1;
+}
+
+/// @brief 表达式叶子结点, 引用一个LMatrix中的数据
+LTEMPLATE
+class LMatrixExprLeaf
+{
+public:
+    explicit LMatrixExprLeaf(IN const LMatrix<Type>& m)
+        : m_pDataList(m.m_dataList), m_rowLen(m.m_rowLen), m_columnLen(m.m_columnLen), m_rowStride(m.m_rowStride)
+    {
+    }
+
+    size_t RowLen() const { return m_rowLen; }
+    size_t ColumnLen() const { return m_columnLen; }
+    bool Valid() const { return true; }
+    Type Value(IN size_t row, IN size_t col) const { return m_pDataList[row * m_rowStride + col]; }
+
+    /// 表达式都是逐元素运算, 数据起始位置相同的矩阵(自身或者共享数据的矩阵)与结果大小相同, 读写同一位置, 是安全的
+    bool Overlap(IN const Type* pBegin, IN const Type* pEnd) const
+    {
+        return m_pDataList != pBegin && 
+            LMatrixDataOverlap<Type>(m_pDataList, m_pDataList + m_rowLen * m_rowStride, pBegin, pEnd);
+    }
+
+private:
+    const Type* m_pDataList;
+    size_t m_rowLen;
+    size_t m_columnLen;
+    size_t m_rowStride;
+};
+
+/// @brief 表达式叶子结点, 引用一个LMatrixView中的数据(按步长访问)
+LTEMPLATE
+class LMatrixViewLeaf
+{
+public:
+    explicit LMatrixViewLeaf(IN const LMatrixView<Type>& v)
+        : m_pData(v.m_pData), 
+        m_rowLen(v.m_rowLen), 
+        m_columnLen(v.m_columnLen), 
+        m_rowStride(v.m_rowStride), 
+        m_columnStride(v.m_columnStride)
+    {
+    }
+
+    size_t RowLen() const { return m_rowLen; }
+    size_t ColumnLen() const { return m_columnLen; }
+    bool Valid() const { return true; }
+    Type Value(IN size_t row, IN size_t col) const { return m_pData[row * m_rowStride + col * m_columnStride]; }
+
+    /// 视图的位置与结果不对应(如子矩阵, 转置), 数据重叠时都是不安全的
+    bool Overlap(IN const Type* pBegin, IN const Type* pEnd) const
+    {
+        if (m_rowLen == 0 || m_columnLen == 0)
+            return false;
+
+        const Type* pLast = m_pData + (m_rowLen - 1) * m_rowStride + (m_columnLen - 1) * m_columnStride;
+        return LMatrixDataOverlap<Type>(m_pData, pLast + 1, pBegin, pEnd);
+    }
+
+private:
+    const Type* m_pData;
+    size_t m_rowLen;
+    size_t m_columnLen;
+    size_t m_rowStride;
+    size_t m_columnStride;
+};
+
+/// @brief 表达式结点中操作数的存储方式
+/// LMatrix和LMatrixView以叶子结点保存(引用), 其他表达式结点按值保存
+template<typename Type, typename E>
+struct LMatrixExprOperand
+{
+    typedef E Node;
+};
+
+template<typename Type>
+struct LMatrixExprOperand<Type, LMatrix<Type> >
+{
+    typedef LMatrixExprLeaf<Type> Node;
+};
+
+template<typename Type>
+struct LMatrixExprOperand<Type, LMatrixView<Type> >
+{
+    typedef LMatrixViewLeaf<Type> Node;
+};
+
+/// @brief 表达式求值后的矩阵类型
+/// LMatrix和LMatrixView不需要求值, 直接使用其引用, 其他表达式求值为一个临时矩阵
+template<typename Type, typename E>
+struct LMatrixExprResult
+{
+    typedef LMatrix<Type> Matrix;
+};
+
+template<typename Type>
+struct LMatrixExprResult<Type, LMatrix<Type> >
+{
+    typedef const LMatrix<Type>& Matrix;
+};
+
+template<typename Type>
+struct LMatrixExprResult<Type, LMatrixView<Type> >
+{
+    typedef const LMatrixView<Type>& Matrix;
+};
+
+/// @brief 二元逐元素运算表达式
+template<typename Type, typename Op, typename L, typename R>
+class LMatrixBinaryExpr : public LMatrixExpr<Type, LMatrixBinaryExpr<Type, Op, L, R> >
+{
+public:
+    LMatrixBinaryExpr(IN const L& lhs, IN const R& rhs)
+        : m_lhs(lhs), m_rhs(rhs)
+    {
+    }
+
+    size_t RowLen() const { return m_lhs.RowLen(); }
+    size_t ColumnLen() const { return m_lhs.ColumnLen(); }
+
+    bool Valid() const
+    {
+        return m_lhs.Valid() && m_rhs.Valid() &&
+            m_lhs.RowLen() == m_rhs.RowLen() &&
+            m_lhs.ColumnLen() == m_rhs.ColumnLen();
+    }
+
+    Type Value(IN size_t row, IN size_t col) const
+    {
+        return Op::Apply(m_lhs.Value(row, col), m_rhs.Value(row, col));
+    }
+
+    bool Overlap(IN const Type* pBegin, IN const Type* pEnd) const
+    {
+        return m_lhs.Overlap(pBegin, pEnd) || m_rhs.Overlap(pBegin, pEnd);
+    }
+
+private:
+    typename LMatrixExprOperand<Type, L>::Node m_lhs; ///< 左操作数
+    typename LMatrixExprOperand<Type, R>::Node m_rhs; ///< 右操作数
+};
+
+/// @brief 矩阵与标量的逐元素运算表达式
+template<typename Type, typename Op, typename E>
+class LMatrixScalarExpr : public LMatrixExpr<Type, LMatrixScalarExpr<Type, Op, E> >
+{
+public:
+    LMatrixScalarExpr(IN const E& lhs, IN const Type& scalar)
+        : m_lhs(lhs), m_scalar(scalar)
+    {
+    }
+
+    size_t RowLen() const { return m_lhs.RowLen(); }
+    size_t ColumnLen() const { return m_lhs.ColumnLen(); }
+    bool Valid() const { return m_lhs.Valid(); }
+
+    Type Value(IN size_t row, IN size_t col) const
+    {
+        return Op::Apply(m_lhs.Value(row, col), m_scalar);
+    }
+
+    bool Overlap(IN const Type* pBegin, IN const Type* pEnd) const
+    {
+        return m_lhs.Overlap(pBegin, pEnd);
+    }
+
+private:
+    typename LMatrixExprOperand<Type, E>::Node m_lhs; ///< 矩阵操作数
+    Type m_scalar; ///< 标量操作数
+};
+
+template<typename Type, typename E>
+LMatrixScalarExpr<Type, LMatrixOpMul<Type>, E> LMatrixExpr<Type, E>::ScalarMul(IN const Type& B) const
+{
+    return LMatrixScalarExpr<Type, LMatrixOpMul<Type>, E>(this->Self(), B);
+}
+
+template<typename Type, typename E>
+LMatrixScalarExpr<Type, LMatrixOpDiv<Type>, E> LMatrixExpr<Type, E>::ScalarDiv(IN const Type& B) const
+{
+    return LMatrixScalarExpr<Type, LMatrixOpDiv<Type>, E>(this->Self(), B);
+}
+
+/// @brief 矩阵加法
+/// 要求矩阵A的大小等于矩阵B的大小, 否则求值结果为空矩阵
+/// @param[in] A 被加数
+/// @param[in] B 加数
+/// @return 结果表达式
+template<typename Type, typename L, typename R>
+LMatrixBinaryExpr<Type, LMatrixOpAdd<Type>, L, R> operator + (IN const LMatrixExpr<Type, L>& A, IN const LMatrixExpr<Type, R>& B)
+{
+    return LMatrixBinaryExpr<Type, LMatrixOpAdd<Type>, L, R>(A.Self(), B.Self());
+}
+
+/// @brief 矩阵减法
+/// 要求矩阵A的大小等于矩阵B的大小, 否则求值结果为空矩阵
+/// @param[in] A 被减数
+/// @param[in] B 减数
+/// @return 结果表达式
+template<typename Type, typename L, typename R>
+LMatrixBinaryExpr<Type, LMatrixOpSub<Type>, L, R> operator - (IN const LMatrixExpr<Type, L>& A, IN const LMatrixExpr<Type, R>& B)
+{
+    return LMatrixBinaryExpr<Type, LMatrixOpSub<Type>, L, R>(A.Self(), B.Self());
+}
+
+/// @brief 矩阵乘法
+/// 矩阵乘法不是逐元素运算, 所以立即计算, 作为表达式的操作数时先求值
+/// 要求矩阵A的列数等于矩阵B的行数, 否则结果为空矩阵
+/// @param[in] A 被乘数
+/// @param[in] B 乘数
+/// @return 结果矩阵
+template<typename Type, typename L, typename R>
+LMatrix<Type> operator * (IN const LMatrixExpr<Type, L>& A, IN const LMatrixExpr<Type, R>& B)
+{
+    typename LMatrixExprResult<Type, L>::Matrix a = A.Self();
+    typename LMatrixExprResult<Type, R>::Matrix b = B.Self();
+
+    LMatrix<Type> C;
+    LMatrix<Type>::MUL(a, b, C);
+    return C;
+}
 
 /// @brief 矩阵
+/// 所有矩阵运算的输入参数都是LMatrixView, LMatrix可以隐式转换为视图, 
+/// 所以运算既可以直接作用于矩阵, 也可以作用于子矩阵, 行, 列以及转置视图
+/// 矩阵数据存储在一块按LMATRIX_ALIGNMENT对齐的内存中, 每行的起始地址间隔行步长个元素(见LMatrixStorage),
+/// 元素[row][col]位于m_dataList[row * m_rowStride + col], 不需要行指针表
+/// 数据不超过LMATRIX_INLINE_SIZE字节的小矩阵存储在对象内部的缓冲区中, Reset不分配堆内存,
+/// 移动这样的矩阵会复制元素, 所以引用被移动矩阵的视图失效
+/// 堆内存中的数据在拷贝构造和赋值时共享(引用计数), 第一次通过非const接口写入时才复制(写入时复制),
+/// 所以模型可以廉价地持有训练数据的副本; 只读访问应通过const引用, 避免不必要的复制
+/// 注意: 通过非const的[]获取的行地址只在下一次拷贝或者赋值该矩阵之前可用于写入
+/// 矩阵数据也可以存储在映射的二进制文件中(见Map), 用于处理大于物理内存的数据集
+/// 运算量超过阈值的运算(见LMATRIX_PARALLEL_SIZE和LMATRIX_PARALLEL_GEMM_SIZE)在全局线程池中并行执行
 LTEMPLATE
-class LMatrix
+class LMatrix : public LMatrixExpr<Type, LMatrix<Type> >
 {
 public:
     /// @brief 矩阵加法
@@ -36,7 +949,7 @@ public:
     /// @param[in] B 加数
     /// @param[out] C 结果矩阵
     /// @return 参数错误返回false
-    static bool ADD(IN const LMatrix<Type>& A, IN const LMatrix<Type>& B, OUT LMatrix<Type>& C);
+    static bool ADD(IN const LMatrixView<Type>& A, IN const LMatrixView<Type>& B, OUT LMatrix<Type>& C);
 
     /// @brief 矩阵减法
     /// 要求矩阵A的大小等于矩阵B的大小
@@ -44,23 +957,44 @@ public:
     /// @param[in] B 减数
     /// @param[out] C 结果矩阵
     /// @return 参数错误返回false
-    static bool SUB(IN const LMatrix<Type>& A, IN const LMatrix<Type>& B, OUT LMatrix<Type>& C);
+    static bool SUB(IN const LMatrixView<Type>& A, IN const LMatrixView<Type>& B, OUT LMatrix<Type>& C);
 
     /// @brief 矩阵乘法
     /// 要求矩阵A的列数等于矩阵B的行数
+    /// float和double矩阵使用分块打包的GEMM内核(见LMatrixGemm), 其他类型使用朴素的三重循环
     /// 注意: 该操作会改变矩阵的结构, 所以C不能和A或B是相同矩阵的引用
     /// @param[in] A 被乘数
     /// @param[in] B 乘数
     /// @param[out] C 结果矩阵
     /// @return 参数错误返回false
-    static bool MUL(IN const LMatrix<Type>& A, IN const LMatrix<Type>& B, OUT LMatrix<Type>& C);
+    static bool MUL(IN const LMatrixView<Type>& A, IN const LMatrixView<Type>& B, OUT LMatrix<Type>& C);
+
+    /// @brief 矩阵转置乘法, C = A.T() * B
+    /// 要求矩阵A的行数等于矩阵B的行数
+    /// GEMM内核按步长直接读取A, 不生成A的转置矩阵
+    /// 注意: 该操作会改变矩阵的结构, 所以C不能和A或B是相同矩阵的引用
+    /// @param[in] A 被乘数(转置前)
+    /// @param[in] B 乘数
+    /// @param[out] C 结果矩阵
+    /// @return 参数错误返回false
+    static bool MUL_AT_B(IN const LMatrixView<Type>& A, IN const LMatrixView<Type>& B, OUT LMatrix<Type>& C);
+
+    /// @brief 矩阵乘转置, C = A * B.T()
+    /// 要求矩阵A的列数等于矩阵B的列数
+    /// GEMM内核按步长直接读取B, 不生成B的转置矩阵, 小矩阵时每个元素为A的行和B的行的内积
+    /// 注意: 该操作会改变矩阵的结构, 所以C不能和A或B是相同矩阵的引用
+    /// @param[in] A 被乘数
+    /// @param[in] B 乘数(转置前)
+    /// @param[out] C 结果矩阵
+    /// @return 参数错误返回false
+    static bool MUL_A_BT(IN const LMatrixView<Type>& A, IN const LMatrixView<Type>& B, OUT LMatrix<Type>& C);
 
     /// @brief 矩阵数乘
     /// @param[in] A 被乘数
     /// @param[in] B 乘数
     /// @param[out] C 结果矩阵
     /// @return 返回true
-    static bool SCALARMUL(IN const LMatrix<Type>& A, IN const Type& B, OUT LMatrix<Type>& C);
+    static bool SCALARMUL(IN const LMatrixView<Type>& A, IN const Type& B, OUT LMatrix<Type>& C);
 
     /// @brief 矩阵点乘
     /// 要求矩阵A的大小等于矩阵B的大小
@@ -68,14 +1002,14 @@ public:
     /// @param[in] B 乘数
     /// @param[out] C 结果矩阵
     /// @return 参数错误返回false
-    static bool DOTMUL(IN const LMatrix<Type>& A, IN const LMatrix<Type>& B, OUT LMatrix<Type>& C);
+    static bool DOTMUL(IN const LMatrixView<Type>& A, IN const LMatrixView<Type>& B, OUT LMatrix<Type>& C);
 
     /// @brief 矩阵数除
     /// @param[in] A 被除数
     /// @param[in] B 除数
     /// @param[out] C 结果矩阵
     /// @return 返回true
-    static bool SCALARDIV(IN const LMatrix<Type>& A, IN const Type& B, OUT LMatrix<Type>& C);
+    static bool SCALARDIV(IN const LMatrixView<Type>& A, IN const Type& B, OUT LMatrix<Type>& C);
 
     /// @brief 矩阵点除
     /// 要求矩阵A的大小等于矩阵B的大小
@@ -83,14 +1017,14 @@ public:
     /// @param[in] B 除数
     /// @param[out] C 结果矩阵
     /// @return 参数错误返回false
-    static bool DOTDIV(IN const LMatrix<Type>& A, IN const LMatrix<Type>& B, OUT LMatrix<Type>& C);
+    static bool DOTDIV(IN const LMatrixView<Type>& A, IN const LMatrixView<Type>& B, OUT LMatrix<Type>& C);
 
     /// @brief 矩阵转置
     /// 注意: 该操作会改变矩阵的结构, 所以B不能和A是相同矩阵的引用
     /// @param[in] A 需要转置的矩阵
     /// @param[out] B 转置后的结果矩阵
     /// @return 返回true
-    static bool T(IN const LMatrix<Type>& A, OUT LMatrix<Type>& B);
+    static bool T(IN const LMatrixView<Type>& A, OUT LMatrix<Type>& B);
 
     /// @brief 子矩阵
     /// 该操作只能取得连续的子矩阵
@@ -103,13 +1037,55 @@ public:
     /// @param[out] D 存储子矩阵
     /// @return 参数错误返回false
     static bool SUBMATRIX(
-        IN const LMatrix<Type>& S, 
-        IN unsigned int rowStart, 
-        IN unsigned int rowLen, 
-        IN unsigned int colStart, 
-        IN unsigned int colLen, 
+        IN const LMatrixView<Type>& S, 
+        IN size_t rowStart, 
+        IN size_t rowLen, 
+        IN size_t colStart, 
+        IN size_t colLen, 
         OUT LMatrix<Type>& D);
 
+    /// @brief 按行求和, B[i][0] = sum(A[i][*])
+    /// @param[in] A 源矩阵
+    /// @param[out] B 结果列向量(A.RowLen * 1)
+    /// @return 返回true
+    static bool ROWSUM(IN const LMatrixView<Type>& A, OUT LMatrix<Type>& B);
+
+    /// @brief 按列求和, B[0][j] = sum(A[*][j])
+    /// @param[in] A 源矩阵
+    /// @param[out] B 结果行向量(1 * A.ColumnLen)
+    /// @return 返回true
+    static bool COLUMNSUM(IN const LMatrixView<Type>& A, OUT LMatrix<Type>& B);
+
+    /// @brief 按行求最大值, B[i][0] = max(A[i][*])
+    /// @param[in] A 源矩阵
+    /// @param[out] B 结果列向量(A.RowLen * 1)
+    /// @return A的列数为0返回false
+    static bool ROWMAX(IN const LMatrixView<Type>& A, OUT LMatrix<Type>& B);
+
+    /// @brief 按行求最小值, B[i][0] = min(A[i][*])
+    /// @param[in] A 源矩阵
+    /// @param[out] B 结果列向量(A.RowLen * 1)
+    /// @return A的列数为0返回false
+    static bool ROWMIN(IN const LMatrixView<Type>& A, OUT LMatrix<Type>& B);
+
+    /// @brief 按列求最大值, B[0][j] = max(A[*][j])
+    /// @param[in] A 源矩阵
+    /// @param[out] B 结果行向量(1 * A.ColumnLen)
+    /// @return A的行数为0返回false
+    static bool COLUMNMAX(IN const LMatrixView<Type>& A, OUT LMatrix<Type>& B);
+
+    /// @brief 按列求最小值, B[0][j] = min(A[*][j])
+    /// @param[in] A 源矩阵
+    /// @param[out] B 结果行向量(1 * A.ColumnLen)
+    /// @return A的行数为0返回false
+    static bool COLUMNMIN(IN const LMatrixView<Type>& A, OUT LMatrix<Type>& B);
+
+    /// @brief 按行求最大值的列索引, 有多个最大值时取第一个
+    /// @param[in] A 源矩阵
+    /// @param[out] B 结果列向量(A.RowLen * 1)
+    /// @return A的列数为0返回false
+    static bool ROWARGMAX(IN const LMatrixView<Type>& A, OUT LMatrix<size_t>& B);
+
 public:
     /// @brief 默认构造函数
     /// 默认矩阵长度为0, 即没有数据可被访问
@@ -122,630 +1098,1406 @@ public:
     /// 如果row或col中任一项为0, 则矩阵行数和列数都为0
     /// @param[in] row 矩阵行大小
     /// @param[in] col 矩阵列大小
-    LMatrix(IN unsigned int row, IN unsigned int col);
+    LMatrix(IN size_t row, IN size_t col);
 
     /// @brief 构造函数, 构造矩阵, 并使用指定数据初始化矩阵
     /// 如果row或col中任一项为0, 则矩阵行数和列数都为0
     /// @param[in] row 矩阵行大小
     /// @param[in] col 矩阵列大小
     /// @param[in] initValue 初始化数据
-    LMatrix(IN unsigned int row, IN unsigned int col, IN const Type& initValue);
+    LMatrix(IN size_t row, IN size_t col, IN const Type& initValue);
 
     /// @brief 构造函数, 构造矩阵, 并使用数组数据初始化矩阵
     /// 如果row或col中任一项为0, 则矩阵行数和列数都为0
     /// @param[in] row 矩阵行大小
     /// @param[in] col 矩阵列大小
     /// @param[in] pDataList 矩阵数据
-    LMatrix(IN unsigned int row, IN unsigned int col, IN const Type* pDataList);
+    LMatrix(IN size_t row, IN size_t col, IN const Type* pDataList);
+
+    /// @brief 拷贝构造函数
+    /// 堆内存中的数据被共享, 不复制
+    LMatrix(IN const LMatrix<Type>& rhs);
+
+    /// @brief 移动构造函数
+    /// 接管rhs的数据, rhs变为空矩阵
+    LMatrix(INOUT LMatrix<Type>&& rhs);
+
+    /// @brief 构造函数, 使用表达式的求值结果初始化矩阵
+    /// 表达式的操作数大小不匹配时矩阵为空
+    /// @param[in] expr 矩阵表达式
+    template<typename E>
+    LMatrix(IN const LMatrixExpr<Type, E>& expr);
+
+    /// @brief 赋值操作符
+    /// 堆内存中的数据被共享, 不复制; 自身为可写的映射矩阵时数据被复制到映射文件中
+    LMatrix<Type>& operator = (IN const LMatrix<Type>& rhs);
+
+    /// @brief 移动赋值操作符
+    /// 接管rhs的数据, rhs变为空矩阵
+    LMatrix<Type>& operator = (INOUT LMatrix<Type>&& rhs);
+
+    /// @brief 表达式赋值操作符
+    /// 在一个循环中计算表达式并直接写入自身, 表达式中可以包含自身
+    /// 表达式中的视图与自身的数据重叠时(如A = A.GetRow(0), B = B.T() + B)先计算到临时矩阵中
+    /// 表达式的操作数大小不匹配时矩阵被置为空
+    /// @param[in] expr 矩阵表达式
+    template<typename E>
+    LMatrix<Type>& operator = (IN const LMatrixExpr<Type, E>& expr);
+
+    /// @brief 矩阵自加
+    /// 要求自身矩阵大小等于矩阵B的大小, 否则自身不变
+    /// @param[in] B 加数(矩阵或者表达式)
+    template<typename E>
+    LMatrix<Type>& operator += (IN const LMatrixExpr<Type, E>& B);
+
+    /// @brief 矩阵自减
+    /// 要求自身矩阵大小等于矩阵B的大小, 否则自身不变
+    /// @param[in] B 减数(矩阵或者表达式)
+    template<typename E>
+    LMatrix<Type>& operator -= (IN const LMatrixExpr<Type, E>& B);
+
+    /// @brief 矩阵自乘
+    /// 要求自身矩阵的列数等于矩阵B的行数
+    /// @param[in] B 乘数
+    LMatrix<Type>& operator *= (IN const LMatrix<Type>& B);
+
+    /// @brief []操作符
+    /// 数据被其他矩阵共享时先复制数据
+    /// @param[in] row 矩阵行
+    /// @return 行首元素地址, 行内的元素是连续的
+    Type* operator[](IN size_t row);
+
+    /// @brief []操作符
+    /// @param[in] row 矩阵行
+    /// @return 行首元素地址, 行内的元素是连续的
+    const Type* operator[](IN size_t row) const;
+
+    /// @brief 判断矩阵是否为空
+    /// 行数或列数为0的矩阵为空
+    /// @return true, false
+    bool Empty() const;
+
+    /// @brief 判断是否是方阵
+    /// 非空以及行数列数相等的矩阵为方阵
+    /// @return true, false
+    bool Square() const;
+
+    /// @brief 矩阵转置
+    /// @return 转置后的结果矩阵
+    LMatrix<Type> T() const;
+
+    /// @brief 矩阵行拆分(拆分为两个矩阵)
+    /// @param[in] rowIdx 拆分的行索引(索引行被包含在下矩阵中)
+    /// @param[out] up 存储上矩阵
+    /// @param[out] down 存储下矩阵
+    void SplitRow(IN size_t rowIdx, OUT LMatrix<Type>& up, OUT LMatrix<Type>& down) const;
+
+    /// @brief 矩阵行拆分(拆分为两个视图, 不复制数据)
+    /// @param[in] rowIdx 拆分的行索引(索引行被包含在下视图中)
+    /// @param[out] up 存储上视图
+    /// @param[out] down 存储下视图
+    void SplitRow(IN size_t rowIdx, OUT LMatrixView<Type>& up, OUT LMatrixView<Type>& down) const;
+
+    /// @brief 矩阵列拆分(拆分为两个矩阵)
+    /// @param[in] colIdx 拆分的列索引(索引列被包含在右矩阵中)
+    /// @param[out] left 存储左矩阵
+    /// @param[out] right 存储右矩阵
+    void SplitCloumn(IN size_t colIdx, OUT LMatrix<Type>& left, OUT LMatrix<Type>& right) const;
+
+    /// @brief 矩阵列拆分(拆分为两个视图, 不复制数据)
+    /// @param[in] colIdx 拆分的列索引(索引列被包含在右视图中)
+    /// @param[out] left 存储左视图
+    /// @param[out] right 存储右视图
+    void SplitCloumn(IN size_t colIdx, OUT LMatrixView<Type>& left, OUT LMatrixView<Type>& right) const;
+
+    /// @brief 获取子矩阵视图
+    /// 不复制数据, 参数错误时返回空视图
+    /// @param[in] rowStart 子矩阵开始行
+    /// @param[in] rowLen 子矩阵行长度
+    /// @param[in] colStart 子矩阵开始列
+    /// @param[in] colLen 子矩阵列长度
+    /// @return 子矩阵视图
+    LMatrixView<Type> SubMatrix(IN size_t rowStart, IN size_t rowLen, IN size_t colStart, IN size_t colLen) const;
+
+    /// @brief 获取子矩阵
+    /// @param[in] rowStart 子矩阵开始行
+    /// @param[in] rowLen 子矩阵行长度
+    /// @param[in] colStart 子矩阵开始列
+    /// @param[in] colLen 子矩阵列长度
+    /// @param[out] D 存储子矩阵
+    void SubMatrix(IN size_t rowStart, IN size_t rowLen, IN size_t colStart, IN size_t colLen, OUT LMatrix<Type>& D) const;
+
+    /// @brief 获取子矩阵视图
+    /// @param[in] rowStart 子矩阵开始行
+    /// @param[in] rowLen 子矩阵行长度
+    /// @param[in] colStart 子矩阵开始列
+    /// @param[in] colLen 子矩阵列长度
+    /// @param[out] D 存储子矩阵视图
+    void SubMatrix(IN size_t rowStart, IN size_t rowLen, IN size_t colStart, IN size_t colLen, OUT LMatrixView<Type>& D) const;
+
+    /// @brief 获取矩阵中的一行数据
+    /// 不复制数据
+    /// @param[in] row 行索引
+    /// @return 行向量视图
+    LMatrixView<Type> GetRow(IN size_t row) const;
+
+    /// @brief 获取矩阵中的一行数据
+    /// @param[in] row 行索引
+    /// @param[out] rowVector 存储行数据
+    void GetRow(IN size_t row, OUT LMatrix<Type>& rowVector) const;
+
+    /// @brief 获取矩阵中的一行数据
+    /// @param[in] row 行索引
+    /// @param[out] rowVector 存储行向量视图
+    void GetRow(IN size_t row, OUT LMatrixView<Type>& rowVector) const;
+
+    /// @brief 获取矩阵中的一列数据
+    /// 不复制数据
+    /// @param[in] col 列索引
+    /// @return 列向量视图
+    LMatrixView<Type> GetColumn(IN size_t col) const;
+
+    /// @brief 获取矩阵中的一列数据
+    /// @param[in] col 列索引
+    /// @param[out] colVector 存储列数据
+    void GetColumn(IN size_t col, OUT LMatrix<Type>& colVector) const;
+
+    /// @brief 获取矩阵中的一列数据
+    /// @param[in] col 列索引
+    /// @param[out] colVector 存储列向量视图
+    void GetColumn(IN size_t col, OUT LMatrixView<Type>& colVector) const;
+
+    /// @brief 获取行步长
+    /// 每行的起始位置间隔行步长个元素, 行步长不小于列数
+    /// @return 行步长(元素个数)
+    size_t RowStride() const;
+
+    /// @brief 使用文件映射作为矩阵的数据存储
+    /// 不读取和复制数据, 元素[row][col]位于文件中offset + (row * rowStride + col) * sizeof(Type)处,
+    /// 数据在访问时按页读入, 由操作系统的页缓存管理, 所以矩阵可以大于物理内存
+    /// 映射后的矩阵可以用于所有矩阵运算和模型接口, 矩阵原有的数据被释放
+    /// 只读映射的矩阵不能被写入, Reset时总是改为使用堆内存, 所以不能作为运算的结果矩阵;
+    /// 需要原地修改数据时使用写时复制映射, 修改只对当前矩阵可见, 不会写回文件
+    /// 拷贝映射的矩阵会把数据复制到堆内存中, 移动则转移映射
+    /// 要求Type可以按字节复制(如float, double, int), 文件中的数据使用本机字节序
+    /// @param[in] fileName 文件名
+    /// @param[in] row 矩阵行数
+    /// @param[in] col 矩阵列数
+    /// @param[in] mode 映射方式
+    /// @param[in] offset 首元素在文件中的位置(字节), 要求是sizeof(Type)的倍数
+    /// @param[in] rowStride 文件中的行步长(元素个数), 为0表示等于列数
+    /// @return 参数错误, 文件大小不足或者映射失败返回false, 矩阵不变
+    bool Map(
+        IN const wchar_t* fileName, 
+        IN size_t row, 
+        IN size_t col, 
+        IN LMAPPED_FILE_MODE mode, 
+        IN size_t offset = 0, 
+        IN size_t rowStride = 0);
+
+    /// @brief 判断矩阵数据是否存储在映射文件中
+    /// @return true, false
+    bool Mapped() const;
+
+    /// @brief 重置矩阵
+    /// 如果row或col中任一项为0, 则矩阵行数和列数都为0
+    /// 大小不变时保留原有的数据存储(只读映射除外)
+    /// @param[in] row 矩阵行大小
+    /// @param[in] col 矩阵列大小
+    void Reset(IN size_t row, IN size_t col);
+
+    /// @brief 重置矩阵, 并使用initValue初始化矩阵中的所有值
+    /// 如果row或col中任一项为0, 则矩阵行数和列数都为0
+    /// @param[in] row 矩阵行大小
+    /// @param[in] col 矩阵列大小
+    /// @param[in] initValue 初始化值
+    void Reset(IN size_t row, IN size_t col, IN const Type& initValue);
+
+public:
+    const size_t& RowLen;           ///< 行长度属性
+    const size_t& ColumnLen;        ///< 列长度属性
+
+private:
+    /// @brief 逐元素运算内核, C[i][j] = Op(A[i][j], B[i][j])
+    /// C可以和A或B是相同矩阵(大小相同, Reset不会重新分配内存), 其他与C重叠的输入先计算到临时矩阵中
+    template<typename Op>
+    static void ElementWise(IN const LMatrixView<Type>& A, IN const LMatrixView<Type>& B, OUT LMatrix<Type>& C);
+
+    /// @brief 矩阵与标量的逐元素运算内核, C[i][j] = Op(A[i][j], B)
+    template<typename Op>
+    static void ElementWise(IN const LMatrixView<Type>& A, IN const Type& B, OUT LMatrix<Type>& C);
+
+    /// @brief 按行归约内核, B[i][0] = Reduce(A[i][*])
+    /// 行不连续时先将行复制到临时缓冲区
+    template<typename Reduce>
+    static void RowReduce(IN const LMatrixView<Type>& A, OUT LMatrix<typename Reduce::Result>& B);
+
+    /// @brief 按列归约内核, B[0][j] = Reduce(A[*][j]), 要求A的行数大于0
+    /// 行连续时逐行合并到结果行中, 否则按A.T()的行归约
+    template<typename Reduce>
+    static void ColumnReduce(IN const LMatrixView<Type>& A, OUT LMatrix<Type>& B);
+
+    /// @brief 判断逐元素运算的输入A是否与结果C冲突
+    /// A就是C本身(首地址, 步长和大小都相同)时逐元素原地计算是安全的,
+    /// 其他重叠(如C的转置, C的一行)在原地计算时会修改还没有读取的元素, 在C重新分配时会释放A的数据
+    /// @param[in] A 输入
+    /// @param[in] C 结果
+    /// @return true, false
+    static bool ElementOverlap(IN const LMatrixView<Type>& A, IN const LMatrix<Type>& C);
+
+    /// @brief 判断归约的输入A是否与结果B重叠, 元素类型不同的结果(如索引)不会与输入重叠
+    static bool ReduceOverlap(IN const LMatrixView<Type>& A, IN const LMatrix<Type>& B) { return A.Overlap(B); }
+    template<typename Result>
+    static bool ReduceOverlap(IN const LMatrixView<Type>&, IN const LMatrix<Result>&) { return false; }
+
+    /// @brief 释放数据存储(堆内存的引用或者映射文件), 矩阵变为空矩阵
+    void Release();
+
+    /// @brief 判断矩阵数据是否存储在只读映射的文件中
+    bool ReadOnly() const;
+
+    /// @brief 判断矩阵数据是否存储在对象内部的缓冲区中
+    bool Inline() const;
+
+    /// @brief 获取对象内部缓冲区的地址
+    Type* InlineData();
+
+    /// @brief 接管rhs的数据, rhs变为空矩阵
+    /// 要求自身为空矩阵, rhs的数据在内部缓冲区中时移动每个元素
+    void Take(INOUT LMatrix<Type>& rhs);
+
+    /// @brief 判断矩阵数据是否存储在堆内存中(可以共享)
+    bool Heap() const;
+
+    /// @brief 判断矩阵数据是否被其他矩阵共享
+    bool Shared() const;
+
+    /// @brief 数据被共享时复制一份独占的数据, 写入数据前调用
+    void Detach();
+
+private:
+    friend class LMatrixExprLeaf<Type>;
+    friend class LMatrixView<Type>;
+
+    Type*  m_dataList;              ///< 实际存储的数据列表(对齐的内存)
+    size_t m_rowLen;                ///< 矩阵行长度
+    size_t m_columnLen;             ///< 矩阵列长度
+    size_t m_rowStride;             ///< 行步长(元素个数), 不小于列长度
+    LMappedFile* m_pMappedFile;     ///< 映射文件, 为0表示数据存储在堆内存或者内部缓冲区中
+
+    /// @brief 内部缓冲区, 存储小矩阵的数据
+    alignas(std::max_align_t) unsigned char m_inlineData[LMATRIX_INLINE_SIZE > 0 ? LMATRIX_INLINE_SIZE : 1];
+};
+
+/// @brief 矩阵视图
+/// 视图不拥有数据, 只引用矩阵中的一块区域, 行和列可以有任意的步长,
+/// 所以获取子矩阵, 行, 列以及转置都不需要分配内存和复制数据
+/// 视图是只读的, 所有矩阵运算和模型接口的输入参数都接受视图
+/// 注意: 视图只在被引用的矩阵存在, 并且没有被赋值或者改变大小时有效
+LTEMPLATE
+class LMatrixView : public LMatrixExpr<Type, LMatrixView<Type> >
+{
+public:
+    /// @brief 视图中的一行, 用于支持view[row][col]形式的访问
+    class Row
+    {
+    public:
+        Row(IN const Type* pData, IN size_t columnStride)
+            : m_pData(pData), m_columnStride(columnStride)
+        {
+        }
+
+        /// @brief []操作符
+        /// @param[in] col 列索引
+        const Type& operator[](IN size_t col) const { return m_pData[col * m_columnStride]; }
+
+    private:
+        const Type* m_pData;
+        size_t m_columnStride;
+    };
+
+public:
+    /// @brief 默认构造函数
+    /// 默认视图为空
+    LMatrixView();
+
+    /// @brief 构造函数, 引用整个矩阵
+    /// @param[in] m 被引用的矩阵
+    LMatrixView(IN const LMatrix<Type>& m);
+
+    /// @brief 构造函数, 引用外部数据
+    /// 元素[row][col]位于pData[row * rowStride + col * colStride]
+    /// 如果row或col中任一项为0, 则视图为空
+    /// @param[in] pData 数据
+    /// @param[in] row 行数
+    /// @param[in] col 列数
+    /// @param[in] rowStride 行步长(元素个数)
+    /// @param[in] colStride 列步长(元素个数)
+    LMatrixView(
+        IN const Type* pData, 
+        IN size_t row, 
+        IN size_t col, 
+        IN size_t rowStride, 
+        IN size_t colStride);
+
+    /// @brief 拷贝构造函数
+    LMatrixView(IN const LMatrixView<Type>& rhs);
+
+    /// @brief 赋值操作符
+    LMatrixView<Type>& operator = (IN const LMatrixView<Type>& rhs);
+
+    /// @brief []操作符
+    /// @param[in] row 行索引
+    Row operator[](IN size_t row) const;
+
+    /// @brief 判断视图是否为空
+    /// @return true, false
+    bool Empty() const;
+
+    /// @brief 判断视图中的数据是否为行优先连续存储
+    /// @return true, false
+    bool Contiguous() const;
+
+    /// @brief 获取首元素地址
+    /// 元素[row][col]位于Data()[row * RowStride() + col * ColumnStride()]
+    /// @return 首元素地址, 空视图返回0
+    const Type* Data() const;
+
+    /// @brief 获取行步长
+    /// @return 行步长(元素个数)
+    size_t RowStride() const;
+
+    /// @brief 获取列步长
+    /// @return 列步长(元素个数)
+    size_t ColumnStride() const;
+
+    /// @brief 判断视图中的数据是否与矩阵m的数据重叠
+    /// 以矩阵为输出的运算在输入视图与输出重叠时需要先计算到临时矩阵中
+    /// @param[in] m 矩阵
+    /// @return true, false
+    bool Overlap(IN const LMatrix<Type>& m) const;
+
+    /// @brief 转置视图
+    /// 交换行列步长, 不复制数据
+    /// @return 转置后的视图
+    LMatrixView<Type> T() const;
+
+    /// @brief 获取子矩阵视图
+    /// 参数错误时返回空视图
+    /// @param[in] rowStart 子矩阵开始行
+    /// @param[in] rowLen 子矩阵行长度
+    /// @param[in] colStart 子矩阵开始列
+    /// @param[in] colLen 子矩阵列长度
+    /// @return 子矩阵视图
+    LMatrixView<Type> SubMatrix(
+        IN size_t rowStart, 
+        IN size_t rowLen, 
+        IN size_t colStart, 
+        IN size_t colLen) const;
+
+    /// @brief 获取一行的视图
+    /// @param[in] row 行索引
+    /// @return 行向量视图
+    LMatrixView<Type> GetRow(IN size_t row) const;
+
+    /// @brief 获取一列的视图
+    /// @param[in] col 列索引
+    /// @return 列向量视图
+    LMatrixView<Type> GetColumn(IN size_t col) const;
+
+private:
+    friend class LMatrix<Type>;
+    friend class LMatrixViewLeaf<Type>;
+
+    const Type* m_pData;            ///< 首元素地址
+    size_t m_rowLen;                ///< 行长度
+    size_t m_columnLen;             ///< 列长度
+    size_t m_rowStride;             ///< 行步长
+    size_t m_columnStride;          ///< 列步长
+
+public:
+    const size_t& RowLen;           ///< 行长度属性
+    const size_t& ColumnLen;        ///< 列长度属性
+};
+
+/// @brief 按需并行的矩阵乘法, C = A * B
+/// 使用LMatrixGemm<CType>计算, A和B的元素类型可以与CType不同, 在CType中累加
+/// 并行时按C的行(或者列, 当C的列数多于行数时)划分, 每个线程独立打包和计算自己的C块
+/// @param[in] A 被乘数, 不能为空
+/// @param[in] B 乘数, 行数等于A的列数, 不能为空
+/// @param[out] pC 结果矩阵数据, 行优先存储, 大小为A.RowLen * ldc
+/// @param[in] ldc 结果矩阵的行步长
+template<typename CType, typename AType, typename BType>
+inline void LMatrixParallelGemm(
+    IN const LMatrixView<AType>& A, 
+    IN const LMatrixView<BType>& B, 
+    OUT CType* pC, 
+    IN size_t ldc)
+{
+    const size_t m = A.RowLen;
+    const size_t n = B.ColumnLen;
+    const size_t k = A.ColumnLen;
+
+    const AType* pA = A.Data();
+    const size_t rsA = A.RowStride();
+    const size_t csA = A.ColumnStride();
+    const BType* pB = B.Data();
+    const size_t rsB = B.RowStride();
+    const size_t csB = B.ColumnStride();
+
+    if (m >= n)
+    {
+        LMatrixParallelFor(m, (unsigned long long)m * n * k, LMATRIX_PARALLEL_GEMM_SIZE, 
+            [=](size_t rowBegin, size_t rowEnd)
+        {
+            LMatrixGemm<CType>::Run(
+                rowEnd - rowBegin, n, k, 
+                &pA[rowBegin * rsA], rsA, csA, 
+                pB, rsB, csB, 
+                &pC[rowBegin * ldc], ldc);
+        });
+    }
+    else
+    {
+        LMatrixParallelFor(n, (unsigned long long)m * n * k, LMATRIX_PARALLEL_GEMM_SIZE, 
+            [=](size_t colBegin, size_t colEnd)
+        {
+            LMatrixGemm<CType>::Run(
+                m, colEnd - colBegin, k, 
+                pA, rsA, csA, 
+                &pB[colBegin * csB], rsB, csB, 
+                &pC[colBegin], ldc);
+        });
+    }
+}
+
+LTEMPLATE
+LMatrix<Type>::LMatrix()
+: m_rowLen(0), m_columnLen(0), RowLen(m_rowLen), ColumnLen(m_columnLen), m_dataList(0), m_rowStride(0), m_pMappedFile(0)
+{
+
+}
+
+LTEMPLATE
+LMatrix<Type>::~LMatrix()
+{
+    this->Release();
+}
+
+LTEMPLATE
+LMatrix<Type>::LMatrix(IN size_t row, IN size_t col)
+: m_rowLen(0), m_columnLen(0), RowLen(m_rowLen), ColumnLen(m_columnLen), m_dataList(0), m_rowStride(0), m_pMappedFile(0)
+{
+    this->Reset(row, col);
+}
+
+LTEMPLATE
+LMatrix<Type>::LMatrix(IN size_t row, IN size_t col, IN const Type& initValue)
+: m_rowLen(0), m_columnLen(0), RowLen(m_rowLen), ColumnLen(m_columnLen), m_dataList(0), m_rowStride(0), m_pMappedFile(0)
+{
+    this->Reset(row, col, initValue);
+}
+
+LTEMPLATE
+LMatrix<Type>::LMatrix(IN size_t row, IN size_t col, IN const Type* pDataList)
+: m_rowLen(0), m_columnLen(0), RowLen(m_rowLen), ColumnLen(m_columnLen), m_dataList(0), m_rowStride(0), m_pMappedFile(0)
+{
+    this->Reset(row, col);
+
+    for (size_t i = 0; i < this->m_rowLen; i++)
+    {
+        Type* pRow = &this->m_dataList[i * this->m_rowStride];
+        for (size_t j = 0; j < this->m_columnLen; j++)
+            pRow[j] = pDataList[i * this->m_columnLen + j];
+    }
+
+}
+
+LTEMPLATE
+LMatrix<Type>::LMatrix(IN const LMatrix<Type>& rhs)
+: m_rowLen(0), m_columnLen(0), RowLen(m_rowLen), ColumnLen(m_columnLen), m_dataList(0), m_rowStride(0), m_pMappedFile(0)
+{
+    (*this) = rhs;
+}
+
+LTEMPLATE
+LMatrix<Type>& LMatrix<Type>::operator = (IN const LMatrix<Type>& rhs)
+{
+    if (this == &rhs)
+        return *this;
+
+    // 共享堆内存中的数据, 先增加引用计数, 自身和rhs共享数据时也不会被释放
+    // 可写的映射矩阵需要将数据写入文件, 仍然复制
+    if (rhs.Heap() && (this->m_pMappedFile == 0 || this->ReadOnly()))
+    {
+        LMatrixStorage<Type>::Counter(rhs.m_dataList)->fetch_add(1, std::memory_order_relaxed);
+        this->Release();
+        this->m_dataList = rhs.m_dataList;
+        this->m_rowLen = rhs.m_rowLen;
+        this->m_columnLen = rhs.m_columnLen;
+        this->m_rowStride = rhs.m_rowStride;
+        return *this;
+    }
+
+    this->Reset(rhs.RowLen, rhs.ColumnLen);
+
+    // 大小相同的矩阵行步长也相同
+    for (size_t i = 0; i < this->m_rowLen; i++)
+    {
+        Type* pRow = &this->m_dataList[i * this->m_rowStride];
+        const Type* pRhsRow = &rhs.m_dataList[i * rhs.m_rowStride];
+        for (size_t j = 0; j < this->m_columnLen; j++)
+            pRow[j] = pRhsRow[j];
+    }
+
+    return *this;
+}
+
+LTEMPLATE
+LMatrix<Type>::LMatrix(INOUT LMatrix<Type>&& rhs)
+: m_rowLen(0), m_columnLen(0), RowLen(m_rowLen), ColumnLen(m_columnLen), m_dataList(0), m_rowStride(0), m_pMappedFile(0)
+{
+    this->Take(rhs);
+}
+
+LTEMPLATE
+template<typename E>
+LMatrix<Type>::LMatrix(IN const LMatrixExpr<Type, E>& expr)
+: m_rowLen(0), m_columnLen(0), RowLen(m_rowLen), ColumnLen(m_columnLen), m_dataList(0), m_rowStride(0), m_pMappedFile(0)
+{
+    (*this) = expr;
+}
+
+LTEMPLATE
+LMatrix<Type>& LMatrix<Type>::operator = (INOUT LMatrix<Type>&& rhs)
+{
+    if (this == &rhs)
+        return *this;
+
+    this->Release();
+    this->Take(rhs);
 
-    /// @brief 拷贝构造函数
-    LMatrix(IN const LMatrix<Type>& rhs);
+    return *this;
+}
 
-    /// @brief 赋值操作符
-    LMatrix<Type>& operator = (IN const LMatrix<Type>& rhs);
+LTEMPLATE
+template<typename E>
+LMatrix<Type>& LMatrix<Type>::operator = (IN const LMatrixExpr<Type, E>& expr)
+{
+    const typename LMatrixExprOperand<Type, E>::Node node(expr.Self());
 
-    /// @brief 矩阵加法
-    /// 要求自身矩阵大小等于矩阵B的大小
-    /// @param[in] B 加数
-    /// @return 结果矩阵
-    LMatrix<Type> operator + (IN const LMatrix<Type>& B) const;
+    // 只读映射的矩阵不能写入, 表达式中可能包含自身, 先计算到临时矩阵中
+    // 视图与自身的数据重叠时, 重新分配内存会释放视图的数据, 原地写入会修改还没有读取的元素, 同样先计算到临时矩阵中
+    if (this->ReadOnly() || node.Overlap(this->m_dataList, this->m_dataList + this->m_rowLen * this->m_rowStride))
+    {
+        LMatrix<Type> temp(expr);
+        (*this) = std::move(temp);
+        return *this;
+    }
 
-    /// @brief 矩阵自加
-    /// 要求自身矩阵大小等于矩阵B的大小
-    /// @param[in] B 加数
-    LMatrix<Type>& operator += (IN const LMatrix<Type>& B);
+    if (!node.Valid())
+    {
+        this->Reset(0, 0);
+        return *this;
+    }
 
-    /// @brief 矩阵减法
-    /// 要求自身矩阵大小等于矩阵B的大小
-    /// @param[in] B 减数
-    /// @return 结果矩阵
-    LMatrix<Type> operator - (IN const LMatrix<Type>& B) const;
+    // 表达式中包含自身(不是视图)时大小一定相同, Reset不会重新分配内存
+    this->Reset(node.RowLen(), node.ColumnLen());
 
-    /// @brief 矩阵自减
-    /// 要求自身矩阵大小等于矩阵B的大小
-    /// @param[in] B 减数
-    LMatrix<Type>& operator -= (IN const LMatrix<Type>& B);
+    LMatrix<Type>& self = *this;
+    LMatrixParallelFor(this->m_rowLen, (unsigned long long)this->m_rowLen * this->m_columnLen, LMATRIX_PARALLEL_SIZE, 
+        [&self, &node](size_t rowBegin, size_t rowEnd)
+    {
+        for (size_t row = rowBegin; row < rowEnd; row++)
+        {
+            Type* pRow = &self.m_dataList[row * self.m_rowStride];
+            for (size_t col = 0; col < self.m_columnLen; col++)
+            {
+                pRow[col] = node.Value(row, col);
+            }
+        }
+    });
 
-    /// @brief 矩阵乘法
-    /// 要求自身矩阵的列数等于矩阵B的行数
-    /// @param[in] B 乘数
-    /// @return 结果矩阵
-    LMatrix<Type> operator * (IN const LMatrix<Type>& B) const;
+    return *this;
+}
 
-    /// @brief 矩阵自乘
-    /// 要求自身矩阵的列数等于矩阵B的行数
-    /// @param[in] B 乘数
-    LMatrix<Type>& operator *= (IN const LMatrix<Type>& B);
+LTEMPLATE
+template<typename E>
+LMatrix<Type>& LMatrix<Type>::operator += (IN const LMatrixExpr<Type, E>& B)
+{
+    const typename LMatrixExprOperand<Type, E>::Node node(B.Self());
+    if (!node.Valid() || node.RowLen() != this->m_rowLen || node.ColumnLen() != this->m_columnLen)
+        return *this;
 
-    /// @brief 矩阵数乘
-    /// @param[in] B 乘数
-    /// @return 结果矩阵
-    LMatrix<Type> ScalarMul(IN const Type& B) const;
+    // 只读映射的矩阵不能原地修改, 视图与自身的数据重叠时原地修改会改变还没有读取的元素
+    if (this->ReadOnly() || node.Overlap(this->m_dataList, this->m_dataList + this->m_rowLen * this->m_rowStride))
+        return (*this) = (*this) + B.Self();
 
-    /// @brief 矩阵数除
-    /// @param[in] B 除数
-    /// @return 结果矩阵
-    LMatrix<Type> ScalarDiv(IN const Type& B) const;
+    // 表达式中的自身引用原来的数据, 数据被共享时仍然有效
+    this->Detach();
 
-    /// @brief []操作符
-    /// @param[in] row 矩阵行
-    Type*& operator[](IN unsigned int row);
+    LMatrix<Type>& self = *this;
+    LMatrixParallelFor(this->m_rowLen, (unsigned long long)this->m_rowLen * this->m_columnLen, LMATRIX_PARALLEL_SIZE, 
+        [&self, &node](size_t rowBegin, size_t rowEnd)
+    {
+        for (size_t row = rowBegin; row < rowEnd; row++)
+        {
+            Type* pRow = &self.m_dataList[row * self.m_rowStride];
+            for (size_t col = 0; col < self.m_columnLen; col++)
+            {
+                pRow[col] += node.Value(row, col);
+            }
+        }
+    });
 
-    /// @brief []操作符
-    /// @param[in] row 矩阵行
-    const Type* operator[](IN unsigned int row) const;
+    return *this;
+}
 
-    /// @brief 判断矩阵是否为空
-    /// 行数或列数为0的矩阵为空
-    /// @return true, false
-    bool Empty() const;
+LTEMPLATE
+template<typename E>
+LMatrix<Type>& LMatrix<Type>::operator -= (IN const LMatrixExpr<Type, E>& B)
+{
+    const typename LMatrixExprOperand<Type, E>::Node node(B.Self());
+    if (!node.Valid() || node.RowLen() != this->m_rowLen || node.ColumnLen() != this->m_columnLen)
+        return *this;
 
-    /// @brief 判断是否是方阵
-    /// 非空以及行数列数相等的矩阵为方阵
-    /// @return true, false
-    bool Square() const;
+    // 只读映射的矩阵不能原地修改, 视图与自身的数据重叠时原地修改会改变还没有读取的元素
+    if (this->ReadOnly() || node.Overlap(this->m_dataList, this->m_dataList + this->m_rowLen * this->m_rowStride))
+        return (*this) = (*this) - B.Self();
 
-    /// @brief 矩阵转置
-    /// @return 转置后的结果矩阵
-    LMatrix<Type> T() const;
+    // 表达式中的自身引用原来的数据, 数据被共享时仍然有效
+    this->Detach();
 
-    /// @brief 矩阵行拆分(拆分为两个矩阵)
-    /// @param[in] rowIdx 拆分的行索引(索引行被包含在下矩阵中)
-    /// @param[out] up 存储上矩阵
-    /// @param[out] down 存储下矩阵
-    void SplitRow(IN unsigned int rowIdx, OUT LMatrix<Type>& up, OUT LMatrix<Type>& down) const;
+    LMatrix<Type>& self = *this;
+    LMatrixParallelFor(this->m_rowLen, (unsigned long long)this->m_rowLen * this->m_columnLen, LMATRIX_PARALLEL_SIZE, 
+        [&self, &node](size_t rowBegin, size_t rowEnd)
+    {
+        for (size_t row = rowBegin; row < rowEnd; row++)
+        {
+            Type* pRow = &self.m_dataList[row * self.m_rowStride];
+            for (size_t col = 0; col < self.m_columnLen; col++)
+            {
+                pRow[col] -= node.Value(row, col);
+            }
+        }
+    });
 
-    /// @brief 矩阵列拆分(拆分为两个矩阵)
-    /// @param[in] colIdx 拆分的列索引(索引列被包含在右矩阵中)
-    /// @param[out] left 存储左矩阵
-    /// @param[out] right 存储右矩阵
-    void SplitCloumn(IN unsigned int colIdx, OUT LMatrix<Type>& left, OUT LMatrix<Type>& right) const;
+    return *this;
+}
 
-    /// @brief 获取子矩阵
-    /// @param[in] rowStart 子矩阵开始行
-    /// @param[in] rowLen 子矩阵行长度
-    /// @param[in] colStart 子矩阵开始列
-    /// @param[in] colLen 子矩阵列长度
-    /// @return 子矩阵
-    LMatrix<Type> SubMatrix(IN unsigned int rowStart, IN unsigned int rowLen, IN unsigned int colStart, IN unsigned int colLen) const;
+LTEMPLATE
+LMatrix<Type>& LMatrix<Type>::operator *= (IN const LMatrix<Type>& B)
+{
+    LMatrix<Type> C;
+    MUL(*this, B, C);
+    (*this) = std::move(C);
+    return *this;
+}
 
-    /// @brief 获取子矩阵
-    /// @param[in] rowStart 子矩阵开始行
-    /// @param[in] rowLen 子矩阵行长度
-    /// @param[in] colStart 子矩阵开始列
-    /// @param[in] colLen 子矩阵列长度
-    /// @param[out] D 存储子矩阵
-    void SubMatrix(IN unsigned int rowStart, IN unsigned int rowLen, IN unsigned int colStart, IN unsigned int colLen, OUT LMatrix<Type>& D) const;
+LTEMPLATE
+Type* LMatrix<Type>::operator[](IN size_t row)
+{
+    this->Detach();
+    return &this->m_dataList[row * this->m_rowStride];
+}
 
-    /// @brief 获取矩阵中的一行数据
-    /// @param[in] row 行索引
-    /// @return 行向量
-    LMatrix<Type> GetRow(IN unsigned int row) const;
+LTEMPLATE
+const Type* LMatrix<Type>::operator[](IN size_t row) const
+{
+    return &this->m_dataList[row * this->m_rowStride];
+}
 
-    /// @brief 获取矩阵中的一行数据
-    /// @param[in] row 行索引
-    /// @param[out] rowVector 存储行数据
-    void GetRow(IN unsigned int row, OUT LMatrix<Type>& rowVector) const;
+LTEMPLATE
+bool LMatrix<Type>::Empty() const
+{
+    if (this->m_columnLen == 0 || this->m_rowLen == 0)
+        return true;
 
-    /// @brief 获取矩阵中的一列数据
-    /// @param[in] col 列索引
-    /// @return 列向量
-    LMatrix<Type> GetColumn(IN unsigned int col) const;
+    return false;
+}
 
-    /// @brief 获取矩阵中的一列数据
-    /// @param[in] col 列索引
-    /// @param[out] colVector 存储列数据
-    void GetColumn(IN unsigned int col, OUT LMatrix<Type>& colVector) const;
+LTEMPLATE
+bool LMatrix<Type>::Square() const
+{
+    if (this->m_columnLen == this->m_rowLen)
+    {
+        if (this->m_columnLen != 0)
+            return true;
+    }
 
-    /// @brief 重置矩阵
-    /// 如果row或col中任一项为0, 则矩阵行数和列数都为0
-    /// @param[in] row 矩阵行大小
-    /// @param[in] col 矩阵列大小
-    void Reset(IN unsigned int row, IN unsigned int col);
+    return false;
+}
 
-    /// @brief 重置矩阵, 并使用initValue初始化矩阵中的所有值
-    /// 如果row或col中任一项为0, 则矩阵行数和列数都为0
-    /// @param[in] row 矩阵行大小
-    /// @param[in] col 矩阵列大小
-    /// @param[in] initValue 初始化值
-    void Reset(IN unsigned int row, IN unsigned int col, IN const Type& initValue);
+LTEMPLATE
+LMatrix<Type> LMatrix<Type>::T() const
+{
+    LMatrix<Type> B;
+    T(*this, B);
+    return B;
+}
 
-public:
-    const unsigned int& RowLen;     ///< 行长度属性
-    const unsigned int& ColumnLen;  ///< 列长度属性
+LTEMPLATE
+void LMatrix<Type>::SplitRow(IN size_t rowIdx, OUT LMatrix<Type>& up, OUT LMatrix<Type>& down) const
+{
+    up.Reset(0, 0);
+    down.Reset(0, 0);
 
-private:
-    Type** m_dataTable;             ///< 二维数据表
-    Type*  m_dataList;              ///< 实际存储的数据列表
-    unsigned int m_rowLen;          ///< 矩阵行长度
-    unsigned int m_columnLen;       ///< 矩阵列长度
-};
+    SUBMATRIX(*this, 0, rowIdx, 0, this->ColumnLen, up);
+    SUBMATRIX(*this, rowIdx, this->RowLen-rowIdx, 0, this->ColumnLen, down);
+}
 
 LTEMPLATE
-LMatrix<Type>::LMatrix()
-: m_rowLen(0), m_columnLen(0), RowLen(m_rowLen), ColumnLen(m_columnLen), m_dataTable(0), m_dataList(0)
+void LMatrix<Type>::SplitRow(IN size_t rowIdx, OUT LMatrixView<Type>& up, OUT LMatrixView<Type>& down) const
+{
+    LMatrixView<Type> view(*this);
+    up = view.SubMatrix(0, rowIdx, 0, this->ColumnLen);
+    down = view.SubMatrix(rowIdx, this->RowLen - rowIdx, 0, this->ColumnLen);
+}
+
+LTEMPLATE
+void LMatrix<Type>::SplitCloumn(IN size_t colIdx, OUT LMatrix<Type>& left, OUT LMatrix<Type>& right) const
 {
+    left.Reset(0, 0);
+    right.Reset(0, 0);
 
+    SUBMATRIX(*this, 0, this->RowLen, 0, colIdx, left);
+    SUBMATRIX(*this, 0, this->RowLen, colIdx, this->ColumnLen - colIdx, right);
 }
 
 LTEMPLATE
-LMatrix<Type>::~LMatrix()
+void LMatrix<Type>::SplitCloumn(IN size_t colIdx, OUT LMatrixView<Type>& left, OUT LMatrixView<Type>& right) const
 {
-    if (this->m_dataTable)
-    {
-        delete[] this->m_dataTable;
-        this->m_dataTable = 0;
-    }
+    LMatrixView<Type> view(*this);
+    left = view.SubMatrix(0, this->RowLen, 0, colIdx);
+    right = view.SubMatrix(0, this->RowLen, colIdx, this->ColumnLen - colIdx);
+}
 
-    if (this->m_dataList)
-    {
-        delete[] this->m_dataList;
-        this->m_dataList = 0;
-    }
+LTEMPLATE
+LMatrixView<Type> LMatrix<Type>::SubMatrix(IN size_t rowStart, IN size_t rowLen, IN size_t colStart, IN size_t colLen) const
+{
+    return LMatrixView<Type>(*this).SubMatrix(rowStart, rowLen, colStart, colLen);
+}
 
-    this->m_rowLen = 0;
-    this->m_columnLen = 0;
+LTEMPLATE
+void LMatrix<Type>::SubMatrix(IN size_t rowStart, IN size_t rowLen, IN size_t colStart, IN size_t colLen, OUT LMatrix<Type>& D) const
+{
+    SUBMATRIX(*this, rowStart, rowLen, colStart, colLen, D);
 }
 
 LTEMPLATE
-LMatrix<Type>::LMatrix(IN unsigned int row, IN unsigned int col)
-: m_rowLen(0), m_columnLen(0), RowLen(m_rowLen), ColumnLen(m_columnLen), m_dataTable(0), m_dataList(0)
+void LMatrix<Type>::SubMatrix(IN size_t rowStart, IN size_t rowLen, IN size_t colStart, IN size_t colLen, OUT LMatrixView<Type>& D) const
 {
-    this->Reset(row, col);
+    D = LMatrixView<Type>(*this).SubMatrix(rowStart, rowLen, colStart, colLen);
 }
 
 LTEMPLATE
-LMatrix<Type>::LMatrix(IN unsigned int row, IN unsigned int col, IN const Type& initValue)
-: m_rowLen(0), m_columnLen(0), RowLen(m_rowLen), ColumnLen(m_columnLen), m_dataTable(0), m_dataList(0)
+LMatrixView<Type> LMatrix<Type>::GetRow(IN size_t row) const
 {
-    this->Reset(row, col);
+    return LMatrixView<Type>(&this->m_dataList[row * this->m_rowStride], 1, this->m_columnLen, this->m_rowStride, 1);
+}
 
-    unsigned int size = row * col;
-    for (unsigned int i = 0; i < size; i++)
+LTEMPLATE
+void LMatrix<Type>::GetRow(IN size_t row, OUT LMatrix<Type>& rowVector) const
+{
+    rowVector.Reset(1, this->m_columnLen);
+    for (size_t i = 0; i < this->m_columnLen; i++)
     {
-        this->m_dataList[i] = initValue;
+        rowVector.m_dataList[i] = (*this)[row][i];
     }
 }
 
 LTEMPLATE
-LMatrix<Type>::LMatrix(IN unsigned int row, IN unsigned int col, IN const Type* pDataList)
-: m_rowLen(0), m_columnLen(0), RowLen(m_rowLen), ColumnLen(m_columnLen), m_dataTable(0), m_dataList(0)
+void LMatrix<Type>::GetRow(IN size_t row, OUT LMatrixView<Type>& rowVector) const
 {
-    this->Reset(row, col);
+    rowVector = this->GetRow(row);
+}
+
+LTEMPLATE
+LMatrixView<Type> LMatrix<Type>::GetColumn(IN size_t col) const
+{
+    return LMatrixView<Type>(&this->m_dataList[col], this->m_rowLen, 1, this->m_rowStride, 1);
+}
 
-    unsigned int size = row * col;
-    for (unsigned int i = 0; i < size; i++)
+LTEMPLATE
+void LMatrix<Type>::GetColumn(IN size_t col, OUT LMatrix<Type>& colVector) const
+{
+    colVector.Reset(this->m_rowLen, 1);
+    for (size_t i = 0; i < this->m_rowLen; i++)
     {
-        this->m_dataList[i] = pDataList[i];
+        colVector[i][0] = (*this)[i][col];
     }
+}
 
+LTEMPLATE
+void LMatrix<Type>::GetColumn(IN size_t col, OUT LMatrixView<Type>& colVector) const
+{
+    colVector = this->GetColumn(col);
 }
 
 LTEMPLATE
-LMatrix<Type>::LMatrix(IN const LMatrix<Type>& rhs)
-: m_rowLen(0), m_columnLen(0), RowLen(m_rowLen), ColumnLen(m_columnLen), m_dataTable(0), m_dataList(0)
+size_t LMatrix<Type>::RowStride() const
 {
-    this->Reset(rhs.RowLen, rhs.ColumnLen);
+    return m_rowStride;
+}
+
+LTEMPLATE
+bool LMatrix<Type>::Map(
+    IN const wchar_t* fileName, 
+    IN size_t row, 
+    IN size_t col, 
+    IN LMAPPED_FILE_MODE mode, 
+    IN size_t offset, 
+    IN size_t rowStride)
+{
+    if (row == 0 || col == 0)
+        return false;
+    if (rowStride == 0)
+        rowStride = col;
+    if (rowStride < col || offset % sizeof(Type) != 0)
+        return false;
+
+    // 映射区域从首元素到最后一行的最后一个元素
+    if (row - 1 > ((size_t)-1 - col) / rowStride)
+        return false;
+    const size_t count = (row - 1) * rowStride + col;
+    if (count > (size_t)-1 / sizeof(Type))
+        return false;
 
-    unsigned int size = rhs.RowLen * rhs.ColumnLen;
-    for (unsigned int i = 0; i < size; i++)
+    LMappedFile* pMappedFile = new LMappedFile();
+    if (!pMappedFile->Open(fileName, mode, offset, count * sizeof(Type)))
     {
-        this->m_dataList[i] = rhs.m_dataList[i];
+        delete pMappedFile;
+        return false;
     }
 
+    this->Release();
+    this->m_dataList = static_cast<Type*>(pMappedFile->Data());
+    this->m_rowLen = row;
+    this->m_columnLen = col;
+    this->m_rowStride = rowStride;
+    this->m_pMappedFile = pMappedFile;
+
+    return true;
 }
 
 LTEMPLATE
-LMatrix<Type>& LMatrix<Type>::operator = (IN const LMatrix<Type>& rhs)
+bool LMatrix<Type>::Mapped() const
 {
-    this->Reset(rhs.RowLen, rhs.ColumnLen);
+    return this->m_pMappedFile != 0;
+}
 
-    unsigned int size = rhs.RowLen * rhs.ColumnLen;
-    for (unsigned int i = 0; i < size; i++)
+LTEMPLATE
+void LMatrix<Type>::Release()
+{
+    if (this->m_pMappedFile != 0)
     {
-        this->m_dataList[i] = rhs.m_dataList[i];
+        delete this->m_pMappedFile;
+        this->m_pMappedFile = 0;
+    }
+    else if (this->Inline())
+    {
+        LMatrixStorage<Type>::Destroy(this->m_dataList, this->m_rowLen * this->m_rowStride);
+    }
+    else if (this->m_dataList != 0)
+    {
+        // 最后一个引用释放数据
+        if (LMatrixStorage<Type>::Counter(this->m_dataList)->fetch_sub(1, std::memory_order_acq_rel) == 1)
+            LMatrixStorage<Type>::Free(this->m_dataList, this->m_rowLen * this->m_rowStride);
     }
 
-    return *this;
+    this->m_dataList = 0;
+    this->m_rowLen = 0;
+    this->m_columnLen = 0;
+    this->m_rowStride = 0;
 }
 
 LTEMPLATE
-LMatrix<Type> LMatrix<Type>::operator + (IN const LMatrix<Type>& B) const
+bool LMatrix<Type>::Inline() const
 {
-    LMatrix<Type> C;
-    ADD(*this, B, C);
-    return C;
+    return this->m_dataList != 0 && (const void*)this->m_dataList == (const void*)this->m_inlineData;
 }
 
 LTEMPLATE
-LMatrix<Type>& LMatrix<Type>::operator += (IN const LMatrix<Type>& B)
+Type* LMatrix<Type>::InlineData()
 {
-    ADD(*this, B, *this);
-    return *this;
+    return reinterpret_cast<Type*>(this->m_inlineData);
 }
 
 LTEMPLATE
-LMatrix<Type> LMatrix<Type>::operator - (IN const LMatrix<Type>& B) const
+bool LMatrix<Type>::Heap() const
 {
-    LMatrix<Type> C;
-    SUB(*this, B, C);
-    return C;
+    return this->m_dataList != 0 && this->m_pMappedFile == 0 && !this->Inline();
 }
 
 LTEMPLATE
-LMatrix<Type>& LMatrix<Type>::operator -= (IN const LMatrix<Type>& B)
+bool LMatrix<Type>::Shared() const
 {
-    SUB(*this, B, *this);
-    return *this;
+    return this->Heap() && 
+        LMatrixStorage<Type>::Counter(this->m_dataList)->load(std::memory_order_acquire) != 1;
 }
 
 LTEMPLATE
-LMatrix<Type> LMatrix<Type>::operator * (IN const LMatrix<Type>& B) const
+void LMatrix<Type>::Detach()
 {
-    LMatrix<Type> C;
-    MUL(*this, B, C);
-    return C;
+    if (!this->Shared())
+        return;
+
+    const size_t count = this->m_rowLen * this->m_rowStride;
+    Type* pData = LMatrixStorage<Type>::Allocate(count);
+    for (size_t i = 0; i < count; i++)
+        pData[i] = this->m_dataList[i];
+
+    if (LMatrixStorage<Type>::Counter(this->m_dataList)->fetch_sub(1, std::memory_order_acq_rel) == 1)
+        LMatrixStorage<Type>::Free(this->m_dataList, count);
+
+    this->m_dataList = pData;
 }
 
 LTEMPLATE
-LMatrix<Type>& LMatrix<Type>::operator *= (IN const LMatrix<Type>& B)
+void LMatrix<Type>::Take(INOUT LMatrix<Type>& rhs)
 {
-    LMatrix<Type> C;
-    MUL(*this, B, C);
-    (*this) = C;
-    return *this;
+    if (rhs.Inline())
+    {
+        const size_t count = rhs.m_rowLen * rhs.m_rowStride;
+        Type* pData = this->InlineData();
+        for (size_t i = 0; i < count; i++)
+            new (&pData[i]) Type(std::move(rhs.m_dataList[i]));
+        LMatrixStorage<Type>::Destroy(rhs.m_dataList, count);
+        this->m_dataList = pData;
+    }
+    else
+    {
+        this->m_dataList = rhs.m_dataList;
+    }
+
+    this->m_rowLen = rhs.m_rowLen;
+    this->m_columnLen = rhs.m_columnLen;
+    this->m_rowStride = rhs.m_rowStride;
+    this->m_pMappedFile = rhs.m_pMappedFile;
+
+    rhs.m_dataList = 0;
+    rhs.m_rowLen = 0;
+    rhs.m_columnLen = 0;
+    rhs.m_rowStride = 0;
+    rhs.m_pMappedFile = 0;
 }
 
 LTEMPLATE
-LMatrix<Type> LMatrix<Type>::ScalarMul(IN const Type& B) const
+bool LMatrix<Type>::ReadOnly() const
 {
-    LMatrix<Type> C;
-    SCALARMUL(*this, B, C);
-    return C;
+    return this->m_pMappedFile != 0 && this->m_pMappedFile->Mode() == LMAPPED_FILE_READ_ONLY;
 }
 
 LTEMPLATE
-LMatrix<Type> LMatrix<Type>::ScalarDiv(IN const Type& B) const
+void LMatrix<Type>::Reset(IN size_t row, IN size_t col)
 {
-    LMatrix<Type> C;
-    SCALARDIV(*this, B, C);
-    return C;
+    if ((this->m_rowLen != row) || this->m_columnLen != col || this->ReadOnly())
+    {
+        this->Release();
+
+        if (row > 0 && col > 0)
+        {
+            size_t rowStride = LMatrixStorage<Type>::RowStride(col);
+            if (row > (size_t)-1 / rowStride)
+                throw std::bad_alloc();
+
+            const size_t count = row * rowStride;
+            if (LMatrixStorage<Type>::Inline(count))
+                this->m_dataList = LMatrixStorage<Type>::Construct(this->m_inlineData, count);
+            else
+                this->m_dataList = LMatrixStorage<Type>::Allocate(count);
+            this->m_rowLen = row;
+            this->m_columnLen = col;
+            this->m_rowStride = rowStride;
+        }
+    }
+    else
+    {
+        // 大小不变时保留数据, 数据被共享时复制
+        this->Detach();
+    }
 }
 
 LTEMPLATE
-Type*& LMatrix<Type>::operator[](IN unsigned int row)
+void LMatrix<Type>::Reset(IN size_t row, IN size_t col, IN const Type& initValue)
 {
-    return this->m_dataTable[row];
+    this->Reset(row, col);
+
+    for (size_t i = 0; i < this->m_rowLen; i++)
+    {
+        Type* pRow = &this->m_dataList[i * this->m_rowStride];
+        for (size_t j = 0; j < this->m_columnLen; j++)
+            pRow[j] = initValue;
+    }
 }
 
 LTEMPLATE
-const Type* LMatrix<Type>::operator[](IN unsigned int row) const
+template<typename Op>
+void LMatrix<Type>::ElementWise(IN const LMatrixView<Type>& A, IN const LMatrixView<Type>& B, OUT LMatrix<Type>& C)
 {
-    return this->m_dataTable[row];
+    // 只读映射的C可能同时是输入, 与C冲突的输入见ElementOverlap, 都先计算到临时矩阵中
+    if (C.ReadOnly() || ElementOverlap(A, C) || ElementOverlap(B, C))
+    {
+        LMatrix<Type> temp;
+        ElementWise<Op>(A, B, temp);
+        C = std::move(temp);
+        return;
+    }
+
+    C.Reset(A.RowLen, A.ColumnLen);
+
+    LMatrixParallelFor(C.RowLen, (unsigned long long)C.RowLen * C.ColumnLen, LMATRIX_PARALLEL_SIZE, 
+        [&A, &B, &C](size_t rowBegin, size_t rowEnd)
+    {
+        const size_t csA = A.m_columnStride;
+        const size_t csB = B.m_columnStride;
+        for (size_t i = rowBegin; i < rowEnd; i++)
+        {
+            const Type* pA = &A.m_pData[i * A.m_rowStride];
+            const Type* pB = &B.m_pData[i * B.m_rowStride];
+            Type* pC = &C.m_dataList[i * C.m_rowStride];
+            if (csA == 1 && csB == 1)
+            {
+                Op::ApplyRow(C.ColumnLen, pA, pB, pC);
+            }
+            else
+            {
+                for (size_t j = 0; j < C.ColumnLen; j++)
+                    pC[j] = Op::Apply(pA[j * csA], pB[j * csB]);
+            }
+        }
+    });
 }
 
 LTEMPLATE
-bool LMatrix<Type>::Empty() const
+template<typename Op>
+void LMatrix<Type>::ElementWise(IN const LMatrixView<Type>& A, IN const Type& B, OUT LMatrix<Type>& C)
 {
-    if (this->m_columnLen == 0 || this->m_rowLen == 0)
-        return true;
+    // 只读映射的C可能同时是输入, 与C冲突的输入见ElementOverlap, 都先计算到临时矩阵中
+    if (C.ReadOnly() || ElementOverlap(A, C))
+    {
+        LMatrix<Type> temp;
+        ElementWise<Op>(A, B, temp);
+        C = std::move(temp);
+        return;
+    }
 
-    return false;
+    C.Reset(A.RowLen, A.ColumnLen);
+
+    LMatrixParallelFor(C.RowLen, (unsigned long long)C.RowLen * C.ColumnLen, LMATRIX_PARALLEL_SIZE, 
+        [&A, &B, &C](size_t rowBegin, size_t rowEnd)
+    {
+        const size_t csA = A.m_columnStride;
+        for (size_t i = rowBegin; i < rowEnd; i++)
+        {
+            const Type* pA = &A.m_pData[i * A.m_rowStride];
+            Type* pC = &C.m_dataList[i * C.m_rowStride];
+            if (csA == 1)
+            {
+                Op::ApplyRow(C.ColumnLen, pA, B, pC);
+            }
+            else
+            {
+                for (size_t j = 0; j < C.ColumnLen; j++)
+                    pC[j] = Op::Apply(pA[j * csA], B);
+            }
+        }
+    });
 }
 
 LTEMPLATE
-bool LMatrix<Type>::Square() const
+bool LMatrix<Type>::ElementOverlap(IN const LMatrixView<Type>& A, IN const LMatrix<Type>& C)
 {
-    if (this->m_columnLen == this->m_rowLen)
-    {
-        if (this->m_columnLen != 0)
-            return true;
-    }
+    if (A.m_pData == C.m_dataList && 
+        A.m_rowLen == C.m_rowLen && 
+        A.m_columnLen == C.m_columnLen && 
+        A.m_rowStride == C.m_rowStride && 
+        A.m_columnStride == 1)
+        return false;
 
-    return false;
+    return A.Overlap(C);
 }
 
 LTEMPLATE
-LMatrix<Type> LMatrix<Type>::T() const
+bool LMatrix<Type>::ADD(IN const LMatrixView<Type>& A, IN const LMatrixView<Type>& B, OUT LMatrix<Type>& C)
 {
-    LMatrix<Type> B;
-    T(*this, B);
-    return B;
+    if ((A.RowLen != B.RowLen) || (A.ColumnLen != B.ColumnLen))
+        return false;
+
+    ElementWise<LMatrixOpAdd<Type> >(A, B, C);
+
+    return true;
 }
 
 LTEMPLATE
-void LMatrix<Type>::SplitRow(IN unsigned int rowIdx, OUT LMatrix<Type>& up, OUT LMatrix<Type>& down) const
+bool LMatrix<Type>::SUB(IN const LMatrixView<Type>& A, IN const LMatrixView<Type>& B, OUT LMatrix<Type>& C)
 {
-    up.Reset(0, 0);
-    down.Reset(0, 0);
+    if ((A.RowLen != B.RowLen) || (A.ColumnLen != B.ColumnLen))
+        return false;
 
-    SUBMATRIX(*this, 0, rowIdx, 0, this->ColumnLen, up);
-    SUBMATRIX(*this, rowIdx, this->RowLen-rowIdx, 0, this->ColumnLen, down);
+    ElementWise<LMatrixOpSub<Type> >(A, B, C);
+
+    return true;
 }
 
 LTEMPLATE
-void LMatrix<Type>::SplitCloumn(IN unsigned int colIdx, OUT LMatrix<Type>& left, OUT LMatrix<Type>& right) const
+bool LMatrix<Type>::MUL(IN const LMatrixView<Type>& A, IN const LMatrixView<Type>& B, OUT LMatrix<Type>& C)
 {
-    left.Reset(0, 0);
-    right.Reset(0, 0);
+    if (A.ColumnLen != B.RowLen)
+        return false;
 
-    SUBMATRIX(*this, 0, this->RowLen, 0, colIdx, left);
-    SUBMATRIX(*this, 0, this->RowLen, colIdx, this->ColumnLen - colIdx, right);
+    // 输入与C重叠时(如MUL(C, B, C)), 先计算到临时矩阵中
+    if (C.ReadOnly() || A.Overlap(C) || B.Overlap(C))
+    {
+        LMatrix<Type> temp;
+        MUL(A, B, temp);
+        C = std::move(temp);
+        return true;
+    }
+
+    C.Reset(A.RowLen, B.ColumnLen);
+    if (C.Empty())
+        return true;
+
+    LMatrixParallelGemm(A, B, C.m_dataList, C.m_rowStride);
+
+    return true;
 }
 
 LTEMPLATE
-LMatrix<Type> LMatrix<Type>::SubMatrix(IN unsigned int rowStart, IN unsigned int rowLen, IN unsigned int colStart, IN unsigned int colLen) const
+bool LMatrix<Type>::MUL_AT_B(IN const LMatrixView<Type>& A, IN const LMatrixView<Type>& B, OUT LMatrix<Type>& C)
 {
-    LMatrix<Type> D;
-    SUBMATRIX(*this, rowStart, rowLen, colStart, colLen, D);
-    return D;
+    return MUL(A.T(), B, C);
 }
 
 LTEMPLATE
-void LMatrix<Type>::SubMatrix(IN unsigned int rowStart, IN unsigned int rowLen, IN unsigned int colStart, IN unsigned int colLen, OUT LMatrix<Type>& D) const
+bool LMatrix<Type>::MUL_A_BT(IN const LMatrixView<Type>& A, IN const LMatrixView<Type>& B, OUT LMatrix<Type>& C)
 {
-    SUBMATRIX(*this, rowStart, rowLen, colStart, colLen, D);
+    return MUL(A, B.T(), C);
 }
 
 LTEMPLATE
-LMatrix<Type> LMatrix<Type>::GetRow(IN unsigned int row) const
+bool LMatrix<Type>::SCALARMUL(IN const LMatrixView<Type>& A, IN const Type& B, OUT LMatrix<Type>& C)
 {
-    LMatrix<Type> rowVector(1, this->m_columnLen);
-    this->GetRow(row, rowVector);
+    ElementWise<LMatrixOpMul<Type> >(A, B, C);
 
-    return rowVector;
+    return true;
 }
 
 LTEMPLATE
-void LMatrix<Type>::GetRow(IN unsigned int row, OUT LMatrix<Type>& rowVector) const
+bool LMatrix<Type>::DOTMUL(IN const LMatrixView<Type>& A, IN const LMatrixView<Type>& B, OUT LMatrix<Type>& C)
 {
-    rowVector.Reset(1, this->m_columnLen);
-    for (unsigned int i = 0; i < this->m_columnLen; i++)
-    {
-        rowVector.m_dataTable[0][i] = this->m_dataTable[row][i];
-    }
+    if ((A.RowLen != B.RowLen) || (A.ColumnLen != B.ColumnLen))
+        return false;
+
+    ElementWise<LMatrixOpMul<Type> >(A, B, C);
+
+    return true;
 }
 
 LTEMPLATE
-LMatrix<Type> LMatrix<Type>::GetColumn(IN unsigned int col) const
+bool LMatrix<Type>::SCALARDIV(IN const LMatrixView<Type>& A, IN const Type& B, OUT LMatrix<Type>& C)
 {
-    LMatrix<Type> columnVector(this->m_rowLen, 1);
-    this->GetColumn(col, columnVector);
+    ElementWise<LMatrixOpDiv<Type> >(A, B, C);
 
-    return columnVector;
+    return true;
 }
 
 LTEMPLATE
-void LMatrix<Type>::GetColumn(IN unsigned int col, OUT LMatrix<Type>& colVector) const
+bool LMatrix<Type>::DOTDIV(IN const LMatrixView<Type>& A, IN const LMatrixView<Type>& B, OUT LMatrix<Type>& C)
 {
-    colVector.Reset(this->m_rowLen, 1);
-    for (unsigned int i = 0; i < this->m_rowLen; i++)
-    {
-        colVector.m_dataTable[i][0] = this->m_dataTable[i][col];
-    }
+    if ((A.RowLen != B.RowLen) || (A.ColumnLen != B.ColumnLen))
+        return false;
+
+    ElementWise<LMatrixOpDiv<Type> >(A, B, C);
+
+    return true;
 }
 
 LTEMPLATE
-void LMatrix<Type>::Reset(IN unsigned int row, IN unsigned int col)
+template<typename Reduce>
+void LMatrix<Type>::RowReduce(IN const LMatrixView<Type>& A, OUT LMatrix<typename Reduce::Result>& B)
 {
-    if ((this->m_rowLen != row) || this->m_columnLen != col)
+    // 输入与B重叠时(如ROWSUM(B, B)), 先计算到临时矩阵中
+    if (ReduceOverlap(A, B))
     {
-        if (this->m_dataTable)
-        {
-            delete[] this->m_dataTable;
-            this->m_dataTable = 0;
-        }
+        LMatrix<typename Reduce::Result> temp;
+        RowReduce<Reduce>(A, temp);
+        B = std::move(temp);
+        return;
+    }
 
-        if (this->m_dataList)
-        {
-            delete[] this->m_dataList;
-            this->m_dataList = 0;
-        }
+    B.Reset(A.RowLen, 1);
 
-        
-        if (row * col > 0)
+    LMatrixParallelFor(A.RowLen, (unsigned long long)A.RowLen * A.ColumnLen, LMATRIX_PARALLEL_SIZE, 
+        [&A, &B](size_t rowBegin, size_t rowEnd)
+    {
+        const size_t csA = A.m_columnStride;
+        std::vector<Type> rowBuffer(csA == 1 ? 0 : A.ColumnLen);
+        for (size_t i = rowBegin; i < rowEnd; i++)
         {
-            this->m_rowLen = row;
-            this->m_columnLen = col;
-
-            this->m_dataTable = new Type*[this->m_rowLen];
-            this->m_dataList = new Type[this->m_rowLen * this->m_columnLen];
-            for (unsigned int i = 0; i < this->m_rowLen; i++)
+            const Type* pA = &A.m_pData[i * A.m_rowStride];
+            if (csA != 1)
             {
-                this->m_dataTable[i] = &this->m_dataList[this->m_columnLen * i];
+                for (size_t j = 0; j < A.ColumnLen; j++)
+                    rowBuffer[j] = pA[j * csA];
+                pA = rowBuffer.data();
             }
+            B[i][0] = Reduce::Reduce(A.ColumnLen, pA);
         }
-        else
-        {
-            this->m_rowLen = 0;
-            this->m_columnLen = 0;
-        }
-    }
+    });
 }
 
 LTEMPLATE
-void LMatrix<Type>::Reset(IN unsigned int row, IN unsigned int col, IN const Type& initValue)
+template<typename Reduce>
+void LMatrix<Type>::ColumnReduce(IN const LMatrixView<Type>& A, OUT LMatrix<Type>& B)
 {
-    this->Reset(row, col);
+    // 输入与B重叠时(如COLUMNSUM(B, B)), 先计算到临时矩阵中
+    if (B.ReadOnly() || A.Overlap(B))
+    {
+        LMatrix<Type> temp;
+        ColumnReduce<Reduce>(A, temp);
+        B = std::move(temp);
+        return;
+    }
 
-    unsigned int size = row * col;
-    for (unsigned int i = 0; i < size; i++)
+    if (A.m_columnStride != 1)
     {
-        this->m_dataList[i] = initValue;
+        LMatrix<Type> column;
+        RowReduce<Reduce>(A.T(), column);
+        B.Reset(1, A.ColumnLen);
+        for (size_t j = 0; j < A.ColumnLen; j++)
+            B.m_dataList[j] = column.m_dataList[j * column.m_rowStride];
+        return;
     }
+
+    B.Reset(1, A.ColumnLen);
+
+    LMatrixParallelFor(A.ColumnLen, (unsigned long long)A.RowLen * A.ColumnLen, LMATRIX_PARALLEL_SIZE, 
+        [&A, &B](size_t colBegin, size_t colEnd)
+    {
+        const size_t len = colEnd - colBegin;
+        Type* pB = &B.m_dataList[colBegin];
+        for (size_t j = 0; j < len; j++)
+            pB[j] = A.m_pData[colBegin + j];
+        for (size_t i = 1; i < A.RowLen; i++)
+            Reduce::Merge(len, &A.m_pData[i * A.m_rowStride + colBegin], pB);
+    });
 }
 
 LTEMPLATE
-bool LMatrix<Type>::ADD(IN const LMatrix<Type>& A, IN const LMatrix<Type>& B, OUT LMatrix<Type>& C)
+bool LMatrix<Type>::ROWSUM(IN const LMatrixView<Type>& A, OUT LMatrix<Type>& B)
 {
-    if ((A.RowLen != B.RowLen) || (A.ColumnLen != B.ColumnLen))
-        return false;
-
-    C.Reset(A.RowLen, A.ColumnLen);
-
-    for (unsigned int i = 0; i < C.RowLen; i++)
-    {
-        for (unsigned int j = 0; j < C.ColumnLen; j++)
-        {
-            C.m_dataTable[i][j] = A.m_dataTable[i][j] + B.m_dataTable[i][j];
-        }
-    }
+    RowReduce<LMatrixReduceSum<Type> >(A, B);
 
     return true;
 }
 
 LTEMPLATE
-bool LMatrix<Type>::SUB(IN const LMatrix<Type>& A, IN const LMatrix<Type>& B, OUT LMatrix<Type>& C)
+bool LMatrix<Type>::COLUMNSUM(IN const LMatrixView<Type>& A, OUT LMatrix<Type>& B)
 {
-    if ((A.RowLen != B.RowLen) || (A.ColumnLen != B.ColumnLen))
-        return false;
-
-    C.Reset(A.RowLen, A.ColumnLen);
-
-    for (unsigned int i = 0; i < C.RowLen; i++)
+    if (A.RowLen == 0)
     {
-        for (unsigned int j = 0; j < C.ColumnLen; j++)
-        {
-            C.m_dataTable[i][j] = A.m_dataTable[i][j] - B.m_dataTable[i][j];
-        }
+        B.Reset(1, A.ColumnLen, Type(0));
+        return true;
     }
 
+    ColumnReduce<LMatrixReduceSum<Type> >(A, B);
+
     return true;
 }
 
-
-
 LTEMPLATE
-bool LMatrix<Type>::MUL(IN const LMatrix<Type>& A, IN const LMatrix<Type>& B, OUT LMatrix<Type>& C)
+bool LMatrix<Type>::ROWMAX(IN const LMatrixView<Type>& A, OUT LMatrix<Type>& B)
 {
-    if (A.ColumnLen != B.RowLen)
+    if (A.ColumnLen == 0)
         return false;
 
-    C.Reset(A.RowLen, B.ColumnLen);
-
-    for (unsigned int i = 0; i < C.RowLen; i++)
-    {
-        for (unsigned int j = 0; j < C.ColumnLen; j++)
-        {
-            C.m_dataTable[i][j] = A.m_dataTable[i][0] * B.m_dataTable[0][j];
-            for (unsigned int k = 1; k < A.ColumnLen; k++)
-            {
-                C.m_dataTable[i][j] += A.m_dataTable[i][k] * B.m_dataTable[k][j];
-            }
-        }
-    }
+    RowReduce<LMatrixReduceMax<Type> >(A, B);
 
     return true;
 }
 
 LTEMPLATE
-bool LMatrix<Type>::SCALARMUL(IN const LMatrix<Type>& A, IN const Type& B, OUT LMatrix<Type>& C)
+bool LMatrix<Type>::ROWMIN(IN const LMatrixView<Type>& A, OUT LMatrix<Type>& B)
 {
-    C.Reset(A.RowLen, A.ColumnLen);
-    for (unsigned int row = 0; row < A.RowLen; row++)
-    {
-        for (unsigned int col = 0; col < A.ColumnLen; col++)
-        {
-            C.m_dataTable[row][col] = A.m_dataTable[row][col] * B;
-        }
-    }
+    if (A.ColumnLen == 0)
+        return false;
+
+    RowReduce<LMatrixReduceMin<Type> >(A, B);
 
     return true;
 }
 
 LTEMPLATE
-bool LMatrix<Type>::DOTMUL(IN const LMatrix<Type>& A, IN const LMatrix<Type>& B, OUT LMatrix<Type>& C)
+bool LMatrix<Type>::COLUMNMAX(IN const LMatrixView<Type>& A, OUT LMatrix<Type>& B)
 {
-    if ((A.RowLen != B.RowLen) || (A.ColumnLen != B.ColumnLen))
+    if (A.RowLen == 0)
         return false;
 
-    C.Reset(A.RowLen, A.ColumnLen);
-
-    for (unsigned int i = 0; i < C.RowLen; i++)
-    {
-        for (unsigned int j = 0; j < C.ColumnLen; j++)
-        {
-            C.m_dataTable[i][j] = A.m_dataTable[i][j] * B.m_dataTable[i][j];
-        }
-    }
+    ColumnReduce<LMatrixReduceMax<Type> >(A, B);
 
     return true;
 }
 
 LTEMPLATE
-bool LMatrix<Type>::SCALARDIV(IN const LMatrix<Type>& A, IN const Type& B, OUT LMatrix<Type>& C)
+bool LMatrix<Type>::COLUMNMIN(IN const LMatrixView<Type>& A, OUT LMatrix<Type>& B)
 {
-    C.Reset(A.RowLen, A.ColumnLen);
-    for (unsigned int row = 0; row < A.RowLen; row++)
-    {
-        for (unsigned int col = 0; col < A.ColumnLen; col++)
-        {
-            C.m_dataTable[row][col] = A.m_dataTable[row][col] / B;
-        }
-    }
+    if (A.RowLen == 0)
+        return false;
+
+    ColumnReduce<LMatrixReduceMin<Type> >(A, B);
 
     return true;
 }
 
 LTEMPLATE
-bool LMatrix<Type>::DOTDIV(IN const LMatrix<Type>& A, IN const LMatrix<Type>& B, OUT LMatrix<Type>& C)
+bool LMatrix<Type>::ROWARGMAX(IN const LMatrixView<Type>& A, OUT LMatrix<size_t>& B)
 {
-    if ((A.RowLen != B.RowLen) || (A.ColumnLen != B.ColumnLen))
+    if (A.ColumnLen == 0)
         return false;
 
-    C.Reset(A.RowLen, A.ColumnLen);
-
-    for (unsigned int i = 0; i < C.RowLen; i++)
-    {
-        for (unsigned int j = 0; j < C.ColumnLen; j++)
-        {
-            C.m_dataTable[i][j] = A.m_dataTable[i][j] / B.m_dataTable[i][j];
-        }
-    }
+    RowReduce<LMatrixReduceArgMax<Type> >(A, B);
 
     return true;
 }
 
 LTEMPLATE
-bool LMatrix<Type>::T(IN const LMatrix<Type>& A, OUT LMatrix<Type>& B)
+bool LMatrix<Type>::T(IN const LMatrixView<Type>& A, OUT LMatrix<Type>& B)
 {
-    B.Reset(A.ColumnLen, A.RowLen);
-    for (unsigned int i = 0; i < A.RowLen; i++)
+    // 输入与B重叠时(如T(B, B)), 先计算到临时矩阵中
+    if (B.ReadOnly() || A.Overlap(B))
     {
-        for (unsigned int j = 0; j < A.ColumnLen; j++)
-            B.m_dataTable[j][i] = A.m_dataTable[i][j];
+        LMatrix<Type> temp;
+        T(A, temp);
+        B = std::move(temp);
+        return true;
     }
 
+    B.Reset(A.ColumnLen, A.RowLen);
+
+    LMatrixParallelFor(B.RowLen, (unsigned long long)B.RowLen * B.ColumnLen, LMATRIX_PARALLEL_SIZE, 
+        [&A, &B](size_t rowBegin, size_t rowEnd)
+    {
+        for (size_t j = rowBegin; j < rowEnd; j++)
+        {
+            const Type* pA = &A.m_pData[j * A.m_columnStride];
+            Type* pB = &B.m_dataList[j * B.m_rowStride];
+            for (size_t i = 0; i < A.RowLen; i++)
+                pB[i] = pA[i * A.m_rowStride];
+        }
+    });
+
     return true;
 }
 
 LTEMPLATE
 bool LMatrix<Type>::SUBMATRIX(
-IN const LMatrix<Type>& S, 
-IN unsigned int rowStart, 
-IN unsigned int rowLen, 
-IN unsigned int colStart, 
-IN unsigned int colLen, 
+IN const LMatrixView<Type>& S, 
+IN size_t rowStart, 
+IN size_t rowLen, 
+IN size_t colStart, 
+IN size_t colLen, 
 OUT LMatrix<Type>& D)
 {
     if ((rowStart + rowLen) > S.RowLen)
@@ -757,11 +2509,20 @@ OUT LMatrix<Type>& D)
     if (rowLen < 1 || colLen < 1)
         return false;
 
+    // 输入与D重叠时(如SUBMATRIX(D, ..., D)), 先复制到临时矩阵中
+    if (D.ReadOnly() || S.Overlap(D))
+    {
+        LMatrix<Type> temp;
+        SUBMATRIX(S, rowStart, rowLen, colStart, colLen, temp);
+        D = std::move(temp);
+        return true;
+    }
+
     D.Reset(rowLen, colLen);
 
-    for (unsigned int row = 0; row < D.RowLen; row++)
+    for (size_t row = 0; row < D.RowLen; row++)
     {
-        for (unsigned int col = 0; col < D.ColumnLen; col++)
+        for (size_t col = 0; col < D.ColumnLen; col++)
         {
             D[row][col] = S[rowStart + row][colStart + col];
         }
@@ -770,7 +2531,160 @@ OUT LMatrix<Type>& D)
     return true;
 }
 
+LTEMPLATE
+LMatrixView<Type>::LMatrixView()
+: m_pData(0), m_rowLen(0), m_columnLen(0), m_rowStride(0), m_columnStride(0), RowLen(m_rowLen), ColumnLen(m_columnLen)
+{
+
+}
+
+LTEMPLATE
+LMatrixView<Type>::LMatrixView(IN const LMatrix<Type>& m)
+: m_pData(m.m_dataList), 
+m_rowLen(m.m_rowLen), 
+m_columnLen(m.m_columnLen), 
+m_rowStride(m.m_rowStride), 
+m_columnStride(1), 
+RowLen(m_rowLen), 
+ColumnLen(m_columnLen)
+{
+
+}
+
+LTEMPLATE
+LMatrixView<Type>::LMatrixView(
+    IN const Type* pData, 
+    IN size_t row, 
+    IN size_t col, 
+    IN size_t rowStride, 
+    IN size_t colStride)
+: m_pData(pData), 
+m_rowLen(row), 
+m_columnLen(col), 
+m_rowStride(rowStride), 
+m_columnStride(colStride), 
+RowLen(m_rowLen), 
+ColumnLen(m_columnLen)
+{
+    if (row == 0 || col == 0 || pData == 0)
+    {
+        m_pData = 0;
+        m_rowLen = 0;
+        m_columnLen = 0;
+    }
+}
+
+LTEMPLATE
+LMatrixView<Type>::LMatrixView(IN const LMatrixView<Type>& rhs)
+: m_pData(rhs.m_pData), 
+m_rowLen(rhs.m_rowLen), 
+m_columnLen(rhs.m_columnLen), 
+m_rowStride(rhs.m_rowStride), 
+m_columnStride(rhs.m_columnStride), 
+RowLen(m_rowLen), 
+ColumnLen(m_columnLen)
+{
+
+}
+
+LTEMPLATE
+LMatrixView<Type>& LMatrixView<Type>::operator = (IN const LMatrixView<Type>& rhs)
+{
+    this->m_pData = rhs.m_pData;
+    this->m_rowLen = rhs.m_rowLen;
+    this->m_columnLen = rhs.m_columnLen;
+    this->m_rowStride = rhs.m_rowStride;
+    this->m_columnStride = rhs.m_columnStride;
+
+    return *this;
+}
+
+LTEMPLATE
+typename LMatrixView<Type>::Row LMatrixView<Type>::operator[](IN size_t row) const
+{
+    return Row(&this->m_pData[row * this->m_rowStride], this->m_columnStride);
+}
+
+LTEMPLATE
+bool LMatrixView<Type>::Empty() const
+{
+    if (this->m_columnLen == 0 || this->m_rowLen == 0)
+        return true;
+
+    return false;
+}
+
+LTEMPLATE
+bool LMatrixView<Type>::Contiguous() const
+{
+    return this->m_columnStride == 1 && (this->m_rowStride == this->m_columnLen || this->m_rowLen == 1);
+}
+
+LTEMPLATE
+const Type* LMatrixView<Type>::Data() const
+{
+    return m_pData;
+}
+
+LTEMPLATE
+size_t LMatrixView<Type>::RowStride() const
+{
+    return m_rowStride;
+}
+
+LTEMPLATE
+size_t LMatrixView<Type>::ColumnStride() const
+{
+    return m_columnStride;
+}
+
+LTEMPLATE
+bool LMatrixView<Type>::Overlap(IN const LMatrix<Type>& m) const
+{
+    const LMatrixViewLeaf<Type> leaf(*this);
+    return leaf.Overlap(m.m_dataList, m.m_dataList + m.m_rowLen * m.m_rowStride);
+}
+
+LTEMPLATE
+LMatrixView<Type> LMatrixView<Type>::T() const
+{
+    return LMatrixView<Type>(this->m_pData, this->m_columnLen, this->m_rowLen, this->m_columnStride, this->m_rowStride);
+}
+
+LTEMPLATE
+LMatrixView<Type> LMatrixView<Type>::SubMatrix(
+    IN size_t rowStart, 
+    IN size_t rowLen, 
+    IN size_t colStart, 
+    IN size_t colLen) const
+{
+    if ((rowStart + rowLen) > this->m_rowLen)
+        return LMatrixView<Type>();
+
+    if ((colStart + colLen) > this->m_columnLen)
+        return LMatrixView<Type>();
+
+    if (rowLen < 1 || colLen < 1)
+        return LMatrixView<Type>();
+
+    return LMatrixView<Type>(
+        &this->m_pData[rowStart * this->m_rowStride + colStart * this->m_columnStride], 
+        rowLen, 
+        colLen, 
+        this->m_rowStride, 
+        this->m_columnStride);
+}
 
+LTEMPLATE
+LMatrixView<Type> LMatrixView<Type>::GetRow(IN size_t row) const
+{
+    return LMatrixView<Type>(&this->m_pData[row * this->m_rowStride], 1, this->m_columnLen, this->m_rowStride, this->m_columnStride);
+}
 
+LTEMPLATE
+LMatrixView<Type> LMatrixView<Type>::GetColumn(IN size_t col) const
+{
+    return LMatrixView<Type>(&this->m_pData[col * this->m_columnStride], this->m_rowLen, 1, this->m_rowStride, this->m_columnStride);
+}
 
 #endif
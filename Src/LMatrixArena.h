@@ -0,0 +1,256 @@
+﻿/// @file LMatrixArena.h
+/// @brief 矩阵内存池头文件
+///
+/// Detail: 训练循环中每次迭代都会创建和销毁大量临时矩阵, 内存池让这些矩阵从预先分配的内存块中顺序分配,
+/// 矩阵析构时不释放内存, 迭代结束时以O(1)的代价重置内存池, 稳定后的迭代中没有malloc和free调用
+/// 在LMatrixArenaScope的作用域中, 当前线程中分配的矩阵数据(见LMatrixStorage)都来自内存池
+/// 内存块有引用计数, 作用域结束后仍然存在的矩阵(如在迭代中第一次Reset的成员矩阵)会让内存块继续有效,
+/// 此时内存池改用新的内存块, 所以误用不会导致数据被覆盖, 只是无法复用内存
+/// 注意: 一个内存池同一时间只能在一个线程中使用, 矩阵可以在任意线程中释放
+/// @author Jie Liu Email:coderjie@outlook.com
+/// @version
+/// @date 2026/10/17
+
+/*  使用内存池的示例代码如下
+
+LMatrixArena arena;
+for (unsigned int i = 0; i < iterCount; i++)
+{
+    // 作用域结束时重置内存池
+    LMatrixArenaScope scope(arena);
+
+    LMatrix<float> temp;
+    LMatrix<float>::MUL(A, B, temp);
+    ...
+}
+*/
+
+#ifndef _LMATRIXARENA_H_
+#define _LMATRIXARENA_H_
+
+#include <new>
+#include <cstddef>
+#include <cstdlib>
+#include <atomic>
+
+#ifndef IN
+#define IN
+#endif
+
+#ifndef INOUT
+#define INOUT
+#endif
+
+#ifndef OUT
+#define OUT
+#endif
+
+/// @brief 内存池默认的内存块大小(字节)
+#ifndef LMATRIX_ARENA_BLOCK_SIZE
+#define LMATRIX_ARENA_BLOCK_SIZE (256 * 1024)
+#endif
+
+/// @brief 矩阵数据的堆内存分配计数(所有元素类型)
+/// 每次为矩阵数据分配堆内存(包括内存池的内存块)时加1, 用于基准测试统计分配次数
+/// @return 计数器
+inline std::atomic<unsigned long long>& LMatrixAllocationCounter()
+{
+    static std::atomic<unsigned long long> s_counter(0);
+    return s_counter;
+}
+
+/// @brief 内存池中的内存块
+/// 引用计数为内存池持有的1个引用加上块中未释放的分配个数, 计数为0时释放内存块
+struct LMatrixArenaBlock
+{
+    std::atomic<size_t> RefCount;   ///< 引用计数
+    size_t Size;                    ///< 可分配的字节数
+    size_t Offset;                  ///< 已分配的字节数
+
+    /// @brief 获取可分配区域的首地址
+    unsigned char* Data()
+    {
+        return reinterpret_cast<unsigned char*>(this) + HEADER_SIZE;
+    }
+
+    /// @brief 内存块头部的字节数
+    static const size_t HEADER_SIZE = 
+        ((sizeof(std::atomic<size_t>) + 2 * sizeof(size_t) + sizeof(std::max_align_t) - 1) / 
+        sizeof(std::max_align_t)) * sizeof(std::max_align_t);
+};
+
+/// @brief 矩阵内存池
+class LMatrixArena
+{
+public:
+    /// @brief 构造函数
+    /// 第一次分配时才分配内存块
+    /// @param[in] blockSize 内存块的最小字节数
+    explicit LMatrixArena(IN size_t blockSize = LMATRIX_ARENA_BLOCK_SIZE)
+        : m_pBlock(0), m_blockSize(blockSize), m_used(0)
+    {
+    }
+
+    /// @brief 析构函数
+    /// 还有未释放的矩阵时, 内存块在最后一个矩阵释放时释放
+    ~LMatrixArena()
+    {
+        if (m_pBlock != 0)
+            Release(m_pBlock);
+    }
+
+    /// @brief 获取当前线程正在使用的内存池
+    /// @return 内存池, 不在LMatrixArenaScope的作用域中时返回0
+    static LMatrixArena* Current()
+    {
+        return CurrentRef();
+    }
+
+    /// @brief 分配内存
+    /// 当前内存块的剩余空间不足时, 分配能容纳本轮全部分配的新内存块, 旧的内存块在其中的矩阵都释放后释放
+    /// @param[in] size 字节数
+    /// @param[in] alignment 对齐字节数, 必须为2的幂
+    /// @param[out] pBlock 存储所在的内存块, 释放时需要调用Release(pBlock)
+    /// @return 内存地址, 内存不足时抛出std::bad_alloc
+    void* Allocate(IN size_t size, IN size_t alignment, OUT LMatrixArenaBlock*& pBlock)
+    {
+        if (size > (size_t)-1 / 2 - alignment)
+            throw std::bad_alloc();
+
+        m_used += size + alignment;
+
+        if (m_pBlock == 0 || this->Fit(m_pBlock, size, alignment) == 0)
+        {
+            if (m_blockSize < m_used)
+                m_blockSize = m_used;
+            LMatrixArenaBlock* pNewBlock = NewBlock(m_blockSize);
+            if (m_pBlock != 0)
+                Release(m_pBlock);
+            m_pBlock = pNewBlock;
+        }
+
+        unsigned char* pMemory = this->Fit(m_pBlock, size, alignment);
+        m_pBlock->Offset = (size_t)(pMemory - m_pBlock->Data()) + size;
+        m_pBlock->RefCount.fetch_add(1, std::memory_order_relaxed);
+        pBlock = m_pBlock;
+
+        return pMemory;
+    }
+
+    /// @brief 重置内存池
+    /// 当前内存块中没有未释放的矩阵时直接复用, 否则放弃该内存块(在其中的矩阵都释放后释放)
+    void Reset()
+    {
+        m_used = 0;
+        if (m_pBlock == 0)
+            return;
+
+        if (m_pBlock->RefCount.load(std::memory_order_acquire) == 1)
+        {
+            m_pBlock->Offset = 0;
+        }
+        else
+        {
+            Release(m_pBlock);
+            m_pBlock = 0;
+        }
+    }
+
+    /// @brief 获取当前内存块的大小
+    /// @return 字节数, 还没有分配内存块时返回0
+    size_t Capacity() const
+    {
+        return m_pBlock != 0 ? m_pBlock->Size : 0;
+    }
+
+    /// @brief 释放内存块的一个引用
+    /// 引用计数为0时释放内存块
+    /// @param[in] pBlock 内存块
+    static void Release(IN LMatrixArenaBlock* pBlock)
+    {
+        if (pBlock->RefCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            pBlock->~LMatrixArenaBlock();
+            free(pBlock);
+        }
+    }
+
+private:
+    friend class LMatrixArenaScope;
+
+    /// @brief 当前线程正在使用的内存池
+    static LMatrixArena*& CurrentRef()
+    {
+        static thread_local LMatrixArena* s_pCurrent = 0;
+        return s_pCurrent;
+    }
+
+    /// @brief 在内存块的剩余空间中查找对齐的地址
+    /// @return 地址, 剩余空间不足时返回0
+    unsigned char* Fit(IN LMatrixArenaBlock* pBlock, IN size_t size, IN size_t alignment) const
+    {
+        const size_t start = (size_t)pBlock->Data() + pBlock->Offset;
+        const size_t aligned = (start + alignment - 1) & ~(alignment - 1);
+        if (aligned - (size_t)pBlock->Data() + size > pBlock->Size)
+            return 0;
+
+        return reinterpret_cast<unsigned char*>(aligned);
+    }
+
+    /// @brief 分配新的内存块, 引用计数为1(内存池持有)
+    static LMatrixArenaBlock* NewBlock(IN size_t size)
+    {
+        if (size > (size_t)-1 - LMatrixArenaBlock::HEADER_SIZE)
+            throw std::bad_alloc();
+
+        void* pMemory = malloc(LMatrixArenaBlock::HEADER_SIZE + size);
+        if (pMemory == 0)
+            throw std::bad_alloc();
+        LMatrixAllocationCounter().fetch_add(1, std::memory_order_relaxed);
+
+        LMatrixArenaBlock* pBlock = new (pMemory) LMatrixArenaBlock();
+        pBlock->RefCount.store(1, std::memory_order_relaxed);
+        pBlock->Size = size;
+        pBlock->Offset = 0;
+        return pBlock;
+    }
+
+private:
+    LMatrixArena(const LMatrixArena&);
+    LMatrixArena& operator = (const LMatrixArena&);
+
+    LMatrixArenaBlock* m_pBlock;    ///< 当前内存块
+    size_t m_blockSize;             ///< 新内存块的大小, 不小于一轮中的分配总量
+    size_t m_used;                  ///< 本轮(上次重置后)分配的字节数(包括对齐的填充)
+};
+
+/// @brief 内存池作用域
+/// 构造时将内存池设为当前线程正在使用的内存池, 析构时恢复之前的内存池并重置该内存池
+/// 作用域可以嵌套
+class LMatrixArenaScope
+{
+public:
+    /// @brief 构造函数
+    /// @param[in] arena 内存池
+    explicit LMatrixArenaScope(INOUT LMatrixArena& arena)
+        : m_arena(arena), m_pPrevious(LMatrixArena::CurrentRef())
+    {
+        LMatrixArena::CurrentRef() = &arena;
+    }
+
+    /// @brief 析构函数
+    ~LMatrixArenaScope()
+    {
+        LMatrixArena::CurrentRef() = m_pPrevious;
+        m_arena.Reset();
+    }
+
+private:
+    LMatrixArenaScope(const LMatrixArenaScope&);
+    LMatrixArenaScope& operator = (const LMatrixArenaScope&);
+
+    LMatrixArena& m_arena;          ///< 内存池
+    LMatrixArena* m_pPrevious;      ///< 之前的内存池
+};
+
+#endif
@@ -0,0 +1,476 @@
+﻿/// @file LMatrixFile.h
+/// @brief 矩阵二进制文件模板头文件
+///
+/// Detail: 矩阵的二进制文件格式(版本1), 文件由三部分组成:
+/// 1. 文件头(LMatrixFileHeader, 64字节): 魔数, 版本, 元素类型, 行列数, 行步长, 对齐字节数, 数据位置
+/// 2. 附加数据(可选): 紧跟文件头, 先是8字节的附加数据大小, 然后是附加数据, 不参与校验, 加载矩阵时忽略
+/// 3. 数据: 从DataOffset(对齐字节数的倍数)开始, 共RowLen行, 每行RowStride个元素, 行尾的填充元素为0
+/// 4. 文件尾(8字节): 数据的CRC-32校验值
+/// 所有字段和元素都使用本机字节序, 字节序不同的文件无法加载
+/// 数据的布局与LMatrix的内存布局相同, 所以加载时可以直接映射文件, 不需要复制数据(见LMatrixFile::Map)
+/// @author Jie Liu Email:coderjie@outlook.com
+/// @version
+/// @date 2026/10/17
+
+/*  使用矩阵二进制文件的示例代码如下
+
+LMatrix<float> dataMatrix(1000, 10, 1.0f);
+LMatrixFile<float>::Save(L"data.lmx", dataMatrix);
+
+// 复制到堆内存中, 并校验数据
+LMatrix<float> loadMatrix;
+LMatrixFile<float>::Load(L"data.lmx", loadMatrix);
+
+// 直接映射文件, 不复制数据
+LMatrix<float> mapMatrix;
+LMatrixFile<float>::Map(L"data.lmx", LMAPPED_FILE_READ_ONLY, mapMatrix);
+*/
+
+#ifndef _LMATRIXFILE_H_
+#define _LMATRIXFILE_H_
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "LMatrix.h"
+
+/// @brief 矩阵文件的版本
+#define LMATRIX_FILE_VERSION 1
+
+/// @brief 矩阵文件中的元素类型
+enum LMATRIX_FILE_TYPE
+{
+    LMATRIX_FILE_INT8 = 1,          ///< signed char
+    LMATRIX_FILE_UINT8 = 2,         ///< unsigned char
+    LMATRIX_FILE_INT16 = 3,         ///< short
+    LMATRIX_FILE_UINT16 = 4,        ///< unsigned short
+    LMATRIX_FILE_INT32 = 5,         ///< int
+    LMATRIX_FILE_UINT32 = 6,        ///< unsigned int
+    LMATRIX_FILE_INT64 = 7,         ///< long long
+    LMATRIX_FILE_UINT64 = 8,        ///< unsigned long long
+    LMATRIX_FILE_FLOAT32 = 9,       ///< float
+    LMATRIX_FILE_FLOAT64 = 10       ///< double
+};
+
+/// @brief 元素类型到文件元素类型的映射
+/// 只有特化的元素类型可以保存到文件中
+LTEMPLATE
+struct LMatrixFileType;
+
+template<> struct LMatrixFileType<signed char> { static const unsigned int VALUE = LMATRIX_FILE_INT8; };
+template<> struct LMatrixFileType<unsigned char> { static const unsigned int VALUE = LMATRIX_FILE_UINT8; };
+template<> struct LMatrixFileType<short> { static const unsigned int VALUE = LMATRIX_FILE_INT16; };
+template<> struct LMatrixFileType<unsigned short> { static const unsigned int VALUE = LMATRIX_FILE_UINT16; };
+template<> struct LMatrixFileType<int> { static const unsigned int VALUE = LMATRIX_FILE_INT32; };
+template<> struct LMatrixFileType<unsigned int> { static const unsigned int VALUE = LMATRIX_FILE_UINT32; };
+template<> struct LMatrixFileType<long>
+{
+    static const unsigned int VALUE = sizeof(long) == 8 ? LMATRIX_FILE_INT64 : LMATRIX_FILE_INT32;
+};
+template<> struct LMatrixFileType<unsigned long>
+{
+    static const unsigned int VALUE = sizeof(unsigned long) == 8 ? LMATRIX_FILE_UINT64 : LMATRIX_FILE_UINT32;
+};
+template<> struct LMatrixFileType<long long> { static const unsigned int VALUE = LMATRIX_FILE_INT64; };
+template<> struct LMatrixFileType<unsigned long long> { static const unsigned int VALUE = LMATRIX_FILE_UINT64; };
+template<> struct LMatrixFileType<float> { static const unsigned int VALUE = LMATRIX_FILE_FLOAT32; };
+template<> struct LMatrixFileType<double> { static const unsigned int VALUE = LMATRIX_FILE_FLOAT64; };
+
+/// @brief 矩阵文件头
+/// 大小为64字节, 数据位置DataOffset不小于文件头大小
+struct LMatrixFileHeader
+{
+    char Magic[8];                  ///< 魔数"LMATRIX"
+    unsigned int Version;           ///< 文件版本
+    unsigned int HeaderSize;        ///< 文件头大小(字节)
+    unsigned int ByteOrder;         ///< 字节序标记, 写入时为0x01020304
+    unsigned int DataType;          ///< 元素类型(LMATRIX_FILE_TYPE)
+    unsigned int ElementSize;       ///< 元素大小(字节)
+    unsigned int Alignment;         ///< 数据的对齐字节数
+    unsigned long long RowLen;      ///< 行数
+    unsigned long long ColumnLen;   ///< 列数
+    unsigned long long RowStride;   ///< 行步长(元素个数), 不小于列数
+    unsigned long long DataOffset;  ///< 数据在文件中的位置(字节)
+};
+
+/// @brief 矩阵文件的CRC-32(IEEE 802.3)校验
+class LMatrixFileChecksum
+{
+public:
+    /// @brief 构造函数
+    LMatrixFileChecksum()
+        : m_crc(0xFFFFFFFF)
+    {
+    }
+
+    /// @brief 累加数据
+    /// @param[in] pData 数据
+    /// @param[in] size 数据大小(字节)
+    void Update(IN const void* pData, IN size_t size)
+    {
+        const unsigned int* pTable = Table();
+        const unsigned char* pByte = static_cast<const unsigned char*>(pData);
+        unsigned int crc = m_crc;
+        for (size_t i = 0; i < size; i++)
+            crc = pTable[(crc ^ pByte[i]) & 0xFF] ^ (crc >> 8);
+        m_crc = crc;
+    }
+
+    /// @brief 获取校验值
+    unsigned int Value() const
+    {
+        return m_crc ^ 0xFFFFFFFF;
+    }
+
+private:
+    /// @brief 获取CRC表
+    static const unsigned int* Table()
+    {
+        static const std::vector<unsigned int> s_table = MakeTable();
+        return &s_table[0];
+    }
+
+    /// @brief 生成CRC表
+    static std::vector<unsigned int> MakeTable()
+    {
+        std::vector<unsigned int> table(256);
+        for (unsigned int i = 0; i < 256; i++)
+        {
+            unsigned int c = i;
+            for (int k = 0; k < 8; k++)
+                c = (c & 1) ? (0xEDB88320 ^ (c >> 1)) : (c >> 1);
+            table[i] = c;
+        }
+        return table;
+    }
+
+private:
+    unsigned int m_crc;             ///< 当前校验值
+};
+
+/// @brief 矩阵二进制文件
+/// 提供矩阵的保存, 加载(复制)和映射(不复制)
+/// @param Type 元素类型, 需要有LMatrixFileType的特化
+LTEMPLATE
+class LMatrixFile
+{
+public:
+    /// @brief 保存矩阵
+    /// 行步长和LMatrix相同, 数据按LMATRIX_ALIGNMENT对齐, 映射后每行的起始地址都是对齐的
+    /// 附加数据保存在文件头和矩阵数据之间, 用于记录调用者自己的信息(如数据来源), 见ReadExtra
+    /// @param[in] fileName 文件名
+    /// @param[in] M 矩阵(可以是任意视图)
+    /// @param[in] pExtra 附加数据, 为0表示没有附加数据
+    /// @param[in] extraSize 附加数据大小(字节)
+    /// @return 矩阵为空或者写入失败返回false
+    static bool Save(
+        IN const wchar_t* fileName,
+        IN const LMatrixView<Type>& M,
+        IN const void* pExtra = 0,
+        IN size_t extraSize = 0)
+    {
+        if (M.Empty())
+            return false;
+
+        if (pExtra == 0)
+            extraSize = 0;
+
+        FILE* pFile = OpenFile(fileName, L"wb");
+        if (pFile == 0)
+            return false;
+
+        LMatrixFileHeader header;
+        MakeHeader(M.RowLen, M.ColumnLen, extraSize, header);
+
+        bool ok = fwrite(&header, sizeof(header), 1, pFile) == 1;
+
+        // 附加数据
+        size_t extraLen = 0;
+        if (extraSize > 0)
+        {
+            unsigned long long sizeField = extraSize;
+            if (ok)
+                ok = fwrite(&sizeField, sizeof(sizeField), 1, pFile) == 1;
+            if (ok)
+                ok = fwrite(pExtra, 1, extraSize, pFile) == extraSize;
+            extraLen = sizeof(sizeField) + extraSize;
+        }
+
+        // 文件头和数据之间的填充
+        std::vector<char> padding((size_t)header.DataOffset - sizeof(header) - extraLen, 0);
+        if (ok && !padding.empty())
+            ok = fwrite(&padding[0], 1, padding.size(), pFile) == padding.size();
+
+        // 逐行写入, 行尾填充元素为0
+        LMatrixFileChecksum checksum;
+        const size_t rowStride = (size_t)header.RowStride;
+        std::vector<Type> rowBuffer(rowStride);
+        memset(&rowBuffer[0], 0, rowStride * sizeof(Type));
+        for (size_t i = 0; ok && i < M.RowLen; i++)
+        {
+            for (size_t j = 0; j < M.ColumnLen; j++)
+                rowBuffer[j] = M[i][j];
+
+            checksum.Update(&rowBuffer[0], rowStride * sizeof(Type));
+            ok = fwrite(&rowBuffer[0], sizeof(Type), rowStride, pFile) == rowStride;
+        }
+
+        unsigned long long tail = checksum.Value();
+        if (ok)
+            ok = fwrite(&tail, sizeof(tail), 1, pFile) == 1;
+
+        if (fclose(pFile) != 0)
+            ok = false;
+
+        return ok;
+    }
+
+    /// @brief 加载矩阵
+    /// 数据被复制到堆内存中, 并校验CRC-32
+    /// @param[in] fileName 文件名
+    /// @param[out] M 矩阵
+    /// @return 文件格式错误, 元素类型不匹配或者校验失败返回false, 矩阵不变
+    static bool Load(IN const wchar_t* fileName, OUT LMatrix<Type>& M)
+    {
+        FILE* pFile = OpenFile(fileName, L"rb");
+        if (pFile == 0)
+            return false;
+
+        LMatrixFileHeader header;
+        if (!ReadHeader(pFile, header) || !SeekFile(pFile, header.DataOffset))
+        {
+            fclose(pFile);
+            return false;
+        }
+
+        LMatrix<Type> D((size_t)header.RowLen, (size_t)header.ColumnLen);
+
+        bool ok = true;
+        LMatrixFileChecksum checksum;
+        const size_t rowStride = (size_t)header.RowStride;
+        std::vector<Type> rowBuffer(rowStride);
+        for (size_t i = 0; ok && i < D.RowLen; i++)
+        {
+            ok = fread(&rowBuffer[0], sizeof(Type), rowStride, pFile) == rowStride;
+            if (!ok)
+                break;
+
+            checksum.Update(&rowBuffer[0], rowStride * sizeof(Type));
+            Type* pRow = D[i];
+            for (size_t j = 0; j < D.ColumnLen; j++)
+                pRow[j] = rowBuffer[j];
+        }
+
+        unsigned long long tail = 0;
+        if (ok)
+            ok = fread(&tail, sizeof(tail), 1, pFile) == 1 && tail == checksum.Value();
+
+        fclose(pFile);
+
+        if (ok)
+            M = std::move(D);
+
+        return ok;
+    }
+
+    /// @brief 映射矩阵
+    /// 不复制数据, 矩阵直接使用映射的文件作为数据存储(见LMatrix::Map)
+    /// 校验需要读取全部数据, 所以默认不校验, 只检查文件头和文件大小
+    /// @param[in] fileName 文件名
+    /// @param[in] mode 映射方式
+    /// @param[out] M 矩阵
+    /// @param[in] verify 是否校验CRC-32
+    /// @return 文件格式错误, 元素类型不匹配, 校验失败或者映射失败返回false, 矩阵不变
+    static bool Map(IN const wchar_t* fileName, IN LMAPPED_FILE_MODE mode, OUT LMatrix<Type>& M, IN bool verify = false)
+    {
+        FILE* pFile = OpenFile(fileName, L"rb");
+        if (pFile == 0)
+            return false;
+
+        LMatrixFileHeader header;
+        bool ok = ReadHeader(pFile, header);
+        if (ok && verify)
+            ok = SeekFile(pFile, header.DataOffset) && VerifyData(pFile, header);
+
+        fclose(pFile);
+        if (!ok)
+            return false;
+
+        // 检查文件中包含完整的数据和文件尾
+        unsigned long long fileSize = 0;
+        if (!LMappedFile::FileSize(fileName, fileSize) || fileSize < FileSize(header))
+            return false;
+
+        return M.Map(
+            fileName,
+            (size_t)header.RowLen,
+            (size_t)header.ColumnLen,
+            mode,
+            (size_t)header.DataOffset,
+            (size_t)header.RowStride);
+    }
+
+    /// @brief 读取文件头
+    /// 可以用于在加载前获取矩阵的大小
+    /// @param[in] fileName 文件名
+    /// @param[out] header 文件头
+    /// @return 文件格式错误或者元素类型不匹配返回false
+    static bool ReadHeader(IN const wchar_t* fileName, OUT LMatrixFileHeader& header)
+    {
+        FILE* pFile = OpenFile(fileName, L"rb");
+        if (pFile == 0)
+            return false;
+
+        bool ok = ReadHeader(pFile, header);
+        fclose(pFile);
+        return ok;
+    }
+
+    /// @brief 读取附加数据
+    /// 只读取文件头和附加数据, 不检查矩阵数据
+    /// @param[in] fileName 文件名
+    /// @param[out] extra 附加数据, 文件中没有附加数据时为空
+    /// @return 文件格式错误或者元素类型不匹配返回false
+    static bool ReadExtra(IN const wchar_t* fileName, OUT std::vector<char>& extra)
+    {
+        FILE* pFile = OpenFile(fileName, L"rb");
+        if (pFile == 0)
+            return false;
+
+        LMatrixFileHeader header;
+        bool ok = ReadHeader(pFile, header);
+
+        // 文件头和数据之间可以容纳大小字段时才可能有附加数据
+        unsigned long long sizeField = 0;
+        const unsigned long long gap = ok ? header.DataOffset - sizeof(header) : 0;
+        if (ok && gap >= sizeof(sizeField))
+        {
+            ok = fread(&sizeField, sizeof(sizeField), 1, pFile) == 1 && sizeField <= gap - sizeof(sizeField);
+        }
+
+        std::vector<char> data((size_t)sizeField);
+        if (ok && !data.empty())
+            ok = fread(&data[0], 1, data.size(), pFile) == data.size();
+
+        fclose(pFile);
+
+        if (ok)
+            extra.swap(data);
+
+        return ok;
+    }
+
+private:
+    /// @brief 打开文件
+    static FILE* OpenFile(IN const wchar_t* fileName, IN const wchar_t* mode)
+    {
+        if (fileName == 0)
+            return 0;
+
+#ifdef _WIN32
+        FILE* pFile = 0;
+        if (_wfopen_s(&pFile, fileName, mode) != 0)
+            return 0;
+        return pFile;
+#else
+        size_t len = wcstombs(0, fileName, 0);
+        if (len == (size_t)-1)
+            return 0;
+
+        std::vector<char> name(len + 1);
+        wcstombs(&name[0], fileName, len + 1);
+
+        char modeName[4] = { (char)mode[0], (char)mode[1], 0, 0 };
+        return fopen(&name[0], modeName);
+#endif
+    }
+
+    /// @brief 移动文件读写位置
+    static bool SeekFile(IN FILE* pFile, IN unsigned long long offset)
+    {
+#ifdef _WIN32
+        return _fseeki64(pFile, (long long)offset, SEEK_SET) == 0;
+#else
+        return fseeko(pFile, (off_t)offset, SEEK_SET) == 0;
+#endif
+    }
+
+    /// @brief 生成文件头
+    static void MakeHeader(IN size_t row, IN size_t col, IN size_t extraSize, OUT LMatrixFileHeader& header)
+    {
+        memset(&header, 0, sizeof(header));
+        memcpy(header.Magic, "LMATRIX", 8);
+        header.Version = LMATRIX_FILE_VERSION;
+        header.HeaderSize = sizeof(header);
+        header.ByteOrder = 0x01020304;
+        header.DataType = LMatrixFileType<Type>::VALUE;
+        header.ElementSize = sizeof(Type);
+        header.Alignment = LMATRIX_ALIGNMENT;
+        header.RowLen = row;
+        header.ColumnLen = col;
+        header.RowStride = LMatrixStorage<Type>::RowStride(col);
+        unsigned long long headerSize = sizeof(header);
+        if (extraSize > 0)
+            headerSize += sizeof(unsigned long long) + extraSize;
+        header.DataOffset = ((headerSize + LMATRIX_ALIGNMENT - 1) / LMATRIX_ALIGNMENT) * LMATRIX_ALIGNMENT;
+    }
+
+    /// @brief 计算文件大小
+    static unsigned long long FileSize(IN const LMatrixFileHeader& header)
+    {
+        return header.DataOffset + header.RowLen * header.RowStride * header.ElementSize + sizeof(unsigned long long);
+    }
+
+    /// @brief 读取并检查文件头
+    static bool ReadHeader(IN FILE* pFile, OUT LMatrixFileHeader& header)
+    {
+        if (fread(&header, sizeof(header), 1, pFile) != 1)
+            return false;
+
+        if (memcmp(header.Magic, "LMATRIX", 8) != 0 ||
+            header.Version != LMATRIX_FILE_VERSION ||
+            header.HeaderSize != sizeof(header) ||
+            header.ByteOrder != 0x01020304)
+            return false;
+
+        if (header.DataType != LMatrixFileType<Type>::VALUE || header.ElementSize != sizeof(Type))
+            return false;
+
+        if (header.RowLen == 0 || header.ColumnLen == 0 || header.RowStride < header.ColumnLen)
+            return false;
+
+        if (header.DataOffset < sizeof(header) || header.DataOffset % sizeof(Type) != 0)
+            return false;
+
+        // 数据大小必须能用size_t表示
+        const unsigned long long maxCount = (unsigned long long)((size_t)-1) / sizeof(Type);
+        if (header.RowLen > maxCount / header.RowStride)
+            return false;
+
+        return true;
+    }
+
+    /// @brief 读取全部数据并校验
+    static bool VerifyData(IN FILE* pFile, IN const LMatrixFileHeader& header)
+    {
+        LMatrixFileChecksum checksum;
+        unsigned long long remain = header.RowLen * header.RowStride * header.ElementSize;
+        std::vector<char> buffer(1024 * 1024);
+        while (remain > 0)
+        {
+            size_t size = remain < buffer.size() ? (size_t)remain : buffer.size();
+            if (fread(&buffer[0], 1, size, pFile) != size)
+                return false;
+
+            checksum.Update(&buffer[0], size);
+            remain -= size;
+        }
+
+        unsigned long long tail = 0;
+        return fread(&tail, sizeof(tail), 1, pFile) == 1 && tail == checksum.Value();
+    }
+};
+
+#endif
@@ -0,0 +1,525 @@
+﻿/// @file LMatrixPrecision.h
+/// @brief 低精度矩阵头文件
+///
+/// Detail: 提供低精度的矩阵元素类型和混合精度的矩阵运算, 用于减小大数据集和推理权重的内存占用
+/// LBFloat16: bfloat16, 与float有相同的指数范围, 8位有效数字, 占用2字节
+/// LFloat16: IEEE 754半精度浮点数, 11位有效数字, 最大值65504, 占用2字节
+/// LInt8Matrix: 每行一个缩放系数的int8矩阵, 占用1字节
+/// LBFloat16和LFloat16可直接作为LMatrix的元素类型, 逐元素运算转换为float计算后再舍入,
+/// 矩阵乘法在float中累加, 结果再舍入为低精度类型
+/// @author Jie Liu Email:coderjie@outlook.com
+/// @version
+/// @date 2026/10/17
+
+/*  使用低精度矩阵的示例代码如下
+
+// 将double权重矩阵转换为bfloat16存储
+LMatrix<double> weightMatrix(1024, 256, 0.5);
+LMatrix<LBFloat16> weightMatrix16;
+LMixedPrecision::CONVERT<double, LBFloat16>(weightMatrix, weightMatrix16);
+
+// 使用float输入与bfloat16权重相乘, 在float中累加
+LMatrix<float> inputMatrix(64, 1024, 1.0f);
+LMatrix<float> outputMatrix;
+LMixedPrecision::MUL<float, LBFloat16>(inputMatrix, weightMatrix16, outputMatrix);
+
+// 将样本矩阵量化为int8存储
+LInt8Matrix sampleMatrix8(inputMatrix);
+LInt8Matrix::MUL<LBFloat16>(sampleMatrix8, weightMatrix16, outputMatrix);
+*/
+
+#ifndef _LMATRIXPRECISION_H_
+#define _LMATRIXPRECISION_H_
+
+#include <cstring>
+#include <cmath>
+#include <vector>
+
+#include "LMatrix.h"
+
+/// @brief bfloat16浮点数
+/// 保留float的高16位(符号位, 8位指数, 7位尾数), 从float转换时按最近偶数舍入
+class LBFloat16
+{
+public:
+    /// @brief 默认构造函数
+    /// 与内置浮点类型一致, 值未初始化
+    LBFloat16()
+    {
+    }
+
+    /// @brief 构造函数, 从float转换
+    /// @param[in] value 值
+    LBFloat16(IN float value)
+        : Bits(FromFloat(value))
+    {
+    }
+
+    /// @brief 转换为float, 不损失精度
+    operator float() const
+    {
+        unsigned int bits = ((unsigned int)Bits) << 16;
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    LBFloat16& operator += (IN float value) { return *this = LBFloat16(float(*this) + value); }
+    LBFloat16& operator -= (IN float value) { return *this = LBFloat16(float(*this) - value); }
+    LBFloat16& operator *= (IN float value) { return *this = LBFloat16(float(*this) * value); }
+    LBFloat16& operator /= (IN float value) { return *this = LBFloat16(float(*this) / value); }
+
+    /// @brief 从float转换为bfloat16位模式
+    /// @param[in] value 值
+    /// @return 位模式
+    static unsigned short FromFloat(IN float value)
+    {
+        unsigned int bits;
+        memcpy(&bits, &value, sizeof(bits));
+
+        // NaN保持为NaN(置位尾数最高位, 避免截断后变为无穷大)
+        if ((bits & 0x7FFFFFFF) > 0x7F800000)
+            return (unsigned short)((bits >> 16) | 0x0040);
+
+        bits += 0x7FFF + ((bits >> 16) & 1);
+        return (unsigned short)(bits >> 16);
+    }
+
+public:
+    unsigned short Bits; ///< 位模式
+};
+
+/// @brief IEEE 754半精度浮点数
+/// 1位符号位, 5位指数, 10位尾数, 从float转换时按最近偶数舍入, 超出范围时为无穷大
+class LFloat16
+{
+public:
+    /// @brief 默认构造函数
+    /// 与内置浮点类型一致, 值未初始化
+    LFloat16()
+    {
+    }
+
+    /// @brief 构造函数, 从float转换
+    /// @param[in] value 值
+    LFloat16(IN float value)
+        : Bits(FromFloat(value))
+    {
+    }
+
+    /// @brief 转换为float, 不损失精度
+    operator float() const
+    {
+        unsigned int sign = ((unsigned int)(Bits & 0x8000)) << 16;
+        unsigned int exponent = (Bits >> 10) & 0x1F;
+        unsigned int mantissa = Bits & 0x3FF;
+
+        unsigned int bits;
+        if (exponent == 0x1F)
+        {
+            // 无穷大或NaN
+            bits = sign | 0x7F800000 | (mantissa << 13);
+        }
+        else if (exponent != 0)
+        {
+            bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+        }
+        else if (mantissa == 0)
+        {
+            bits = sign;
+        }
+        else
+        {
+            // 非规格化数, 规格化为float
+            exponent = 127 - 15 + 1;
+            while ((mantissa & 0x400) == 0)
+            {
+                mantissa <<= 1;
+                exponent--;
+            }
+            bits = sign | (exponent << 23) | ((mantissa & 0x3FF) << 13);
+        }
+
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    LFloat16& operator += (IN float value) { return *this = LFloat16(float(*this) + value); }
+    LFloat16& operator -= (IN float value) { return *this = LFloat16(float(*this) - value); }
+    LFloat16& operator *= (IN float value) { return *this = LFloat16(float(*this) * value); }
+    LFloat16& operator /= (IN float value) { return *this = LFloat16(float(*this) / value); }
+
+    /// @brief 从float转换为半精度位模式
+    /// @param[in] value 值
+    /// @return 位模式
+    static unsigned short FromFloat(IN float value)
+    {
+        unsigned int bits;
+        memcpy(&bits, &value, sizeof(bits));
+
+        unsigned int sign = (bits >> 16) & 0x8000;
+        unsigned int exponent = (bits >> 23) & 0xFF;
+        unsigned int mantissa = bits & 0x7FFFFF;
+
+        // 无穷大或NaN
+        if (exponent == 0xFF)
+            return (unsigned short)(sign | 0x7C00 | (mantissa != 0 ? 0x200 : 0));
+
+        int halfExponent = (int)exponent - 127 + 15;
+
+        // 上溢为无穷大
+        if (halfExponent >= 0x1F)
+            return (unsigned short)(sign | 0x7C00);
+
+        unsigned int half;
+        unsigned int shift;
+        if (halfExponent <= 0)
+        {
+            // 非规格化数, 太小的数下溢为0
+            if (halfExponent < -10)
+                return (unsigned short)sign;
+
+            mantissa |= 0x800000;
+            shift = (unsigned int)(14 - halfExponent);
+            half = mantissa >> shift;
+        }
+        else
+        {
+            shift = 13;
+            half = ((unsigned int)halfExponent << 10) | (mantissa >> shift);
+        }
+
+        // 最近偶数舍入, 进位可能使指数加1(包括进位为无穷大), 结果仍然正确
+        unsigned int remainder = mantissa & ((1u << shift) - 1);
+        unsigned int halfway = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (half & 1) != 0))
+            half++;
+
+        return (unsigned short)(sign | half);
+    }
+
+public:
+    unsigned short Bits; ///< 位模式
+};
+
+/// @brief 低精度类型的矩阵乘法内核
+/// 在float中分块计算并累加, 每块完成后将结果舍入为低精度类型
+/// @param Type 低精度元素类型
+LTEMPLATE
+struct LMatrixWidenGemm
+{
+    template<typename AType, typename BType>
+    static void Run(
+        IN size_t m,
+        IN size_t n,
+        IN size_t k,
+        IN const AType* pA,
+        IN size_t rsA,
+        IN size_t csA,
+        IN const BType* pB,
+        IN size_t rsB,
+        IN size_t csB,
+        OUT Type* pC,
+        IN size_t ldc)
+    {
+        // 按float内核的A块行数和B块列数分块计算, 每块完成后舍入到pC中,
+        // 临时缓冲区的大小不超过一块, 与m * n无关(线程局部, 与float内核的打包缓冲区用途不同)
+        const size_t blockRow = LMatrixGemm<float>::BLOCK_ROW;
+        const size_t blockColumn = LMatrixGemm<float>::BLOCK_COLUMN;
+        const size_t tileRow = m < blockRow ? m : blockRow;
+        const size_t tileColumn = n < blockColumn ? n : blockColumn;
+        float* pBuffer = LMatrixScratch<float, 2>::Get(tileRow * tileColumn);
+
+        for (size_t ic = 0; ic < m; ic += blockRow)
+        {
+            const size_t mc = (m - ic) < blockRow ? (m - ic) : blockRow;
+            for (size_t jc = 0; jc < n; jc += blockColumn)
+            {
+                const size_t nc = (n - jc) < blockColumn ? (n - jc) : blockColumn;
+                LMatrixGemm<float>::Run(mc, nc, k, &pA[ic * rsA], rsA, csA, &pB[jc * csB], rsB, csB, pBuffer, nc);
+
+                for (size_t i = 0; i < mc; i++)
+                {
+                    Type* pRow = &pC[(ic + i) * ldc + jc];
+                    const float* pTile = &pBuffer[i * nc];
+                    for (size_t j = 0; j < nc; j++)
+                        pRow[j] = Type(pTile[j]);
+                }
+            }
+        }
+    }
+};
+
+/// @brief bfloat16矩阵乘法内核
+template<>
+struct LMatrixGemm<LBFloat16> : public LMatrixWidenGemm<LBFloat16>
+{
+};
+
+/// @brief 半精度矩阵乘法内核
+template<>
+struct LMatrixGemm<LFloat16> : public LMatrixWidenGemm<LFloat16>
+{
+};
+
+/// @brief 混合精度矩阵运算
+/// 操作数可以是不同的元素类型(float, double, LBFloat16, LFloat16), 结果为float矩阵, 在float中累加
+/// 调用时需要显式指定元素类型, 如LMixedPrecision::MUL<float, LBFloat16>(A, B, C)
+struct LMixedPrecision
+{
+    /// @brief 矩阵乘法, C = A * B
+    /// @param[in] A 被乘数
+    /// @param[in] B 乘数, 行数等于A的列数
+    /// @param[out] C 结果矩阵
+    /// @return 参数错误返回false
+    template<typename AType, typename BType>
+    static bool MUL(IN const LMatrixView<AType>& A, IN const LMatrixView<BType>& B, OUT LMatrix<float>& C)
+    {
+        if (A.ColumnLen != B.RowLen)
+            return false;
+
+        C.Reset(A.RowLen, B.ColumnLen);
+        if (C.Empty())
+            return true;
+
+        LMatrixParallelGemm(A, B, C[0], C.RowStride());
+
+        return true;
+    }
+
+    /// @brief 矩阵乘法, C = A.T() * B
+    template<typename AType, typename BType>
+    static bool MUL_AT_B(IN const LMatrixView<AType>& A, IN const LMatrixView<BType>& B, OUT LMatrix<float>& C)
+    {
+        return MUL<AType, BType>(A.T(), B, C);
+    }
+
+    /// @brief 矩阵乘法, C = A * B.T()
+    template<typename AType, typename BType>
+    static bool MUL_A_BT(IN const LMatrixView<AType>& A, IN const LMatrixView<BType>& B, OUT LMatrix<float>& C)
+    {
+        return MUL<AType, BType>(A, B.T(), C);
+    }
+
+    /// @brief 转换矩阵的元素类型
+    /// 低精度类型与double之间经过float转换
+    /// @param[in] A 源矩阵
+    /// @param[out] B 存储转换后的矩阵
+    template<typename SrcType, typename DstType>
+    static void CONVERT(IN const LMatrixView<SrcType>& A, OUT LMatrix<DstType>& B)
+    {
+        B.Reset(A.RowLen, A.ColumnLen);
+        LMatrixParallelFor(B.RowLen, (unsigned long long)B.RowLen * B.ColumnLen, LMATRIX_PARALLEL_SIZE,
+            [&A, &B](size_t rowBegin, size_t rowEnd)
+        {
+            for (size_t i = rowBegin; i < rowEnd; i++)
+            {
+                DstType* pRow = B[i];
+                for (size_t j = 0; j < B.ColumnLen; j++)
+                    pRow[j] = DstType(A[i][j]);
+            }
+        });
+    }
+};
+
+/// @brief int8矩阵
+/// 每一行使用一个缩放系数, 元素值 = 量化值 * 缩放系数, 量化值范围为-127~127
+/// 缩放系数为行中绝对值最大的元素除以127, 全零行的缩放系数为1
+/// 矩阵乘法中缩放系数从内积中提出, 量化值在float中累加
+class LInt8Matrix
+{
+public:
+    /// @brief 矩阵乘法, C = A * B, A为int8矩阵
+    /// A的每一行的缩放系数作用于C的对应行
+    /// @param[in] A 被乘数
+    /// @param[in] B 乘数, 行数等于A的列数
+    /// @param[out] C 结果矩阵
+    /// @return 参数错误返回false
+    template<typename BType>
+    static bool MUL(IN const LInt8Matrix& A, IN const LMatrixView<BType>& B, OUT LMatrix<float>& C)
+    {
+        if (A.ColumnLen != B.RowLen)
+            return false;
+
+        C.Reset(A.RowLen, B.ColumnLen);
+        if (C.Empty())
+            return true;
+
+        LMatrixParallelGemm(LMatrixView<signed char>(A.m_quantMatrix), B, C[0], C.RowStride());
+
+        for (size_t i = 0; i < C.RowLen; i++)
+        {
+            const float scale = A.m_scaleList[i];
+            float* pRow = C[i];
+            for (size_t j = 0; j < C.ColumnLen; j++)
+                pRow[j] *= scale;
+        }
+
+        return true;
+    }
+
+    /// @brief 矩阵乘法, C = A * B.T(), B为int8矩阵
+    /// B的每一行(如全连接层的一个输出)的缩放系数作用于C的对应列
+    /// @param[in] A 被乘数
+    /// @param[in] B 乘数(转置前), 列数等于A的列数
+    /// @param[out] C 结果矩阵
+    /// @return 参数错误返回false
+    template<typename AType>
+    static bool MUL_A_BT(IN const LMatrixView<AType>& A, IN const LInt8Matrix& B, OUT LMatrix<float>& C)
+    {
+        if (A.ColumnLen != B.ColumnLen)
+            return false;
+
+        C.Reset(A.RowLen, B.RowLen);
+        if (C.Empty())
+            return true;
+
+        LMatrixParallelGemm(A, LMatrixView<signed char>(B.m_quantMatrix).T(), C[0], C.RowStride());
+
+        for (size_t i = 0; i < C.RowLen; i++)
+        {
+            float* pRow = C[i];
+            for (size_t j = 0; j < C.ColumnLen; j++)
+                pRow[j] *= B.m_scaleList[j];
+        }
+
+        return true;
+    }
+
+public:
+    /// @brief 默认构造函数
+    /// 默认矩阵长度为0
+    LInt8Matrix()
+        : RowLen(m_quantMatrix.RowLen), ColumnLen(m_quantMatrix.ColumnLen)
+    {
+    }
+
+    /// @brief 构造函数, 量化float矩阵
+    /// @param[in] A 源矩阵
+    explicit LInt8Matrix(IN const LMatrixView<float>& A)
+        : RowLen(m_quantMatrix.RowLen), ColumnLen(m_quantMatrix.ColumnLen)
+    {
+        this->Quantize(A);
+    }
+
+    /// @brief 构造函数, 量化double矩阵
+    /// @param[in] A 源矩阵
+    explicit LInt8Matrix(IN const LMatrixView<double>& A)
+        : RowLen(m_quantMatrix.RowLen), ColumnLen(m_quantMatrix.ColumnLen)
+    {
+        this->Quantize(A);
+    }
+
+    /// @brief 拷贝构造函数
+    LInt8Matrix(IN const LInt8Matrix& rhs)
+        : m_quantMatrix(rhs.m_quantMatrix),
+        m_scaleList(rhs.m_scaleList),
+        RowLen(m_quantMatrix.RowLen),
+        ColumnLen(m_quantMatrix.ColumnLen)
+    {
+    }
+
+    /// @brief 赋值操作符
+    LInt8Matrix& operator = (IN const LInt8Matrix& rhs)
+    {
+        m_quantMatrix = rhs.m_quantMatrix;
+        m_scaleList = rhs.m_scaleList;
+        return *this;
+    }
+
+    /// @brief 量化float矩阵
+    /// @param[in] A 源矩阵
+    void Quantize(IN const LMatrixView<float>& A)
+    {
+        this->QuantizeMatrix(A);
+    }
+
+    /// @brief 量化double矩阵
+    /// @param[in] A 源矩阵
+    void Quantize(IN const LMatrixView<double>& A)
+    {
+        this->QuantizeMatrix(A);
+    }
+
+    /// @brief 反量化为float矩阵
+    /// @param[out] D 存储结果矩阵
+    void Dequantize(OUT LMatrix<float>& D) const
+    {
+        D.Reset(RowLen, ColumnLen);
+        for (size_t i = 0; i < D.RowLen; i++)
+        {
+            const signed char* pQuantRow = m_quantMatrix[i];
+            float* pRow = D[i];
+            for (size_t j = 0; j < D.ColumnLen; j++)
+                pRow[j] = pQuantRow[j] * m_scaleList[i];
+        }
+    }
+
+    /// @brief 判断矩阵是否为空
+    /// @return true, false
+    bool Empty() const
+    {
+        return m_quantMatrix.Empty();
+    }
+
+    /// @brief 获取一行的量化值
+    /// @param[in] row 行索引
+    /// @return 量化值列表
+    const signed char* operator[](IN size_t row) const
+    {
+        return m_quantMatrix[row];
+    }
+
+    /// @brief 获取一行的缩放系数
+    /// @param[in] row 行索引
+    /// @return 缩放系数
+    float Scale(IN size_t row) const
+    {
+        return m_scaleList[row];
+    }
+
+private:
+    /// @brief 逐行量化
+    template<typename Type>
+    void QuantizeMatrix(IN const LMatrixView<Type>& A)
+    {
+        m_quantMatrix.Reset(A.RowLen, A.ColumnLen);
+        m_scaleList.assign(m_quantMatrix.RowLen, 1.0f);
+
+        for (size_t i = 0; i < m_quantMatrix.RowLen; i++)
+        {
+            float maxValue = 0.0f;
+            for (size_t j = 0; j < A.ColumnLen; j++)
+            {
+                float value = (float)fabs((float)A[i][j]);
+                if (value > maxValue)
+                    maxValue = value;
+            }
+            if (maxValue > 0.0f)
+                m_scaleList[i] = maxValue / 127.0f;
+
+            const float inverseScale = 1.0f / m_scaleList[i];
+            signed char* pQuantRow = m_quantMatrix[i];
+            for (size_t j = 0; j < A.ColumnLen; j++)
+            {
+                float value = (float)floor((float)A[i][j] * inverseScale + 0.5f);
+                if (value > 127.0f)
+                    value = 127.0f;
+                if (value < -127.0f)
+                    value = -127.0f;
+                pQuantRow[j] = (signed char)value;
+            }
+        }
+    }
+
+private:
+    LMatrix<signed char> m_quantMatrix; ///< 量化值矩阵
+    std::vector<float> m_scaleList; ///< 每一行的缩放系数
+
+public:
+    const size_t& RowLen;           ///< 行长度属性
+    const size_t& ColumnLen;        ///< 列长度属性
+};
+
+#endif
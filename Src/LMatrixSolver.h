@@ -0,0 +1,383 @@
+﻿/// @file LMatrixSolver.h
+/// @brief 线性方程组求解模板头文件
+///
+/// Detail: Cholesky分解, QR分解(Householder变换)以及基于它们的最小二乘求解, 支持岭(L2)正则化
+/// Cholesky: 求解法方程(A.T() * A + λI) * X = A.T() * B, 计算量小, 但条件数为A的条件数的平方
+/// QR: 直接对A做正交分解, 计算量约为Cholesky的两倍, 数值稳定性更好
+/// 元素类型只能为float或double
+/// @author Jie Liu Email:coderjie@outlook.com
+/// @version
+/// @date 2026/10/17
+
+/*  使用最小二乘求解的示例代码如下
+
+// 求解 min ||A * X - B||^2 + 0.1 * ||X||^2
+LMatrix<double> A(100, 3);
+LMatrix<double> B(100, 1);
+...
+LMatrix<double> X;
+LMatrixSolver<double>::LEASTSQUARES(A, B, LLEAST_SQUARES_QR, 0.1, X);
+*/
+
+#ifndef _LMATRIXSOLVER_H_
+#define _LMATRIXSOLVER_H_
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "LMatrix.h"
+
+/// @brief 最小二乘求解方法
+enum LLEAST_SQUARES_METHOD
+{
+    LLEAST_SQUARES_CHOLESKY = 0,    ///< 法方程的Cholesky分解
+    LLEAST_SQUARES_QR = 1           ///< 样本矩阵的QR分解
+};
+
+/// @brief 线性方程组求解
+LTEMPLATE
+class LMatrixSolver
+{
+public:
+    /// @brief Cholesky分解, A = L * L.T()
+    /// @param[in] A 对称正定矩阵, 只使用下三角部分
+    /// @param[out] L 存储下三角矩阵, 上三角部分为0
+    /// @return A不是方阵或者不是正定矩阵返回false
+    static bool CHOLESKY(IN const LMatrixView<Type>& A, OUT LMatrix<Type>& L);
+
+    /// @brief 使用Cholesky分解的结果求解 L * L.T() * X = B
+    /// @param[in] L Cholesky分解得到的下三角矩阵
+    /// @param[in] B 右端矩阵, 行数等于L的行数
+    /// @param[out] X 存储解矩阵
+    /// @return 参数错误返回false
+    static bool CHOLESKYSOLVE(IN const LMatrixView<Type>& L, IN const LMatrixView<Type>& B, OUT LMatrix<Type>& X);
+
+    /// @brief QR分解(精简形式), A = Q * R
+    /// @param[in] A 被分解的矩阵, 行数不小于列数
+    /// @param[out] Q 存储列正交矩阵, 大小同A
+    /// @param[out] R 存储上三角矩阵, 行数和列数都等于A的列数
+    /// @return A的行数小于列数或者A为空返回false
+    static bool QR(IN const LMatrixView<Type>& A, OUT LMatrix<Type>& Q, OUT LMatrix<Type>& R);
+
+    /// @brief 最小二乘求解, min ||A * X - B||^2 + lambda * ||X||^2
+    /// B有多列时对每一列分别求解
+    /// @param[in] A 系数矩阵, lambda为0时要求行数不小于列数并且列满秩
+    /// @param[in] B 右端矩阵, 行数等于A的行数
+    /// @param[in] method 求解方法
+    /// @param[in] lambda 岭正则化系数, 不能小于0
+    /// @param[out] X 存储解矩阵, 行数为A的列数, 列数为B的列数
+    /// @return 参数错误或者问题病态(矩阵秩亏)返回false
+    static bool LEASTSQUARES(
+        IN const LMatrixView<Type>& A,
+        IN const LMatrixView<Type>& B,
+        IN LLEAST_SQUARES_METHOD method,
+        IN Type lambda,
+        OUT LMatrix<Type>& X);
+
+private:
+    /// @brief 使用点积计算法方程矩阵的最大列数, 列数更多时使用分块矩阵乘法
+    static const size_t GRAM_DOT_MAX_COLUMN = 256;
+
+    /// @brief 对矩阵的列依次做Householder变换
+    /// 矩阵以转置形式存储, 每一行为原矩阵的一列, 变换后第k行的[k, m)为第k个Householder向量v,
+    /// 第j行(j > k)的第k个元素为R[k][j], R的对角元素存储在rDiag中, 变换为 H = I - beta * v * v.T()
+    /// @param[inout] At 原矩阵的转置, n * m
+    /// @param[inout] pBt 同时做变换的矩阵的转置(可以为0), 变换后每一行的前n个元素为Q.T() * B
+    /// @param[out] rDiag 存储R的对角元素
+    /// @param[out] beta 存储每个变换的系数
+    static void Householder(
+        INOUT LMatrix<Type>& At,
+        INOUT LMatrix<Type>* pBt,
+        OUT std::vector<Type>& rDiag,
+        OUT std::vector<Type>& beta);
+
+    /// @brief 判断上三角矩阵的对角元素是否接近0(矩阵秩亏)
+    static bool RankDeficient(IN const std::vector<Type>& diag, IN size_t m);
+};
+
+LTEMPLATE
+bool LMatrixSolver<Type>::CHOLESKY(IN const LMatrixView<Type>& A, OUT LMatrix<Type>& L)
+{
+    const size_t n = A.RowLen;
+    if (n == 0 || A.ColumnLen != n)
+        return false;
+
+    LMatrix<Type> C(n, n, (Type)0);
+    for (size_t i = 0; i < n; i++)
+    {
+        Type* pRowI = C[i];
+        for (size_t j = 0; j <= i; j++)
+        {
+            // L[i][j] = (A[i][j] - L[i][0:j] . L[j][0:j]) / L[j][j]
+            const Type sum = A[i][j] - LVectorKernel<Type>::Dot(j, pRowI, C[j]);
+            if (j == i)
+            {
+                if (!(sum > (Type)0))
+                    return false;
+                pRowI[i] = std::sqrt(sum);
+            }
+            else
+            {
+                pRowI[j] = sum / C[j][j];
+            }
+        }
+    }
+
+    L = std::move(C);
+    return true;
+}
+
+LTEMPLATE
+bool LMatrixSolver<Type>::CHOLESKYSOLVE(IN const LMatrixView<Type>& L, IN const LMatrixView<Type>& B, OUT LMatrix<Type>& X)
+{
+    const size_t n = L.RowLen;
+    if (n == 0 || L.ColumnLen != n || B.RowLen != n || B.ColumnLen == 0)
+        return false;
+
+    // 每一列的解存储为Xt的一行, L和L.T()复制为连续存储的矩阵, 使前代和回代时的访问连续
+    const LMatrix<Type> Lc(L);
+    LMatrix<Type> Xt(B.ColumnLen, n);
+    LMatrix<Type> Lt;
+    LMatrix<Type>::T(L, Lt);
+    for (size_t c = 0; c < B.ColumnLen; c++)
+    {
+        Type* pX = Xt[c];
+
+        // 前代, L * y = b
+        for (size_t i = 0; i < n; i++)
+            pX[i] = (B[i][c] - LVectorKernel<Type>::Dot(i, Lc[i], pX)) / Lc[i][i];
+
+        // 回代, L.T() * x = y
+        for (size_t k = n; k > 0; k--)
+        {
+            const size_t i = k - 1;
+            pX[i] = (pX[i] - LVectorKernel<Type>::Dot(n - k, Lt[i] + k, pX + k)) / Lt[i][i];
+        }
+    }
+
+    LMatrix<Type>::T(Xt, X);
+    return true;
+}
+
+LTEMPLATE
+bool LMatrixSolver<Type>::QR(IN const LMatrixView<Type>& A, OUT LMatrix<Type>& Q, OUT LMatrix<Type>& R)
+{
+    const size_t m = A.RowLen;
+    const size_t n = A.ColumnLen;
+    if (n == 0 || m < n)
+        return false;
+
+    LMatrix<Type> At;
+    LMatrix<Type>::T(A, At);
+    std::vector<Type> rDiag;
+    std::vector<Type> beta;
+    Householder(At, 0, rDiag, beta);
+
+    R.Reset(n, n, (Type)0);
+    for (size_t k = 0; k < n; k++)
+    {
+        R[k][k] = rDiag[k];
+        for (size_t j = k + 1; j < n; j++)
+            R[k][j] = At[j][k];
+    }
+
+    // Q = H0 * H1 * ... * Hn-1 * [I; 0], Q的第j列为依次逆序变换单位向量ej
+    LMatrix<Type> Qt(n, m, (Type)0);
+    for (size_t j = 0; j < n; j++)
+    {
+        Type* pQ = Qt[j];
+        pQ[j] = (Type)1;
+        for (size_t k = j + 1; k > 0; k--)
+        {
+            const size_t h = k - 1;
+            const Type* pV = At[h] + h;
+            const Type s = beta[h] * LVectorKernel<Type>::Dot(m - h, pV, pQ + h);
+            LVectorKernel<Type>::Axpy(m - h, -s, pV, pQ + h);
+        }
+    }
+
+    LMatrix<Type>::T(Qt, Q);
+    return true;
+}
+
+LTEMPLATE
+bool LMatrixSolver<Type>::LEASTSQUARES(
+    IN const LMatrixView<Type>& A,
+    IN const LMatrixView<Type>& B,
+    IN LLEAST_SQUARES_METHOD method,
+    IN Type lambda,
+    OUT LMatrix<Type>& X)
+{
+    const size_t m = A.RowLen;
+    const size_t n = A.ColumnLen;
+    if (m == 0 || n == 0 || B.RowLen != m || B.ColumnLen == 0)
+        return false;
+    if (!(lambda >= (Type)0))
+        return false;
+
+    if (method == LLEAST_SQUARES_CHOLESKY)
+    {
+        // (A.T() * A + λI) * X = A.T() * B
+        LMatrix<Type> G;
+        LMatrix<Type> C;
+        if (n <= GRAM_DOT_MAX_COLUMN)
+        {
+            // 列数较少时(样本矩阵通常行数远大于列数)转置后计算列之间的点积, 只计算下三角部分
+            LMatrix<Type> At;
+            LMatrix<Type> Bt;
+            LMatrix<Type>::T(A, At);
+            LMatrix<Type>::T(B, Bt);
+            G.Reset(n, n);
+            C.Reset(n, B.ColumnLen);
+            for (size_t i = 0; i < n; i++)
+            {
+                for (size_t j = 0; j <= i; j++)
+                {
+                    G[i][j] = LVectorKernel<Type>::Dot(m, At[i], At[j]);
+                    G[j][i] = G[i][j];
+                }
+                for (size_t c = 0; c < B.ColumnLen; c++)
+                    C[i][c] = LVectorKernel<Type>::Dot(m, At[i], Bt[c]);
+            }
+        }
+        else
+        {
+            LMatrix<Type>::MUL_AT_B(A, A, G);
+            LMatrix<Type>::MUL_AT_B(A, B, C);
+        }
+        for (size_t i = 0; i < n; i++)
+            G[i][i] += lambda;
+
+        LMatrix<Type> L;
+        if (!CHOLESKY(G, L))
+            return false;
+
+        // 主元为L对角元素的平方
+        std::vector<Type> pivot(n);
+        for (size_t i = 0; i < n; i++)
+            pivot[i] = L[i][i] * L[i][i];
+        if (RankDeficient(pivot, m))
+            return false;
+
+        return CHOLESKYSOLVE(L, C, X);
+    }
+
+    if (method != LLEAST_SQUARES_QR)
+        return false;
+
+    // 岭正则化等价于在A下方增加sqrt(λ)I, 在B下方增加0
+    const size_t rows = (lambda > (Type)0) ? m + n : m;
+    if (rows < n)
+        return false;
+
+    LMatrix<Type> At(n, rows, (Type)0);
+    LMatrix<Type> Bt(B.ColumnLen, rows, (Type)0);
+    for (size_t i = 0; i < m; i++)
+    {
+        for (size_t j = 0; j < n; j++)
+            At[j][i] = A[i][j];
+        for (size_t c = 0; c < B.ColumnLen; c++)
+            Bt[c][i] = B[i][c];
+    }
+    if (rows > m)
+    {
+        const Type root = std::sqrt(lambda);
+        for (size_t j = 0; j < n; j++)
+            At[j][m + j] = root;
+    }
+
+    std::vector<Type> rDiag;
+    std::vector<Type> beta;
+    Householder(At, &Bt, rDiag, beta);
+    if (RankDeficient(rDiag, rows))
+        return false;
+
+    // 回代, R * x = (Q.T() * b)[0:n], R[k][j] = At[j][k]
+    LMatrix<Type> Xt(B.ColumnLen, n);
+    for (size_t c = 0; c < B.ColumnLen; c++)
+    {
+        const Type* pY = Bt[c];
+        Type* pX = Xt[c];
+        for (size_t k = n; k > 0; k--)
+        {
+            const size_t i = k - 1;
+            Type sum = pY[i];
+            for (size_t j = k; j < n; j++)
+                sum -= At[j][i] * pX[j];
+            pX[i] = sum / rDiag[i];
+        }
+    }
+
+    LMatrix<Type>::T(Xt, X);
+    return true;
+}
+
+LTEMPLATE
+void LMatrixSolver<Type>::Householder(
+    INOUT LMatrix<Type>& At,
+    INOUT LMatrix<Type>* pBt,
+    OUT std::vector<Type>& rDiag,
+    OUT std::vector<Type>& beta)
+{
+    const size_t n = At.RowLen;
+    const size_t m = At.ColumnLen;
+    rDiag.assign(n, (Type)0);
+    beta.assign(n, (Type)0);
+
+    for (size_t k = 0; k < n && k < m; k++)
+    {
+        Type* pV = At[k] + k;
+        const size_t len = m - k;
+
+        const Type norm = std::sqrt(LVectorKernel<Type>::Dot(len, pV, pV));
+        if (norm == (Type)0)
+            continue;
+
+        // 选择与x0符号相反的alpha, 避免v0 = x0 - alpha时的相消误差
+        const Type alpha = (pV[0] >= (Type)0) ? -norm : norm;
+        const Type vTv = (Type)2 * (norm * norm - alpha * pV[0]);
+        pV[0] -= alpha;
+        rDiag[k] = alpha;
+        beta[k] = (Type)2 / vTv;
+
+        for (size_t j = k + 1; j < n; j++)
+        {
+            Type* pCol = At[j] + k;
+            const Type s = beta[k] * LVectorKernel<Type>::Dot(len, pV, pCol);
+            LVectorKernel<Type>::Axpy(len, -s, pV, pCol);
+        }
+
+        if (pBt != 0)
+        {
+            for (size_t c = 0; c < pBt->RowLen; c++)
+            {
+                Type* pCol = (*pBt)[c] + k;
+                const Type s = beta[k] * LVectorKernel<Type>::Dot(len, pV, pCol);
+                LVectorKernel<Type>::Axpy(len, -s, pV, pCol);
+            }
+        }
+    }
+}
+
+LTEMPLATE
+bool LMatrixSolver<Type>::RankDeficient(IN const std::vector<Type>& diag, IN size_t m)
+{
+    Type maxDiag = (Type)0;
+    for (size_t i = 0; i < diag.size(); i++)
+    {
+        if (std::fabs(diag[i]) > maxDiag)
+            maxDiag = std::fabs(diag[i]);
+    }
+
+    const Type tolerance = maxDiag * (Type)(m > diag.size() ? m : diag.size()) * std::numeric_limits<Type>::epsilon();
+    for (size_t i = 0; i < diag.size(); i++)
+    {
+        if (!(std::fabs(diag[i]) > tolerance))
+            return true;
+    }
+
+    return false;
+}
+
+#endif
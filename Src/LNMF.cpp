@@ -12,9 +12,9 @@ static float RandFloat()
 /// @brief 将矩阵中的值填入随机值(0.0f~1.0f)
 static void RandNMFMatrix(INOUT LNMFMatrix& m)
 {
-    for (unsigned int i = 0; i < m.RowLen; i++)
+    for (size_t i = 0; i < m.RowLen; i++)
     {
-        for (unsigned int j = 0; j < m.ColumnLen; j++)
+        for (size_t j = 0; j < m.ColumnLen; j++)
         {
             m[i][j] = RandFloat();
         }
@@ -22,80 +22,120 @@ static void RandNMFMatrix(INOUT LNMFMatrix& m)
 }
 
 
-LNMF::LNMF()
+/// @brief 检查稠密原始矩阵, 不能为空且不能有负数
+static bool CheckNMFMatrix(IN const LNMFMatrixView& V)
 {
+    if (0 == V.RowLen || 0 == V.ColumnLen)
+        return false;
 
-}
-
-LNMF::~LNMF()
-{
+    for (size_t row = 0; row < V.RowLen; row++)
+    {
+        for (size_t col = 0; col < V.ColumnLen; col++)
+        {
+            if (V[row][col] < 0.0f)
+                return false;
+        }
+    }
 
+    return true;
 }
 
-bool LNMF::Factoring(IN const LNMFProblem& problem, OUT LNMFMatrix* pW, OUT LNMFMatrix* pH)
+/// @brief 检查稀疏原始矩阵, 不能为空且非零元素不能有负数
+static bool CheckNMFMatrix(IN const LNMFSparseMatrix& V)
 {
-    // 检查参数
-    if (0 == pW || 0 == pH)
-        return false;
-
-    if (0 == problem.R || 0 == problem.IterCount)
-        return false;
-
-    if (0 == problem.V.RowLen || 0 == problem.V.ColumnLen)
-    {
+    if (V.Empty())
         return false;
-    }
 
-    for (unsigned int row = 0; row < problem.V.RowLen; row++)
+    for (size_t row = 0; row < V.RowLen; row++)
     {
-        for (unsigned int col = 0; col < problem.V.ColumnLen; col++)
+        const float* pValue = V.RowValue(row);
+        for (size_t i = 0; i < V.RowNonZeroNum(row); i++)
         {
-            if (problem.V[row][col] < 0.0f)
+            if (pValue[i] < 0.0f)
                 return false;
         }
     }
 
-    const LNMFMatrix& V = problem.V; // 原始矩阵
+    return true;
+}
+
+/// @brief C = W.T() * V, V为稠密矩阵
+static void NMFMulWtV(IN const LNMFMatrixView& W, IN const LNMFMatrixView& V, OUT LNMFMatrix& C)
+{
+    LNMFMatrix::MUL_AT_B(W, V, C);
+}
+
+/// @brief C = W.T() * V, V为稀疏矩阵
+static void NMFMulWtV(IN const LNMFMatrixView& W, IN const LNMFSparseMatrix& V, OUT LNMFMatrix& C)
+{
+    LNMFSparseMatrix::MUL(W.T(), V, C);
+}
+
+/// @brief C = V * H.T(), V为稠密矩阵
+static void NMFMulVHt(IN const LNMFMatrixView& V, IN const LNMFMatrixView& H, OUT LNMFMatrix& C)
+{
+    LNMFMatrix::MUL_A_BT(V, H, C);
+}
+
+/// @brief C = V * H.T(), V为稀疏矩阵
+static void NMFMulVHt(IN const LNMFSparseMatrix& V, IN const LNMFMatrixView& H, OUT LNMFMatrix& C)
+{
+    LNMFSparseMatrix::MUL(V, H.T(), C);
+}
+
+/// @brief 因式分解(乘法更新规则)
+/// @param[in] V 原始矩阵(稠密矩阵视图或稀疏矩阵)
+/// @param[in] r 基矩阵的列数(系数矩阵的行数)
+/// @param[in] iterCount 迭代次数
+/// @param[out] pW 存储分解后的基矩阵
+/// @param[out] pH 存储分解后的系数矩阵
+template<typename NMFMatrix>
+static void NMFFactoring(
+    IN const NMFMatrix& V, 
+    IN size_t r, 
+    IN unsigned int iterCount, 
+    OUT LNMFMatrix* pW, 
+    OUT LNMFMatrix* pH)
+{
     LNMFMatrix W; // 基矩阵
     LNMFMatrix H; // 系数矩阵
 
     // 生成基矩阵
-    W.Reset(V.RowLen, problem.R);
+    W.Reset(V.RowLen, r);
     RandNMFMatrix(W);
 
     // 生成特征矩阵
-    H.Reset(problem.R, V.ColumnLen);
+    H.Reset(r, V.ColumnLen);
     RandNMFMatrix(H);
 
-    LNMFMatrix TF;
-    LNMFMatrix TW;
     LNMFMatrix TWW;
 
     LNMFMatrix HN;
     LNMFMatrix HD;
     LNMFMatrix HHN;
 
+    LNMFMatrix HHT;
     LNMFMatrix WN;
     LNMFMatrix WD;
-    LNMFMatrix WH;
     LNMFMatrix WWN;
 
     // 迭代求解
-    for (unsigned int i = 0; i < problem.IterCount; i++)
+    // H = H .* (W.T() * V) ./ (W.T() * W * H)
+    // W = W .* (V * H.T()) ./ (W * H * H.T())
+    // 分母按 W.T() * W 和 H * H.T() 先乘, 不生成与原始矩阵同样大小的 W * H
+    for (unsigned int i = 0; i < iterCount; i++)
     {
-        LNMFMatrix::T(W, TW);
-        LNMFMatrix::MUL(TW, V, HN);
-        LNMFMatrix::MUL(TW, W, TWW);
+        NMFMulWtV(W, V, HN);
+        LNMFMatrix::MUL_AT_B(W, W, TWW);
         LNMFMatrix::MUL(TWW, H, HD);
 
         LNMFMatrix::DOTMUL(H, HN, HHN);
         LNMFMatrix::DOTDIV(HHN, HD, H);
 
 
-        LNMFMatrix::T(H, TF);
-        LNMFMatrix::MUL(V, TF, WN);
-        LNMFMatrix::MUL(W, H, WH);
-        LNMFMatrix::MUL(WH, TF, WD);
+        NMFMulVHt(V, H, WN);
+        LNMFMatrix::MUL_A_BT(H, H, HHT);
+        LNMFMatrix::MUL(W, HHT, WD);
 
         LNMFMatrix::DOTMUL(W, WN, WWN);
         LNMFMatrix::DOTDIV(WWN, WD, W);
@@ -103,8 +143,49 @@ bool LNMF::Factoring(IN const LNMFProblem& problem, OUT LNMFMatrix* pW, OUT LNMF
 
     (*pW) = W;
     (*pH) = H;
+}
+
+
+LNMF::LNMF()
+{
 
+}
+
+LNMF::~LNMF()
+{
+
+}
+
+bool LNMF::Factoring(IN const LNMFProblem& problem, OUT LNMFMatrix* pW, OUT LNMFMatrix* pH)
+{
+    // 检查参数
+    if (0 == pW || 0 == pH)
+        return false;
+
+    if (0 == problem.R || 0 == problem.IterCount)
+        return false;
+
+    if (!CheckNMFMatrix(problem.V))
+        return false;
+
+    NMFFactoring(problem.V, problem.R, problem.IterCount, pW, pH);
 
     return true;
+}
+
+bool LNMF::Factoring(IN const LNMFSparseProblem& problem, OUT LNMFMatrix* pW, OUT LNMFMatrix* pH)
+{
+    // 检查参数
+    if (0 == pW || 0 == pH)
+        return false;
 
-}
\ No newline at end of file
+    if (0 == problem.R || 0 == problem.IterCount)
+        return false;
+
+    if (!CheckNMFMatrix(problem.V))
+        return false;
+
+    NMFFactoring(problem.V, problem.R, problem.IterCount, pW, pH);
+
+    return true;
+}
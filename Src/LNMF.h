@@ -33,9 +33,12 @@ nmf.Factoring(problem, &W, &H);
 #ifndef _LNMF_H_
 #define _LNMF_H_
 
-#include "LDataStruct/LMatrix.h"
+#include "LMatrix.h"
+#include "LSparseMatrix.h"
 
 typedef LMatrix<float> LNMFMatrix; ///< NMF矩阵
+typedef LMatrixView<float> LNMFMatrixView; ///< NMF矩阵视图
+typedef LSparseMatrix<float> LNMFSparseMatrix; ///< NMF稀疏矩阵
 
 /// @brief NMF问题结构
 struct LNMFProblem
@@ -44,14 +47,33 @@ struct LNMFProblem
     /// @param[in] v 原始矩阵, 原始矩阵中不能有负数
     /// @param[in] r 基矩阵的列数(系数矩阵的行数)
     /// @param[in] iterCount 迭代次数
-    LNMFProblem(IN const LNMFMatrix& v, IN unsigned int r, IN unsigned int iterCount)
+    LNMFProblem(IN const LNMFMatrixView& v, IN size_t r, IN unsigned int iterCount)
         : V(v), R(r), IterCount(iterCount)
     {
 
     }
 
-    const LNMFMatrix& V; ///< 原始矩阵
-    const unsigned int R; ///< 基矩阵的列数(系数矩阵的行数)
+    const LNMFMatrixView V; ///< 原始矩阵(视图)
+    const size_t R; ///< 基矩阵的列数(系数矩阵的行数)
+    const unsigned int IterCount; ///< 迭代次数
+};
+
+/// @brief NMF稀疏问题结构
+/// 原始矩阵为稀疏矩阵, 迭代过程中不生成与原始矩阵同样大小的稠密矩阵
+struct LNMFSparseProblem
+{
+    /// @brief 构造函数
+    /// @param[in] v 原始矩阵(稀疏矩阵), 原始矩阵中不能有负数, 在问题使用期间必须有效
+    /// @param[in] r 基矩阵的列数(系数矩阵的行数)
+    /// @param[in] iterCount 迭代次数
+    LNMFSparseProblem(IN const LNMFSparseMatrix& v, IN size_t r, IN unsigned int iterCount)
+        : V(v), R(r), IterCount(iterCount)
+    {
+
+    }
+
+    const LNMFSparseMatrix& V; ///< 原始矩阵(稀疏矩阵)
+    const size_t R; ///< 基矩阵的列数(系数矩阵的行数)
     const unsigned int IterCount; ///< 迭代次数
 };
 
@@ -71,6 +93,13 @@ public:
     /// @param[out] pH 存储分解后的系数矩阵, 不能为0
     /// @return 成功返回true, 失败返回false, 参数有误会失败
     bool Factoring(IN const LNMFProblem& problem, OUT LNMFMatrix* pW, OUT LNMFMatrix* pH);
+
+    /// @brief 稀疏矩阵因式分解
+    /// @param[in] problem 原始问题, 原始矩阵中不能有负数
+    /// @param[out] pW 存储分解后的基矩阵, 不能为0
+    /// @param[out] pH 存储分解后的系数矩阵, 不能为0
+    /// @return 成功返回true, 失败返回false, 参数有误会失败
+    bool Factoring(IN const LNMFSparseProblem& problem, OUT LNMFMatrix* pW, OUT LNMFMatrix* pH);
 };
 
 #endif
\ No newline at end of file
@@ -28,10 +28,10 @@ class CBPNeuron
 public:
     /// @brief 构造函数
     /// @param[in] inputNum 输入个数, 必须大于等于1
-    explicit CBPNeuron(IN unsigned int inputNum)
+    explicit CBPNeuron(IN size_t inputNum)
     {
         m_weightList.resize(inputNum + 1);
-        for (unsigned int i = 0; i < m_weightList.size(); i++)
+        for (size_t i = 0; i < m_weightList.size(); i++)
         {
             m_weightList[i] = RandClamped();
         }
@@ -44,17 +44,14 @@ public:
     }
 
     /// @brief 激活神经元
-    /// @param[in] inputVector 输入向量(行向量), 向量长度必须等于神经元的输入个数
+    /// @param[in] pInputList 连续存储的输入值, 个数必须等于神经元的输入个数
     /// @return 激活值, 激活值范围0~1
-    double Active(IN const LNNMatrix& inputVector)
+    double Active(IN const double* pInputList)
     {
-        double sum = 0.0;
-        for (unsigned int i = 0; i < inputVector.ColumnLen; i++)
-        {
-            sum += inputVector[0][i] * m_weightList[i];
-        }
+        const size_t inputNum = m_weightList.size() - 1;
+        double sum = LVectorKernel<double>::Dot(inputNum, pInputList, &m_weightList[0]);
 
-        sum += m_weightList[inputVector.ColumnLen] * 1.0f;
+        sum += m_weightList[inputNum] * 1.0f;
 
         return this->Sigmoid(sum);
     }
@@ -77,7 +74,7 @@ public:
         if (0 == pFrontErrorList)
             return false;
 
-        for (unsigned int i = 0; i < inputList.size(); i++)
+        for (size_t i = 0; i < inputList.size(); i++)
         {
             m_weightList[i] += learnRate * inputList[i] * error;
             (*pFrontErrorList)[i] = m_weightList[i] * error;
@@ -109,11 +106,11 @@ public:
     /// @brief 构造函数
     /// @param[in] neuronInputNum 神经元输入个数, 必须为大于等于1的数
     /// @param[in] neuronNum 神经元个数, 必须为大于等于1的数
-    CBPNeuronLayer(IN unsigned int neuronInputNum, IN unsigned int neuronNum)
+    CBPNeuronLayer(IN size_t neuronInputNum, IN size_t neuronNum)
     {
         m_neuronInputNum = neuronInputNum;
 
-        for (unsigned int i = 0; i < neuronNum; i++)
+        for (size_t i = 0; i < neuronNum; i++)
         {
             CBPNeuron* pNeuron = new CBPNeuron(neuronInputNum);
             m_neuronList.push_back(pNeuron);
@@ -125,7 +122,7 @@ public:
 
     ~CBPNeuronLayer()
     {
-        for (unsigned int i = 0; i < m_neuronList.size(); i++)
+        for (size_t i = 0; i < m_neuronList.size(); i++)
         {
             if (m_neuronList[i] != 0)
             {
@@ -140,7 +137,7 @@ public:
     /// @param[in] inputVector 输入向量(行向量), 向量长度必须等于神经元的输入个数
     /// @param[out] pOutputVector 输出向量(行向量), 存储神经元层的输出, 输出向量的长度等于神经元的个数, 该值不能为0
     /// @return 成功返回true, 失败返回false, 参数有误会失败
-    bool Active(IN const LNNMatrix& inputVector, OUT LNNMatrix* pOutputVector)
+    bool Active(IN const LNNMatrixView& inputVector, OUT LNNMatrix* pOutputVector)
     {
         if (m_neuronInputNum < 1 || m_neuronList.size() < 1)
             return false;
@@ -151,14 +148,15 @@ public:
         if (0 == pOutputVector)
             return false;
 
-        for (unsigned int i = 0; i < inputVector.ColumnLen; i++)
+        for (size_t i = 0; i < inputVector.ColumnLen; i++)
         {
             m_inputList[i] = inputVector[0][i];
         }
 
-        for (unsigned int i = 0; i < m_neuronList.size(); i++)
+        // 输入值已复制到连续的输入列表中, 每个神经元直接使用向量内核计算内积
+        for (size_t i = 0; i < m_neuronList.size(); i++)
         {
-            (*pOutputVector)[0][i] = m_neuronList[i]->Active(inputVector);
+            (*pOutputVector)[0][i] = m_neuronList[i]->Active(&m_inputList[0]);
         }
 
         return true;
@@ -178,24 +176,24 @@ public:
             return false;
 
         // 初始化前一层的输出误差列表
-        for (unsigned int i = 0; i < pFrontOpErrorList->size(); i++)
+        for (size_t i = 0; i < pFrontOpErrorList->size(); i++)
         {
             (*pFrontOpErrorList)[i] = 0.0f; 
         }
 
         // 对每个神经元进行反向训练, 并获取每个神经元对前层输出的误差列表
-        for (unsigned int i = 0; i < m_neuronList.size(); i++)
+        for (size_t i = 0; i < m_neuronList.size(); i++)
         {
             m_neuronList[i]->BackTrain(m_inputList, opErrorList[i], learnRate, &m_frontErrorList);
 
             // 累加各个神经元的误差
-            for (unsigned int j = 0; j < pFrontOpErrorList->size(); j++)
+            for (size_t j = 0; j < pFrontOpErrorList->size(); j++)
             {
                 (*pFrontOpErrorList)[j] += m_frontErrorList[j];
             }
         }
 
-        for (unsigned int i = 0; i < pFrontOpErrorList->size(); i++)
+        for (size_t i = 0; i < pFrontOpErrorList->size(); i++)
         {
             (*pFrontOpErrorList)[i] *= m_inputList[i] * (1.0f-m_inputList[i]);
         }
@@ -205,7 +203,7 @@ public:
     }
 
 private:
-    unsigned int m_neuronInputNum; ///< 神经元输入个数
+    size_t m_neuronInputNum; ///< 神经元输入个数
     vector<CBPNeuron*> m_neuronList; ///< 神经元列表
     vector<double> m_inputList; ///< 神经元的输入值列表, 每次调用Active函数被更新
     vector<double> m_frontErrorList; ///< 神经元前层输出误差
@@ -236,7 +234,7 @@ public:
 
     /// @brief 训练BP网络
     /// 详细解释见头文件LBPNetwork中的声明
-    bool Train(IN const LNNMatrix& inputMatrix, IN const LNNMatrix& outputMatrix, IN float rate)
+    bool Train(IN const LNNMatrixView& inputMatrix, IN const LNNMatrixView& outputMatrix, IN float rate)
     {
         if (!m_bInitDone)
             return false;
@@ -256,14 +254,13 @@ public:
 
 
         // 针对每个训练样本, 分别训练
-        for (unsigned int row = 0; row < inputMatrix.RowLen; row++)
+        for (size_t row = 0; row < inputMatrix.RowLen; row++)
         {
-            inputMatrix.GetRow(row, m_inputVectorForTrain);
-            this->Active(m_inputVectorForTrain, &m_outputVectorForTrain);
+            this->Active(inputMatrix.GetRow(row), &m_outputVectorForTrain);
 
             // 计算输出层误差
             vector<double>& errorList = m_layerErrorList[m_layerErrorList.size()-1];
-            for (unsigned int i = 0; i < m_outputVectorForTrain.ColumnLen; i++)
+            for (size_t i = 0; i < m_outputVectorForTrain.ColumnLen; i++)
             {
                 errorList[i] = outputMatrix[row][i]-m_outputVectorForTrain[0][i];
                 errorList[i] *= m_outputVectorForTrain[0][i] * (1.0f-m_outputVectorForTrain[0][i]);
@@ -283,7 +280,7 @@ public:
 
     /// @brief 激活BP网络
     /// 详细解释见头文件LBPNetwork中的声明
-    bool Active(IN const LNNMatrix& inputMatrix, OUT LNNMatrix* pOutputMatrix)
+    bool Active(IN const LNNMatrixView& inputMatrix, OUT LNNMatrix* pOutputMatrix)
     {
         if (!m_bInitDone)
             return false;
@@ -300,19 +297,19 @@ public:
         pOutputMatrix->Reset(inputMatrix.RowLen, m_networkPogology.OutputNumber);
 
 
-        for (unsigned int row = 0; row < inputMatrix.RowLen; row++)
+        for (size_t row = 0; row < inputMatrix.RowLen; row++)
         {
-            inputMatrix.GetRow(row, m_inputVectorForActive);
+            const LNNMatrixView inputVector = inputMatrix.GetRow(row);
 
-            for (unsigned int i = 0; i < m_layerList.size(); i++)
+            for (size_t i = 0; i < m_layerList.size(); i++)
             {
                 if (0 == i)
-                    m_layerList[i]->Active(m_inputVectorForActive, &m_layerOutList[i]);
+                    m_layerList[i]->Active(inputVector, &m_layerOutList[i]);
                 else
                     m_layerList[i]->Active(m_layerOutList[i-1], &m_layerOutList[i]);
             }
 
-            for (unsigned int col = 0; col < pOutputMatrix->ColumnLen; col++)
+            for (size_t col = 0; col < pOutputMatrix->ColumnLen; col++)
             {
                 (*pOutputMatrix)[row][col] = m_layerOutList[m_layerOutList.size()-1][0][col];
             }
@@ -335,9 +332,7 @@ private:
 
         m_layerOutList.resize(pogology.HiddenLayerNumber + 1);
         m_layerErrorList.resize(pogology.HiddenLayerNumber + 2);
-        m_inputVectorForTrain.Reset(1, pogology.InputNumber);
         m_outputVectorForTrain.Reset(1, pogology.OutputNumber);
-        m_inputVectorForActive.Reset(1, pogology.InputNumber);
 
         m_layerErrorList[0].resize(pogology.InputNumber);
 
@@ -349,7 +344,7 @@ private:
         m_layerErrorList[1].resize(pogology.NeuronsOfHiddenLayer);
 
         // 创建剩余的隐藏层
-        for (unsigned int i = 1; i < pogology.HiddenLayerNumber; i++)
+        for (size_t i = 1; i < pogology.HiddenLayerNumber; i++)
         {
             CBPNeuronLayer* pHiddenLayer = new CBPNeuronLayer(pogology.NeuronsOfHiddenLayer, pogology.NeuronsOfHiddenLayer);
             m_layerList.push_back(pHiddenLayer);
@@ -372,7 +367,7 @@ private:
     void CleanUp()
     {
         m_bInitDone = false;
-        for (unsigned int i = 0; i < m_layerList.size(); i++)
+        for (size_t i = 0; i < m_layerList.size(); i++)
         {
             if (0 != m_layerList[i])
             {
@@ -396,9 +391,7 @@ private:
     */
     vector<LNNMatrix> m_layerOutList; ///< 神经元层输出列表
     vector<vector<double>> m_layerErrorList; ///< 神经元层输出误差列表
-    LNNMatrix m_inputVectorForTrain; ///< 输入向量Train函数使用
     LNNMatrix m_outputVectorForTrain; ///< 输出向量Train函数使用
-    LNNMatrix m_inputVectorForActive; ///< 输入向量Active函数使用
 };
 
 LBPNetwork::LBPNetwork(IN const LBPNetworkPogology& pogology)
@@ -416,12 +409,12 @@ LBPNetwork::~LBPNetwork()
     }
 }
 
-bool LBPNetwork::Train(IN const LNNMatrix& inputMatrix, IN const LNNMatrix& outputMatrix, IN float rate)
+bool LBPNetwork::Train(IN const LNNMatrixView& inputMatrix, IN const LNNMatrixView& outputMatrix, IN float rate)
 {
     return m_pBPNetwork->Train(inputMatrix, outputMatrix, rate);
 }
 
-bool LBPNetwork::Active(IN const LNNMatrix& inputMatrix, OUT LNNMatrix* pOutputMatrix)
+bool LBPNetwork::Active(IN const LNNMatrixView& inputMatrix, OUT LNNMatrix* pOutputMatrix)
 {
     return m_pBPNetwork->Active(inputMatrix, pOutputMatrix);
 }
\ No newline at end of file
@@ -16,6 +16,7 @@
 #include "LMatrix.h"
 
 typedef LMatrix<double> LNNMatrix; // 神经网络矩阵
+typedef LMatrixView<double> LNNMatrixView; // 神经网络矩阵视图
 
 
 /// @brief BP网络的拓扑结构
@@ -23,10 +24,10 @@ typedef LMatrix<double> LNNMatrix; // 神经网络矩阵
 /// 隐藏层中至少有一个神经元
 struct LBPNetworkPogology
 {
-    unsigned int InputNumber; ///< 输入个数, 要求大于等于1的数
-    unsigned int OutputNumber; ///< 输出个数, 要求大于等于1的数
-    unsigned int HiddenLayerNumber; ///< 隐藏层层数, 要求大于等于1的数
-    unsigned int NeuronsOfHiddenLayer; ///< 单个隐藏层中的神经元个数, 要求大于等于1的数
+    size_t InputNumber; ///< 输入个数, 要求大于等于1的数
+    size_t OutputNumber; ///< 输出个数, 要求大于等于1的数
+    size_t HiddenLayerNumber; ///< 隐藏层层数, 要求大于等于1的数
+    size_t NeuronsOfHiddenLayer; ///< 单个隐藏层中的神经元个数, 要求大于等于1的数
 };
 
 class CBPNetwork;
@@ -48,7 +49,7 @@ public:
     /// @param[in] outputMatrix 目标输出数据矩阵, 每一行为一个目标输出, 输出矩阵的行数必须等于数据矩阵的行数, 输出矩阵的列数必须等于BP网络的输出个数
     /// @param[in] rate 学习速率为大于0的数
     /// @return 成功训练返回true, , 失败返回false, 参数有误或者网络未初始化会失败
-    bool Train(IN const LNNMatrix& inputMatrix, IN const LNNMatrix& outputMatrix, IN float rate);
+    bool Train(IN const LNNMatrixView& inputMatrix, IN const LNNMatrixView& outputMatrix, IN float rate);
 
     /// @brief 激活神经网络
     /// 
@@ -56,7 +57,7 @@ public:
     /// @param[in] inputMatrix 输入数据矩阵, 每一行为一个输入, 矩阵的列数必须等于BP网络的输入个数
     /// @param[out] pOutputMatrix 存储输出数据矩阵, 每一行为一个输出, 该值不能为0
     /// @return 成功返回true, 失败返回false, 参数有误或者网络未初始化会失败
-    bool Active(IN const LNNMatrix& inputMatrix, OUT LNNMatrix* pOutputMatrix);
+    bool Active(IN const LNNMatrixView& inputMatrix, OUT LNNMatrix* pOutputMatrix);
 
 private:
     CBPNetwork* m_pBPNetwork; ///< BP网络的实现对象
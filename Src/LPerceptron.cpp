@@ -53,7 +53,7 @@ public:
         if (X.RowLen != Y.RowLen)
             return false;
 
-        for (unsigned int n = 0; n < Y.RowLen; n++)
+        for (size_t n = 0; n < Y.RowLen; n++)
         {
             if (Y[n][0] != LPERCEPTRON_SUN &&
                 Y[n][0] != LPERCEPTRON_MOON)
@@ -70,10 +70,10 @@ public:
         while (true)
         {
             // 检验每一个训练样本查看是否被错误分类
-            for (unsigned int i = 0; i < X.RowLen; i++)
+            for (size_t i = 0; i < X.RowLen; i++)
             {
                 float WXi = 0.0f;
-                for (unsigned int n = 0; n < W.size(); n++)
+                for (size_t n = 0; n < W.size(); n++)
                 {
                     WXi += W[n] * X[i][n];
                 }
@@ -84,7 +84,7 @@ public:
                     bErrorClass = true;
 
                     // 更新W和B
-                    for (unsigned int n = 0; n < W.size(); n++)
+                    for (size_t n = 0; n < W.size(); n++)
                     {
                         W[n] = W[n] + Alpha * Y[i][0] * X[i][n];
                     }
@@ -124,7 +124,7 @@ public:
             return 0.0f;
 
         float y = 0.0f;
-        for (unsigned int i = 0; i < sample.ColumnLen; i++)
+        for (size_t i = 0; i < sample.ColumnLen; i++)
         {
             y += sample[0][i] * m_weightVector[i];
         }
@@ -45,7 +45,7 @@ printf("Predict: %f\n", perceptron.Predict(testSample));
 #ifndef _LPERCEPTRON_H_
 #define _LPERCEPTRON_H_
 
-#include "LDataStruct/LMatrix.h"
+#include "LMatrix.h"
 
 #ifndef IN
 #define IN
@@ -8,7 +8,7 @@ using std::vector;
 /// @brief 列值范围
 struct CColumnRange
 {
-    unsigned int Idx; ///< 列索引
+    size_t Idx; ///< 列索引
     double Min;       ///< 最小值
     double Max;       ///< 最大值
     double Dis;       ///< 最大最小值差, 应该大于0.0
@@ -53,30 +53,27 @@ public:
         m_rangeList.clear();
         m_columnLen = matrix.ColumnLen;
 
+        // 找到每一列的最大最小值
+        LDoubleMatrix minVector;
+        LDoubleMatrix maxVector;
+        LDoubleMatrix::COLUMNMIN(matrix, minVector);
+        LDoubleMatrix::COLUMNMAX(matrix, maxVector);
+
         // 针对每一个需要转换的列
-        for (unsigned int i = 0; i < colVec.ColumnLen; i++)
+        for (size_t i = 0; i < colVec.ColumnLen; i++)
         {
             // 数据有误
-            unsigned int colIdx = colVec[0][i];
+            size_t colIdx = colVec[0][i];
             if (colIdx >= matrix.ColumnLen)
             {
                 m_rangeList.clear();
                 return false;
             }
 
-            // 找到每一列的最大最小值
             CColumnRange colRange;
             colRange.Idx = colIdx;
-            colRange.Min = matrix[0][colIdx];
-            colRange.Max = matrix[0][colIdx];
-
-            for (unsigned int row = 0; row < matrix.RowLen; row++)
-            {
-                if (matrix[row][colIdx] < colRange.Min)
-                    colRange.Min = matrix[row][colIdx];
-                if (matrix[row][colIdx] > colRange.Max)
-                    colRange.Max = matrix[row][colIdx];
-            }
+            colRange.Min = minVector[0][colIdx];
+            colRange.Max = maxVector[0][colIdx];
             colRange.Dis = colRange.Max - colRange.Min;
 
             // 数据有误, 该列值都相同
@@ -115,7 +112,7 @@ public:
         for (auto iter = m_rangeList.begin(); iter != m_rangeList.end(); iter++)
         {
             // 针对每一个需要缩放的行
-            for (unsigned int row = 0; row < matrix.RowLen; row++)
+            for (size_t row = 0; row < matrix.RowLen; row++)
             {
                 double prop = (matrix[row][iter->Idx] - iter->Min) / iter->Dis;
 
@@ -134,7 +131,7 @@ private:
     double m_targetMax; ///< 目标最大值
     double m_targetDis; ///< 目标最大最小值差, 应该大于0.0
 
-    unsigned int m_columnLen; ///< 数据列长度
+    size_t m_columnLen; ///< 数据列长度
 
     vector<CColumnRange> m_rangeList; ///< 每列值范围列表
 };
@@ -184,11 +181,11 @@ void DoubleMatrixShuffle(IN unsigned int seed, INOUT LDoubleMatrix& dataMatrix)
     srand(seed);
 
     /// 每次从未处理的数据中随机取出一个数字，然后把该数字放在数组的尾部，即数组尾部存放的是已经处理过的数字
-    for (int i = 0; i < (int)dataMatrix.RowLen; i++)
+    for (size_t i = 0; i < dataMatrix.RowLen; i++)
     {
-        int k = RandInt(0, i);
+        size_t k = (size_t)RandInt(0, (int)i);
 
-        for (int j = 0; j < (int)dataMatrix.ColumnLen; j++)
+        for (size_t j = 0; j < dataMatrix.ColumnLen; j++)
         {
             double t = dataMatrix[k][j];
             dataMatrix[k][j] = dataMatrix[i][j];
@@ -208,18 +205,18 @@ void DoubleMatrixShuffle(IN unsigned int seed, INOUT LDoubleMatrix& dataMatrixA,
     srand(seed);
 
     /// 每次从未处理的数据中随机取出一个数字，然后把该数字放在数组的尾部，即数组尾部存放的是已经处理过的数字
-    for (int i = 0; i < (int)dataMatrixA.RowLen; i++)
+    for (size_t i = 0; i < dataMatrixA.RowLen; i++)
     {
-        int k = RandInt(0, i);
+        size_t k = (size_t)RandInt(0, (int)i);
 
-        for (int j = 0; j < (int)dataMatrixA.ColumnLen; j++)
+        for (size_t j = 0; j < dataMatrixA.ColumnLen; j++)
         {
             double t = dataMatrixA[k][j];
             dataMatrixA[k][j] = dataMatrixA[i][j];
             dataMatrixA[i][j] = t;
         }
 
-        for (int j = 0; j < (int)dataMatrixB.ColumnLen; j++)
+        for (size_t j = 0; j < dataMatrixB.ColumnLen; j++)
         {
 
             double t = dataMatrixB[k][j];
@@ -3,23 +3,97 @@
 
 #include <cmath>
 
+#include "LMatrixSolver.h"
+
 
 namespace Regression
 {
-    /// @brief 样本矩阵中增加常数项, 添加在最后一列, 值为1.0f
-    /// @param[in] sampleMatrix 样本矩阵
-    /// @param[in] newSampleMatrix 添加常数项后的样本矩阵
-    void SamplexAddConstant(IN const LRegressionMatrix& sampleMatrix, OUT LRegressionMatrix& newSampleMatrix)
+    /// @brief 稠密样本矩阵乘法, C = A * B
+    inline void Mul(IN const LRegressionMatrixView& A, IN const LRegressionMatrixView& B, OUT LRegressionMatrix& C)
+    {
+        LRegressionMatrix::MUL(A, B, C);
+    }
+
+    /// @brief 稀疏样本矩阵乘法, C = A * B
+    inline void Mul(IN const LRegressionSparseMatrix& A, IN const LRegressionMatrixView& B, OUT LRegressionMatrix& C)
+    {
+        LRegressionSparseMatrix::MUL(A, B, C);
+    }
+
+    /// @brief 稠密样本矩阵转置乘法, C = A.T() * B
+    inline void MulAtB(IN const LRegressionMatrixView& A, IN const LRegressionMatrixView& B, OUT LRegressionMatrix& C)
+    {
+        LRegressionMatrix::MUL_AT_B(A, B, C);
+    }
+
+    /// @brief 稀疏样本矩阵转置乘法, C = A.T() * B
+    inline void MulAtB(IN const LRegressionSparseMatrix& A, IN const LRegressionMatrixView& B, OUT LRegressionMatrix& C)
+    {
+        LRegressionSparseMatrix::MUL_AT_B(A, B, C);
+    }
+
+    /// @brief 复制稠密样本矩阵
+    inline void ToDense(IN const LRegressionMatrixView& A, OUT LRegressionMatrix& D)
+    {
+        D = LRegressionMatrix(A);
+    }
+
+    /// @brief 稀疏样本矩阵转换为稠密矩阵
+    inline void ToDense(IN const LRegressionSparseMatrix& A, OUT LRegressionMatrix& D)
+    {
+        A.ToDense(D);
+    }
+
+    /// @brief 计算样本矩阵增加常数项后与权重矩阵的乘积, Y = [X, 1] * W
+    /// 常数项添加在样本的最后一列, 值为1.0, 对应权重矩阵的最后一行, 不生成增加常数项后的样本矩阵
+    /// @param[in] sampleMatrix 样本矩阵X(稠密矩阵视图或稀疏矩阵), m * n
+    /// @param[in] weightMatrix 权重矩阵W, (n + 1) * k
+    /// @param[out] outputMatrix 存储结果矩阵Y, m * k
+    template<typename SampleMatrix>
+    void SampleMulWeight(
+        IN const SampleMatrix& sampleMatrix,
+        IN const LRegressionMatrixView& weightMatrix,
+        OUT LRegressionMatrix& outputMatrix)
     {
-        // 每个样本中最后一项增加常数项的特征值:1.0
-        newSampleMatrix.Reset(sampleMatrix.RowLen, sampleMatrix.ColumnLen + 1);
-        for (unsigned int row = 0; row < sampleMatrix.RowLen; row++)
+        const size_t n = sampleMatrix.ColumnLen;
+        Mul(sampleMatrix, weightMatrix.SubMatrix(0, n, 0, weightMatrix.ColumnLen), outputMatrix);
+
+        const LRegressionMatrix bias(weightMatrix.SubMatrix(n, 1, 0, weightMatrix.ColumnLen));
+        for (size_t row = 0; row < outputMatrix.RowLen; row++)
+        {
+            LVectorKernel<double>::Add(outputMatrix.ColumnLen, outputMatrix[row], bias[0], outputMatrix[row]);
+        }
+    }
+
+    /// @brief 计算样本矩阵增加常数项后的转置与误差矩阵的乘积, D = [X, 1].T() * E
+    /// 结果矩阵的最后一行对应常数项, 为误差矩阵每一列的和
+    /// @param[in] sampleMatrix 样本矩阵X(稠密矩阵视图或稀疏矩阵), m * n
+    /// @param[in] errorMatrix 误差矩阵E, m * k
+    /// @param[out] outputMatrix 存储结果矩阵D, (n + 1) * k
+    template<typename SampleMatrix>
+    void SampleTMulError(
+        IN const SampleMatrix& sampleMatrix,
+        IN const LRegressionMatrixView& errorMatrix,
+        OUT LRegressionMatrix& outputMatrix)
+    {
+        const size_t n = sampleMatrix.ColumnLen;
+        LRegressionMatrix D;
+        MulAtB(sampleMatrix, errorMatrix, D);
+
+        LRegressionMatrix errorSum;
+        LRegressionMatrix::COLUMNSUM(errorMatrix, errorSum);
+
+        outputMatrix.Reset(n + 1, errorMatrix.ColumnLen);
+        for (size_t row = 0; row < n; row++)
         {
-            for (unsigned int col = 0; col < sampleMatrix.ColumnLen; col++)
+            for (size_t col = 0; col < D.ColumnLen; col++)
             {
-                newSampleMatrix[row][col] = sampleMatrix[row][col];
+                outputMatrix[row][col] = D[row][col];
             }
-            newSampleMatrix[row][sampleMatrix.ColumnLen] = 1.0f; 
+        }
+        for (size_t col = 0; col < errorMatrix.ColumnLen; col++)
+        {
+            outputMatrix[n][col] = errorSum[0][col];
         }
     }
 }
@@ -33,6 +107,8 @@ public:
     CLinearRegression()
     {
         m_N = 0;
+        m_solver = REGRESSION_SOLVER_GRADIENT;
+        m_lambda = 0.0;
     }
 
     ~CLinearRegression()
@@ -40,9 +116,28 @@ public:
 
     }
 
+    /// @brief 设置求解方法
+    bool SetSolver(IN LREGRESSION_SOLVER solver, IN double lambda)
+    {
+        if (solver != REGRESSION_SOLVER_GRADIENT &&
+            solver != REGRESSION_SOLVER_CHOLESKY &&
+            solver != REGRESSION_SOLVER_QR)
+            return false;
+        if (!(lambda >= 0.0))
+            return false;
+
+        m_solver = solver;
+        m_lambda = lambda;
+        return true;
+    }
+
     /// @brief 训练模型
-    bool TrainModel(IN const LRegressionMatrix& xMatrix, IN const LRegressionMatrix& yVector, IN double alpha)
+    template<typename SampleMatrix>
+    bool TrainModel(IN const SampleMatrix& xMatrix, IN const LRegressionMatrixView& yVector, IN double alpha)
     {
+        if (m_solver != REGRESSION_SOLVER_GRADIENT)
+            return this->Solve(xMatrix, yVector);
+
         // 第一次训练, 记录下特征值数量, 并且初始化权重向量为0.0
         if (m_N == 0)
         {
@@ -65,32 +160,35 @@ public:
         if (alpha <= 0.0)
             return false;
 
-        LRegressionMatrix X;
-        Regression::SamplexAddConstant(xMatrix, X);
-
-        const LRegressionMatrix& Y = yVector;
+        const LRegressionMatrixView& Y = yVector;
         LRegressionMatrix& W = m_wVector;
 
-        LRegressionMatrix XT = X.T();
-
+        // 临时矩阵从内存池中分配, 函数返回时重置内存池
+        LMatrixArenaScope arenaScope(m_arena);
         LRegressionMatrix XW;
         LRegressionMatrix DW;
 
         /*
         h(x) = X * W
-        wj = wj - α * ∑((h(x)-y) * xj)
+        wj = wj - α * (∑((h(x)-y) * xj) + λ * wj)
         */
-        LRegressionMatrix::MUL(X, W, XW);
+        Regression::SampleMulWeight(xMatrix, W, XW);
         LRegressionMatrix::SUB(XW, Y, XW);
-        LRegressionMatrix::MUL(XT, XW, DW);
-        LRegressionMatrix::SCALARMUL(DW, -1.0 * alpha, DW);
-        LRegressionMatrix::ADD(W, DW, W);
+        Regression::SampleTMulError(xMatrix, XW, DW);
+        if (m_lambda > 0.0)
+        {
+            // 常数项不参与正则化
+            for (size_t row = 0; row < m_N; row++)
+                DW[row][0] += m_lambda * W[row][0];
+        }
+        W -= DW.ScalarMul(alpha);
 
         return true;
     }
 
     /// @brief 使用训练好的模型预测数据
-    bool Predict(IN const LRegressionMatrix& xMatrix, OUT LRegressionMatrix& yVector) const
+    template<typename SampleMatrix>
+    bool Predict(IN const SampleMatrix& xMatrix, OUT LRegressionMatrix& yVector) const
     {
         // 检查参数
         // 特征值小于1说明模型还没有训练
@@ -102,16 +200,14 @@ public:
         if (xMatrix.ColumnLen != m_N)
             return false;
 
-        LRegressionMatrix X;
-        Regression::SamplexAddConstant(xMatrix, X);
-
-        LRegressionMatrix::MUL(X, m_wVector, yVector);
+        Regression::SampleMulWeight(xMatrix, m_wVector, yVector);
 
         return true;
     }
 
     /// @brief 计算模型得分
-    double Score(IN const LRegressionMatrix& xMatrix, IN LRegressionMatrix& yVector) const
+    template<typename SampleMatrix>
+    double Score(IN const SampleMatrix& xMatrix, IN const LRegressionMatrixView& yVector) const
     {
         LRegressionMatrix predictY;
         bool bRet = this->Predict(xMatrix, predictY);
@@ -119,23 +215,23 @@ public:
             return 2.0;
 
 
-        double sumY = 0.0;
-        for (unsigned int i = 0; i < yVector.RowLen; i++)
-        {
-            sumY += yVector[i][0];
-        }
-        double meanY = sumY / (double)yVector.RowLen;
+        LRegressionMatrix sumMatrix;
+        LRegressionMatrix::COLUMNSUM(yVector, sumMatrix);
+        double meanY = sumMatrix[0][0] / (double)yVector.RowLen;
 
-        double lossValue = 0.0;
-        double denominator = 0.0;
-        for (unsigned int i = 0; i < yVector.RowLen; i++)
-        {
-            double dis = yVector[i][0] - predictY[i][0];
-            lossValue += dis * dis;
+        // 残差平方和
+        LRegressionMatrix disVector;
+        LRegressionMatrix::SUB(yVector, predictY, disVector);
+        LRegressionMatrix::DOTMUL(disVector, disVector, disVector);
+        LRegressionMatrix::COLUMNSUM(disVector, sumMatrix);
+        double lossValue = sumMatrix[0][0];
 
-            dis = yVector[i][0] - meanY;
-            denominator += dis * dis;
-        }
+        // 总平方和
+        disVector.Reset(yVector.RowLen, 1, meanY);
+        LRegressionMatrix::SUB(yVector, disVector, disVector);
+        LRegressionMatrix::DOTMUL(disVector, disVector, disVector);
+        LRegressionMatrix::COLUMNSUM(disVector, sumMatrix);
+        double denominator = sumMatrix[0][0];
 
         double score = 1.0 - lossValue / denominator;
 
@@ -143,8 +239,65 @@ public:
     }
 
 private:
-    unsigned int m_N; ///< 样本特征值个数
+    /// @brief 直接求解最小二乘问题
+    /// 样本和输出先减去均值, 求解不含常数项的(岭)回归, 常数项 b = mean(y) - mean(X) * w
+    /// 去除均值使常数项不参与正则化, 同时改善了矩阵的条件数
+    template<typename SampleMatrix>
+    bool Solve(IN const SampleMatrix& xMatrix, IN const LRegressionMatrixView& yVector)
+    {
+        // 检查参数
+        if (xMatrix.RowLen < 1 || xMatrix.ColumnLen < 1)
+            return false;
+        if (yVector.ColumnLen != 1)
+            return false;
+        if (yVector.RowLen != xMatrix.RowLen)
+            return false;
+
+        const size_t m = xMatrix.RowLen;
+        const size_t n = xMatrix.ColumnLen;
+
+        LRegressionMatrix X;
+        Regression::ToDense(xMatrix, X);
+        LRegressionMatrix Y(yVector);
+
+        LRegressionMatrix meanX;
+        LRegressionMatrix meanY;
+        LRegressionMatrix::COLUMNSUM(X, meanX);
+        LRegressionMatrix::COLUMNSUM(Y, meanY);
+        LVectorKernel<double>::Scale(n, 1.0 / (double)m, meanX[0], meanX[0]);
+        meanY[0][0] /= (double)m;
+
+        for (size_t row = 0; row < m; row++)
+        {
+            LVectorKernel<double>::Sub(n, X[row], meanX[0], X[row]);
+            Y[row][0] -= meanY[0][0];
+        }
+
+        const LLEAST_SQUARES_METHOD method =
+            (m_solver == REGRESSION_SOLVER_QR) ? LLEAST_SQUARES_QR : LLEAST_SQUARES_CHOLESKY;
+        LRegressionMatrix W;
+        if (!LMatrixSolver<double>::LEASTSQUARES(X, Y, method, m_lambda, W))
+            return false;
+
+        m_N = n;
+        m_wVector.Reset(n + 1, 1);
+        double bias = meanY[0][0];
+        for (size_t row = 0; row < n; row++)
+        {
+            m_wVector[row][0] = W[row][0];
+            bias -= meanX[0][row] * W[row][0];
+        }
+        m_wVector[n][0] = bias;
+
+        return true;
+    }
+
+private:
+    size_t m_N; ///< 样本特征值个数
     LRegressionMatrix m_wVector; ///<权重矩阵(列向量)
+    LREGRESSION_SOLVER m_solver; ///< 求解方法
+    double m_lambda; ///< 岭正则化系数
+    LMatrixArena m_arena; ///< 梯度下降中临时矩阵的内存池
 };
 
 LLinearRegression::LLinearRegression()
@@ -162,17 +315,37 @@ LLinearRegression::~LLinearRegression()
     }
 }
 
-bool LLinearRegression::TrainModel(IN const LRegressionMatrix& xMatrix, IN const LRegressionMatrix& yVector, IN double alpha)
+bool LLinearRegression::SetSolver(IN LREGRESSION_SOLVER solver, IN double lambda)
+{
+    return m_pLinearRegression->SetSolver(solver, lambda);
+}
+
+bool LLinearRegression::TrainModel(IN const LRegressionMatrixView& xMatrix, IN const LRegressionMatrixView& yVector, IN double alpha)
 {
     return m_pLinearRegression->TrainModel(xMatrix, yVector, alpha);
 }
 
-bool LLinearRegression::Predict(IN const LRegressionMatrix& xMatrix, OUT LRegressionMatrix& yVector) const
+bool LLinearRegression::TrainModel(IN const LRegressionSparseMatrix& xMatrix, IN const LRegressionMatrixView& yVector, IN double alpha)
+{
+    return m_pLinearRegression->TrainModel(xMatrix, yVector, alpha);
+}
+
+bool LLinearRegression::Predict(IN const LRegressionMatrixView& xMatrix, OUT LRegressionMatrix& yVector) const
+{
+    return m_pLinearRegression->Predict(xMatrix, yVector);
+}
+
+bool LLinearRegression::Predict(IN const LRegressionSparseMatrix& xMatrix, OUT LRegressionMatrix& yVector) const
 {
     return m_pLinearRegression->Predict(xMatrix, yVector);
 }
 
-double LLinearRegression::Score(IN const LRegressionMatrix& xMatrix, IN LRegressionMatrix& yVector) const
+double LLinearRegression::Score(IN const LRegressionMatrixView& xMatrix, IN const LRegressionMatrixView& yVector) const
+{
+    return m_pLinearRegression->Score(xMatrix, yVector);
+}
+
+double LLinearRegression::Score(IN const LRegressionSparseMatrix& xMatrix, IN const LRegressionMatrixView& yVector) const
 {
     return m_pLinearRegression->Score(xMatrix, yVector);
 }
@@ -200,7 +373,8 @@ public:
     }
 
     /// @brief 训练模型
-    bool TrainModel(IN const LRegressionMatrix& xMatrix, IN const LRegressionMatrix& yVector, IN double alpha)
+    template<typename SampleMatrix>
+    bool TrainModel(IN const SampleMatrix& xMatrix, IN const LRegressionMatrixView& yVector, IN double alpha)
     {
         // 第一次训练, 记录下特征值数量, 并且初始化权重向量为0.0
         if (m_N == 0)
@@ -226,20 +400,19 @@ public:
         if (alpha <= 0.0)
             return false;
 
-        for (unsigned int i = 0; i < yVector.RowLen; i++)
+        for (size_t i = 0; i < yVector.RowLen; i++)
         {
             if (yVector[i][0] != REGRESSION_ONE &&
                 yVector[i][0] != REGRESSION_ZERO)
                 return false;
         }
 
-        LRegressionMatrix X;
-        Regression::SamplexAddConstant(xMatrix, X);
-
-        const LRegressionMatrix& Y = yVector;
+        const LRegressionMatrixView& Y = yVector;
 
         LRegressionMatrix& W = m_wVector;
-        LRegressionMatrix XT = X.T();
+
+        // 临时矩阵从内存池中分配, 函数返回时重置内存池
+        LMatrixArenaScope arenaScope(m_arena);
 
         /*
         如果h(x)  =  1/(1 + e^(X * W)) 则
@@ -248,26 +421,26 @@ public:
         wj = wj + α * ∑((y - h(x)) * xj)
         */
 
-        LRegressionMatrix XW(X.RowLen, 1);
+        LRegressionMatrix XW;
         LRegressionMatrix DW;
 
-        LRegressionMatrix::MUL(X, W, XW);
-        for (unsigned int m = 0; m < XW.RowLen; m++)
+        Regression::SampleMulWeight(xMatrix, W, XW);
+        for (size_t m = 0; m < XW.RowLen; m++)
         {
             this->Sigmoid(XW[m][0], XW[m][0]);
         }
 
         LRegressionMatrix::SUB(Y, XW, XW);
-        LRegressionMatrix::MUL(XT, XW, DW);
+        Regression::SampleTMulError(xMatrix, XW, DW);
 
-        LRegressionMatrix::SCALARMUL(DW, -1.0f * alpha, DW);
-        LRegressionMatrix::ADD(W, DW, W);
+        W -= DW.ScalarMul(alpha);
 
         return true;
     }
 
     /// @brief 使用训练好的模型预测数据
-    bool Predict(IN const LRegressionMatrix& xMatrix, OUT LRegressionMatrix& yVector) const
+    template<typename SampleMatrix>
+    bool Predict(IN const SampleMatrix& xMatrix, OUT LRegressionMatrix& yVector) const
     {
         // 检查参数
         if (m_N < 1)
@@ -278,13 +451,9 @@ public:
         if (xMatrix.ColumnLen != m_N)
             return false;
 
-        LRegressionMatrix X;
-        Regression::SamplexAddConstant(xMatrix, X);
-
-        yVector.Reset(X.RowLen, 1, 0.0f);
-        LRegressionMatrix::MUL(X, m_wVector, yVector);
+        Regression::SampleMulWeight(xMatrix, m_wVector, yVector);
 
-        for (unsigned int m = 0; m < yVector.RowLen; m++)
+        for (size_t m = 0; m < yVector.RowLen; m++)
         {
             this->Sigmoid(yVector[m][0], yVector[m][0]);
         }
@@ -294,7 +463,8 @@ public:
     }
 
     /// @brief 计算模型得分
-    double Score(IN const LRegressionMatrix& xMatrix, IN const LRegressionMatrix& yVector) const
+    template<typename SampleMatrix>
+    double Score(IN const SampleMatrix& xMatrix, IN const LRegressionMatrixView& yVector) const
     {
         // 检查参数
         // 特征值小于1说明模型还没有训练
@@ -313,7 +483,7 @@ public:
         this->Predict(xMatrix, predictY);
 
         double score = 0.0;
-        for (unsigned int i = 0; i < yVector.RowLen; i++)
+        for (size_t i = 0; i < yVector.RowLen; i++)
         {
             if (yVector[i][0] == REGRESSION_ONE)
             {
@@ -335,7 +505,8 @@ public:
     }
 
     /// @brief 计算似然值, 似然值为0.0~1.0之间的数, 似然值值越大模型越好
-    double LikelihoodValue(IN const LRegressionMatrix& xMatrix, IN const LRegressionMatrix& yVector) const
+    template<typename SampleMatrix>
+    double LikelihoodValue(IN const SampleMatrix& xMatrix, IN const LRegressionMatrixView& yVector) const
     {
         // 检查参数
         // 特征值小于1说明模型还没有训练
@@ -354,7 +525,7 @@ public:
         this->Predict(xMatrix, predictY);
 
         double likelihood = 1.0;
-        for (unsigned int i = 0; i < yVector.RowLen; i++)
+        for (size_t i = 0; i < yVector.RowLen; i++)
         {
             if (yVector[i][0] == REGRESSION_ONE)
                 likelihood *= predictY[i][0];
@@ -377,8 +548,9 @@ private:
     }
 
 private:
-    unsigned int m_N; ///< 样本特征值个数
+    size_t m_N; ///< 样本特征值个数
     LRegressionMatrix m_wVector; ///<权重矩阵(列向量)
+    LMatrixArena m_arena; ///< 梯度下降中临时矩阵的内存池
 };
 
 LLogisticRegression::LLogisticRegression()
@@ -396,22 +568,42 @@ LLogisticRegression::~LLogisticRegression()
     }
 }
 
-bool LLogisticRegression::TrainModel(IN const LRegressionMatrix& xMatrix, IN const LRegressionMatrix& yVector, IN double alpha)
+bool LLogisticRegression::TrainModel(IN const LRegressionMatrixView& xMatrix, IN const LRegressionMatrixView& yVector, IN double alpha)
 {
     return m_pLogisticRegression->TrainModel(xMatrix, yVector, alpha);
 }
 
-bool LLogisticRegression::Predict(IN const LRegressionMatrix& xMatrix, OUT LRegressionMatrix& yVector) const
+bool LLogisticRegression::TrainModel(IN const LRegressionSparseMatrix& xMatrix, IN const LRegressionMatrixView& yVector, IN double alpha)
+{
+    return m_pLogisticRegression->TrainModel(xMatrix, yVector, alpha);
+}
+
+bool LLogisticRegression::Predict(IN const LRegressionMatrixView& xMatrix, OUT LRegressionMatrix& yVector) const
+{
+    return m_pLogisticRegression->Predict(xMatrix, yVector);
+}
+
+bool LLogisticRegression::Predict(IN const LRegressionSparseMatrix& xMatrix, OUT LRegressionMatrix& yVector) const
 {
     return m_pLogisticRegression->Predict(xMatrix, yVector);
 }
 
-double LLogisticRegression::Score(IN const LRegressionMatrix& xMatrix, IN const LRegressionMatrix& yVector) const
+double LLogisticRegression::Score(IN const LRegressionMatrixView& xMatrix, IN const LRegressionMatrixView& yVector) const
 {
     return m_pLogisticRegression->Score(xMatrix, yVector);
 }
 
-double LLogisticRegression::LikelihoodValue(IN const LRegressionMatrix& xMatrix, IN const LRegressionMatrix& yVector) const
+double LLogisticRegression::Score(IN const LRegressionSparseMatrix& xMatrix, IN const LRegressionMatrixView& yVector) const
+{
+    return m_pLogisticRegression->Score(xMatrix, yVector);
+}
+
+double LLogisticRegression::LikelihoodValue(IN const LRegressionMatrixView& xMatrix, IN const LRegressionMatrixView& yVector) const
+{
+    return m_pLogisticRegression->LikelihoodValue(xMatrix, yVector);
+}
+
+double LLogisticRegression::LikelihoodValue(IN const LRegressionSparseMatrix& xMatrix, IN const LRegressionMatrixView& yVector) const
 {
     return m_pLogisticRegression->LikelihoodValue(xMatrix, yVector);
 }
@@ -432,7 +624,8 @@ public:
     }
 
     /// @brief 训练模型
-    bool TrainModel(IN const LRegressionMatrix& xMatrix, IN const LRegressionMatrix& yMatrix, IN double alpha)
+    template<typename SampleMatrix>
+    bool TrainModel(IN const SampleMatrix& xMatrix, IN const LRegressionMatrixView& yMatrix, IN double alpha)
     {
         if (m_N == 0)
         {
@@ -456,41 +649,30 @@ public:
         if (alpha <= 0.0)
             return false;
 
-        // 增加常数项后的样本矩阵
-        LRegressionMatrix X;
-        Regression::SamplexAddConstant(xMatrix, X);
-
         // 权重矩阵
         LRegressionMatrix& W = m_wMatrix;
 
+        // 临时矩阵从内存池中分配, 函数返回时重置内存池
+        LMatrixArenaScope arenaScope(m_arena);
+
         // 概率矩阵
-        LRegressionMatrix P(X.RowLen, m_K, 0.0);
+        LRegressionMatrix P;
 
         // 计算概率矩阵
-        this->SampleProbK(X, W, P);
+        this->SampleProbK(xMatrix, W, P);
 
         LRegressionMatrix::SUB(yMatrix, P, P);
 
-        // 权重向量(列向量)
-        LRegressionMatrix dwVec(m_N + 1, 1, 0.0f);
+        // 权重梯度矩阵, 每一列为一个分类的权重梯度
+        LRegressionMatrix DW;
+        Regression::SampleTMulError(xMatrix, P, DW);
 
         // 第一个权重值不优化, 解决Softmax回归参数有冗余的问题
-        for (unsigned int k = 1; k < m_K; k++)
+        for (size_t k = 1; k < m_K; k++)
         {
-            dwVec.Reset(m_N + 1, 1, 0.0f);
-            for (unsigned int row = 0; row < X.RowLen; row++)
-            {
-                for (unsigned int col = 0; col < X.ColumnLen; col++)
-                {
-                    dwVec[col][0] += X[row][col] * P[row][k];
-                }
-            }
-
-            LRegressionMatrix::SCALARMUL(dwVec, alpha, dwVec);
-
-            for (unsigned int row = 0; row < m_wMatrix.RowLen; row++)
+            for (size_t row = 0; row < m_wMatrix.RowLen; row++)
             {
-                m_wMatrix[row][k] += dwVec[row][0];
+                m_wMatrix[row][k] += alpha * DW[row][k];
             }
         }
 
@@ -498,7 +680,8 @@ public:
     }
 
     /// @brief 使用训练好的模型预测数据
-    bool Predict(IN const LRegressionMatrix& xMatrix, OUT LRegressionMatrix& yMatrix) const
+    template<typename SampleMatrix>
+    bool Predict(IN const SampleMatrix& xMatrix, OUT LRegressionMatrix& yMatrix) const
     {
         // 检查参数
         if (m_N < 1 || m_K < 2)
@@ -509,18 +692,14 @@ public:
         if (xMatrix.ColumnLen != m_N)
             return false;
 
-        yMatrix.Reset(xMatrix.RowLen, m_K, 0.0f);
-
-        LRegressionMatrix X;
-        Regression::SamplexAddConstant(xMatrix, X);
-
-        this->SampleProbK(X, m_wMatrix, yMatrix);
+        this->SampleProbK(xMatrix, m_wMatrix, yMatrix);
 
         return true;
     }
 
     /// @brief 计算模型得分
-    double Score(IN const LRegressionMatrix& xMatrix, IN const LRegressionMatrix& yMatrix) const
+    template<typename SampleMatrix>
+    double Score(IN const SampleMatrix& xMatrix, IN const LRegressionMatrixView& yMatrix) const
     {
         // 检查参数
         if (m_N < 1 || m_K < 2)
@@ -537,24 +716,16 @@ public:
         LRegressionMatrix predictY;
         this->Predict(xMatrix, predictY);
 
+        // 标记矩阵中每行最大值(REGRESSION_ONE)的位置为样本类别, 概率矩阵中每行最大值的位置为预测类别
+        LMatrix<size_t> labelVector;
+        LMatrix<size_t> predictLabelVector;
+        LRegressionMatrix::ROWARGMAX(yMatrix, labelVector);
+        LRegressionMatrix::ROWARGMAX(predictY, predictLabelVector);
+
         double score = 0.0;
-        for (unsigned int row = 0; row < yMatrix.RowLen; row++)
+        for (size_t row = 0; row < yMatrix.RowLen; row++)
         {
-            unsigned int label;
-            unsigned int predictLabel;
-            double maxProb = 0.0;
-            for (unsigned int col = 0; col < yMatrix.ColumnLen; col++)
-            {
-                if (yMatrix[row][col] == REGRESSION_ONE)
-                    label = col;
-                if (predictY[row][col] > maxProb)
-                {
-                    maxProb = predictY[row][col];
-                    predictLabel = col;
-                }
-            }
-
-            if (label == predictLabel)
+            if (labelVector[row][0] == predictLabelVector[row][0])
                 score += 1.0;
         }
 
@@ -562,7 +733,8 @@ public:
     }
 
     /// @brief 计算似然值, 似然值为0.0~1.0之间的数, 似然值值越大模型越好
-    double LikelihoodValue(IN const LRegressionMatrix& xMatrix, IN const LRegressionMatrix& yMatrix) const
+    template<typename SampleMatrix>
+    double LikelihoodValue(IN const SampleMatrix& xMatrix, IN const LRegressionMatrixView& yMatrix) const
     {
         // 检查参数
         // 特征值小于1说明模型还没有训练
@@ -581,9 +753,9 @@ public:
         this->Predict(xMatrix, predictY);
 
         double likelihood = 1.0;
-        for (unsigned int i = 0; i < yMatrix.RowLen; i++)
+        for (size_t i = 0; i < yMatrix.RowLen; i++)
         {
-            for (unsigned int j = 0; j < yMatrix.ColumnLen; j++)
+            for (size_t j = 0; j < yMatrix.ColumnLen; j++)
             {
                 if (yMatrix[i][j] == REGRESSION_ONE)
                 {
@@ -599,44 +771,44 @@ public:
 
 private:
     /// @brief 计算样本属于K个分类的各个概率
-    /// @param[in] sampleMatrix 样本矩阵, m * n
-    /// @param[in] weightMatrix 权重矩阵, n * k, 每一列为一个分类权重
+    /// @param[in] sampleMatrix 样本矩阵(不含常数项), m * n
+    /// @param[in] weightMatrix 权重矩阵, (n + 1) * k, 每一列为一个分类权重, 最后一行为常数项权重
     /// @param[out] probMatrix 概率矩阵, 存储每个样本属于不同分类的概率
+    template<typename SampleMatrix>
     void SampleProbK(
-        IN const LRegressionMatrix& sampleMatrix, 
-        IN const LRegressionMatrix& weightMatrix, 
+        IN const SampleMatrix& sampleMatrix, 
+        IN const LRegressionMatrixView& weightMatrix, 
         OUT LRegressionMatrix& probMatrix) const
     {
-        LRegressionMatrix::MUL(sampleMatrix, weightMatrix, probMatrix);
+        Regression::SampleMulWeight(sampleMatrix, weightMatrix, probMatrix);
 
-        for (unsigned int row = 0; row < probMatrix.RowLen; row++)
+        // 每行先减去该行的最大值再求指数, 结果不变, 但避免指数溢出
+        LRegressionMatrix maxVector;
+        LRegressionMatrix::ROWMAX(probMatrix, maxVector);
+        for (size_t row = 0; row < probMatrix.RowLen; row++)
         {
-            for (unsigned int col = 0; col < probMatrix.ColumnLen; col++)
+            double* pRow = probMatrix[row];
+            LVectorKernel<double>::AddScalar(probMatrix.ColumnLen, -maxVector[row][0], pRow, pRow);
+            for (size_t col = 0; col < probMatrix.ColumnLen; col++)
             {
-                probMatrix[row][col] = exp(probMatrix[row][col]);
+                pRow[col] = exp(pRow[col]);
             }
         }
 
-        for (unsigned int row = 0; row < probMatrix.RowLen; row++)
+        LRegressionMatrix sumVector;
+        LRegressionMatrix::ROWSUM(probMatrix, sumVector);
+        for (size_t row = 0; row < probMatrix.RowLen; row++)
         {
-            double sum = 0.0;
-            for (unsigned int col = 0; col < probMatrix.ColumnLen; col++)
-            {
-                sum += probMatrix[row][col];
-            }
-
-            for (unsigned int col = 0; col < probMatrix.ColumnLen; col++)
-            {
-                probMatrix[row][col] = probMatrix[row][col]/sum;
-            }
+            LVectorKernel<double>::DivScalar(probMatrix.ColumnLen, sumVector[row][0], probMatrix[row], probMatrix[row]);
         }
     }
 
 private:
-    unsigned int m_N; ///< 样本特征值个数
-    unsigned int m_K; ///< 样本类别个数
+    size_t m_N; ///< 样本特征值个数
+    size_t m_K; ///< 样本类别个数
 
     LRegressionMatrix m_wMatrix; ///<权重矩阵, 每一列则为一个分类的权重向量
+    LMatrixArena m_arena; ///< 梯度下降中临时矩阵的内存池
 };
 
 LSoftmaxRegression::LSoftmaxRegression()
@@ -655,22 +827,37 @@ LSoftmaxRegression::~LSoftmaxRegression()
 }
 
 
-bool LSoftmaxRegression::TrainModel(IN const LRegressionMatrix& xMatrix, IN const LRegressionMatrix& yMatrix, IN double alpha)
+bool LSoftmaxRegression::TrainModel(IN const LRegressionMatrixView& xMatrix, IN const LRegressionMatrixView& yMatrix, IN double alpha)
+{
+    return m_pSoftmaxRegression->TrainModel(xMatrix, yMatrix, alpha);
+}
+
+bool LSoftmaxRegression::TrainModel(IN const LRegressionSparseMatrix& xMatrix, IN const LRegressionMatrixView& yMatrix, IN double alpha)
 {
     return m_pSoftmaxRegression->TrainModel(xMatrix, yMatrix, alpha);
 }
 
-bool LSoftmaxRegression::Predict(IN const LRegressionMatrix& xMatrix, OUT LRegressionMatrix& yMatrix) const
+bool LSoftmaxRegression::Predict(IN const LRegressionMatrixView& xMatrix, OUT LRegressionMatrix& yMatrix) const
 {
     return m_pSoftmaxRegression->Predict(xMatrix, yMatrix);
 }
 
-double LSoftmaxRegression::Score(IN const LRegressionMatrix& xMatrix, IN const LRegressionMatrix& yMatrix) const
+bool LSoftmaxRegression::Predict(IN const LRegressionSparseMatrix& xMatrix, OUT LRegressionMatrix& yMatrix) const
+{
+    return m_pSoftmaxRegression->Predict(xMatrix, yMatrix);
+}
+
+double LSoftmaxRegression::Score(IN const LRegressionMatrixView& xMatrix, IN const LRegressionMatrixView& yMatrix) const
+{
+    return m_pSoftmaxRegression->Score(xMatrix, yMatrix);
+}
+
+double LSoftmaxRegression::Score(IN const LRegressionSparseMatrix& xMatrix, IN const LRegressionMatrixView& yMatrix) const
 {
     return m_pSoftmaxRegression->Score(xMatrix, yMatrix);
 }
 
-double LSoftmaxRegression::LikelihoodValue(IN const LRegressionMatrix& xMatrix, IN const LRegressionMatrix& yMatrix) const
+double LSoftmaxRegression::LikelihoodValue(IN const LRegressionMatrixView& xMatrix, IN const LRegressionMatrixView& yMatrix) const
 {
     return m_pSoftmaxRegression->LikelihoodValue(xMatrix, yMatrix);
 }
\ No newline at end of file
@@ -17,6 +17,7 @@
 /// 梯度下降算法: 每次训练使用所有样本集, 如果样本集很大, 则导致内存开销大, 并且训练耗时长, 优点是收敛快
 /// 随机梯度下降算法: 每次训练使用样本集中的一个样本, 缺点是收敛慢
 /// 批量梯度下降算法: 综合以上两种
+/// 线性回归还可以直接求解法方程(Cholesky分解或者QR分解), 一次训练即得到最优解, 见LREGRESSION_SOLVER
 /// @author Jie Liu Email:coderjie@outlook.com
 /// @version   
 /// @date 2018/01/31
@@ -27,8 +28,19 @@
 
 
 #include "LMatrix.h"
+#include "LSparseMatrix.h"
 
 typedef LMatrix<double> LRegressionMatrix;
+typedef LMatrixView<double> LRegressionMatrixView;
+typedef LSparseMatrix<double> LRegressionSparseMatrix;
+
+/// @brief 线性回归的求解方法
+enum LREGRESSION_SOLVER
+{
+    REGRESSION_SOLVER_GRADIENT = 0,     ///< 梯度下降, 每次训练为一步梯度下降(默认)
+    REGRESSION_SOLVER_CHOLESKY = 1,     ///< 法方程的Cholesky分解, 一次训练得到最优解, 计算量小
+    REGRESSION_SOLVER_QR = 2            ///< 样本矩阵的QR分解, 一次训练得到最优解, 数值稳定性更好
+};
 
 class CLinearRegression;
 
@@ -42,27 +54,46 @@ public:
     /// @brief 析构函数
     ~LLinearRegression();
 
+    /// @brief 设置求解方法
+    /// 请在训练前设置, 默认为梯度下降并且不使用正则化
+    /// @param[in] solver 求解方法
+    /// @param[in] lambda 岭(L2)正则化系数, 不能小于0, 常数项不参与正则化
+    /// @return 参数错误返回false
+    bool SetSolver(IN LREGRESSION_SOLVER solver, IN double lambda = 0.0);
+
     /// @brief 训练模型
+    /// 梯度下降:
     /// 如果一次训练的样本数量为1, 则为随机梯度下降
     /// 如果一次训练的样本数量为M(样本总数), 则为梯度下降
     /// 如果一次训练的样本数量为m(1 < m < M), 则为批量梯度下降
+    /// 直接求解(Cholesky或QR): 每次训练使用给定的样本重新求解, 忽略alpha
+    /// 样本矩阵(去除均值后)列满秩或者lambda大于0时才有唯一解, 否则返回失败
     /// @param[in] xMatrix 样本矩阵, 每一行代表一个样本, 每一列代表样本的一个特征
     /// @param[in] yVector(列向量) 样本输出向量, 每一行代表一个样本
     /// @param[in] alpha 学习速度, 该值必须大于0.0f
     /// @return 成功返回true, 失败返回false(参数错误的情况下会返回失败)
-    bool TrainModel(IN const LRegressionMatrix& xMatrix, IN const LRegressionMatrix& yVector, IN double alpha);
+    bool TrainModel(IN const LRegressionMatrixView& xMatrix, IN const LRegressionMatrixView& yVector, IN double alpha);
+
+    /// @brief 使用稀疏样本矩阵训练模型, 参数及返回值同上
+    bool TrainModel(IN const LRegressionSparseMatrix& xMatrix, IN const LRegressionMatrixView& yVector, IN double alpha);
 
     /// @brief 使用训练好的模型预测数据
     /// @param[in] xMatrix 需要预测的样本矩阵
     /// @param[out] yVector 存储预测的结果向量(列向量)
     /// @return 成功返回true, 失败返回false(模型未训练或参数错误的情况下会返回失败)
-    bool Predict(IN const LRegressionMatrix& xMatrix, OUT LRegressionMatrix& yVector) const;
+    bool Predict(IN const LRegressionMatrixView& xMatrix, OUT LRegressionMatrix& yVector) const;
+
+    /// @brief 使用稀疏样本矩阵预测数据, 参数及返回值同上
+    bool Predict(IN const LRegressionSparseMatrix& xMatrix, OUT LRegressionMatrix& yVector) const;
 
     /// @brief 计算模型得分
     /// @param[in] xMatrix 样本矩阵, 每一行代表一个样本, 每一列代表样本的一个特征
     /// @param[in] yVector (列向量) 样本输出向量, 每一行代表一个样本
     /// @return 相关指数R^2, 该值最大值为1, 该值越接近1, 表示回归的效果越好, 如果有错误则返回2.0
-    double Score(IN const LRegressionMatrix& xMatrix, IN LRegressionMatrix& yVector) const;
+    double Score(IN const LRegressionMatrixView& xMatrix, IN const LRegressionMatrixView& yVector) const;
+
+    /// @brief 使用稀疏样本矩阵计算模型得分, 参数及返回值同上
+    double Score(IN const LRegressionSparseMatrix& xMatrix, IN const LRegressionMatrixView& yVector) const;
 
 private:
     CLinearRegression* m_pLinearRegression; ///< 线性回归实现对象
@@ -99,25 +130,37 @@ public:
     /// @param[in] yVector(列向量) 样本标记向量, 每一行代表一个样本, 值只能为REGRESSION_ONE或REGRESSION_ZERO 
     /// @param[in] alpha 学习速度, 该值必须大于0.0f
     /// @return 成功返回true, 失败返回false(参数错误的情况下会返回失败)
-    bool TrainModel(IN const LRegressionMatrix& xMatrix, IN const LRegressionMatrix& yVector, IN double alpha);
+    bool TrainModel(IN const LRegressionMatrixView& xMatrix, IN const LRegressionMatrixView& yVector, IN double alpha);
+
+    /// @brief 使用稀疏样本矩阵训练模型, 参数及返回值同上
+    bool TrainModel(IN const LRegressionSparseMatrix& xMatrix, IN const LRegressionMatrixView& yVector, IN double alpha);
 
     /// @brief 使用训练好的模型预测数据
     /// @param[in] xMatrix 需要预测的样本矩阵
     /// @param[out] yVector 存储预测的结果向量(列向量), 值为REGRESSION_ONE标记的概率
     /// @return 成功返回true, 失败返回false(模型未训练或参数错误的情况下会返回失败)
-    bool Predict(IN const LRegressionMatrix& xMatrix, OUT LRegressionMatrix& yVector) const;
+    bool Predict(IN const LRegressionMatrixView& xMatrix, OUT LRegressionMatrix& yVector) const;
+
+    /// @brief 使用稀疏样本矩阵预测数据, 参数及返回值同上
+    bool Predict(IN const LRegressionSparseMatrix& xMatrix, OUT LRegressionMatrix& yVector) const;
 
     /// @brief 计算模型得分
     /// @param[in] xMatrix 样本矩阵, 每一行代表一个样本, 每一列代表样本的一个特征
     /// @param[in] yVector 样本标记向量(列向量), 每一行代表一个样本, 值只能为REGRESSION_ONE或REGRESSION_ZERO 
     /// @return 得分 值为0.0~1.0, 模型未训练或者参数有误返回-1.0
-    double Score(IN const LRegressionMatrix& xMatrix, IN const LRegressionMatrix& yVector) const;
+    double Score(IN const LRegressionMatrixView& xMatrix, IN const LRegressionMatrixView& yVector) const;
+
+    /// @brief 使用稀疏样本矩阵计算模型得分, 参数及返回值同上
+    double Score(IN const LRegressionSparseMatrix& xMatrix, IN const LRegressionMatrixView& yVector) const;
 
     /// @brief 计算似然值, 似然值为0.0~1.0之间的数, 似然值值越大模型越好
     /// @param[in] xMatrix 样本矩阵, 每一行代表一个样本, 每一列代表样本的一个特征
     /// @param[in] yVector(列向量) 样本输出向量, 每一行代表一个样本, 值只能为REGRESSION_ONE或REGRESSION_ZERO
     /// @return 成功返回似然值, 失败返回-1.0f(参数错误的情况下会返回失败)
-    double LikelihoodValue(IN const LRegressionMatrix& xMatrix, IN const LRegressionMatrix& yVector) const;
+    double LikelihoodValue(IN const LRegressionMatrixView& xMatrix, IN const LRegressionMatrixView& yVector) const;
+
+    /// @brief 使用稀疏样本矩阵计算似然值, 参数及返回值同上
+    double LikelihoodValue(IN const LRegressionSparseMatrix& xMatrix, IN const LRegressionMatrixView& yVector) const;
 
 private:
     CLogisticRegression* m_pLogisticRegression; ///< 逻辑回归实现类
@@ -146,27 +189,39 @@ public:
     /// 如果样本属于该类别则标记为REGRESSION_ONE, 不属于则标记为REGRESSION_ZERO
     /// @param[in] alpha 学习速度, 该值必须大于0.0f
     /// @return 成功返回true, 失败返回false(参数错误的情况下会返回失败)
-    bool TrainModel(IN const LRegressionMatrix& xMatrix, IN const LRegressionMatrix& yMatrix, IN double alpha);
+    bool TrainModel(IN const LRegressionMatrixView& xMatrix, IN const LRegressionMatrixView& yMatrix, IN double alpha);
+
+    /// @brief 使用稀疏样本矩阵训练模型, 参数及返回值同上
+    bool TrainModel(IN const LRegressionSparseMatrix& xMatrix, IN const LRegressionMatrixView& yMatrix, IN double alpha);
 
     /// @brief 使用训练好的模型预测数据
     /// @param[in] xMatrix 需要预测的样本矩阵
     /// @param[out] yMatrix 存储预测的结果矩阵, 每一行代表一个样本, 每一列代表在该类别下的概率
     /// @return 成功返回true, 失败返回false(参数错误的情况下会返回失败)
-    bool Predict(IN const LRegressionMatrix& xMatrix, OUT LRegressionMatrix& yMatrix) const;
+    bool Predict(IN const LRegressionMatrixView& xMatrix, OUT LRegressionMatrix& yMatrix) const;
+
+    /// @brief 使用稀疏样本矩阵预测数据, 参数及返回值同上
+    bool Predict(IN const LRegressionSparseMatrix& xMatrix, OUT LRegressionMatrix& yMatrix) const;
 
     /// @brief 计算模型得分
     /// @param[in] xMatrix 样本矩阵, 每一行代表一个样本, 每一列代表样本的一个特征
     /// @param[in] yMatrix 类标记矩阵, 每一行代表一个样本, 每一列代表样本的一个类别
     /// 如果样本属于该类别则标记为REGRESSION_ONE, 不属于则标记为REGRESSION_ZERO
     /// @return 得分 值为0.0~1.0, 模型未训练或者参数有误返回-1.0
-    double Score(IN const LRegressionMatrix& xMatrix, IN const LRegressionMatrix& yMatrix) const;
+    double Score(IN const LRegressionMatrixView& xMatrix, IN const LRegressionMatrixView& yMatrix) const;
+
+    /// @brief 使用稀疏样本矩阵计算模型得分, 参数及返回值同上
+    double Score(IN const LRegressionSparseMatrix& xMatrix, IN const LRegressionMatrixView& yMatrix) const;
 
     /// @brief 计算似然值, 似然值为0.0~1.0之间的数, 似然值值越大模型越好
     /// @param[in] xMatrix 样本矩阵, 每一行代表一个样本, 每一列代表样本的一个特征
     /// @param[in] yMatrix 类标记矩阵, 每一行代表一个样本, 每一列代表样本的一个类别
     /// 如果样本属于该类别则标记为REGRESSION_ONE, 不属于则标记为REGRESSION_ZERO
     /// @return 成功返回似然值, 失败返回-1.0f(参数错误的情况下会返回失败)
-    double LikelihoodValue(IN const LRegressionMatrix& xMatrix, IN const LRegressionMatrix& yMatrix) const;
+    double LikelihoodValue(IN const LRegressionMatrixView& xMatrix, IN const LRegressionMatrixView& yMatrix) const;
+
+    /// @brief 使用稀疏样本矩阵计算似然值, 参数及返回值同上
+    double LikelihoodValue(IN const LRegressionSparseMatrix& xMatrix, IN const LRegressionMatrixView& yMatrix) const;
 
 private:
     CSoftmaxRegression* m_pSoftmaxRegression; ///< Softmax回归实现对象
@@ -1,6 +1,9 @@
 ﻿
 #include "LReinforcementLearning.h"
 
+#include <cstdio>
+#include <cstdlib>
+
 #ifdef _DEBUG
 #define DebugPrint(format, ...) printf(format, __VA_ARGS__)
 #else
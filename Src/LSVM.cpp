@@ -1,13 +1,12 @@
 ﻿
 #include "LSVM.h"
+#include "LFixedMatrix.h"
 
 #include <cstdlib>
 #include <ctime>
 #include <cstdio>
 #include <cmath>
 
-#include <Windows.h>
-
 #ifndef LMAX
 #define LMAX(a,b)    (((a) > (b)) ? (a) : (b))
 #endif
@@ -16,16 +15,19 @@
 #define LMIN(a,b)    (((a) < (b)) ? (a) : (b))
 #endif
 
+/// @brief 核函数中分块计算使用的行向量, 存储在栈上
+typedef LFixedMatrix<float, 1, 64> LSVMKernelBlock;
+
 /// @brief SVM解结构
 struct LSVMSolution
 {
     /// @brief 构造函数
     ///  
     /// @param[in] m 样本数量
-    LSVMSolution(unsigned int m)
+    LSVMSolution(size_t m)
     {
         this->AVector.Reset(m, 1);
-        for (unsigned int i = 0; i < m; i++)
+        for (size_t i = 0; i < m; i++)
         {
             this->AVector[i][0] = 0.0f;
         }
@@ -47,13 +49,33 @@ LSVMKRBF::~LSVMKRBF()
 
 }
 
-float LSVMKRBF::Translate(IN const LSVMMatrix& vectorA, IN const LSVMMatrix& vectorB) 
+float LSVMKRBF::Translate(IN const LSVMMatrixView& vectorA, IN const LSVMMatrixView& vectorB) 
 {
-    LSVMMatrix::SUB(vectorA, vectorB, m_deltaRow);
-    LSVMMatrix::T(m_deltaRow, m_deltaRowT);
-    LSVMMatrix::MUL(m_deltaRow, m_deltaRowT, m_k);
+    // 分块计算差向量的平方和, 每块的差向量存储在栈上的固定大小行向量中, 不分配堆内存
+    const size_t n = vectorA.ColumnLen;
+    const bool contiguous = (vectorA.ColumnStride() == 1 && vectorB.ColumnStride() == 1);
+    const LSVMMatrixView::Row rowA = vectorA[0];
+    const LSVMMatrixView::Row rowB = vectorB[0];
+
+    LSVMKernelBlock delta;
+    float distance = 0.0f;
+    for (size_t start = 0; start < n; start += LSVMKernelBlock::ColumnLen)
+    {
+        const size_t len = LMIN(LSVMKernelBlock::ColumnLen, n - start);
+        if (contiguous)
+        {
+            LVectorKernel<float>::Sub(len, vectorA.Data() + start, vectorB.Data() + start, delta.Data());
+        }
+        else
+        {
+            for (size_t j = 0; j < len; j++)
+                delta[0][j] = rowA[start + j] - rowB[start + j];
+        }
+
+        distance += LVectorKernel<float>::Dot(len, delta.Data(), delta.Data());
+    }
 
-    return exp(m_k[0][0]/(-2 * m_gamma * m_gamma));
+    return exp(distance/(-2 * m_gamma * m_gamma));
 }
 
 /// @brief 原始函数(不使用核函数, 直接计算内积)
@@ -73,21 +95,20 @@ public:
     }
 
     /// @brief 转换函数
-    virtual float Translate(IN const LSVMMatrix& vectorA, IN const LSVMMatrix& vectorB)
+    virtual float Translate(IN const LSVMMatrixView& vectorA, IN const LSVMMatrixView& vectorB)
     {
-        LSVMMatrix::T(vectorB, m_bT);
-        LSVMMatrix::MUL(vectorA, m_bT, m_abT);
-        return m_abT[0][0];
-    }
+        const size_t n = vectorA.ColumnLen;
+        if (vectorA.ColumnStride() == 1 && vectorB.ColumnStride() == 1)
+            return LVectorKernel<float>::Dot(n, vectorA.Data(), vectorB.Data());
 
-private:
+        const LSVMMatrixView::Row rowA = vectorA[0];
+        const LSVMMatrixView::Row rowB = vectorB[0];
+        float sum = 0.0f;
+        for (size_t j = 0; j < n; j++)
+            sum += rowA[j] * rowB[j];
 
-    /*
-    以下变量被设为成员变量为优化程序效率目的
-    */
-    LSVMMatrix m_bT;
-    LSVMMatrix m_ab;
-    LSVMMatrix m_abT;
+        return sum;
+    }
 };
 
 /// @brief 支持向量机实现类
@@ -133,6 +154,12 @@ public:
             m_pKMatrix = 0;
         }
 
+        if (m_pProblem != 0)
+        {
+            delete m_pProblem;
+            m_pProblem = 0;
+        }
+
         if (m_pParam != 0)
         {
             delete m_pParam;
@@ -153,7 +180,15 @@ public:
         if (problem.XMatrix.RowLen != problem.YVector.RowLen)
             return false;
 
-        m_pProblem = &problem;
+        // 持有样本矩阵和标签向量的共享副本(不复制数据), 调用者的问题结构在训练后可以被释放
+        m_xMatrix = problem.XMatrix;
+        m_yVector = problem.YVector;
+        if (m_pProblem != 0)
+        {
+            delete m_pProblem;
+            m_pProblem = 0;
+        }
+        m_pProblem = new LSVMProblem(m_xMatrix, m_yVector);
 
         // 初始化解结构
         if (m_pSolution != 0)
@@ -170,14 +205,12 @@ public:
             m_pKMatrix = 0;
         }
         m_pKMatrix = new LSVMMatrix(problem.XMatrix.RowLen, problem.XMatrix.RowLen);
-        LSVMMatrix sampleA;
-        LSVMMatrix sampleB;
-        for (unsigned int i = 0; i < problem.XMatrix.RowLen; i++)
+        for (size_t i = 0; i < problem.XMatrix.RowLen; i++)
         {
-            problem.XMatrix.GetRow(i, sampleA);
-            for (unsigned int j = 0; j < problem.XMatrix.RowLen; j++)
+            const LSVMMatrixView sampleA = problem.XMatrix.GetRow(i);
+            for (size_t j = 0; j < problem.XMatrix.RowLen; j++)
             {
-                problem.XMatrix.GetRow(j, sampleB);
+                const LSVMMatrixView sampleB = problem.XMatrix.GetRow(j);
                 (*m_pKMatrix)[i][j] = m_pKernelFunc->Translate(sampleA, sampleB);
             }
         }
@@ -186,15 +219,15 @@ public:
         result.IterCount = this->SMOTrainModel(*m_pProblem, *m_pSolution);
 
         // 获取支持向量的索引
-        unsigned int supportVectorNum = 0;
-        for (unsigned int i = 0; i < m_pSolution->AVector.RowLen; i++)
+        size_t supportVectorNum = 0;
+        for (size_t i = 0; i < m_pSolution->AVector.RowLen; i++)
         {
             if (m_pSolution->AVector[i][0] != 0.0f)
                 supportVectorNum++;
         }
         m_supportVectorIndex.Reset(supportVectorNum, 1);
-        unsigned int j = 0;
-        for (unsigned int i = 0; i < m_pSolution->AVector.RowLen; i++)
+        size_t j = 0;
+        for (size_t i = 0; i < m_pSolution->AVector.RowLen; i++)
         {
             if (m_pSolution->AVector[i][0] != 0.0f)
             {
@@ -210,7 +243,7 @@ public:
     }
 
     /// @brief 使用训练好的模型进行预测
-    bool Predict(IN const LSVMMatrix& sampleSet, OUT LSVMMatrix& yVector)
+    bool Predict(IN const LSVMMatrixView& sampleSet, OUT LSVMMatrix& yVector)
     {
         // 检查参数
         if (this->m_pProblem == 0)
@@ -227,24 +260,21 @@ public:
         LSVMMatrix::DOTMUL(this->m_pSolution->AVector, this->m_pProblem->YVector, AY); // 列向量
         LSVMMatrix AYT = AY.T(); // 行向量
 
-        LSVMMatrix sampleA;
-        LSVMMatrix sampleB;
         LSVMMatrix KColumn(this->m_pProblem->XMatrix.RowLen, 1); // 列向量
 
-        for (unsigned int row = 0; row < sampleSet.RowLen; row++)
+        for (size_t row = 0; row < sampleSet.RowLen; row++)
         {
-            sampleSet.GetRow(row, sampleB);
+            const LSVMMatrixView sampleB = sampleSet.GetRow(row);
 
             // 只对支持向量做内积, 节省时间
-            for (unsigned int i = 0; i < KColumn.RowLen; i++)
+            for (size_t i = 0; i < KColumn.RowLen; i++)
             {
                 KColumn[i][0] = 0.0f;
             }
-            for (unsigned int i = 0; i < m_supportVectorIndex.RowLen; i++)
+            for (size_t i = 0; i < m_supportVectorIndex.RowLen; i++)
             {
-                unsigned int j = m_supportVectorIndex[i][0];
-                sampleA = this->m_pProblem->XMatrix.GetRow(j);
-                KColumn[j][0] = m_pKernelFunc->Translate(sampleA, sampleB);
+                size_t j = m_supportVectorIndex[i][0];
+                KColumn[j][0] = m_pKernelFunc->Translate(this->m_pProblem->XMatrix.GetRow(j), sampleB);
             }
             LSVMMatrix AYTK = AYT * KColumn;
             if (AYTK[0][0] + this->m_pSolution->B >= 0.0f)
@@ -262,9 +292,9 @@ private:
     /// @param[in] i 随机数中被过滤的值
     /// @param[in] max 随机数中的最大值, 要求大于0
     /// @return 随机数
-    int SelectRand(IN unsigned int i, IN unsigned int max)
+    size_t SelectRand(IN size_t i, IN size_t max)
     {
-        int j = i; 
+        size_t j = i; 
         while (j == i)
         {
             j = rand()%(max + 1);
@@ -276,12 +306,12 @@ private:
     /// @param[in] i 第一个alpha索引
     /// @param[in] E 所有样本误差向量
     /// @return 第二个alpha索引
-    unsigned int SelectSecondAlpha(IN unsigned int i, IN const LSVMMatrix& E)
+    size_t SelectSecondAlpha(IN size_t i, IN const LSVMMatrix& E)
     {
-        unsigned int j = 0;
+        size_t j = 0;
         float maxDeltaE = 0.0f;
 
-        for (unsigned int k = 0; k < E.RowLen; k++)
+        for (size_t k = 0; k < E.RowLen; k++)
         {
 
             float deltaE = abs(E[i][0] - E[k][0]);
@@ -323,13 +353,16 @@ private:
     /// @return 误差值
     void CalculateError(IN const LSVMSolution& solution, OUT LSVMMatrix& errorVector)
     {
+        // 临时矩阵从内存池中分配, 函数返回时重置内存池
+        LMatrixArenaScope arenaScope(m_arena);
+
         LSVMMatrix AY;
         LSVMMatrix::DOTMUL(solution.AVector, m_pProblem->YVector, AY); // 列向量
         LSVMMatrix AYT = AY.T(); // 行向量
 
         LSVMMatrix KColumn;
         LSVMMatrix AYTK;
-        for (unsigned int i = 0; i < m_pProblem->XMatrix.RowLen; i++)
+        for (size_t i = 0; i < m_pProblem->XMatrix.RowLen; i++)
         {
             m_pKMatrix->GetColumn(i, KColumn); // 列向量
             LSVMMatrix::MUL(AYT, KColumn, AYTK);
@@ -344,10 +377,10 @@ private:
     /// @return 遍历次数
     unsigned int SMOTrainModel(IN const LSVMProblem& problem, OUT LSVMSolution& solution)
     {
-        const unsigned int M = problem.XMatrix.RowLen; // 样本数量
+        const size_t M = problem.XMatrix.RowLen; // 样本数量
 
         LSVMMatrix E(M, 1); ///< 误差缓存向量(列向量)
-        for (unsigned int i = 0; i < M; i++)
+        for (size_t i = 0; i < M; i++)
         {
             E[i][0] = 0.0f;
         }
@@ -365,7 +398,7 @@ private:
             // 遍历整个alpha集合
             if (entireSet)
             {
-                for (unsigned int i = 0; i < M; i++)
+                for (size_t i = 0; i < M; i++)
                 {
                     if (!this->SMOOptimizeAlpha(i, E, solution))
                         continue;
@@ -379,7 +412,7 @@ private:
             // 遍历不在边界上的alpha
             if (!entireSet)
             {
-                for (unsigned int i = 0; i < M; i++)
+                for (size_t i = 0; i < M; i++)
                 {
                     if (solution.AVector[i][0] == 0 || solution.AVector[i][0] == m_pParam->C)
                         continue;
@@ -421,14 +454,14 @@ private:
     /// @param[out] solution 问题的解
     /// @return 成功优化返回true, 优化失败返回false
     bool SMOOptimizeAlpha(
-        IN unsigned int fristAlpha,   
+        IN size_t fristAlpha,   
         IN const LSVMMatrix& error, 
         OUT LSVMSolution& solution)
     {
-        const unsigned int i = fristAlpha;
+        const size_t i = fristAlpha;
         const LSVMMatrix& X = m_pProblem->XMatrix; // 样本矩阵
         const LSVMMatrix& Y = m_pProblem->YVector; // 标签向量(列向量)
-        const unsigned int M = X.RowLen; // 样本数量
+        const size_t M = X.RowLen; // 样本数量
         const LSVMMatrix& K = *m_pKMatrix; // K矩阵
 
         const float C = m_pParam->C; // 常数C
@@ -446,7 +479,7 @@ private:
         if (((A[i][0] < C) && (marginXi < 1)) ||
             ((A[i][0] > 0) && (marginXi > 1)))
         {
-            unsigned int j = this->SelectSecondAlpha(i, E);
+            size_t j = this->SelectSecondAlpha(i, E);
 
             float LAj = 0.0f; // alpha j 的下届
             float HAj = 0.0f; // alpha j 的上届
@@ -517,13 +550,16 @@ private:
     }
 
 private:
-    const LSVMProblem* m_pProblem; ///< 原始问题
+    LSVMMatrix m_xMatrix; ///< 样本矩阵(与调用者共享数据)
+    LSVMMatrix m_yVector; ///< 标签向量(与调用者共享数据)
+    const LSVMProblem* m_pProblem; ///< 原始问题, 引用m_xMatrix和m_yVector
     LSVMParam* m_pParam; ///< 参数
     LSVMSolution* m_pSolution; ///< SVM的解
     LSVMMatrix* m_pKMatrix; ///< K矩阵
     ISVMKernelFunc* m_pKernelFunc; ///< 核函数接口
     LSVMKOriginal m_kOriginal; ///< 原始核函数
-    LMatrix<unsigned int> m_supportVectorIndex; ///< 记录支持向量的样本的索引(列向量)
+    LMatrix<size_t> m_supportVectorIndex; ///< 记录支持向量的样本的索引(列向量)
+    LMatrixArena m_arena; ///< 计算误差时临时矩阵的内存池
 };
 
 LSVM::LSVM(IN const LSVMParam& param)
@@ -544,7 +580,7 @@ bool LSVM::TrainModel(IN const LSVMProblem& problem, OUT LSVMResult& result)
     return m_pSVM->TrainModel(problem, result);
 }
 
-bool LSVM::Predict(IN const LSVMMatrix& sampleSet, OUT LSVMMatrix& yVector)
+bool LSVM::Predict(IN const LSVMMatrixView& sampleSet, OUT LSVMMatrix& yVector)
 {
     return m_pSVM->Predict(sampleSet, yVector);
 }
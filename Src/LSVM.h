@@ -10,7 +10,7 @@
 #ifndef _LSVM_H_
 #define _LSVM_H_
 
-#include "LDataStruct/LMatrix.h"
+#include "LMatrix.h"
 
 #ifndef IN
 #define IN
@@ -25,6 +25,7 @@
 #endif
 
 typedef LMatrix<float> LSVMMatrix;
+typedef LMatrixView<float> LSVMMatrixView;
 
 
 /// @brief 核函数接口
@@ -32,14 +33,14 @@ class ISVMKernelFunc
 {
 public:
     /// @brief 析构函数
-    virtual ~ISVMKernelFunc() = 0 {}
+    virtual ~ISVMKernelFunc() {}
 
     /// @brief 转换
     /// 要求向量A和B的长度相同, 并且都是行向量
     /// @param[in] vectorA 向量A(行向量)
     /// @param[in] vectorB 向量B(行向量)
     /// @return 返回向量A, B映射在高纬空间上的向量的内积
-    virtual float Translate(IN const LSVMMatrix& vectorA, IN const LSVMMatrix& vectorB) = 0;
+    virtual float Translate(IN const LSVMMatrixView& vectorA, IN const LSVMMatrixView& vectorB) = 0;
 };
 
 /// @brief 径向基核函数
@@ -61,17 +62,10 @@ public:
     /// @param[in] vectorA 向量A(行向量)
     /// @param[in] vectorB 向量B(行向量)
     /// @return 返回向量A, B映射在高纬空间上的向量内积
-    virtual float Translate(IN const LSVMMatrix& vectorA, IN const LSVMMatrix& vectorB);
+    virtual float Translate(IN const LSVMMatrixView& vectorA, IN const LSVMMatrixView& vectorB);
 
 private:
     float m_gamma; ///< gamma参数
-
-    /*
-    以下变量被设为成员变量为优化程序效率目的
-    */
-    LSVMMatrix m_deltaRow;
-    LSVMMatrix m_deltaRowT;
-    LSVMMatrix m_k;
 };
 
 /// @brief SVM参数结构
@@ -101,7 +95,7 @@ struct LSVMProblem
 struct LSVMResult
 {
     unsigned int IterCount; ///< 遍历次数
-    unsigned int SupportVectorNum; ///< 支持向量数
+    size_t SupportVectorNum; ///< 支持向量数
 };
 
 
@@ -130,7 +124,7 @@ public:
     /// @param[in] sampleSet 需要预测的样本集
     /// @param[out] yVector 存储预测的结果向量(列向量), 值为-1.0 or 1.0
     /// @return 成功返回true, 失败返回false(模型未训练或参数错误的情况下会返回失败)
-    bool Predict(IN const LSVMMatrix& sampleSet, OUT LSVMMatrix& yVector);
+    bool Predict(IN const LSVMMatrixView& sampleSet, OUT LSVMMatrix& yVector);
 
 private:
     CSVM* m_pSVM; ///< SVM实现对象
@@ -0,0 +1,628 @@
+﻿/// @file LSparseMatrix.h
+/// @brief 稀疏矩阵模板头文件
+///
+/// Detail: 稀疏矩阵使用CSR(Compressed Sparse Row)格式存储, 只存储非零元素
+/// 每一行的非零元素按列索引递增顺序连续存储, 行偏移表记录每一行第一个非零元素的位置
+/// CSC格式即为转置矩阵的CSR格式, 可通过T()得到
+/// 稀疏矩阵与稠密矩阵(LMatrix)的乘法运算结果为稠密矩阵
+/// @author Jie Liu Email:coderjie@outlook.com
+/// @version
+/// @date 2026/10/17
+
+/*  使用稀疏矩阵的示例代码如下
+
+// 从稠密矩阵构造稀疏矩阵, 零元素不被存储
+LMatrix<double> denseMatrix(3, 4, 0.0);
+denseMatrix[0][1] = 1.0;
+denseMatrix[2][3] = 2.0;
+LSparseMatrix<double> sparseMatrix(denseMatrix);
+
+// 稀疏矩阵乘以稠密矩阵(列向量)
+LMatrix<double> x(4, 1, 1.0);
+LMatrix<double> y;
+LSparseMatrix<double>::MUL(sparseMatrix, x, y);
+*/
+
+#ifndef _LSPARSEMATRIX_H_
+#define _LSPARSEMATRIX_H_
+
+#include <utility>
+#include <vector>
+
+#include "LMatrix.h"
+
+/// @brief 稀疏矩阵(CSR格式)
+LTEMPLATE
+class LSparseMatrix
+{
+public:
+    /// @brief 稀疏矩阵乘以稠密矩阵, C = A * B
+    /// 要求矩阵A的列数等于矩阵B的行数, B为列向量时即为SpMV
+    /// @param[in] A 被乘数(稀疏矩阵)
+    /// @param[in] B 乘数
+    /// @param[out] C 结果矩阵
+    /// @return 参数错误返回false
+    static bool MUL(IN const LSparseMatrix<Type>& A, IN const LMatrixView<Type>& B, OUT LMatrix<Type>& C);
+
+    /// @brief 稠密矩阵乘以稀疏矩阵, C = A * B
+    /// 要求矩阵A的列数等于矩阵B的行数
+    /// @param[in] A 被乘数
+    /// @param[in] B 乘数(稀疏矩阵)
+    /// @param[out] C 结果矩阵
+    /// @return 参数错误返回false
+    static bool MUL(IN const LMatrixView<Type>& A, IN const LSparseMatrix<Type>& B, OUT LMatrix<Type>& C);
+
+    /// @brief 稀疏矩阵转置乘以稠密矩阵, C = A.T() * B
+    /// 要求矩阵A的行数等于矩阵B的行数, 不生成A的转置矩阵
+    /// @param[in] A 被乘数(稀疏矩阵, 转置前)
+    /// @param[in] B 乘数
+    /// @param[out] C 结果矩阵
+    /// @return 参数错误返回false
+    static bool MUL_AT_B(IN const LSparseMatrix<Type>& A, IN const LMatrixView<Type>& B, OUT LMatrix<Type>& C);
+
+    /// @brief 稀疏矩阵转置
+    /// 转置矩阵的CSR格式即为原矩阵的CSC格式
+    /// 注意: B不能和A是相同矩阵的引用
+    /// @param[in] A 需要转置的矩阵
+    /// @param[out] B 转置后的结果矩阵
+    /// @return 返回true
+    static bool T(IN const LSparseMatrix<Type>& A, OUT LSparseMatrix<Type>& B);
+
+public:
+    /// @brief 默认构造函数
+    /// 默认矩阵长度为0
+    LSparseMatrix();
+
+    /// @brief 构造函数, 构造全零矩阵
+    /// 如果row或col中任一项为0, 则矩阵行数和列数都为0
+    /// @param[in] row 矩阵行大小
+    /// @param[in] col 矩阵列大小
+    LSparseMatrix(IN size_t row, IN size_t col);
+
+    /// @brief 构造函数, 从稠密矩阵构造, 零元素不被存储
+    /// @param[in] dense 稠密矩阵
+    explicit LSparseMatrix(IN const LMatrixView<Type>& dense);
+
+    /// @brief 拷贝构造函数
+    LSparseMatrix(IN const LSparseMatrix<Type>& rhs);
+
+    /// @brief 赋值操作符
+    LSparseMatrix<Type>& operator = (IN const LSparseMatrix<Type>& rhs);
+
+    /// @brief 判断矩阵是否为空
+    /// 行数或列数为0的矩阵为空
+    /// @return true, false
+    bool Empty() const;
+
+    /// @brief 获取非零元素个数
+    /// @return 非零元素个数
+    size_t NonZeroNum() const;
+
+    /// @brief 获取指定位置的元素值
+    /// 在行内二分查找, 不存在的元素为0
+    /// @param[in] row 行索引
+    /// @param[in] col 列索引
+    /// @return 元素值
+    Type At(IN size_t row, IN size_t col) const;
+
+    /// @brief 获取一行中非零元素的个数
+    /// @param[in] row 行索引
+    /// @return 非零元素个数
+    size_t RowNonZeroNum(IN size_t row) const;
+
+    /// @brief 获取一行中非零元素的列索引列表
+    /// @param[in] row 行索引
+    /// @return 列索引列表, 长度为RowNonZeroNum(row), 列索引递增
+    const size_t* RowColumnIndex(IN size_t row) const;
+
+    /// @brief 获取一行中非零元素的值列表
+    /// @param[in] row 行索引
+    /// @return 值列表, 长度为RowNonZeroNum(row)
+    const Type* RowValue(IN size_t row) const;
+
+    /// @brief 矩阵转置
+    /// @return 转置后的结果矩阵
+    LSparseMatrix<Type> T() const;
+
+    /// @brief 获取连续的若干行
+    /// @param[in] rowStart 开始行
+    /// @param[in] rowLen 行数
+    /// @param[out] D 存储结果矩阵
+    /// @return 参数错误返回false
+    bool GetRows(IN size_t rowStart, IN size_t rowLen, OUT LSparseMatrix<Type>& D) const;
+
+    /// @brief 转换为稠密矩阵
+    /// @param[out] D 存储稠密矩阵
+    void ToDense(OUT LMatrix<Type>& D) const;
+
+    /// @brief 重置为全零矩阵
+    /// 如果row或col中任一项为0, 则矩阵行数和列数都为0
+    /// @param[in] row 矩阵行大小
+    /// @param[in] col 矩阵列大小
+    void Reset(IN size_t row, IN size_t col);
+
+    /// @brief 使用CSR数据重置矩阵
+    /// 数据不合法时矩阵不变
+    /// @param[in] row 矩阵行大小
+    /// @param[in] col 矩阵列大小
+    /// @param[in] rowOffsetList 行偏移表, 长度为row + 1, 第一个值为0, 最后一个值为非零元素个数, 非递减
+    /// @param[in] columnIndexList 非零元素的列索引列表, 每一行内严格递增
+    /// @param[in] valueList 非零元素的值列表, 长度等于列索引列表的长度
+    /// @return 数据不合法返回false
+    bool Reset(
+        IN size_t row,
+        IN size_t col,
+        IN const std::vector<size_t>& rowOffsetList,
+        IN const std::vector<size_t>& columnIndexList,
+        IN const std::vector<Type>& valueList);
+
+    /// @brief 使用CSR数据重置矩阵, 数据被移动到矩阵中, 不复制
+    /// 数据合法时参数中的列表被移走, 不合法时矩阵和参数都不变
+    /// @param[in] row 矩阵行大小
+    /// @param[in] col 矩阵列大小
+    /// @param[inout] rowOffsetList 行偏移表, 要求同上
+    /// @param[inout] columnIndexList 非零元素的列索引列表, 要求同上
+    /// @param[inout] valueList 非零元素的值列表, 要求同上
+    /// @return 数据不合法返回false
+    bool Reset(
+        IN size_t row,
+        IN size_t col,
+        INOUT std::vector<size_t>&& rowOffsetList,
+        INOUT std::vector<size_t>&& columnIndexList,
+        INOUT std::vector<Type>&& valueList);
+
+public:
+    const size_t& RowLen;           ///< 行长度属性
+    const size_t& ColumnLen;        ///< 列长度属性
+
+private:
+    /// @brief 检查CSR数据是否合法
+    static bool ValidCSR(
+        IN size_t row,
+        IN size_t col,
+        IN const std::vector<size_t>& rowOffsetList,
+        IN const std::vector<size_t>& columnIndexList,
+        IN const std::vector<Type>& valueList);
+
+private:
+    size_t m_rowLen;                            ///< 矩阵行长度
+    size_t m_columnLen;                         ///< 矩阵列长度
+    std::vector<size_t> m_rowOffsetList;        ///< 行偏移表, 长度为行长度 + 1
+    std::vector<size_t> m_columnIndexList;///< 非零元素的列索引列表
+    std::vector<Type> m_valueList;              ///< 非零元素的值列表
+};
+
+LTEMPLATE
+LSparseMatrix<Type>::LSparseMatrix()
+: m_rowLen(0), m_columnLen(0), RowLen(m_rowLen), ColumnLen(m_columnLen)
+{
+    m_rowOffsetList.push_back(0);
+}
+
+LTEMPLATE
+LSparseMatrix<Type>::LSparseMatrix(IN size_t row, IN size_t col)
+: m_rowLen(0), m_columnLen(0), RowLen(m_rowLen), ColumnLen(m_columnLen)
+{
+    this->Reset(row, col);
+}
+
+LTEMPLATE
+LSparseMatrix<Type>::LSparseMatrix(IN const LMatrixView<Type>& dense)
+: m_rowLen(0), m_columnLen(0), RowLen(m_rowLen), ColumnLen(m_columnLen)
+{
+    this->Reset(dense.RowLen, dense.ColumnLen);
+
+    for (size_t row = 0; row < m_rowLen; row++)
+    {
+        for (size_t col = 0; col < m_columnLen; col++)
+        {
+            const Type& value = dense[row][col];
+            if (value != Type(0))
+            {
+                m_columnIndexList.push_back(col);
+                m_valueList.push_back(value);
+            }
+        }
+        m_rowOffsetList[row + 1] = m_valueList.size();
+    }
+}
+
+LTEMPLATE
+LSparseMatrix<Type>::LSparseMatrix(IN const LSparseMatrix<Type>& rhs)
+: m_rowLen(rhs.m_rowLen),
+m_columnLen(rhs.m_columnLen),
+RowLen(m_rowLen),
+ColumnLen(m_columnLen),
+m_rowOffsetList(rhs.m_rowOffsetList),
+m_columnIndexList(rhs.m_columnIndexList),
+m_valueList(rhs.m_valueList)
+{
+
+}
+
+LTEMPLATE
+LSparseMatrix<Type>& LSparseMatrix<Type>::operator = (IN const LSparseMatrix<Type>& rhs)
+{
+    m_rowLen = rhs.m_rowLen;
+    m_columnLen = rhs.m_columnLen;
+    m_rowOffsetList = rhs.m_rowOffsetList;
+    m_columnIndexList = rhs.m_columnIndexList;
+    m_valueList = rhs.m_valueList;
+
+    return *this;
+}
+
+LTEMPLATE
+bool LSparseMatrix<Type>::Empty() const
+{
+    if (m_columnLen == 0 || m_rowLen == 0)
+        return true;
+
+    return false;
+}
+
+LTEMPLATE
+size_t LSparseMatrix<Type>::NonZeroNum() const
+{
+    return m_valueList.size();
+}
+
+LTEMPLATE
+Type LSparseMatrix<Type>::At(IN size_t row, IN size_t col) const
+{
+    size_t low = m_rowOffsetList[row];
+    size_t high = m_rowOffsetList[row + 1];
+    while (low < high)
+    {
+        size_t mid = low + (high - low) / 2;
+        if (m_columnIndexList[mid] == col)
+            return m_valueList[mid];
+
+        if (m_columnIndexList[mid] < col)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    return Type(0);
+}
+
+LTEMPLATE
+size_t LSparseMatrix<Type>::RowNonZeroNum(IN size_t row) const
+{
+    return m_rowOffsetList[row + 1] - m_rowOffsetList[row];
+}
+
+LTEMPLATE
+const size_t* LSparseMatrix<Type>::RowColumnIndex(IN size_t row) const
+{
+    if (m_columnIndexList.empty())
+        return 0;
+
+    return &m_columnIndexList[0] + m_rowOffsetList[row];
+}
+
+LTEMPLATE
+const Type* LSparseMatrix<Type>::RowValue(IN size_t row) const
+{
+    if (m_valueList.empty())
+        return 0;
+
+    return &m_valueList[0] + m_rowOffsetList[row];
+}
+
+LTEMPLATE
+LSparseMatrix<Type> LSparseMatrix<Type>::T() const
+{
+    LSparseMatrix<Type> B;
+    T(*this, B);
+    return B;
+}
+
+LTEMPLATE
+bool LSparseMatrix<Type>::GetRows(IN size_t rowStart, IN size_t rowLen, OUT LSparseMatrix<Type>& D) const
+{
+    if ((rowStart + rowLen) > m_rowLen)
+        return false;
+
+    if (rowLen < 1)
+        return false;
+
+    size_t begin = m_rowOffsetList[rowStart];
+    size_t end = m_rowOffsetList[rowStart + rowLen];
+
+    D.Reset(rowLen, m_columnLen);
+    for (size_t row = 0; row <= rowLen; row++)
+    {
+        D.m_rowOffsetList[row] = m_rowOffsetList[rowStart + row] - begin;
+    }
+    D.m_columnIndexList.assign(m_columnIndexList.begin() + begin, m_columnIndexList.begin() + end);
+    D.m_valueList.assign(m_valueList.begin() + begin, m_valueList.begin() + end);
+
+    return true;
+}
+
+LTEMPLATE
+void LSparseMatrix<Type>::ToDense(OUT LMatrix<Type>& D) const
+{
+    D.Reset(m_rowLen, m_columnLen, Type(0));
+    for (size_t row = 0; row < m_rowLen; row++)
+    {
+        Type* pRow = D[row];
+        for (size_t i = m_rowOffsetList[row]; i < m_rowOffsetList[row + 1]; i++)
+        {
+            pRow[m_columnIndexList[i]] = m_valueList[i];
+        }
+    }
+}
+
+LTEMPLATE
+void LSparseMatrix<Type>::Reset(IN size_t row, IN size_t col)
+{
+    if (row == 0 || col == 0)
+    {
+        row = 0;
+        col = 0;
+    }
+
+    m_rowLen = row;
+    m_columnLen = col;
+    m_rowOffsetList.assign(row + 1, 0);
+    m_columnIndexList.clear();
+    m_valueList.clear();
+}
+
+LTEMPLATE
+bool LSparseMatrix<Type>::Reset(
+    IN size_t row,
+    IN size_t col,
+    IN const std::vector<size_t>& rowOffsetList,
+    IN const std::vector<size_t>& columnIndexList,
+    IN const std::vector<Type>& valueList)
+{
+    if (!ValidCSR(row, col, rowOffsetList, columnIndexList, valueList))
+        return false;
+
+    m_rowLen = row;
+    m_columnLen = col;
+    m_rowOffsetList = rowOffsetList;
+    m_columnIndexList = columnIndexList;
+    m_valueList = valueList;
+
+    return true;
+}
+
+LTEMPLATE
+bool LSparseMatrix<Type>::Reset(
+    IN size_t row,
+    IN size_t col,
+    INOUT std::vector<size_t>&& rowOffsetList,
+    INOUT std::vector<size_t>&& columnIndexList,
+    INOUT std::vector<Type>&& valueList)
+{
+    if (!ValidCSR(row, col, rowOffsetList, columnIndexList, valueList))
+        return false;
+
+    m_rowLen = row;
+    m_columnLen = col;
+    m_rowOffsetList = std::move(rowOffsetList);
+    m_columnIndexList = std::move(columnIndexList);
+    m_valueList = std::move(valueList);
+
+    return true;
+}
+
+LTEMPLATE
+bool LSparseMatrix<Type>::ValidCSR(
+    IN size_t row,
+    IN size_t col,
+    IN const std::vector<size_t>& rowOffsetList,
+    IN const std::vector<size_t>& columnIndexList,
+    IN const std::vector<Type>& valueList)
+{
+    if (row == 0 || col == 0)
+        return false;
+    if (rowOffsetList.size() != row + 1)
+        return false;
+    if (columnIndexList.size() != valueList.size())
+        return false;
+    if (rowOffsetList[0] != 0 || rowOffsetList[row] != valueList.size())
+        return false;
+
+    for (size_t i = 0; i < row; i++)
+    {
+        if (rowOffsetList[i] > rowOffsetList[i + 1])
+            return false;
+
+        for (size_t j = rowOffsetList[i]; j < rowOffsetList[i + 1]; j++)
+        {
+            if (columnIndexList[j] >= col)
+                return false;
+            if (j > rowOffsetList[i] && columnIndexList[j] <= columnIndexList[j - 1])
+                return false;
+        }
+    }
+
+    return true;
+}
+
+LTEMPLATE
+bool LSparseMatrix<Type>::MUL(IN const LSparseMatrix<Type>& A, IN const LMatrixView<Type>& B, OUT LMatrix<Type>& C)
+{
+    if (A.ColumnLen != B.RowLen)
+        return false;
+
+    // 稠密操作数与C重叠时, 先计算到临时矩阵中
+    if (B.Overlap(C))
+    {
+        LMatrix<Type> temp;
+        MUL(A, B, temp);
+        C = std::move(temp);
+        return true;
+    }
+
+    C.Reset(A.RowLen, B.ColumnLen);
+    if (C.Empty())
+        return true;
+
+    const size_t n = B.ColumnLen;
+    LMatrixParallelFor(A.RowLen, (unsigned long long)A.NonZeroNum() * n, LMATRIX_PARALLEL_SIZE,
+        [&A, &B, &C, n](size_t rowBegin, size_t rowEnd)
+    {
+        for (size_t i = rowBegin; i < rowEnd; i++)
+        {
+            Type* pCRow = C[i];
+            const size_t* pIndex = A.RowColumnIndex(i);
+            const Type* pValue = A.RowValue(i);
+            const size_t nonZeroNum = A.RowNonZeroNum(i);
+
+            // SpMV, 每行为一个稀疏向量与稠密向量的内积
+            if (n == 1)
+            {
+                Type sum = Type(0);
+                for (size_t p = 0; p < nonZeroNum; p++)
+                    sum += pValue[p] * B[pIndex[p]][0];
+                pCRow[0] = sum;
+                continue;
+            }
+
+            for (size_t j = 0; j < n; j++)
+                pCRow[j] = Type(0);
+
+            for (size_t p = 0; p < nonZeroNum; p++)
+            {
+                const Type a = pValue[p];
+                const LMatrixView<Type> bRow = B.GetRow(pIndex[p]);
+                for (size_t j = 0; j < n; j++)
+                    pCRow[j] += a * bRow[0][j];
+            }
+        }
+    });
+
+    return true;
+}
+
+LTEMPLATE
+bool LSparseMatrix<Type>::MUL(IN const LMatrixView<Type>& A, IN const LSparseMatrix<Type>& B, OUT LMatrix<Type>& C)
+{
+    if (A.ColumnLen != B.RowLen)
+        return false;
+
+    // 稠密操作数与C重叠时, 先计算到临时矩阵中
+    if (A.Overlap(C))
+    {
+        LMatrix<Type> temp;
+        MUL(A, B, temp);
+        C = std::move(temp);
+        return true;
+    }
+
+    C.Reset(A.RowLen, B.ColumnLen);
+    if (C.Empty())
+        return true;
+
+    LMatrixParallelFor(A.RowLen, (unsigned long long)A.RowLen * B.NonZeroNum(), LMATRIX_PARALLEL_SIZE,
+        [&A, &B, &C](size_t rowBegin, size_t rowEnd)
+    {
+        for (size_t i = rowBegin; i < rowEnd; i++)
+        {
+            Type* pCRow = C[i];
+            for (size_t j = 0; j < C.ColumnLen; j++)
+                pCRow[j] = Type(0);
+
+            // C的第i行为B的各行以A[i][p]为系数的线性组合
+            for (size_t p = 0; p < A.ColumnLen; p++)
+            {
+                const Type a = A[i][p];
+                if (a == Type(0))
+                    continue;
+
+                const size_t* pIndex = B.RowColumnIndex(p);
+                const Type* pValue = B.RowValue(p);
+                const size_t nonZeroNum = B.RowNonZeroNum(p);
+                for (size_t q = 0; q < nonZeroNum; q++)
+                    pCRow[pIndex[q]] += a * pValue[q];
+            }
+        }
+    });
+
+    return true;
+}
+
+LTEMPLATE
+bool LSparseMatrix<Type>::MUL_AT_B(IN const LSparseMatrix<Type>& A, IN const LMatrixView<Type>& B, OUT LMatrix<Type>& C)
+{
+    if (A.RowLen != B.RowLen)
+        return false;
+
+    // 稠密操作数与C重叠时, 先计算到临时矩阵中
+    if (B.Overlap(C))
+    {
+        LMatrix<Type> temp;
+        MUL_AT_B(A, B, temp);
+        C = std::move(temp);
+        return true;
+    }
+
+    C.Reset(A.ColumnLen, B.ColumnLen, Type(0));
+    if (C.Empty())
+        return true;
+
+    // A的第i行的每个非零元素A[i][c]将B的第i行累加到C的第c行, 并行时按C的列划分, 避免写冲突
+    LMatrixParallelFor(B.ColumnLen, (unsigned long long)A.NonZeroNum() * B.ColumnLen, LMATRIX_PARALLEL_SIZE,
+        [&A, &B, &C](size_t colBegin, size_t colEnd)
+    {
+        for (size_t i = 0; i < A.RowLen; i++)
+        {
+            const size_t* pIndex = A.RowColumnIndex(i);
+            const Type* pValue = A.RowValue(i);
+            const size_t nonZeroNum = A.RowNonZeroNum(i);
+            const LMatrixView<Type> bRow = B.GetRow(i);
+            for (size_t p = 0; p < nonZeroNum; p++)
+            {
+                const Type a = pValue[p];
+                Type* pCRow = C[pIndex[p]];
+                for (size_t j = colBegin; j < colEnd; j++)
+                    pCRow[j] += a * bRow[0][j];
+            }
+        }
+    });
+
+    return true;
+}
+
+LTEMPLATE
+bool LSparseMatrix<Type>::T(IN const LSparseMatrix<Type>& A, OUT LSparseMatrix<Type>& B)
+{
+    B.Reset(A.ColumnLen, A.RowLen);
+    if (B.Empty())
+        return true;
+
+    // 统计每列的非零元素个数, 得到转置矩阵的行偏移表
+    for (size_t i = 0; i < A.m_columnIndexList.size(); i++)
+    {
+        B.m_rowOffsetList[A.m_columnIndexList[i] + 1]++;
+    }
+    for (size_t row = 0; row < B.m_rowLen; row++)
+    {
+        B.m_rowOffsetList[row + 1] += B.m_rowOffsetList[row];
+    }
+
+    // 按A的行顺序填充, 转置矩阵每行内的列索引自然递增
+    B.m_columnIndexList.resize(A.m_columnIndexList.size());
+    B.m_valueList.resize(A.m_valueList.size());
+    std::vector<size_t> nextList(B.m_rowOffsetList.begin(), B.m_rowOffsetList.end() - 1);
+    for (size_t row = 0; row < A.m_rowLen; row++)
+    {
+        for (size_t i = A.m_rowOffsetList[row]; i < A.m_rowOffsetList[row + 1]; i++)
+        {
+            size_t pos = nextList[A.m_columnIndexList[i]]++;
+            B.m_columnIndexList[pos] = row;
+            B.m_valueList[pos] = A.m_valueList[i];
+        }
+    }
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,292 @@
+﻿/// @file LThreadPool.h
+/// @brief 线程池头文件
+///
+/// Detail: 全库共享的线程池, 矩阵运算等计算密集的内核使用该线程池并行执行
+/// 调用线程也参与计算, 所以线程池中的工作线程数为线程数减1
+/// 在并行任务中再次调用ParallelFor时(嵌套并行)直接在当前线程中串行执行
+/// 循环体抛出的异常(如std::bad_alloc)在所有线程都离开该任务后, 在调用线程中重新抛出
+/// @author Jie Liu Email:coderjie@outlook.com
+/// @version
+/// @date 2026/10/17
+
+/*  使用线程池的示例代码如下
+
+// 设置全局线程池的线程数(默认为CPU的逻辑核心数)
+LThreadPool::Global().SetThreadNum(8);
+
+// 将[0, 1000)划分为若干段并行执行
+LThreadPool::Global().ParallelFor(1000, [&](size_t begin, size_t end)
+{
+    for (size_t i = begin; i < end; i++)
+        dataList[i] *= 2.0;
+});
+*/
+
+#ifndef _LTHREADPOOL_H_
+#define _LTHREADPOOL_H_
+
+#include <cstddef>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+#ifndef IN
+#define IN
+#endif
+
+#ifndef INOUT
+#define INOUT
+#endif
+
+#ifndef OUT
+#define OUT
+#endif
+
+/// @brief 线程池
+class LThreadPool
+{
+public:
+    /// @brief 获取全局线程池
+    /// 第一次调用时创建, 线程数为CPU的逻辑核心数
+    /// @return 全局线程池
+    static LThreadPool& Global()
+    {
+        static LThreadPool s_pool(std::thread::hardware_concurrency());
+        return s_pool;
+    }
+
+    /// @brief 构造函数
+    /// @param[in] threadNum 线程数(包括调用线程), 为0时视为1
+    explicit LThreadPool(IN unsigned int threadNum)
+        : m_threadNum(1), m_pJob(0), m_jobId(0), m_bStop(false)
+    {
+        this->Start(threadNum);
+    }
+
+    /// @brief 析构函数
+    ~LThreadPool()
+    {
+        this->Stop();
+    }
+
+    /// @brief 设置线程数
+    /// 注意: 不能在ParallelFor执行期间调用
+    /// @param[in] threadNum 线程数(包括调用线程), 为0时视为1, 为1时所有任务串行执行
+    void SetThreadNum(IN unsigned int threadNum)
+    {
+        std::lock_guard<std::mutex> runLock(m_runMutex);
+        this->Stop();
+        this->Start(threadNum);
+    }
+
+    /// @brief 获取线程数
+    /// @return 线程数(包括调用线程)
+    unsigned int ThreadNum() const
+    {
+        return m_threadNum;
+    }
+
+    /// @brief 并行循环
+    /// 将[0, count)均匀划分为不超过线程数的若干段, 每一段调用一次func(begin, end)
+    /// 函数返回时所有段都已执行完成
+    /// 某一段抛出异常时, 还没有开始的段不再执行, 等待正在执行的段完成后重新抛出第一个异常
+    /// 嵌套调用, 线程池正在被其他线程使用, 或者只有一个线程时, 直接在当前线程中执行func(0, count)
+    /// @param[in] count 循环次数
+    /// @param[in] func 循环体, 形式为void(size_t begin, size_t end)
+    template<typename Func>
+    void ParallelFor(IN size_t count, IN const Func& func)
+    {
+        if (count == 0)
+            return;
+
+        unsigned int taskNum = m_threadNum < count ? m_threadNum : (unsigned int)count;
+        if (taskNum <= 1 || InParallel() || !m_runMutex.try_lock())
+        {
+            func(0, count);
+            return;
+        }
+
+        std::lock_guard<std::mutex> runLock(m_runMutex, std::adopt_lock);
+
+        LJob job;
+        job.Task = [&func, count, taskNum](unsigned int task)
+        {
+            size_t begin = (size_t)((unsigned long long)count * task / taskNum);
+            size_t end = (size_t)((unsigned long long)count * (task + 1) / taskNum);
+            func(begin, end);
+        };
+        job.TaskNum = taskNum;
+        job.NextTask = 0;
+        job.DoneNum = 0;
+        job.ActiveWorkerNum = 0;
+        job.Failed = false;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_pJob = &job;
+            m_jobId++;
+        }
+        m_jobCondition.notify_all();
+
+        {
+            // 调用线程也参与计算, RunTasks不会抛出异常, 离开作用域时恢复标志
+            LParallelScope scope;
+            this->RunTasks(job);
+        }
+
+        {
+            // 等待所有任务完成, 并且没有工作线程还在引用该任务
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_doneCondition.wait(lock, [&job]()
+            {
+                return job.DoneNum == job.TaskNum && job.ActiveWorkerNum == 0;
+            });
+            m_pJob = 0;
+        }
+
+        if (job.Error)
+            std::rethrow_exception(job.Error);
+    }
+
+private:
+    /// @brief 并行任务
+    struct LJob
+    {
+        std::function<void(unsigned int)> Task; ///< 任务函数, 参数为任务索引
+        unsigned int TaskNum; ///< 任务数
+        std::atomic<unsigned int> NextTask; ///< 下一个未被领取的任务索引
+        std::atomic<unsigned int> DoneNum; ///< 已完成的任务数
+        unsigned int ActiveWorkerNum; ///< 正在执行该任务的工作线程数, 由m_mutex保护
+        std::atomic<bool> Failed; ///< 是否有任务抛出了异常, 之后领取的任务不再执行
+        std::exception_ptr Error; ///< 第一个抛出的异常, 由m_mutex保护
+    };
+
+    /// @brief 在作用域中把当前线程标记为正在执行并行任务
+    struct LParallelScope
+    {
+        LParallelScope() { InParallel() = true; }
+        ~LParallelScope() { InParallel() = false; }
+    };
+
+    /// @brief 当前线程是否正在执行并行任务
+    static bool& InParallel()
+    {
+        static thread_local bool s_bInParallel = false;
+        return s_bInParallel;
+    }
+
+    /// @brief 启动工作线程
+    void Start(IN unsigned int threadNum)
+    {
+        m_threadNum = threadNum > 0 ? threadNum : 1;
+        m_bStop = false;
+        for (unsigned int i = 1; i < m_threadNum; i++)
+        {
+            m_workerList.push_back(std::thread(&LThreadPool::WorkerLoop, this));
+        }
+    }
+
+    /// @brief 停止所有工作线程
+    void Stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_bStop = true;
+        }
+        m_jobCondition.notify_all();
+
+        for (unsigned int i = 0; i < m_workerList.size(); i++)
+        {
+            m_workerList[i].join();
+        }
+        m_workerList.clear();
+        m_threadNum = 1;
+    }
+
+    /// @brief 领取并执行任务, 直到所有任务都被领取
+    /// 任务抛出的异常保存在job.Error中, 不会离开该函数(工作线程中的异常不会导致std::terminate)
+    void RunTasks(INOUT LJob& job)
+    {
+        while (true)
+        {
+            unsigned int task = job.NextTask.fetch_add(1);
+            if (task >= job.TaskNum)
+                break;
+
+            if (!job.Failed.load())
+            {
+                try
+                {
+                    job.Task(task);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    if (!job.Error)
+                        job.Error = std::current_exception();
+                    job.Failed = true;
+                }
+            }
+
+            if (job.DoneNum.fetch_add(1) + 1 == job.TaskNum)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_doneCondition.notify_all();
+            }
+        }
+    }
+
+    /// @brief 工作线程函数
+    void WorkerLoop()
+    {
+        InParallel() = true;
+
+        unsigned long long lastJobId = 0;
+        while (true)
+        {
+            LJob* pJob = 0;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_jobCondition.wait(lock, [this, lastJobId]()
+                {
+                    return m_bStop || (m_pJob != 0 && m_jobId != lastJobId);
+                });
+                if (m_bStop)
+                    return;
+
+                pJob = m_pJob;
+                pJob->ActiveWorkerNum++;
+                lastJobId = m_jobId;
+            }
+
+            this->RunTasks(*pJob);
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                pJob->ActiveWorkerNum--;
+            }
+            m_doneCondition.notify_all();
+        }
+    }
+
+private:
+    LThreadPool(const LThreadPool&);
+    LThreadPool& operator = (const LThreadPool&);
+
+private:
+    unsigned int m_threadNum; ///< 线程数(包括调用线程)
+    std::vector<std::thread> m_workerList; ///< 工作线程列表
+    LJob* m_pJob; ///< 当前的并行任务, 由m_mutex保护
+    unsigned long long m_jobId; ///< 当前并行任务的编号, 由m_mutex保护
+    bool m_bStop; ///< 停止标志, 由m_mutex保护
+    std::mutex m_mutex; ///< 保护任务状态
+    std::mutex m_runMutex; ///< 保证同一时间只有一个并行任务
+    std::condition_variable m_jobCondition; ///< 通知工作线程有新任务
+    std::condition_variable m_doneCondition; ///< 通知调用线程任务完成
+};
+
+#endif
@@ -0,0 +1,243 @@
+﻿#include "LVectorKernel.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define LVECTOR_X86
+#endif
+
+#ifdef LVECTOR_X86
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+/// @brief 填充AVX2内核函数表, 定义在LVectorKernelAvx2.cpp中
+/// @return 编译器不支持时返回false
+bool LVectorKernelAvx2Table(OUT LVectorKernelTable<float>& floatTable, OUT LVectorKernelTable<double>& doubleTable);
+
+/// @brief 填充AVX-512内核函数表, 定义在LVectorKernelAvx512.cpp中
+/// @return 编译器不支持时返回false
+bool LVectorKernelAvx512Table(OUT LVectorKernelTable<float>& floatTable, OUT LVectorKernelTable<double>& doubleTable);
+
+namespace
+{
+#ifdef LVECTOR_X86
+    /// @brief SSE2 float向量类型描述
+    struct CVectorSse2Float
+    {
+        typedef float Scalar;
+        typedef __m128 Vec;
+        static const size_t WIDTH = 4;
+
+        static Vec Zero() { return _mm_setzero_ps(); }
+        static Vec Set1(IN Scalar s) { return _mm_set1_ps(s); }
+        static Vec Load(IN const Scalar* p) { return _mm_loadu_ps(p); }
+        static void Store(OUT Scalar* p, IN Vec v) { _mm_storeu_ps(p, v); }
+        static Vec Add(IN Vec a, IN Vec b) { return _mm_add_ps(a, b); }
+        static Vec Sub(IN Vec a, IN Vec b) { return _mm_sub_ps(a, b); }
+        static Vec Mul(IN Vec a, IN Vec b) { return _mm_mul_ps(a, b); }
+        static Vec Div(IN Vec a, IN Vec b) { return _mm_div_ps(a, b); }
+        static Vec Max(IN Vec a, IN Vec b) { return _mm_max_ps(a, b); }
+        static Vec Min(IN Vec a, IN Vec b) { return _mm_min_ps(a, b); }
+        static Vec MulAdd(IN Vec a, IN Vec b, IN Vec c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+        static Scalar ReduceAdd(IN Vec v)
+        {
+            v = _mm_add_ps(v, _mm_movehl_ps(v, v));
+            v = _mm_add_ss(v, _mm_shuffle_ps(v, v, 1));
+            return _mm_cvtss_f32(v);
+        }
+        static Scalar ReduceMax(IN Vec v)
+        {
+            v = _mm_max_ps(v, _mm_movehl_ps(v, v));
+            v = _mm_max_ss(v, _mm_shuffle_ps(v, v, 1));
+            return _mm_cvtss_f32(v);
+        }
+        static Scalar ReduceMin(IN Vec v)
+        {
+            v = _mm_min_ps(v, _mm_movehl_ps(v, v));
+            v = _mm_min_ss(v, _mm_shuffle_ps(v, v, 1));
+            return _mm_cvtss_f32(v);
+        }
+    };
+
+    /// @brief SSE2 double向量类型描述
+    struct CVectorSse2Double
+    {
+        typedef double Scalar;
+        typedef __m128d Vec;
+        static const size_t WIDTH = 2;
+
+        static Vec Zero() { return _mm_setzero_pd(); }
+        static Vec Set1(IN Scalar s) { return _mm_set1_pd(s); }
+        static Vec Load(IN const Scalar* p) { return _mm_loadu_pd(p); }
+        static void Store(OUT Scalar* p, IN Vec v) { _mm_storeu_pd(p, v); }
+        static Vec Add(IN Vec a, IN Vec b) { return _mm_add_pd(a, b); }
+        static Vec Sub(IN Vec a, IN Vec b) { return _mm_sub_pd(a, b); }
+        static Vec Mul(IN Vec a, IN Vec b) { return _mm_mul_pd(a, b); }
+        static Vec Div(IN Vec a, IN Vec b) { return _mm_div_pd(a, b); }
+        static Vec Max(IN Vec a, IN Vec b) { return _mm_max_pd(a, b); }
+        static Vec Min(IN Vec a, IN Vec b) { return _mm_min_pd(a, b); }
+        static Vec MulAdd(IN Vec a, IN Vec b, IN Vec c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+        static Scalar ReduceAdd(IN Vec v) { return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v))); }
+        static Scalar ReduceMax(IN Vec v) { return _mm_cvtsd_f64(_mm_max_sd(v, _mm_unpackhi_pd(v, v))); }
+        static Scalar ReduceMin(IN Vec v) { return _mm_cvtsd_f64(_mm_min_sd(v, _mm_unpackhi_pd(v, v))); }
+    };
+
+    /// @brief 执行CPUID指令
+    void Cpuid(IN unsigned int leaf, IN unsigned int subLeaf, OUT unsigned int info[4])
+    {
+#if defined(_MSC_VER)
+        int regs[4];
+        __cpuidex(regs, (int)leaf, (int)subLeaf);
+        for (int i = 0; i < 4; i++)
+            info[i] = (unsigned int)regs[i];
+#else
+        __cpuid_count(leaf, subLeaf, info[0], info[1], info[2], info[3]);
+#endif
+    }
+
+    /// @brief 读取XCR0寄存器(操作系统保存的向量寄存器状态)
+    unsigned long long Xgetbv()
+    {
+#if defined(_MSC_VER)
+        return _xgetbv(0);
+#else
+        unsigned int eax;
+        unsigned int edx;
+        __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        return ((unsigned long long)edx << 32) | eax;
+#endif
+    }
+#endif
+
+    /// @brief 检测CPU和操作系统支持的最高指令集
+    LVECTOR_ISA DetectIsa()
+    {
+#ifdef LVECTOR_X86
+        unsigned int info[4];
+        Cpuid(0, 0, info);
+        const unsigned int maxLeaf = info[0];
+
+        Cpuid(1, 0, info);
+        const bool sse2 = (info[3] & (1u << 26)) != 0;
+        const bool fma = (info[2] & (1u << 12)) != 0;
+        const bool osxsave = (info[2] & (1u << 27)) != 0;
+        const bool avx = (info[2] & (1u << 28)) != 0;
+        if (!sse2)
+            return LVECTOR_ISA_SCALAR;
+        if (!osxsave || !avx || !fma || maxLeaf < 7)
+            return LVECTOR_ISA_SSE2;
+
+        // 操作系统需要保存XMM和YMM寄存器(XCR0的第1, 2位)
+        const unsigned long long xcr0 = Xgetbv();
+        if ((xcr0 & 0x6) != 0x6)
+            return LVECTOR_ISA_SSE2;
+
+        Cpuid(7, 0, info);
+        const bool avx2 = (info[1] & (1u << 5)) != 0;
+        const bool avx512f = (info[1] & (1u << 16)) != 0;
+        if (!avx2)
+            return LVECTOR_ISA_SSE2;
+
+        // 还需要保存opmask和ZMM寄存器(XCR0的第5, 6, 7位)
+        if (!avx512f || (xcr0 & 0xE6) != 0xE6)
+            return LVECTOR_ISA_AVX2;
+
+        return LVECTOR_ISA_AVX512;
+#else
+        return LVECTOR_ISA_SCALAR;
+#endif
+    }
+
+    /// @brief 内核分派状态
+    struct CVectorKernelDispatch
+    {
+        LVECTOR_ISA SupportedIsa; ///< 支持的最高指令集
+        LVECTOR_ISA Isa; ///< 当前使用的指令集
+        LVectorKernelTable<float> FloatTable; ///< float内核函数表
+        LVectorKernelTable<double> DoubleTable; ///< double内核函数表
+
+        CVectorKernelDispatch()
+        {
+            SupportedIsa = DetectIsa();
+
+            // 编译器不支持的指令集逐级降低
+            LVECTOR_ISA isa = SupportedIsa;
+            while (!this->Select(isa))
+                isa = (LVECTOR_ISA)(isa - 1);
+            SupportedIsa = isa;
+        }
+
+        /// @brief 选择指令集
+        bool Select(IN LVECTOR_ISA isa)
+        {
+            switch (isa)
+            {
+            case LVECTOR_ISA_AVX512:
+                if (!LVectorKernelAvx512Table(FloatTable, DoubleTable))
+                    return false;
+                break;
+            case LVECTOR_ISA_AVX2:
+                if (!LVectorKernelAvx2Table(FloatTable, DoubleTable))
+                    return false;
+                break;
+#ifdef LVECTOR_X86
+            case LVECTOR_ISA_SSE2:
+                LVectorKernelImpl<CVectorSse2Float>::FillTable(FloatTable);
+                LVectorKernelImpl<CVectorSse2Double>::FillTable(DoubleTable);
+                break;
+#endif
+            case LVECTOR_ISA_SCALAR:
+                LVectorKernelImpl<LVectorScalar<float> >::FillTable(FloatTable);
+                LVectorKernelImpl<LVectorScalar<double> >::FillTable(DoubleTable);
+                break;
+            default:
+                return false;
+            }
+
+            Isa = isa;
+            return true;
+        }
+    };
+
+    /// @brief 获取内核分派状态
+    /// 第一次调用时检测CPU特性
+    CVectorKernelDispatch& Dispatch()
+    {
+        static CVectorKernelDispatch s_dispatch;
+        return s_dispatch;
+    }
+}
+
+LVECTOR_ISA LVectorKernelSupportedIsa()
+{
+    return Dispatch().SupportedIsa;
+}
+
+LVECTOR_ISA LVectorKernelIsa()
+{
+    return Dispatch().Isa;
+}
+
+bool LVectorKernelSetIsa(IN LVECTOR_ISA isa)
+{
+    CVectorKernelDispatch& dispatch = Dispatch();
+    if (isa < LVECTOR_ISA_SCALAR || isa > dispatch.SupportedIsa)
+        return false;
+
+    return dispatch.Select(isa);
+}
+
+template<>
+const LVectorKernelTable<float>& LVectorKernel<float>::Table()
+{
+    return Dispatch().FloatTable;
+}
+
+template<>
+const LVectorKernelTable<double>& LVectorKernel<double>::Table()
+{
+    return Dispatch().DoubleTable;
+}
@@ -0,0 +1,191 @@
+﻿/// @file LVectorKernel.h
+/// @brief 向量内核头文件
+///
+/// Detail: 连续向量上的逐元素运算和归约运算(axpy, fma, 求和, 最大值, 内积等)
+/// float和double的内核在第一次使用时根据CPU特性选择SSE2, AVX2(+FMA)或者AVX-512实现,
+/// 其他元素类型使用逐个元素计算的通用实现
+/// LMatrix的逐元素运算和行列归约都使用这些内核
+/// 注意: 不同的指令集实现中归约的累加顺序不同, 浮点结果可能有舍入误差级别的差异
+/// @author Jie Liu Email:coderjie@outlook.com
+/// @version
+/// @date 2026/10/17
+
+/*  使用向量内核的示例代码如下
+
+float x[100];
+float y[100];
+
+// y = 2 * x + y
+LVectorKernel<float>::Axpy(100, 2.0f, x, y);
+
+// 内积
+float dot = LVectorKernel<float>::Dot(100, x, y);
+*/
+
+#ifndef _LVECTORKERNEL_H_
+#define _LVECTORKERNEL_H_
+
+#include <cstddef>
+#include <cmath>
+
+#include "LVectorKernelImpl.h"
+
+/// @brief 向量内核的指令集
+enum LVECTOR_ISA
+{
+    LVECTOR_ISA_SCALAR = 0,     ///< 逐个元素计算
+    LVECTOR_ISA_SSE2 = 1,       ///< 128位SSE2
+    LVECTOR_ISA_AVX2 = 2,       ///< 256位AVX2和FMA
+    LVECTOR_ISA_AVX512 = 3      ///< 512位AVX-512F
+};
+
+/// @brief 获取CPU和操作系统支持的最高指令集
+/// @return 指令集
+LVECTOR_ISA LVectorKernelSupportedIsa();
+
+/// @brief 获取当前使用的指令集
+/// @return 指令集
+LVECTOR_ISA LVectorKernelIsa();
+
+/// @brief 设置使用的指令集
+/// 用于测试和性能对比, 默认使用支持的最高指令集
+/// 注意: 不能在其他线程使用向量内核时调用
+/// @param[in] isa 指令集
+/// @return 不支持该指令集返回false, 当前指令集不变
+bool LVectorKernelSetIsa(IN LVECTOR_ISA isa);
+
+/// @brief 向量内核
+/// 所有向量都是连续存储的, 长度为n, 输出向量可以和输入向量相同(完全重叠)
+/// @param Type 元素类型
+LTEMPLATE
+class LVectorKernel
+{
+public:
+    /// @brief z = x + y
+    static void Add(IN size_t n, IN const Type* pX, IN const Type* pY, OUT Type* pZ)
+    {
+        Table().Add(n, pX, pY, pZ);
+    }
+
+    /// @brief z = x - y
+    static void Sub(IN size_t n, IN const Type* pX, IN const Type* pY, OUT Type* pZ)
+    {
+        Table().Sub(n, pX, pY, pZ);
+    }
+
+    /// @brief z = x * y
+    static void Mul(IN size_t n, IN const Type* pX, IN const Type* pY, OUT Type* pZ)
+    {
+        Table().Mul(n, pX, pY, pZ);
+    }
+
+    /// @brief z = x / y
+    static void Div(IN size_t n, IN const Type* pX, IN const Type* pY, OUT Type* pZ)
+    {
+        Table().Div(n, pX, pY, pZ);
+    }
+
+    /// @brief z = max(x, y)
+    static void Maximum(IN size_t n, IN const Type* pX, IN const Type* pY, OUT Type* pZ)
+    {
+        Table().Maximum(n, pX, pY, pZ);
+    }
+
+    /// @brief z = min(x, y)
+    static void Minimum(IN size_t n, IN const Type* pX, IN const Type* pY, OUT Type* pZ)
+    {
+        Table().Minimum(n, pX, pY, pZ);
+    }
+
+    /// @brief z = x + a
+    static void AddScalar(IN size_t n, IN const Type& a, IN const Type* pX, OUT Type* pZ)
+    {
+        Table().AddScalar(n, a, pX, pZ);
+    }
+
+    /// @brief z = a * x
+    static void Scale(IN size_t n, IN const Type& a, IN const Type* pX, OUT Type* pZ)
+    {
+        Table().Scale(n, a, pX, pZ);
+    }
+
+    /// @brief z = x / a
+    static void DivScalar(IN size_t n, IN const Type& a, IN const Type* pX, OUT Type* pZ)
+    {
+        Table().DivScalar(n, a, pX, pZ);
+    }
+
+    /// @brief y = a * x + y
+    static void Axpy(IN size_t n, IN const Type& a, IN const Type* pX, INOUT Type* pY)
+    {
+        Table().Axpy(n, a, pX, pY);
+    }
+
+    /// @brief z = x * y + z
+    /// 支持FMA的指令集中使用融合乘加(只舍入一次)
+    static void Fma(IN size_t n, IN const Type* pX, IN const Type* pY, INOUT Type* pZ)
+    {
+        Table().Fma(n, pX, pY, pZ);
+    }
+
+    /// @brief 内积, sum(x * y)
+    static Type Dot(IN size_t n, IN const Type* pX, IN const Type* pY)
+    {
+        return Table().Dot(n, pX, pY);
+    }
+
+    /// @brief 欧几里得范数, sqrt(sum(x * x))
+    static Type Norm(IN size_t n, IN const Type* pX)
+    {
+        return Type(sqrt(Table().Dot(n, pX, pX)));
+    }
+
+    /// @brief 求和, sum(x)
+    static Type Sum(IN size_t n, IN const Type* pX)
+    {
+        return Table().Sum(n, pX);
+    }
+
+    /// @brief 最大值, 要求n > 0
+    static Type Max(IN size_t n, IN const Type* pX)
+    {
+        return Table().Max(n, pX);
+    }
+
+    /// @brief 最小值, 要求n > 0
+    static Type Min(IN size_t n, IN const Type* pX)
+    {
+        return Table().Min(n, pX);
+    }
+
+    /// @brief 第一个最大值的索引, 要求n > 0
+    static size_t ArgMax(IN size_t n, IN const Type* pX)
+    {
+        return Table().ArgMax(n, pX);
+    }
+
+private:
+    /// @brief 获取内核函数表
+    /// 通用类型使用逐个元素计算的实现, float和double的函数表定义在LVectorKernel.cpp中
+    static const LVectorKernelTable<Type>& Table()
+    {
+        static const LVectorKernelTable<Type> s_table = ScalarTable();
+        return s_table;
+    }
+
+    /// @brief 生成逐个元素计算的函数表
+    static LVectorKernelTable<Type> ScalarTable()
+    {
+        LVectorKernelTable<Type> table;
+        LVectorKernelImpl<LVectorScalar<Type> >::FillTable(table);
+        return table;
+    }
+};
+
+template<>
+const LVectorKernelTable<float>& LVectorKernel<float>::Table();
+
+template<>
+const LVectorKernelTable<double>& LVectorKernel<double>::Table();
+
+#endif
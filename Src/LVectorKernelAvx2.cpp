@@ -0,0 +1,122 @@
+﻿// AVX2和FMA指令集的向量内核实现
+// 本文件单独开启AVX2和FMA代码生成, 只有在运行时检测到CPU支持时才会调用其中的函数
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define LVECTOR_AVX2
+#endif
+
+#ifdef LVECTOR_AVX2
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2,fma"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+#endif
+
+#include <immintrin.h>
+
+#include "LVectorKernelImpl.h"
+
+namespace
+{
+    /// @brief AVX2 float向量类型描述
+    struct CVectorAvx2Float
+    {
+        typedef float Scalar;
+        typedef __m256 Vec;
+        static const size_t WIDTH = 8;
+
+        static Vec Zero() { return _mm256_setzero_ps(); }
+        static Vec Set1(IN Scalar s) { return _mm256_set1_ps(s); }
+        static Vec Load(IN const Scalar* p) { return _mm256_loadu_ps(p); }
+        static void Store(OUT Scalar* p, IN Vec v) { _mm256_storeu_ps(p, v); }
+        static Vec Add(IN Vec a, IN Vec b) { return _mm256_add_ps(a, b); }
+        static Vec Sub(IN Vec a, IN Vec b) { return _mm256_sub_ps(a, b); }
+        static Vec Mul(IN Vec a, IN Vec b) { return _mm256_mul_ps(a, b); }
+        static Vec Div(IN Vec a, IN Vec b) { return _mm256_div_ps(a, b); }
+        static Vec Max(IN Vec a, IN Vec b) { return _mm256_max_ps(a, b); }
+        static Vec Min(IN Vec a, IN Vec b) { return _mm256_min_ps(a, b); }
+        static Vec MulAdd(IN Vec a, IN Vec b, IN Vec c) { return _mm256_fmadd_ps(a, b, c); }
+        static Scalar ReduceAdd(IN Vec v)
+        {
+            __m128 x = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+            x = _mm_add_ps(x, _mm_movehl_ps(x, x));
+            x = _mm_add_ss(x, _mm_shuffle_ps(x, x, 1));
+            return _mm_cvtss_f32(x);
+        }
+        static Scalar ReduceMax(IN Vec v)
+        {
+            __m128 x = _mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+            x = _mm_max_ps(x, _mm_movehl_ps(x, x));
+            x = _mm_max_ss(x, _mm_shuffle_ps(x, x, 1));
+            return _mm_cvtss_f32(x);
+        }
+        static Scalar ReduceMin(IN Vec v)
+        {
+            __m128 x = _mm_min_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+            x = _mm_min_ps(x, _mm_movehl_ps(x, x));
+            x = _mm_min_ss(x, _mm_shuffle_ps(x, x, 1));
+            return _mm_cvtss_f32(x);
+        }
+    };
+
+    /// @brief AVX2 double向量类型描述
+    struct CVectorAvx2Double
+    {
+        typedef double Scalar;
+        typedef __m256d Vec;
+        static const size_t WIDTH = 4;
+
+        static Vec Zero() { return _mm256_setzero_pd(); }
+        static Vec Set1(IN Scalar s) { return _mm256_set1_pd(s); }
+        static Vec Load(IN const Scalar* p) { return _mm256_loadu_pd(p); }
+        static void Store(OUT Scalar* p, IN Vec v) { _mm256_storeu_pd(p, v); }
+        static Vec Add(IN Vec a, IN Vec b) { return _mm256_add_pd(a, b); }
+        static Vec Sub(IN Vec a, IN Vec b) { return _mm256_sub_pd(a, b); }
+        static Vec Mul(IN Vec a, IN Vec b) { return _mm256_mul_pd(a, b); }
+        static Vec Div(IN Vec a, IN Vec b) { return _mm256_div_pd(a, b); }
+        static Vec Max(IN Vec a, IN Vec b) { return _mm256_max_pd(a, b); }
+        static Vec Min(IN Vec a, IN Vec b) { return _mm256_min_pd(a, b); }
+        static Vec MulAdd(IN Vec a, IN Vec b, IN Vec c) { return _mm256_fmadd_pd(a, b, c); }
+        static Scalar ReduceAdd(IN Vec v)
+        {
+            __m128d x = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+            return _mm_cvtsd_f64(_mm_add_sd(x, _mm_unpackhi_pd(x, x)));
+        }
+        static Scalar ReduceMax(IN Vec v)
+        {
+            __m128d x = _mm_max_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+            return _mm_cvtsd_f64(_mm_max_sd(x, _mm_unpackhi_pd(x, x)));
+        }
+        static Scalar ReduceMin(IN Vec v)
+        {
+            __m128d x = _mm_min_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+            return _mm_cvtsd_f64(_mm_min_sd(x, _mm_unpackhi_pd(x, x)));
+        }
+    };
+}
+
+bool LVectorKernelAvx2Table(OUT LVectorKernelTable<float>& floatTable, OUT LVectorKernelTable<double>& doubleTable)
+{
+    LVectorKernelImpl<CVectorAvx2Float>::FillTable(floatTable);
+    LVectorKernelImpl<CVectorAvx2Double>::FillTable(doubleTable);
+    return true;
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#else
+
+#include "LVectorKernelImpl.h"
+
+bool LVectorKernelAvx2Table(OUT LVectorKernelTable<float>& floatTable, OUT LVectorKernelTable<double>& doubleTable)
+{
+    return false;
+}
+
+#endif
@@ -0,0 +1,94 @@
+﻿// AVX-512F指令集的向量内核实现
+// 本文件单独开启AVX-512F代码生成, 只有在运行时检测到CPU和操作系统支持时才会调用其中的函数
+// VS2015的编译器不支持AVX-512内联函数, 此时返回false, 运行时使用AVX2实现
+
+#if (defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)) && \
+    (!defined(_MSC_VER) || _MSC_VER >= 1910 || defined(__clang__))
+#define LVECTOR_AVX512
+#endif
+
+#ifdef LVECTOR_AVX512
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx512f,avx2,fma"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx2,fma")
+#endif
+
+#include <immintrin.h>
+
+#include "LVectorKernelImpl.h"
+
+namespace
+{
+    /// @brief AVX-512 float向量类型描述
+    struct CVectorAvx512Float
+    {
+        typedef float Scalar;
+        typedef __m512 Vec;
+        static const size_t WIDTH = 16;
+
+        static Vec Zero() { return _mm512_setzero_ps(); }
+        static Vec Set1(IN Scalar s) { return _mm512_set1_ps(s); }
+        static Vec Load(IN const Scalar* p) { return _mm512_loadu_ps(p); }
+        static void Store(OUT Scalar* p, IN Vec v) { _mm512_storeu_ps(p, v); }
+        static Vec Add(IN Vec a, IN Vec b) { return _mm512_add_ps(a, b); }
+        static Vec Sub(IN Vec a, IN Vec b) { return _mm512_sub_ps(a, b); }
+        static Vec Mul(IN Vec a, IN Vec b) { return _mm512_mul_ps(a, b); }
+        static Vec Div(IN Vec a, IN Vec b) { return _mm512_div_ps(a, b); }
+        static Vec Max(IN Vec a, IN Vec b) { return _mm512_max_ps(a, b); }
+        static Vec Min(IN Vec a, IN Vec b) { return _mm512_min_ps(a, b); }
+        static Vec MulAdd(IN Vec a, IN Vec b, IN Vec c) { return _mm512_fmadd_ps(a, b, c); }
+        static Scalar ReduceAdd(IN Vec v) { return _mm512_reduce_add_ps(v); }
+        static Scalar ReduceMax(IN Vec v) { return _mm512_reduce_max_ps(v); }
+        static Scalar ReduceMin(IN Vec v) { return _mm512_reduce_min_ps(v); }
+    };
+
+    /// @brief AVX-512 double向量类型描述
+    struct CVectorAvx512Double
+    {
+        typedef double Scalar;
+        typedef __m512d Vec;
+        static const size_t WIDTH = 8;
+
+        static Vec Zero() { return _mm512_setzero_pd(); }
+        static Vec Set1(IN Scalar s) { return _mm512_set1_pd(s); }
+        static Vec Load(IN const Scalar* p) { return _mm512_loadu_pd(p); }
+        static void Store(OUT Scalar* p, IN Vec v) { _mm512_storeu_pd(p, v); }
+        static Vec Add(IN Vec a, IN Vec b) { return _mm512_add_pd(a, b); }
+        static Vec Sub(IN Vec a, IN Vec b) { return _mm512_sub_pd(a, b); }
+        static Vec Mul(IN Vec a, IN Vec b) { return _mm512_mul_pd(a, b); }
+        static Vec Div(IN Vec a, IN Vec b) { return _mm512_div_pd(a, b); }
+        static Vec Max(IN Vec a, IN Vec b) { return _mm512_max_pd(a, b); }
+        static Vec Min(IN Vec a, IN Vec b) { return _mm512_min_pd(a, b); }
+        static Vec MulAdd(IN Vec a, IN Vec b, IN Vec c) { return _mm512_fmadd_pd(a, b, c); }
+        static Scalar ReduceAdd(IN Vec v) { return _mm512_reduce_add_pd(v); }
+        static Scalar ReduceMax(IN Vec v) { return _mm512_reduce_max_pd(v); }
+        static Scalar ReduceMin(IN Vec v) { return _mm512_reduce_min_pd(v); }
+    };
+}
+
+bool LVectorKernelAvx512Table(OUT LVectorKernelTable<float>& floatTable, OUT LVectorKernelTable<double>& doubleTable)
+{
+    LVectorKernelImpl<CVectorAvx512Float>::FillTable(floatTable);
+    LVectorKernelImpl<CVectorAvx512Double>::FillTable(doubleTable);
+    return true;
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#else
+
+#include "LVectorKernelImpl.h"
+
+bool LVectorKernelAvx512Table(OUT LVectorKernelTable<float>& floatTable, OUT LVectorKernelTable<double>& doubleTable)
+{
+    return false;
+}
+
+#endif
@@ -0,0 +1,312 @@
+﻿/// @file LVectorKernelImpl.h
+/// @brief 向量内核的通用实现头文件
+///
+/// Detail: 向量内核的算法按向量类型描述(V)编写, 各指令集的实现文件定义自己的V, 实例化后填充内核函数表
+/// 注意: 指令集实现文件在开启目标指令集(#pragma GCC target等)之后才包含本文件,
+/// 所以本文件不能包含其他头文件中的内联函数, 也不能被LVectorKernel.h以外的公共头文件包含
+/// V需要提供以下类型和静态函数:
+/// Scalar: 元素类型, Vec: 向量类型, WIDTH: 向量中的元素个数
+/// Zero(), Set1(s), Load(p), Store(p, v): 非对齐的加载和存储
+/// Add, Sub, Mul, Div, Max, Min: 逐元素运算, MulAdd(a, b, c): a * b + c
+/// ReduceAdd(v), ReduceMax(v), ReduceMin(v): 向量内的归约
+/// @author Jie Liu Email:coderjie@outlook.com
+/// @version
+/// @date 2026/10/17
+
+#ifndef _LVECTORKERNELIMPL_H_
+#define _LVECTORKERNELIMPL_H_
+
+#include <cstddef>
+
+#ifndef LTEMPLATE
+#define LTEMPLATE template<typename Type>
+#endif
+
+#ifndef IN
+#define IN
+#endif
+
+#ifndef INOUT
+#define INOUT
+#endif
+
+#ifndef OUT
+#define OUT
+#endif
+
+/// @brief 向量内核函数表
+/// 所有向量都是连续存储的, 长度为n, 输出向量可以和输入向量相同
+LTEMPLATE
+struct LVectorKernelTable
+{
+    void (*Add)(IN size_t n, IN const Type* pX, IN const Type* pY, OUT Type* pZ);       ///< z = x + y
+    void (*Sub)(IN size_t n, IN const Type* pX, IN const Type* pY, OUT Type* pZ);       ///< z = x - y
+    void (*Mul)(IN size_t n, IN const Type* pX, IN const Type* pY, OUT Type* pZ);       ///< z = x * y
+    void (*Div)(IN size_t n, IN const Type* pX, IN const Type* pY, OUT Type* pZ);       ///< z = x / y
+    void (*Maximum)(IN size_t n, IN const Type* pX, IN const Type* pY, OUT Type* pZ);   ///< z = max(x, y)
+    void (*Minimum)(IN size_t n, IN const Type* pX, IN const Type* pY, OUT Type* pZ);   ///< z = min(x, y)
+    void (*AddScalar)(IN size_t n, IN Type a, IN const Type* pX, OUT Type* pZ);         ///< z = x + a
+    void (*Scale)(IN size_t n, IN Type a, IN const Type* pX, OUT Type* pZ);             ///< z = a * x
+    void (*DivScalar)(IN size_t n, IN Type a, IN const Type* pX, OUT Type* pZ);         ///< z = x / a
+    void (*Axpy)(IN size_t n, IN Type a, IN const Type* pX, INOUT Type* pY);            ///< y = a * x + y
+    void (*Fma)(IN size_t n, IN const Type* pX, IN const Type* pY, INOUT Type* pZ);     ///< z = x * y + z
+    Type (*Dot)(IN size_t n, IN const Type* pX, IN const Type* pY);                     ///< sum(x * y)
+    Type (*Sum)(IN size_t n, IN const Type* pX);                                        ///< sum(x)
+    Type (*Max)(IN size_t n, IN const Type* pX);                                        ///< max(x), n > 0
+    Type (*Min)(IN size_t n, IN const Type* pX);                                        ///< min(x), n > 0
+    size_t (*ArgMax)(IN size_t n, IN const Type* pX);                                   ///< 第一个最大值的索引, n > 0
+};
+
+/// @brief 向量内核的通用实现
+/// 主循环每次处理WIDTH个元素, 归约使用两个累加向量以隐藏加法延迟, 剩余元素逐个处理
+/// @param V 向量类型描述
+template<typename V>
+struct LVectorKernelImpl
+{
+    typedef typename V::Scalar Scalar;
+    typedef typename V::Vec Vec;
+
+    static void Add(IN size_t n, IN const Scalar* pX, IN const Scalar* pY, OUT Scalar* pZ)
+    {
+        size_t i = 0;
+        for (; i + V::WIDTH <= n; i += V::WIDTH)
+            V::Store(&pZ[i], V::Add(V::Load(&pX[i]), V::Load(&pY[i])));
+        for (; i < n; i++)
+            pZ[i] = pX[i] + pY[i];
+    }
+
+    static void Sub(IN size_t n, IN const Scalar* pX, IN const Scalar* pY, OUT Scalar* pZ)
+    {
+        size_t i = 0;
+        for (; i + V::WIDTH <= n; i += V::WIDTH)
+            V::Store(&pZ[i], V::Sub(V::Load(&pX[i]), V::Load(&pY[i])));
+        for (; i < n; i++)
+            pZ[i] = pX[i] - pY[i];
+    }
+
+    static void Mul(IN size_t n, IN const Scalar* pX, IN const Scalar* pY, OUT Scalar* pZ)
+    {
+        size_t i = 0;
+        for (; i + V::WIDTH <= n; i += V::WIDTH)
+            V::Store(&pZ[i], V::Mul(V::Load(&pX[i]), V::Load(&pY[i])));
+        for (; i < n; i++)
+            pZ[i] = pX[i] * pY[i];
+    }
+
+    static void Div(IN size_t n, IN const Scalar* pX, IN const Scalar* pY, OUT Scalar* pZ)
+    {
+        size_t i = 0;
+        for (; i + V::WIDTH <= n; i += V::WIDTH)
+            V::Store(&pZ[i], V::Div(V::Load(&pX[i]), V::Load(&pY[i])));
+        for (; i < n; i++)
+            pZ[i] = pX[i] / pY[i];
+    }
+
+    static void Maximum(IN size_t n, IN const Scalar* pX, IN const Scalar* pY, OUT Scalar* pZ)
+    {
+        size_t i = 0;
+        for (; i + V::WIDTH <= n; i += V::WIDTH)
+            V::Store(&pZ[i], V::Max(V::Load(&pX[i]), V::Load(&pY[i])));
+        for (; i < n; i++)
+            pZ[i] = pX[i] > pY[i] ? pX[i] : pY[i];
+    }
+
+    static void Minimum(IN size_t n, IN const Scalar* pX, IN const Scalar* pY, OUT Scalar* pZ)
+    {
+        size_t i = 0;
+        for (; i + V::WIDTH <= n; i += V::WIDTH)
+            V::Store(&pZ[i], V::Min(V::Load(&pX[i]), V::Load(&pY[i])));
+        for (; i < n; i++)
+            pZ[i] = pX[i] < pY[i] ? pX[i] : pY[i];
+    }
+
+    static void AddScalar(IN size_t n, IN Scalar a, IN const Scalar* pX, OUT Scalar* pZ)
+    {
+        const Vec va = V::Set1(a);
+        size_t i = 0;
+        for (; i + V::WIDTH <= n; i += V::WIDTH)
+            V::Store(&pZ[i], V::Add(V::Load(&pX[i]), va));
+        for (; i < n; i++)
+            pZ[i] = pX[i] + a;
+    }
+
+    static void Scale(IN size_t n, IN Scalar a, IN const Scalar* pX, OUT Scalar* pZ)
+    {
+        const Vec va = V::Set1(a);
+        size_t i = 0;
+        for (; i + V::WIDTH <= n; i += V::WIDTH)
+            V::Store(&pZ[i], V::Mul(V::Load(&pX[i]), va));
+        for (; i < n; i++)
+            pZ[i] = pX[i] * a;
+    }
+
+    static void DivScalar(IN size_t n, IN Scalar a, IN const Scalar* pX, OUT Scalar* pZ)
+    {
+        const Vec va = V::Set1(a);
+        size_t i = 0;
+        for (; i + V::WIDTH <= n; i += V::WIDTH)
+            V::Store(&pZ[i], V::Div(V::Load(&pX[i]), va));
+        for (; i < n; i++)
+            pZ[i] = pX[i] / a;
+    }
+
+    static void Axpy(IN size_t n, IN Scalar a, IN const Scalar* pX, INOUT Scalar* pY)
+    {
+        const Vec va = V::Set1(a);
+        size_t i = 0;
+        for (; i + V::WIDTH <= n; i += V::WIDTH)
+            V::Store(&pY[i], V::MulAdd(va, V::Load(&pX[i]), V::Load(&pY[i])));
+        for (; i < n; i++)
+            pY[i] += a * pX[i];
+    }
+
+    static void Fma(IN size_t n, IN const Scalar* pX, IN const Scalar* pY, INOUT Scalar* pZ)
+    {
+        size_t i = 0;
+        for (; i + V::WIDTH <= n; i += V::WIDTH)
+            V::Store(&pZ[i], V::MulAdd(V::Load(&pX[i]), V::Load(&pY[i]), V::Load(&pZ[i])));
+        for (; i < n; i++)
+            pZ[i] += pX[i] * pY[i];
+    }
+
+    static Scalar Dot(IN size_t n, IN const Scalar* pX, IN const Scalar* pY)
+    {
+        Vec sum0 = V::Zero();
+        Vec sum1 = V::Zero();
+        size_t i = 0;
+        for (; i + 2 * V::WIDTH <= n; i += 2 * V::WIDTH)
+        {
+            sum0 = V::MulAdd(V::Load(&pX[i]), V::Load(&pY[i]), sum0);
+            sum1 = V::MulAdd(V::Load(&pX[i + V::WIDTH]), V::Load(&pY[i + V::WIDTH]), sum1);
+        }
+        for (; i + V::WIDTH <= n; i += V::WIDTH)
+            sum0 = V::MulAdd(V::Load(&pX[i]), V::Load(&pY[i]), sum0);
+
+        Scalar sum = V::ReduceAdd(V::Add(sum0, sum1));
+        for (; i < n; i++)
+            sum += pX[i] * pY[i];
+
+        return sum;
+    }
+
+    static Scalar Sum(IN size_t n, IN const Scalar* pX)
+    {
+        Vec sum0 = V::Zero();
+        Vec sum1 = V::Zero();
+        size_t i = 0;
+        for (; i + 2 * V::WIDTH <= n; i += 2 * V::WIDTH)
+        {
+            sum0 = V::Add(sum0, V::Load(&pX[i]));
+            sum1 = V::Add(sum1, V::Load(&pX[i + V::WIDTH]));
+        }
+        for (; i + V::WIDTH <= n; i += V::WIDTH)
+            sum0 = V::Add(sum0, V::Load(&pX[i]));
+
+        Scalar sum = V::ReduceAdd(V::Add(sum0, sum1));
+        for (; i < n; i++)
+            sum += pX[i];
+
+        return sum;
+    }
+
+    static Scalar Max(IN size_t n, IN const Scalar* pX)
+    {
+        size_t i = 0;
+        Scalar maxValue = pX[0];
+        if (n >= V::WIDTH)
+        {
+            Vec maxVec = V::Load(&pX[0]);
+            for (i = V::WIDTH; i + V::WIDTH <= n; i += V::WIDTH)
+                maxVec = V::Max(maxVec, V::Load(&pX[i]));
+            maxValue = V::ReduceMax(maxVec);
+        }
+        for (; i < n; i++)
+        {
+            if (pX[i] > maxValue)
+                maxValue = pX[i];
+        }
+
+        return maxValue;
+    }
+
+    static Scalar Min(IN size_t n, IN const Scalar* pX)
+    {
+        size_t i = 0;
+        Scalar minValue = pX[0];
+        if (n >= V::WIDTH)
+        {
+            Vec minVec = V::Load(&pX[0]);
+            for (i = V::WIDTH; i + V::WIDTH <= n; i += V::WIDTH)
+                minVec = V::Min(minVec, V::Load(&pX[i]));
+            minValue = V::ReduceMin(minVec);
+        }
+        for (; i < n; i++)
+        {
+            if (pX[i] < minValue)
+                minValue = pX[i];
+        }
+
+        return minValue;
+    }
+
+    static size_t ArgMax(IN size_t n, IN const Scalar* pX)
+    {
+        // 先向量化地求最大值, 再查找第一个等于最大值的位置
+        const Scalar maxValue = Max(n, pX);
+        for (size_t i = 0; i < n; i++)
+        {
+            if (pX[i] == maxValue)
+                return i;
+        }
+
+        return 0;
+    }
+
+    /// @brief 使用本实现填充内核函数表
+    static void FillTable(OUT LVectorKernelTable<Scalar>& table)
+    {
+        table.Add = &Add;
+        table.Sub = &Sub;
+        table.Mul = &Mul;
+        table.Div = &Div;
+        table.Maximum = &Maximum;
+        table.Minimum = &Minimum;
+        table.AddScalar = &AddScalar;
+        table.Scale = &Scale;
+        table.DivScalar = &DivScalar;
+        table.Axpy = &Axpy;
+        table.Fma = &Fma;
+        table.Dot = &Dot;
+        table.Sum = &Sum;
+        table.Max = &Max;
+        table.Min = &Min;
+        table.ArgMax = &ArgMax;
+    }
+};
+
+/// @brief 标量向量类型描述, 每个向量只有一个元素
+/// 用于非x86平台和非浮点元素类型
+LTEMPLATE
+struct LVectorScalar
+{
+    typedef Type Scalar;
+    typedef Type Vec;
+    static const size_t WIDTH = 1;
+
+    static Vec Zero() { return Type(0); }
+    static Vec Set1(IN Scalar s) { return s; }
+    static Vec Load(IN const Scalar* p) { return *p; }
+    static void Store(OUT Scalar* p, IN Vec v) { *p = v; }
+    static Vec Add(IN Vec a, IN Vec b) { return a + b; }
+    static Vec Sub(IN Vec a, IN Vec b) { return a - b; }
+    static Vec Mul(IN Vec a, IN Vec b) { return a * b; }
+    static Vec Div(IN Vec a, IN Vec b) { return a / b; }
+    static Vec Max(IN Vec a, IN Vec b) { return a > b ? a : b; }
+    static Vec Min(IN Vec a, IN Vec b) { return a < b ? a : b; }
+    static Vec MulAdd(IN Vec a, IN Vec b, IN Vec c) { return a * b + c; }
+    static Scalar ReduceAdd(IN Vec v) { return v; }
+    static Scalar ReduceMax(IN Vec v) { return v; }
+    static Scalar ReduceMin(IN Vec v) { return v; }
+};
+
+#endif
@@ -0,0 +1,66 @@
+﻿
+#include "../LBenchmark.h"
+
+#include "../../../Src/LNeuralNetwork.h"
+
+/// @brief BP网络: iris数据集(4个输入, 3个输出), 两个隐藏层
+/// 规模参数为样本行数, 隐藏层神经元个数分别测试16和64
+void BenchmarkBPNetwork(INOUT LBenchmark& bench)
+{
+    LDataMatrix data;
+    if (!bench.LoadDataSet("iris.csv", data))
+        return;
+
+    const size_t inputNum = data.ColumnLen - 1;
+    const size_t outputNum = 3;
+    const size_t hiddenLayerNum = 2;
+    const size_t neuronsList[2] = { 16, 64 };
+
+    const std::vector<size_t> sizes = bench.Sizes("150,1200,9600");
+    for (size_t s = 0; s < sizes.size(); s++)
+    {
+        const size_t rows = sizes[s];
+
+        LNNMatrix X;
+        LBenchmarkTile(data, 0, inputNum, rows, X);
+        LBenchmarkNormalize(X);
+
+        LNNMatrix Y(rows, outputNum, 0.0);
+        for (size_t i = 0; i < rows; i++)
+            Y[i][(size_t)data[i % data.RowLen][inputNum]] = 1.0;
+
+        for (size_t n = 0; n < 2; n++)
+        {
+            const size_t neurons = neuronsList[n];
+
+            LBPNetworkPogology pogology;
+            pogology.InputNumber = inputNum;
+            pogology.OutputNumber = outputNum;
+            pogology.HiddenLayerNumber = hiddenLayerNum;
+            pogology.NeuronsOfHiddenLayer = neurons;
+            LBPNetwork network(pogology);
+
+            // 权重个数(包括偏置), 前向计算每个权重2次浮点运算, 反向传播约4次
+            const double weightNum = (double)((inputNum + 1) * neurons +
+                (hiddenLayerNum - 1) * (neurons + 1) * neurons + (neurons + 1) * outputNum);
+
+            LNNMatrix output;
+            const std::string suffix = neurons == 16 ? "/H16" : "/H64";
+            bench.Run(("BPNetwork/Train" + suffix).c_str(), rows, 6.0 * rows * weightNum, (double)rows, [&]() {
+                return network.Train(X, Y, 0.5f);
+            });
+            bench.Run(("BPNetwork/Active" + suffix).c_str(), rows, 2.0 * rows * weightNum, (double)rows, [&]() {
+                return network.Active(X, &output);
+            });
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    LBenchmark bench("BPNetwork", argc, argv);
+
+    BenchmarkBPNetwork(bench);
+
+    return bench.Report();
+}
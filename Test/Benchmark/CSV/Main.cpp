@@ -0,0 +1,233 @@
+﻿
+#include "../LBenchmark.h"
+
+#include "../../../Src/LMappedFile.h"
+
+/// @brief 将数据集的数据行(不包括首行)重复写入文件, 直到文件达到指定的大小
+/// @param[in] srcPath 源数据集路径
+/// @param[in] dstPath 生成的文件路径
+/// @param[in] bytes 文件大小(字节)
+/// @param[out] rows 生成的行数
+/// @return 成功返回true
+bool WriteReplicatedCSV(IN const std::string& srcPath, IN const char* dstPath, IN size_t bytes, OUT size_t& rows)
+{
+    FILE* pSrc = fopen(srcPath.c_str(), "rb");
+    if (pSrc == 0)
+        return false;
+
+    std::string text;
+    char buffer[4096];
+    size_t len = 0;
+    while ((len = fread(buffer, 1, sizeof(buffer), pSrc)) > 0)
+        text.append(buffer, len);
+    fclose(pSrc);
+
+    // 去掉首行, 保证每行以换行符结束
+    const size_t headerEnd = text.find('\n');
+    if (headerEnd == std::string::npos)
+        return false;
+    std::string body = text.substr(headerEnd + 1);
+    if (body.empty())
+        return false;
+    if (body[body.size() - 1] != '\n')
+        body.push_back('\n');
+
+    size_t bodyRows = 0;
+    for (size_t i = 0; i < body.size(); i++)
+    {
+        if (body[i] == '\n')
+            bodyRows++;
+    }
+
+    FILE* pDst = fopen(dstPath, "wb");
+    if (pDst == 0)
+        return false;
+
+    rows = 0;
+    for (size_t written = 0; written < bytes; written += body.size())
+    {
+        fwrite(body.data(), 1, body.size(), pDst);
+        rows += bodyRows;
+    }
+    fclose(pDst);
+
+    return true;
+}
+
+/// @brief CSV解析: breast_cancer数据集(31列)的数据行重复到指定的大小(MB)
+/// 文件在预热后位于页缓存中, 测量的是解析吞吐量而不是磁盘速度
+/// CSV/Load一次加载整个文件, CSV/Batch按256行的批次流式读取, CSV/Cached从缓存文件加载(只映射, 不解析)
+/// CSV/Typed按数据模式加载为float特征矩阵和int标签向量, 与先加载为double矩阵再转换拆分相比少一次复制
+/// 测试多GB的文件时使用--sizes指定, 如--sizes=4096(文件需要放在页缓存中, 请保证足够的内存)
+void BenchmarkCSVLoad(INOUT LBenchmark& bench)
+{
+    const char* fileName = "LBenchmarkCSV.csv";
+    const wchar_t* wideFileName = L"LBenchmarkCSV.csv";
+    const char* cacheFileName = "LBenchmarkCSV.csv.lmx";
+
+    const std::vector<size_t> sizes = bench.Sizes("4,64");
+    for (size_t s = 0; s < sizes.size(); s++)
+    {
+        size_t rows = 0;
+        if (!WriteReplicatedCSV(bench.DataSetPath("breast_cancer.csv"), fileName, sizes[s] * 1024 * 1024, rows))
+        {
+            bench.Fail("Can not create CSV file");
+            return;
+        }
+
+        unsigned long long fileSize = 0;
+        LMappedFile::FileSize(wideFileName, fileSize);
+
+        LCSVParser parser(wideFileName);
+        LDataMatrix data;
+
+        // 线程数从1开始成倍增加到全局线程池的线程数, CSV/Load/T<n>为使用n个线程的结果
+        const unsigned int maxThreadNum = LThreadPool::Global().ThreadNum();
+        double serialNs = 0.0;
+        for (unsigned int threadNum = 1; ; threadNum *= 2)
+        {
+            if (threadNum > maxThreadNum)
+                threadNum = maxThreadNum;
+            LThreadPool::Global().SetThreadNum(threadNum);
+
+            char name[64];
+            sprintf(name, "CSV/Load/T%u", threadNum);
+            const size_t resultNum = bench.Results().size();
+            bench.Run(name, sizes[s], 0.0, (double)rows, [&]() {
+                return parser.LoadAllData(data) && data.RowLen == rows && data.ColumnLen == 31;
+            });
+
+            // 吞吐量(MB/s)和相对于单线程的加速比
+            if (bench.Results().size() > resultNum)
+            {
+                const double ns = bench.Results().back().NsPerOp;
+                if (threadNum == 1)
+                    serialNs = ns;
+
+                sprintf(name, "CSV/Load/T%u/MBPerSec", threadNum);
+                bench.Metric(name, sizes[s], (double)fileSize * 1e3 / ns);
+                if (threadNum > 1 && serialNs > 0.0)
+                {
+                    sprintf(name, "CSV/Load/T%u/Speedup", threadNum);
+                    bench.Metric(name, sizes[s], serialNs / ns);
+                }
+            }
+
+            if (threadNum == maxThreadNum)
+                break;
+        }
+        LThreadPool::Global().SetThreadNum(maxThreadNum);
+
+        // 前30列为float特征, 最后一列为int标签, 只解析一次, 不复制
+        LCSVSchema schema;
+        schema.LabelColumn = 30;
+        LMatrix<float> feature;
+        LMatrix<int> label;
+        bench.Run("CSV/Typed", sizes[s], 0.0, (double)rows, [&]() {
+            return parser.LoadData(schema, feature, label) && feature.RowLen == rows && feature.ColumnLen == 30 && label.RowLen == rows;
+        });
+        feature.Reset(0, 0);
+        label.Reset(0, 0);
+
+        // 按批次流式读取整个文件, 内存只占用一个窗口和一个批次
+        LCSVBatchReader reader(wideFileName);
+        reader.SetBatchSize(256);
+        bench.Run("CSV/Batch", sizes[s], 0.0, (double)rows, [&]() {
+            reader.Rewind();
+            size_t batchRows = 0;
+            while (reader.NextBatch(data))
+                batchRows += data.RowLen;
+            return !reader.Failed() && batchRows == rows;
+        });
+
+        // 第一次加载生成缓存文件, 以后每次加载都映射缓存文件
+        remove(cacheFileName);
+        LCSVParser cachedParser(wideFileName);
+        cachedParser.SetCache(true);
+        bench.Run("CSV/Cached", sizes[s], 0.0, (double)rows, [&]() {
+            return cachedParser.LoadAllData(data) && data.RowLen == rows && data.ColumnLen == 31;
+        });
+        data.Reset(0, 0);
+
+        remove(cacheFileName);
+        remove(fileName);
+    }
+}
+
+/// @brief svmlight格式: 随机生成的稀疏数据(10000个特征, 每行约20个非零特征), 大小为指定的MB
+/// SVMLight/Load一次加载整个文件(多线程), SVMLight/Batch按256行的批次流式读取
+void BenchmarkSVMLightLoad(INOUT LBenchmark& bench)
+{
+    const char* fileName = "LBenchmarkSVMLight.svm";
+    const wchar_t* wideFileName = L"LBenchmarkSVMLight.svm";
+    const size_t featureNum = 10000;
+
+    const std::vector<size_t> sizes = bench.Sizes("4,64");
+    for (size_t s = 0; s < sizes.size(); s++)
+    {
+        FILE* pFile = fopen(fileName, "wb");
+        if (pFile == 0)
+        {
+            bench.Fail("Can not create svmlight file");
+            return;
+        }
+
+        // 每行的特征索引递增, 间隔为1到1000
+        std::string text;
+        char buffer[64];
+        size_t rows = 0;
+        size_t written = 0;
+        unsigned int state = 1;
+        while (written < sizes[s] * 1024 * 1024)
+        {
+            text = (rows % 2 == 0) ? "1" : "-1";
+            for (size_t index = 0; ; )
+            {
+                state = state * 1103515245u + 12345u;
+                index += 1 + (state >> 8) % 1000;
+                if (index > featureNum)
+                    break;
+                sprintf(buffer, " %u:%.4f", (unsigned int)index, (double)((state >> 4) % 10000) / 10000.0);
+                text += buffer;
+            }
+            text += "\n";
+            fwrite(text.data(), 1, text.size(), pFile);
+            written += text.size();
+            rows++;
+        }
+        fclose(pFile);
+
+        LSVMLightReader reader(wideFileName);
+        reader.SetFeatureNum(featureNum);
+        LDataSparseMatrix X;
+        LDataMatrix y;
+        const size_t resultNum = bench.Results().size();
+        bench.Run("SVMLight/Load", sizes[s], 0.0, (double)rows, [&]() {
+            return reader.LoadAllData(X, y) && X.RowLen == rows && X.ColumnLen == featureNum;
+        });
+        if (bench.Results().size() > resultNum)
+            bench.Metric("SVMLight/Load/MBPerSec", sizes[s], (double)written * 1e3 / bench.Results().back().NsPerOp);
+        X.Reset(0, 0);
+
+        reader.SetBatchSize(256);
+        bench.Run("SVMLight/Batch", sizes[s], 0.0, (double)rows, [&]() {
+            reader.Rewind();
+            size_t batchRows = 0;
+            while (reader.NextBatch(X, y))
+                batchRows += X.RowLen;
+            return !reader.Failed() && batchRows == rows;
+        });
+
+        remove(fileName);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    LBenchmark bench("CSV", argc, argv);
+
+    BenchmarkCSVLoad(bench);
+    BenchmarkSVMLightLoad(bench);
+
+    return bench.Report();
+}
@@ -0,0 +1,83 @@
+﻿
+#include "../LBenchmark.h"
+
+#include "../../../Src/LDecisionTree.h"
+
+/// @brief 在一个数据集上测试分类树的训练和预测
+/// @param[in] fileName 数据集文件名, 最后一列为类别
+/// @param[in] name 基准测试名称前缀
+/// @param[in] defaultSizes 默认的样本行数列表
+void BenchmarkClassifier(INOUT LBenchmark& bench, IN const char* fileName, IN const char* name, IN const char* defaultSizes)
+{
+    LDataMatrix data;
+    if (!bench.LoadDataSet(fileName, data))
+        return;
+
+    const size_t featureNum = data.ColumnLen - 1;
+    LDTMatrix nVector(1, featureNum, DT_FEATURE_CONTINUUM);
+
+    const std::vector<size_t> sizes = bench.Sizes(defaultSizes);
+    for (size_t s = 0; s < sizes.size(); s++)
+    {
+        const size_t rows = sizes[s];
+
+        LDTMatrix X;
+        LDTMatrix Y;
+        LBenchmarkTile(data, 0, featureNum, rows, X);
+        LBenchmarkTile(data, featureNum, 1, rows, Y);
+
+        LDecisionTreeClassifier classifier;
+        LDTMatrix predict;
+
+        bench.Run((std::string(name) + "/Train").c_str(), rows, 0.0, (double)rows, [&]() {
+            return classifier.TrainModel(X, nVector, Y);
+        });
+        bench.Run((std::string(name) + "/Predict").c_str(), rows, 0.0, (double)rows, [&]() {
+            return classifier.Predict(X, predict);
+        });
+    }
+}
+
+/// @brief 回归树: diabetes数据集
+void BenchmarkRegression(INOUT LBenchmark& bench)
+{
+    LDataMatrix data;
+    LDataMatrix target;
+    if (!bench.LoadDataSet("diabetes_data.csv", data, false, L' ') ||
+        !bench.LoadDataSet("diabetes_target.csv", target, false, L' '))
+        return;
+
+    LDTMatrix nVector(1, data.ColumnLen, DT_FEATURE_CONTINUUM);
+
+    const std::vector<size_t> sizes = bench.Sizes("442,884,1768");
+    for (size_t s = 0; s < sizes.size(); s++)
+    {
+        const size_t rows = sizes[s];
+
+        LDTMatrix X;
+        LDTMatrix Y;
+        LBenchmarkTile(data, 0, data.ColumnLen, rows, X);
+        LBenchmarkTile(target, 0, 1, rows, Y);
+
+        LDecisionTreeRegression regression;
+        LDTMatrix predict;
+
+        bench.Run("RegressionTree/Train", rows, 0.0, (double)rows, [&]() {
+            return regression.TrainModel(X, nVector, Y);
+        });
+        bench.Run("RegressionTree/Predict", rows, 0.0, (double)rows, [&]() {
+            return regression.Predict(X, predict);
+        });
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    LBenchmark bench("DecisionTree", argc, argv);
+
+    BenchmarkClassifier(bench, "iris.csv", "ClassifierIris", "150,600,2400");
+    BenchmarkClassifier(bench, "breast_cancer.csv", "ClassifierBreastCancer", "569,1138,2276");
+    BenchmarkRegression(bench);
+
+    return bench.Report();
+}
@@ -0,0 +1,75 @@
+﻿
+#include "../LBenchmark.h"
+
+#include "../../../Src/LKDTree.h"
+
+/// @brief KD树: breast_cancer数据集的前10个特征
+/// 重复的行加上微小的偏移, 避免大量完全相同的点
+void BenchmarkKDTree(INOUT LBenchmark& bench)
+{
+    LDataMatrix data;
+    if (!bench.LoadDataSet("breast_cancer.csv", data))
+        return;
+
+    const size_t featureNum = 10;
+    const size_t queryNum = 256;
+    const std::vector<size_t> sizes = bench.Sizes("569,4552,36416");
+    for (size_t s = 0; s < sizes.size(); s++)
+    {
+        const size_t rows = sizes[s];
+
+        LKDTreeMatrix dataSet;
+        LBenchmarkTile(data, 0, featureNum, rows, dataSet);
+        LBenchmarkNormalize(dataSet);
+        for (size_t i = data.RowLen; i < rows; i++)
+        {
+            for (size_t j = 0; j < featureNum; j++)
+                dataSet[i][j] += (float)((i * 7 + j * 13) % 101) * 1e-4f;
+        }
+
+        // 查询点为数据集中点的中点
+        std::vector<LKDTreeMatrix> queryList(queryNum);
+        for (size_t q = 0; q < queryNum; q++)
+        {
+            const size_t a = (q * 7919) % rows;
+            const size_t b = (q * 104729 + 1) % rows;
+            queryList[q].Reset(1, featureNum);
+            for (size_t j = 0; j < featureNum; j++)
+                queryList[q][0][j] = (dataSet[a][j] + dataSet[b][j]) * 0.5f;
+        }
+
+        LKDTree tree;
+        bench.Run("KDTree/Build", rows, 0.0, (double)rows, [&]() {
+            tree.BuildTree(dataSet);
+            return true;
+        });
+
+        bench.Run("KDTree/Nearest", rows, 0.0, (double)queryNum, [&]() {
+            for (size_t q = 0; q < queryNum; q++)
+            {
+                if (tree.SearchNearestNeighbor(queryList[q]) < 0)
+                    return false;
+            }
+            return true;
+        });
+
+        LKDTreeList indexList;
+        bench.Run("KDTree/KNearest5", rows, 0.0, (double)queryNum, [&]() {
+            for (size_t q = 0; q < queryNum; q++)
+            {
+                if (!tree.SearchKNearestNeighbors(queryList[q], 5, indexList))
+                    return false;
+            }
+            return true;
+        });
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    LBenchmark bench("KDTree", argc, argv);
+
+    BenchmarkKDTree(bench);
+
+    return bench.Report();
+}
@@ -0,0 +1,71 @@
+﻿
+#include "../LBenchmark.h"
+
+#include "../../../Src/LDataCluster.h"
+
+/// @brief K均值聚类: iris数据集(4个特征, K=3)
+/// 每次操作为一次完整的聚类, 初始中心点随机, 迭代次数和耗时会有波动
+void BenchmarkKMeans(INOUT LBenchmark& bench)
+{
+    LDataMatrix data;
+    if (!bench.LoadDataSet("iris.csv", data))
+        return;
+
+    const size_t featureNum = data.ColumnLen - 1;
+    const std::vector<size_t> sizes = bench.Sizes("150,1200,9600");
+    for (size_t s = 0; s < sizes.size(); s++)
+    {
+        const size_t rows = sizes[s];
+
+        LDCDataMatrix X;
+        LBenchmarkTile(data, 0, featureNum, rows, X);
+
+        const LDATA_SIMILAR_METHOD methods[2] = { EUCLIDEAN_DISTANCE, PEARSON_CORRETATIO };
+        const char* names[2] = { "KMeans/Euclidean", "KMeans/Pearson" };
+        for (size_t m = 0; m < 2; m++)
+        {
+            LKMeansCluster cluster;
+            cluster.SetDataSimilerMethod(methods[m]);
+            cluster.SetK(3);
+            cluster.Init();
+
+            LDCResultMatrix result;
+            bench.Run(names[m], rows, 0.0, (double)rows, [&]() {
+                cluster.Cluster(X, result);
+                return result.size() == 3;
+            });
+        }
+    }
+}
+
+/// @brief 分级聚类: iris数据集, 计算量为样本数的三次方, 只测试较小的规模
+void BenchmarkHierarchical(INOUT LBenchmark& bench)
+{
+    LDataMatrix data;
+    if (!bench.LoadDataSet("iris.csv", data))
+        return;
+
+    const size_t featureNum = data.ColumnLen - 1;
+    const size_t rows = data.RowLen;
+
+    LDCDataMatrix X;
+    LBenchmarkTile(data, 0, featureNum, rows, X);
+
+    LBiClusterTree tree;
+    tree.SetDataSimilerMethod(EUCLIDEAN_DISTANCE);
+    tree.Init();
+    bench.Run("BiClusterTree/Euclidean", rows, 0.0, (double)rows, [&]() {
+        tree.Cluster(X);
+        return true;
+    });
+}
+
+int main(int argc, char* argv[])
+{
+    LBenchmark bench("KMeans", argc, argv);
+
+    BenchmarkKMeans(bench);
+    BenchmarkHierarchical(bench);
+
+    return bench.Report();
+}
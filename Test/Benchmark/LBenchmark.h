@@ -0,0 +1,402 @@
+﻿/// @file LBenchmark.h
+/// @brief 本文声明了微基准测试框架
+/// LBenchmark(基准测试运行器)
+/// Detail: 每个基准测试先预热一次, 然后成倍增加重复次数直到运行时间达到最短运行时间
+/// 报告每次操作的纳秒数(ns/op), GFLOP/s, 每秒处理的行数(rows/s)以及进程的峰值内存(peak RSS)
+/// 结果以JSON格式输出, 便于对比不同版本或者不同机器的结果, 精度等非计时的指标通过Metric()记录
+/// 命令行参数:
+///     --sizes=64,128,256      问题规模列表, 默认使用每个基准测试自己的规模列表
+///     --min-time=0.5          每个基准测试的最短运行时间(秒)
+///     --quick                 快速模式, 只运行最小的规模并且每个基准测试只运行一次, 用于构建检查
+///     --out=result.json       结果输出文件, 默认输出到标准输出
+///     --dataset=../DataSet    数据集目录
+/// @author Jie Liu Email:coderjie@outlook.com
+/// @version
+/// @date 2026/10/17
+
+#ifndef _LBENCHMARK_H_
+#define _LBENCHMARK_H_
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <Psapi.h>
+#ifdef _MSC_VER
+#pragma comment(lib, "psapi.lib")
+#endif
+#else
+#include <sys/resource.h>
+#endif
+
+#include "../../Src/LCSVIo.h"
+
+/// @brief 数据集目录的默认值, 构建系统可以通过宏定义指定
+#ifndef LBENCHMARK_DATASET_DIR
+#define LBENCHMARK_DATASET_DIR "../../DataSet"
+#endif
+
+/// @brief 基准测试结果
+struct LBenchmarkResult
+{
+    std::string Name;               ///< 基准测试名称
+    size_t Size;                    ///< 问题规模
+    unsigned long long Iterations;  ///< 计时的重复次数
+    double NsPerOp;                 ///< 每次操作的纳秒数
+    double GFlops;                  ///< 每秒十亿次浮点运算数, 不统计浮点运算数时为0
+    double RowsPerSec;              ///< 每秒处理的行数, 不统计行数时为0
+    double AllocsPerOp;             ///< 每次操作中矩阵数据的堆内存分配次数(见LMatrixAllocationCounter)
+    unsigned long long PeakRss;     ///< 运行后的进程峰值内存(KB)
+};
+
+/// @brief 非计时的指标(如模型精度)
+struct LBenchmarkMetric
+{
+    std::string Name;               ///< 指标名称
+    size_t Size;                    ///< 问题规模
+    double Value;                   ///< 指标值
+};
+
+/// @brief 基准测试运行器
+class LBenchmark
+{
+public:
+    /// @brief 构造函数
+    /// @param[in] suite 基准测试集名称
+    /// @param[in] argc 命令行参数个数
+    /// @param[in] argv 命令行参数
+    LBenchmark(IN const char* suite, IN int argc, IN char* argv[])
+        : m_suite(suite), m_minTime(0.5), m_bQuick(false), m_datasetDir(LBENCHMARK_DATASET_DIR), m_bOk(true)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            const char* arg = argv[i];
+            if (strcmp(arg, "--quick") == 0)
+                m_bQuick = true;
+            else if (strncmp(arg, "--min-time=", 11) == 0)
+                m_minTime = atof(arg + 11);
+            else if (strncmp(arg, "--out=", 6) == 0)
+                m_outFile = arg + 6;
+            else if (strncmp(arg, "--dataset=", 10) == 0)
+                m_datasetDir = arg + 10;
+            else if (strncmp(arg, "--sizes=", 8) == 0)
+                ParseSizes(arg + 8, m_sizes);
+            else
+                fprintf(stderr, "Unknown argument: %s\n", arg);
+        }
+
+        if (m_bQuick)
+            m_minTime = 0.0;
+    }
+
+    /// @brief 获取问题规模列表
+    /// 快速模式下只返回最小的规模
+    /// @param[in] defaultSizes 命令行未指定规模时使用的规模列表(逗号分隔)
+    /// @return 规模列表
+    std::vector<size_t> Sizes(IN const char* defaultSizes) const
+    {
+        std::vector<size_t> sizes = m_sizes;
+        if (sizes.empty())
+            ParseSizes(defaultSizes, sizes);
+
+        if (m_bQuick && sizes.size() > 1)
+        {
+            size_t minSize = sizes[0];
+            for (size_t i = 1; i < sizes.size(); i++)
+            {
+                if (sizes[i] < minSize)
+                    minSize = sizes[i];
+            }
+            sizes.assign(1, minSize);
+        }
+
+        return sizes;
+    }
+
+    /// @brief 是否为快速模式
+    bool Quick() const
+    {
+        return m_bQuick;
+    }
+
+    /// @brief 获取数据集目录中文件的路径
+    /// @param[in] fileName 文件名(不包含目录)
+    std::string DataSetPath(IN const char* fileName) const
+    {
+        return m_datasetDir + "/" + fileName;
+    }
+
+    /// @brief 加载数据集目录中的CSV文件
+    /// 加载失败时基准测试集标记为失败
+    /// @param[in] fileName 文件名(不包含目录)
+    /// @param[out] data 存储数据
+    /// @param[in] skipHeader 是否跳过首行
+    /// @param[in] delimiter 分隔符
+    /// @return 成功返回true
+    bool LoadDataSet(IN const char* fileName, OUT LDataMatrix& data, IN bool skipHeader = true, IN wchar_t delimiter = L',')
+    {
+        std::string path = DataSetPath(fileName);
+        std::wstring widePath(path.begin(), path.end());
+
+        LCSVParser parser(widePath.c_str());
+        parser.SetSkipHeader(skipHeader);
+        parser.SetDelimiter(delimiter);
+        if (!parser.LoadAllData(data) || data.RowLen == 0)
+        {
+            fprintf(stderr, "Can not load data set: %s\n", path.c_str());
+            m_bOk = false;
+            return false;
+        }
+
+        return true;
+    }
+
+    /// @brief 运行一个基准测试
+    /// @param[in] name 基准测试名称
+    /// @param[in] size 问题规模
+    /// @param[in] flopsPerOp 每次操作的浮点运算数, 为0表示不统计
+    /// @param[in] rowsPerOp 每次操作处理的行数, 为0表示不统计
+    /// @param[in] func 被测试的操作, 返回false表示操作失败
+    template<typename Func>
+    void Run(IN const char* name, IN size_t size, IN double flopsPerOp, IN double rowsPerOp, IN Func func)
+    {
+        typedef std::chrono::steady_clock Clock;
+
+        // 预热, 同时检查操作是否成功
+        if (!func())
+        {
+            fprintf(stderr, "Benchmark failed: %s/%llu\n", name, (unsigned long long)size);
+            m_bOk = false;
+            return;
+        }
+
+        unsigned long long iterations = 1;
+        unsigned long long allocations = 0;
+        double seconds = 0.0;
+        while (true)
+        {
+            const unsigned long long allocationStart = LMatrixAllocationCounter().load();
+            Clock::time_point start = Clock::now();
+            for (unsigned long long i = 0; i < iterations; i++)
+                func();
+            seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            allocations = LMatrixAllocationCounter().load() - allocationStart;
+
+            if (seconds >= m_minTime || m_bQuick)
+                break;
+
+            // 根据已用时间估计需要的重复次数, 每次最多增加10倍
+            unsigned long long next = iterations * 10;
+            if (seconds > 0.0)
+            {
+                const double estimate = iterations * m_minTime * 1.2 / seconds;
+                if (estimate < (double)next)
+                    next = (unsigned long long)estimate + 1;
+            }
+            iterations = next > iterations ? next : iterations + 1;
+        }
+
+        LBenchmarkResult result;
+        result.Name = name;
+        result.Size = size;
+        result.Iterations = iterations;
+        result.NsPerOp = seconds * 1e9 / (double)iterations;
+        result.GFlops = (flopsPerOp > 0.0 && seconds > 0.0) ? flopsPerOp * iterations / seconds * 1e-9 : 0.0;
+        result.RowsPerSec = (rowsPerOp > 0.0 && seconds > 0.0) ? rowsPerOp * iterations / seconds : 0.0;
+        result.AllocsPerOp = (double)allocations / (double)iterations;
+        result.PeakRss = PeakRss();
+        m_results.push_back(result);
+
+        fprintf(stderr, "%-32s %8llu %14.1f ns/op %10.3f GFLOP/s %14.1f rows/s %12.1f allocs/op\n",
+            name, (unsigned long long)size, result.NsPerOp, result.GFlops, result.RowsPerSec, result.AllocsPerOp);
+    }
+
+    /// @brief 获取已经完成的基准测试结果
+    const std::vector<LBenchmarkResult>& Results() const
+    {
+        return m_results;
+    }
+
+    /// @brief 将基准测试集标记为失败
+    /// @param[in] message 失败信息
+    void Fail(IN const char* message)
+    {
+        fprintf(stderr, "%s\n", message);
+        m_bOk = false;
+    }
+
+    /// @brief 记录一个非计时的指标
+    /// @param[in] name 指标名称
+    /// @param[in] size 问题规模
+    /// @param[in] value 指标值
+    void Metric(IN const char* name, IN size_t size, IN double value)
+    {
+        LBenchmarkMetric metric;
+        metric.Name = name;
+        metric.Size = size;
+        metric.Value = value;
+        m_metrics.push_back(metric);
+
+        fprintf(stderr, "%-32s %8llu %14.6g\n", name, (unsigned long long)size, value);
+    }
+
+    /// @brief 输出JSON格式的结果
+    /// @return 所有基准测试都成功并且输出成功返回0, 否则返回1
+    int Report() const
+    {
+        FILE* pFile = stdout;
+        if (!m_outFile.empty())
+        {
+            pFile = fopen(m_outFile.c_str(), "w");
+            if (pFile == 0)
+            {
+                fprintf(stderr, "Can not open output file: %s\n", m_outFile.c_str());
+                return 1;
+            }
+        }
+
+        fprintf(pFile, "{\n");
+        fprintf(pFile, "  \"suite\": \"%s\",\n", m_suite.c_str());
+        fprintf(pFile, "  \"quick\": %s,\n", m_bQuick ? "true" : "false");
+        fprintf(pFile, "  \"min_time\": %g,\n", m_minTime);
+        fprintf(pFile, "  \"threads\": %u,\n", LThreadPool::Global().ThreadNum());
+        fprintf(pFile, "  \"isa\": \"%s\",\n", IsaName(LVectorKernelIsa()));
+        fprintf(pFile, "  \"peak_rss_kb\": %llu,\n", PeakRss());
+        fprintf(pFile, "  \"results\": [\n");
+        for (size_t i = 0; i < m_results.size(); i++)
+        {
+            const LBenchmarkResult& result = m_results[i];
+            fprintf(pFile, "    {\"name\": \"%s\", \"size\": %llu, \"iterations\": %llu, "
+                "\"ns_per_op\": %.1f, \"gflops\": %.4f, \"rows_per_sec\": %.1f, \"allocs_per_op\": %.1f, \"peak_rss_kb\": %llu}%s\n",
+                result.Name.c_str(), (unsigned long long)result.Size, result.Iterations,
+                result.NsPerOp, result.GFlops, result.RowsPerSec, result.AllocsPerOp, result.PeakRss,
+                (i + 1 < m_results.size()) ? "," : "");
+        }
+        fprintf(pFile, "  ],\n");
+        fprintf(pFile, "  \"metrics\": [\n");
+        for (size_t i = 0; i < m_metrics.size(); i++)
+        {
+            const LBenchmarkMetric& metric = m_metrics[i];
+            fprintf(pFile, "    {\"name\": \"%s\", \"size\": %llu, \"value\": %.10g}%s\n",
+                metric.Name.c_str(), (unsigned long long)metric.Size, metric.Value,
+                (i + 1 < m_metrics.size()) ? "," : "");
+        }
+        fprintf(pFile, "  ]\n");
+        fprintf(pFile, "}\n");
+
+        if (pFile != stdout)
+            fclose(pFile);
+
+        return m_bOk ? 0 : 1;
+    }
+
+    /// @brief 获取进程的峰值内存
+    /// @return 峰值内存(KB), 获取失败返回0
+    static unsigned long long PeakRss()
+    {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) == 0)
+            return 0;
+        return (unsigned long long)counters.PeakWorkingSetSize / 1024;
+#else
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+            return 0;
+#ifdef __APPLE__
+        return (unsigned long long)usage.ru_maxrss / 1024;
+#else
+        return (unsigned long long)usage.ru_maxrss;
+#endif
+#endif
+    }
+
+private:
+    /// @brief 解析逗号分隔的规模列表
+    static void ParseSizes(IN const char* text, OUT std::vector<size_t>& sizes)
+    {
+        sizes.clear();
+        while (*text != '\0')
+        {
+            char* pEnd = 0;
+            unsigned long long size = strtoull(text, &pEnd, 10);
+            if (pEnd == text)
+                break;
+            if (size > 0)
+                sizes.push_back((size_t)size);
+            text = (*pEnd == ',') ? pEnd + 1 : pEnd;
+        }
+    }
+
+    /// @brief 获取指令集名称
+    static const char* IsaName(IN LVECTOR_ISA isa)
+    {
+        switch (isa)
+        {
+        case LVECTOR_ISA_SSE2: return "sse2";
+        case LVECTOR_ISA_AVX2: return "avx2";
+        case LVECTOR_ISA_AVX512: return "avx512";
+        default: return "scalar";
+        }
+    }
+
+private:
+    std::string m_suite;                        ///< 基准测试集名称
+    double m_minTime;                           ///< 最短运行时间(秒)
+    bool m_bQuick;                              ///< 是否为快速模式
+    std::string m_outFile;                      ///< 结果输出文件
+    std::string m_datasetDir;                   ///< 数据集目录
+    std::vector<size_t> m_sizes;                ///< 命令行指定的规模列表
+    std::vector<LBenchmarkResult> m_results;    ///< 结果列表
+    std::vector<LBenchmarkMetric> m_metrics;    ///< 指标列表
+    bool m_bOk;                                 ///< 是否所有基准测试都成功
+};
+
+/// @brief 将数据集按行重复到指定的行数
+/// 用于在小数据集上构造参数化规模的问题
+/// @param[in] src 源数据
+/// @param[in] colStart 源数据的起始列
+/// @param[in] colLen 复制的列数
+/// @param[in] rows 目标行数
+/// @param[out] dst 存储结果
+template<typename Type>
+void LBenchmarkTile(IN const LDataMatrix& src, IN size_t colStart, IN size_t colLen, IN size_t rows, OUT LMatrix<Type>& dst)
+{
+    dst.Reset(rows, colLen);
+    for (size_t i = 0; i < rows; i++)
+    {
+        const double* pSrc = src[i % src.RowLen] + colStart;
+        Type* pDst = dst[i];
+        for (size_t j = 0; j < colLen; j++)
+            pDst[j] = (Type)pSrc[j];
+    }
+}
+
+/// @brief 将矩阵的每列缩放到[0, 1]
+template<typename Type>
+void LBenchmarkNormalize(INOUT LMatrix<Type>& data)
+{
+    for (size_t j = 0; j < data.ColumnLen; j++)
+    {
+        Type min = data[0][j];
+        Type max = data[0][j];
+        for (size_t i = 1; i < data.RowLen; i++)
+        {
+            if (data[i][j] < min)
+                min = data[i][j];
+            if (data[i][j] > max)
+                max = data[i][j];
+        }
+
+        const Type range = (max > min) ? (max - min) : (Type)1;
+        for (size_t i = 0; i < data.RowLen; i++)
+            data[i][j] = (data[i][j] - min) / range;
+    }
+}
+
+#endif
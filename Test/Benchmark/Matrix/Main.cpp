@@ -0,0 +1,130 @@
+﻿
+#include "../LBenchmark.h"
+
+/// @brief 生成确定的测试矩阵
+template<typename Type>
+void FillMatrix(IN size_t row, IN size_t col, IN unsigned int seed, OUT LMatrix<Type>& M)
+{
+    M.Reset(row, col);
+    for (size_t i = 0; i < row; i++)
+    {
+        for (size_t j = 0; j < col; j++)
+            M[i][j] = (Type)((i * 131 + j * 71 + seed * 17) % 1000) / (Type)1000 - (Type)0.5;
+    }
+}
+
+/// @brief 一种元素类型的矩阵内核基准测试
+template<typename Type>
+void BenchmarkKernels(INOUT LBenchmark& bench, IN const char* typeName)
+{
+    const std::vector<size_t> sizes = bench.Sizes("64,256,512,1024");
+    for (size_t s = 0; s < sizes.size(); s++)
+    {
+        const size_t n = sizes[s];
+        const double n2 = (double)n * (double)n;
+        const double n3 = n2 * (double)n;
+
+        LMatrix<Type> A;
+        LMatrix<Type> B;
+        LMatrix<Type> C;
+        FillMatrix(n, n, 1, A);
+        FillMatrix(n, n, 2, B);
+
+        std::string prefix = std::string(typeName) + "/";
+
+        bench.Run((prefix + "MUL").c_str(), n, 2.0 * n3, (double)n, [&]() {
+            return LMatrix<Type>::MUL(A, B, C);
+        });
+        bench.Run((prefix + "MUL_AT_B").c_str(), n, 2.0 * n3, (double)n, [&]() {
+            return LMatrix<Type>::MUL_AT_B(A, B, C);
+        });
+        bench.Run((prefix + "MUL_A_BT").c_str(), n, 2.0 * n3, (double)n, [&]() {
+            return LMatrix<Type>::MUL_A_BT(A, B, C);
+        });
+        bench.Run((prefix + "ADD").c_str(), n, n2, (double)n, [&]() {
+            return LMatrix<Type>::ADD(A, B, C);
+        });
+        bench.Run((prefix + "DOTMUL").c_str(), n, n2, (double)n, [&]() {
+            return LMatrix<Type>::DOTMUL(A, B, C);
+        });
+        bench.Run((prefix + "SCALARMUL").c_str(), n, n2, (double)n, [&]() {
+            return LMatrix<Type>::SCALARMUL(A, (Type)1.5, C);
+        });
+        bench.Run((prefix + "EXPR_A+B*s-A").c_str(), n, 3.0 * n2, (double)n, [&]() {
+            C = A + B.ScalarMul((Type)2) - A;
+            return C.RowLen == n;
+        });
+        bench.Run((prefix + "T").c_str(), n, 0.0, (double)n, [&]() {
+            return LMatrix<Type>::T(A, C);
+        });
+        bench.Run((prefix + "ROWSUM").c_str(), n, n2, (double)n, [&]() {
+            return LMatrix<Type>::ROWSUM(A, C);
+        });
+        bench.Run((prefix + "COLUMNSUM").c_str(), n, n2, (double)n, [&]() {
+            return LMatrix<Type>::COLUMNSUM(A, C);
+        });
+        bench.Run((prefix + "ROWMAX").c_str(), n, n2, (double)n, [&]() {
+            return LMatrix<Type>::ROWMAX(A, C);
+        });
+        bench.Run((prefix + "COLUMNMAX").c_str(), n, n2, (double)n, [&]() {
+            return LMatrix<Type>::COLUMNMAX(A, C);
+        });
+
+        // 向量内核, 向量长度为n*n
+        LMatrix<Type> X;
+        LMatrix<Type> Y;
+        FillMatrix(1, n * n, 3, X);
+        FillMatrix(1, n * n, 4, Y);
+        volatile Type sink = 0;
+        bench.Run((prefix + "VECTOR_DOT").c_str(), n, 2.0 * n2, 0.0, [&]() {
+            sink = LVectorKernel<Type>::Dot(n * n, X[0], Y[0]);
+            return true;
+        });
+        bench.Run((prefix + "VECTOR_AXPY").c_str(), n, 2.0 * n2, 0.0, [&]() {
+            LVectorKernel<Type>::Axpy(n * n, (Type)1e-6, X[0], Y[0]);
+            return true;
+        });
+        (void)sink;
+    }
+}
+
+/// @brief 数据集上的矩阵乘法(样本矩阵与随机权重相乘, 与模型的前向计算相同)
+void BenchmarkDataSet(INOUT LBenchmark& bench)
+{
+    LDataMatrix data;
+    if (!bench.LoadDataSet("breast_cancer.csv", data))
+        return;
+
+    const size_t featureNum = data.ColumnLen - 1;
+    const size_t outputNum = 16;
+    const std::vector<size_t> rowSizes = bench.Sizes("569,4552,36416");
+    for (size_t s = 0; s < rowSizes.size(); s++)
+    {
+        const size_t rows = rowSizes[s];
+
+        LMatrix<double> X;
+        LBenchmarkTile(data, 0, featureNum, rows, X);
+        LMatrix<double> W;
+        FillMatrix(featureNum, outputNum, 5, W);
+        LMatrix<double> Y;
+
+        bench.Run("double/DATASET_X*W", rows, 2.0 * rows * featureNum * outputNum, (double)rows, [&]() {
+            return LMatrix<double>::MUL(X, W, Y);
+        });
+        bench.Run("double/DATASET_X*W+XT*Y", rows, 4.0 * rows * featureNum * outputNum, (double)rows, [&]() {
+            LMatrix<double> G;
+            return LMatrix<double>::MUL(X, W, Y) && LMatrix<double>::MUL_AT_B(X, Y, G);
+        });
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    LBenchmark bench("Matrix", argc, argv);
+
+    BenchmarkKernels<float>(bench, "float");
+    BenchmarkKernels<double>(bench, "double");
+    BenchmarkDataSet(bench);
+
+    return bench.Report();
+}
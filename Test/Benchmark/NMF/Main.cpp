@@ -0,0 +1,45 @@
+﻿
+#include "../LBenchmark.h"
+
+#include "../../../Src/LNMF.h"
+
+/// @brief NMF: wine数据集的13个非负特征
+/// 每次操作为一次完整的分解, 乘法更新规则每次迭代约 6*m*n*r 次浮点运算
+void BenchmarkNMF(INOUT LBenchmark& bench)
+{
+    LDataMatrix data;
+    if (!bench.LoadDataSet("wine_data.csv", data))
+        return;
+
+    const size_t featureNum = data.ColumnLen - 1;
+    const size_t r = 3;
+    const unsigned int iterCount = 20;
+    const std::vector<size_t> sizes = bench.Sizes("178,1424,11392");
+    for (size_t s = 0; s < sizes.size(); s++)
+    {
+        const size_t rows = sizes[s];
+
+        LNMFMatrix V;
+        LBenchmarkTile(data, 0, featureNum, rows, V);
+        LBenchmarkNormalize(V);
+
+        LNMF nmf;
+        LNMFMatrix W;
+        LNMFMatrix H;
+        LNMFProblem problem(V, r, iterCount);
+
+        const double flops = 6.0 * rows * featureNum * r * iterCount;
+        bench.Run("NMF/Factoring", rows, flops, (double)rows, [&]() {
+            return nmf.Factoring(problem, &W, &H);
+        });
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    LBenchmark bench("NMF", argc, argv);
+
+    BenchmarkNMF(bench);
+
+    return bench.Report();
+}
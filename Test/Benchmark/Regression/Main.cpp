@@ -0,0 +1,177 @@
+﻿
+#include "../LBenchmark.h"
+
+#include "../../../Src/LRegression.h"
+
+/// @brief 在一个数据集上对比线性回归的梯度下降和直接求解(Cholesky, QR)
+/// 每次梯度下降拟合为从0开始的GRADIENT_STEPS步全量梯度下降, 精度(R^2)通过指标记录
+/// @param[in] name 数据集名称
+/// @param[in] data 特征矩阵
+/// @param[in] target 输出(列向量)
+/// @param[in] defaultSizes 默认的样本行数列表
+void BenchmarkLinearDataSet(
+    INOUT LBenchmark& bench,
+    IN const char* name,
+    IN const LDataMatrix& data,
+    IN const LDataMatrix& target,
+    IN const char* defaultSizes)
+{
+    const unsigned int GRADIENT_STEPS = 200;
+    const double featureNum = (double)data.ColumnLen;
+    const std::string prefix = std::string("Linear/") + name + "/";
+
+    const std::vector<size_t> sizes = bench.Sizes(defaultSizes);
+    for (size_t s = 0; s < sizes.size(); s++)
+    {
+        const size_t rows = sizes[s];
+
+        LRegressionMatrix X;
+        LRegressionMatrix Y;
+        LBenchmarkTile(data, 0, data.ColumnLen, rows, X);
+        LBenchmarkTile(target, 0, 1, rows, Y);
+        LBenchmarkNormalize(X);
+
+        // 特征缩放到[0, 1]后X.T() * X的最大特征值不超过rows * (featureNum + 1), 以此确定稳定的学习速度
+        const double alpha = 1.0 / ((double)rows * (featureNum + 1.0));
+
+        LLinearRegression model;
+        LRegressionMatrix predict;
+
+        // 每次训练为一步全量梯度下降: 前向计算XW和梯度XT(XW-Y)
+        bench.Run((prefix + "TrainStep").c_str(), rows, 4.0 * rows * (featureNum + 1.0), (double)rows, [&]() {
+            return model.TrainModel(X, Y, alpha);
+        });
+        bench.Run((prefix + "Predict").c_str(), rows, 2.0 * rows * (featureNum + 1.0), (double)rows, [&]() {
+            return model.Predict(X, predict);
+        });
+
+        LLinearRegression gradient;
+        bench.Run((prefix + "GradientFit").c_str(), rows, 4.0 * rows * (featureNum + 1.0) * GRADIENT_STEPS, (double)rows, [&]() {
+            LLinearRegression fresh;
+            for (unsigned int step = 0; step < GRADIENT_STEPS; step++)
+            {
+                if (!fresh.TrainModel(X, Y, alpha))
+                    return false;
+            }
+            return gradient.TrainModel(X, Y, alpha);
+        });
+        for (unsigned int step = 1; step < GRADIENT_STEPS; step++)
+            gradient.TrainModel(X, Y, alpha);
+        bench.Metric((prefix + "GradientFit/R2").c_str(), rows, gradient.Score(X, Y));
+
+        // 法方程: 构造X.T() * X约2*rows*n^2次浮点运算, QR分解约4*rows*n^2次
+        const double n = featureNum;
+        const LREGRESSION_SOLVER solvers[3] = { REGRESSION_SOLVER_CHOLESKY, REGRESSION_SOLVER_QR, REGRESSION_SOLVER_QR };
+        const double lambdas[3] = { 0.0, 0.0, 1.0 };
+        const double flops[3] = { 2.0 * rows * n * n, 4.0 * rows * n * n, 4.0 * rows * n * n };
+        const char* names[3] = { "Cholesky", "QR", "QRRidge" };
+        for (size_t k = 0; k < 3; k++)
+        {
+            LLinearRegression direct;
+            direct.SetSolver(solvers[k], lambdas[k]);
+            bench.Run((prefix + names[k]).c_str(), rows, flops[k], (double)rows, [&]() {
+                return direct.TrainModel(X, Y, 1.0);
+            });
+            bench.Metric((prefix + names[k] + "/R2").c_str(), rows, direct.Score(X, Y));
+        }
+    }
+}
+
+/// @brief 线性回归: diabetes数据集(10个特征)和boston_house_prices数据集(13个特征)
+void BenchmarkLinear(INOUT LBenchmark& bench)
+{
+    LDataMatrix data;
+    LDataMatrix target;
+    if (bench.LoadDataSet("diabetes_data.csv", data, false, L' ') &&
+        bench.LoadDataSet("diabetes_target.csv", target, false, L' '))
+    {
+        BenchmarkLinearDataSet(bench, "Diabetes", data, target, "442,3536,28288");
+    }
+
+    // boston_house_prices有两行表头, 跳过首行后第二行(列名)解析为无效的数据, 将其去除
+    LDataMatrix boston;
+    if (bench.LoadDataSet("boston_house_prices.csv", boston) && boston.RowLen > 1)
+    {
+        const size_t featureNum = boston.ColumnLen - 1;
+        boston.SubMatrix(1, boston.RowLen - 1, 0, featureNum, data);
+        boston.SubMatrix(1, boston.RowLen - 1, featureNum, 1, target);
+        BenchmarkLinearDataSet(bench, "Boston", data, target, "506,4048,32384");
+    }
+}
+
+/// @brief 逻辑回归: breast_cancer数据集(30个特征, 二分类)
+void BenchmarkLogistic(INOUT LBenchmark& bench)
+{
+    LDataMatrix data;
+    if (!bench.LoadDataSet("breast_cancer.csv", data))
+        return;
+
+    const size_t featureNum = data.ColumnLen - 1;
+    const std::vector<size_t> sizes = bench.Sizes("569,4552,36416");
+    for (size_t s = 0; s < sizes.size(); s++)
+    {
+        const size_t rows = sizes[s];
+
+        LRegressionMatrix X;
+        LRegressionMatrix Y;
+        LBenchmarkTile(data, 0, featureNum, rows, X);
+        LBenchmarkTile(data, featureNum, 1, rows, Y);
+        LBenchmarkNormalize(X);
+
+        LLogisticRegression model;
+        LRegressionMatrix predict;
+
+        bench.Run("Logistic/TrainStep", rows, 4.0 * rows * (featureNum + 1.0), (double)rows, [&]() {
+            return model.TrainModel(X, Y, 0.1);
+        });
+        bench.Run("Logistic/Predict", rows, 2.0 * rows * (featureNum + 1.0), (double)rows, [&]() {
+            return model.Predict(X, predict);
+        });
+    }
+}
+
+/// @brief Softmax回归: iris数据集(4个特征, 3个类别)
+void BenchmarkSoftmax(INOUT LBenchmark& bench)
+{
+    LDataMatrix data;
+    if (!bench.LoadDataSet("iris.csv", data))
+        return;
+
+    const size_t featureNum = data.ColumnLen - 1;
+    const size_t classNum = 3;
+    const std::vector<size_t> sizes = bench.Sizes("150,1200,9600");
+    for (size_t s = 0; s < sizes.size(); s++)
+    {
+        const size_t rows = sizes[s];
+
+        LRegressionMatrix X;
+        LBenchmarkTile(data, 0, featureNum, rows, X);
+        LBenchmarkNormalize(X);
+
+        LRegressionMatrix Y(rows, classNum, REGRESSION_ZERO);
+        for (size_t i = 0; i < rows; i++)
+            Y[i][(size_t)data[i % data.RowLen][featureNum]] = REGRESSION_ONE;
+
+        LSoftmaxRegression model;
+        LRegressionMatrix predict;
+
+        const double flops = 2.0 * rows * (featureNum + 1.0) * classNum;
+        bench.Run("Softmax/TrainStep", rows, 2.0 * flops, (double)rows, [&]() {
+            return model.TrainModel(X, Y, 0.1);
+        });
+        bench.Run("Softmax/Predict", rows, flops, (double)rows, [&]() {
+            return model.Predict(X, predict);
+        });
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    LBenchmark bench("Regression", argc, argv);
+
+    BenchmarkLinear(bench);
+    BenchmarkLogistic(bench);
+    BenchmarkSoftmax(bench);
+
+    return bench.Report();
+}
@@ -0,0 +1,62 @@
+﻿
+#include "../LBenchmark.h"
+
+#include "../../../Src/LSVM.h"
+
+/// @brief SVM: breast_cancer数据集(30个特征, 类别映射为-1和1)
+/// SMO训练的耗时和数据有关, 因此限制最大遍历次数, 报告每次训练的耗时
+void BenchmarkSVM(INOUT LBenchmark& bench)
+{
+    LDataMatrix data;
+    if (!bench.LoadDataSet("breast_cancer.csv", data))
+        return;
+
+    const size_t featureNum = data.ColumnLen - 1;
+    const std::vector<size_t> sizes = bench.Sizes("100,200,400");
+    for (size_t s = 0; s < sizes.size(); s++)
+    {
+        const size_t rows = sizes[s];
+
+        LSVMMatrix X;
+        LSVMMatrix Y;
+        LBenchmarkTile(data, 0, featureNum, rows, X);
+        LBenchmarkTile(data, featureNum, 1, rows, Y);
+        LBenchmarkNormalize(X);
+        for (size_t i = 0; i < rows; i++)
+            Y[i][0] = (Y[i][0] > 0.5f) ? 1.0f : -1.0f;
+
+        LSVMProblem problem(X, Y);
+        LSVMResult result;
+        LSVMMatrix predict;
+
+        LSVMKRBF rbf(1.0f);
+        LSVMParam params[2];
+        params[0].C = 1.0f;
+        params[0].MaxIterCount = 5;
+        params[0].PKernelFunc = 0;
+        params[1] = params[0];
+        params[1].PKernelFunc = &rbf;
+        const char* names[2] = { "SVM/Linear", "SVM/RBF" };
+
+        for (size_t k = 0; k < 2; k++)
+        {
+            LSVM svm(params[k]);
+
+            bench.Run((std::string(names[k]) + "/Train").c_str(), rows, 0.0, (double)rows, [&]() {
+                return svm.TrainModel(problem, result);
+            });
+            bench.Run((std::string(names[k]) + "/Predict").c_str(), rows, 0.0, (double)rows, [&]() {
+                return svm.Predict(X, predict);
+            });
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    LBenchmark bench("SVM", argc, argv);
+
+    BenchmarkSVM(bench);
+
+    return bench.Report();
+}
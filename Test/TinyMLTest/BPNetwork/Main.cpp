@@ -7,10 +7,10 @@
 /// @brief ӡ
 void MatrixPrint(IN const LNNMatrix& dataMatrix)
 {
-    printf("Matrix Row: %u  Col: %u\n", dataMatrix.RowLen, dataMatrix.ColumnLen);
-    for (unsigned int i = 0; i < dataMatrix.RowLen; i++)
+    printf("Matrix Row: %llu  Col: %llu\n", (unsigned long long)dataMatrix.RowLen, (unsigned long long)dataMatrix.ColumnLen);
+    for (size_t i = 0; i < dataMatrix.RowLen; i++)
     {
-        for (unsigned int j = 0; j < dataMatrix.ColumnLen; j++)
+        for (size_t j = 0; j < dataMatrix.ColumnLen; j++)
         {
             printf("%.2f  ", dataMatrix[i][j]);
         }
@@ -0,0 +1,794 @@
+﻿
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../../../Src/LCSVIo.h"
+#include "../../../Src/LMatrixFile.h"
+#include "../../../Src/LRegression.h"
+#include "../../../Src/LNeuralNetwork.h"
+
+/// @brief 测试使用的文件名
+static const wchar_t* TEST_FILE_NAME = L"CSVParserTest.csv";
+static const char* TEST_FILE_NAME_A = "CSVParserTest.csv";
+
+/// @brief 测试文件的缓存文件名
+static const wchar_t* CACHE_FILE_NAME = L"CSVParserTest.csv.lmx";
+static const char* CACHE_FILE_NAME_A = "CSVParserTest.csv.lmx";
+
+/// @brief 检查条件, 失败时打印信息
+#define CHECK(condition) \
+    if (!(condition)) \
+    { \
+        printf("Check Failed: %s (Line %d)\n", #condition, __LINE__); \
+        return false; \
+    }
+
+/// @brief 将文本写入测试文件
+bool WriteFile(IN const std::string& text)
+{
+    FILE* pFile = fopen(TEST_FILE_NAME_A, "wb");
+    if (pFile == 0)
+        return false;
+
+    const bool ok = fwrite(text.data(), 1, text.size(), pFile) == text.size();
+    fclose(pFile);
+    return ok;
+}
+
+/// @brief 写入测试文件并解析
+bool Load(IN const std::string& text, IN bool skipHeader, IN wchar_t delimiter, OUT LDataMatrix& data)
+{
+    if (!WriteFile(text))
+        return false;
+
+    LCSVParser parser(TEST_FILE_NAME);
+    parser.SetSkipHeader(skipHeader);
+    parser.SetDelimiter(delimiter);
+    return parser.LoadAllData(data);
+}
+
+/// @brief 测试文件格式: 首行, 空行, 行尾格式, 空白字符和BOM
+bool TestFormat()
+{
+    printf("Test Format\n");
+
+    LDataMatrix data;
+    CHECK(Load("a,b,c\n1,2,3\n4,5,6\n", true, L',', data));
+    CHECK(data.RowLen == 2 && data.ColumnLen == 3);
+    CHECK(data[0][0] == 1.0 && data[0][2] == 3.0 && data[1][0] == 4.0 && data[1][2] == 6.0);
+
+    // 不跳过首行时首行作为数据
+    CHECK(Load("1,2\n3,4", false, L',', data));
+    CHECK(data.RowLen == 2 && data.ColumnLen == 2 && data[1][1] == 4.0);
+
+    // 空行被忽略, 字段首尾的空白字符被去除, 支持\r\n
+    CHECK(Load("\r\n 1 , 2\t,3 \r\n\r\n\n4,5,6\r\n\n\n", false, L',', data));
+    CHECK(data.RowLen == 2 && data.ColumnLen == 3);
+    CHECK(data[0][0] == 1.0 && data[0][1] == 2.0 && data[0][2] == 3.0 && data[1][2] == 6.0);
+
+    // UTF-8 BOM
+    CHECK(Load("\xEF\xBB\xBF" "1.5,2\n3,4\n", false, L',', data));
+    CHECK(data.RowLen == 2 && data[0][0] == 1.5);
+
+    // 空格和制表符作为分隔符
+    CHECK(Load(" 1 2 3 \n4 5 6\n", false, L' ', data));
+    CHECK(data.RowLen == 2 && data.ColumnLen == 3 && data[0][0] == 1.0 && data[1][2] == 6.0);
+    CHECK(Load("1\t2\n3\t4\n", false, L'\t', data));
+    CHECK(data.RowLen == 2 && data.ColumnLen == 2 && data[1][0] == 3.0);
+
+    // 非法的数值只转换合法的前缀, 没有合法前缀时为0
+    CHECK(Load("1.5abc,abc,-2e1x\n", false, L',', data));
+    CHECK(data.RowLen == 1 && data[0][0] == 1.5 && data[0][1] == 0.0 && data[0][2] == -20.0);
+
+    return true;
+}
+
+/// @brief 测试格式错误的文件
+bool TestError()
+{
+    printf("Test Error\n");
+
+    LDataMatrix data;
+    CHECK(!Load("", false, L',', data));
+    CHECK(!Load("\n \n\r\n", false, L',', data));
+    CHECK(!Load("a,b\n", true, L',', data));
+
+    // 空字段
+    CHECK(!Load("1,,2\n", false, L',', data));
+    CHECK(!Load("1,2,\n", false, L',', data));
+    CHECK(!Load("1  2\n", false, L' ', data));
+
+    // 每行的字段数不一致
+    CHECK(!Load("1,2,3\n4,5\n", false, L',', data));
+    CHECK(data.RowLen == 0 && data.ColumnLen == 0);
+    CHECK(!Load("1,2\n3,4,5\n", false, L',', data));
+
+    // 非ASCII分隔符
+    CHECK(!Load("1\xEF\xBC\x8C" "2\n", false, 0xFF0C, data));
+
+    // 文件不存在
+    remove(TEST_FILE_NAME_A);
+    LCSVParser parser(TEST_FILE_NAME);
+    CHECK(!parser.LoadAllData(data));
+
+    return true;
+}
+
+/// @brief 测试数值转换, 结果与strtod完全相同
+/// 包括快速转换的数值和超出快速转换范围(有效数字过多, 指数过大)的数值
+bool TestNumber()
+{
+    printf("Test Number\n");
+
+    const size_t rowLength = 2000;
+    const size_t colLength = 8;
+
+    std::string text;
+    unsigned int state = 12345u;
+    char buffer[64];
+    for (size_t i = 0; i < rowLength; i++)
+    {
+        for (size_t j = 0; j < colLength; j++)
+        {
+            state = state * 1103515245u + 12345u;
+            const double mantissa = (double)(state >> 4) / 1048576.0 - 1024.0;
+            const int exponent = (int)((state >> 3) % 61) - 30;
+            const double value = mantissa * pow(10.0, (double)exponent);
+            switch (j)
+            {
+            case 0: sprintf(buffer, "%.17g", value); break;
+            case 1: sprintf(buffer, "%.6f", mantissa); break;
+            case 2: sprintf(buffer, "%.3e", value); break;
+            case 3: sprintf(buffer, "%d", (int)(state >> 8) - 8000000); break;
+            case 4: sprintf(buffer, "%.19e", value); break;
+            case 5: sprintf(buffer, "0.%07u", state % 10000000u); break;
+            case 6: sprintf(buffer, "+%.4fE+%d", mantissa < 0 ? -mantissa : mantissa, exponent < 0 ? -exponent : exponent); break;
+            default: sprintf(buffer, "%.25f", mantissa); break;
+            }
+            text += buffer;
+            text += (j + 1 < colLength) ? ',' : '\n';
+        }
+    }
+
+    LDataMatrix data;
+    CHECK(Load(text, false, L',', data));
+    CHECK(data.RowLen == rowLength && data.ColumnLen == colLength);
+
+    const char* p = text.c_str();
+    for (size_t i = 0; i < rowLength; i++)
+    {
+        for (size_t j = 0; j < colLength; j++)
+        {
+            char* pEnd = 0;
+            const double expected = strtod(p, &pEnd);
+            if (memcmp(&expected, &data[i][j], sizeof(double)) != 0)
+            {
+                printf("Value Mismatch: [%u][%u] %.17g %.17g\n", (unsigned int)i, (unsigned int)j, expected, data[i][j]);
+                return false;
+            }
+            p = pEnd + 1;
+        }
+    }
+
+    return true;
+}
+
+/// @brief 测试并行解析: 多个线程的结果与单个线程完全相同, 行的顺序不变
+/// 文件大于并行分段的最小大小, 每段中都有空行
+bool TestParallel()
+{
+    printf("Test Parallel\n");
+
+    std::string text = "index,double,mod\n";
+    char buffer[64];
+    const size_t rowLength = 1500000;
+    for (size_t i = 0; i < rowLength; i++)
+    {
+        sprintf(buffer, "%u,%u.5,%u\n", (unsigned int)i, (unsigned int)(2 * i), (unsigned int)(i % 3));
+        text += buffer;
+        if (i % 99991 == 5)
+            text += "\n \n";
+    }
+    CHECK(WriteFile(text));
+
+    const unsigned int threadNum = LThreadPool::Global().ThreadNum();
+    LDataMatrix serialData;
+    LDataMatrix parallelData;
+    LCSVParser parser(TEST_FILE_NAME);
+    parser.SetSkipHeader(true);
+
+    LThreadPool::Global().SetThreadNum(1);
+    bool ok = parser.LoadAllData(serialData);
+    LThreadPool::Global().SetThreadNum(4);
+    ok = parser.LoadAllData(parallelData) && ok;
+
+    // 按数据模式并行加载: 第1列为特征, 第0列为标签
+    LCSVSchema schema;
+    schema.FeatureColumns.push_back(1);
+    schema.LabelColumn = 0;
+    LMatrix<float> typedFeature;
+    LMatrix<int> typedLabel;
+    ok = parser.LoadData(schema, typedFeature, typedLabel) && ok;
+
+    // 最后一段中的行字段数不一致
+    text += "1,2\n";
+    ok = WriteFile(text) && !parser.LoadAllData(parallelData) && ok;
+    LThreadPool::Global().SetThreadNum(threadNum);
+    CHECK(ok);
+
+    CHECK(WriteFile(text.substr(0, text.size() - 4)));
+    CHECK(parser.LoadAllData(parallelData));
+    CHECK(serialData.RowLen == rowLength && serialData.ColumnLen == 3);
+    CHECK(parallelData.RowLen == rowLength && parallelData.ColumnLen == 3);
+    for (size_t i = 0; i < rowLength; i++)
+    {
+        CHECK(serialData[i][0] == (double)i && serialData[i][1] == 2.0 * i + 0.5 && serialData[i][2] == (double)(i % 3));
+        CHECK(parallelData[i][0] == serialData[i][0] && parallelData[i][1] == serialData[i][1] && parallelData[i][2] == serialData[i][2]);
+    }
+
+    CHECK(typedFeature.RowLen == rowLength && typedFeature.ColumnLen == 1);
+    CHECK(typedLabel.RowLen == rowLength && typedLabel.ColumnLen == 1);
+    for (size_t i = 0; i < rowLength; i++)
+        CHECK(typedFeature[i][0] == (float)(2.0 * i + 0.5) && typedLabel[i][0] == (int)i);
+
+    return true;
+}
+
+/// @brief 测试按数据模式加载: 列的选择和顺序, 元素类型转换, 忽略的列和错误
+bool TestSchema()
+{
+    printf("Test Schema\n");
+
+    CHECK(WriteFile("a,b,c,d\n1,2,3,4\n5,6,7,8\n\n9,10,11,12\n"));
+    LCSVParser parser(TEST_FILE_NAME);
+    parser.SetSkipHeader(true);
+
+    // 特征列按指定的顺序存入特征矩阵
+    LCSVSchema schema;
+    schema.FeatureColumns.push_back(3);
+    schema.FeatureColumns.push_back(0);
+    schema.LabelColumn = 1;
+    LMatrix<float> floatFeature;
+    LMatrix<int> intLabel;
+    CHECK(parser.LoadData(schema, floatFeature, intLabel));
+    CHECK(floatFeature.RowLen == 3 && floatFeature.ColumnLen == 2);
+    CHECK(intLabel.RowLen == 3 && intLabel.ColumnLen == 1);
+    CHECK(floatFeature[0][0] == 4.0f && floatFeature[0][1] == 1.0f && floatFeature[2][0] == 12.0f && floatFeature[2][1] == 9.0f);
+    CHECK(intLabel[0][0] == 2 && intLabel[1][0] == 6 && intLabel[2][0] == 10);
+
+    // 默认除标签列外的所有列都是特征列
+    LCSVSchema labelSchema;
+    labelSchema.LabelColumn = 2;
+    LDataMatrix doubleFeature;
+    LDataMatrix doubleLabel;
+    CHECK(parser.LoadData(labelSchema, doubleFeature, doubleLabel));
+    CHECK(doubleFeature.RowLen == 3 && doubleFeature.ColumnLen == 3);
+    CHECK(doubleFeature[1][0] == 5.0 && doubleFeature[1][1] == 6.0 && doubleFeature[1][2] == 8.0);
+    CHECK(doubleLabel.RowLen == 3 && doubleLabel[2][0] == 11.0);
+
+    // 没有标签列时标签向量为空, 结果与LoadAllData相同
+    LDataMatrix allData;
+    CHECK(parser.LoadData(LCSVSchema(), doubleFeature, doubleLabel));
+    CHECK(parser.LoadAllData(allData));
+    CHECK(doubleLabel.Empty());
+    CHECK(doubleFeature.RowLen == allData.RowLen && doubleFeature.ColumnLen == allData.ColumnLen);
+    for (size_t i = 0; i < allData.RowLen; i++)
+        for (size_t j = 0; j < allData.ColumnLen; j++)
+            CHECK(doubleFeature[i][j] == allData[i][j]);
+
+    // 列索引超出范围, 重复, 与标签列相同或者没有特征列时失败
+    schema.FeatureColumns.push_back(4);
+    CHECK(!parser.LoadData(schema, floatFeature, intLabel));
+    schema.FeatureColumns.back() = 0;
+    CHECK(!parser.LoadData(schema, floatFeature, intLabel));
+    schema.FeatureColumns.back() = 1;
+    CHECK(!parser.LoadData(schema, floatFeature, intLabel));
+    schema.FeatureColumns.pop_back();
+    schema.LabelColumn = 4;
+    CHECK(!parser.LoadData(schema, floatFeature, intLabel));
+
+    CHECK(WriteFile("7\n8\n"));
+    LCSVSchema onlyLabel;
+    onlyLabel.LabelColumn = 0;
+    parser.SetSkipHeader(false);
+    CHECK(!parser.LoadData(onlyLabel, doubleFeature, doubleLabel));
+
+    // 不使用的列不转换也不检查, 使用的列不能为空, 每行的字段数仍然必须一致
+    CHECK(WriteFile("1,,abc,2\n3,,,4\n"));
+    LCSVSchema skipSchema;
+    skipSchema.FeatureColumns.push_back(0);
+    skipSchema.LabelColumn = 3;
+    CHECK(parser.LoadData(skipSchema, floatFeature, intLabel));
+    CHECK(floatFeature.RowLen == 2 && floatFeature.ColumnLen == 1 && floatFeature[1][0] == 3.0f && intLabel[1][0] == 4);
+    skipSchema.FeatureColumns.push_back(1);
+    CHECK(!parser.LoadData(skipSchema, floatFeature, intLabel));
+    CHECK(WriteFile("1,,abc,2\n3,,4\n"));
+    skipSchema.FeatureColumns.pop_back();
+    CHECK(!parser.LoadData(skipSchema, floatFeature, intLabel));
+
+    // 转换为int时截断小数部分, 超出范围时取最近的边界
+    CHECK(WriteFile("2.7,-2.7,1e20,-1e20\n"));
+    LMatrix<int> intFeature;
+    CHECK(parser.LoadData(LCSVSchema(), intFeature, intLabel));
+    CHECK(intFeature.RowLen == 1 && intFeature.ColumnLen == 4 && intLabel.Empty());
+    CHECK(intFeature[0][0] == 2 && intFeature[0][1] == -2 && intFeature[0][2] == 2147483647 && intFeature[0][3] == (-2147483647 - 1));
+
+    return true;
+}
+
+/// @brief 生成批量读取的测试数据
+/// 第i行为(i, 2i, i % 3), 包含首行, 空行和\r\n
+std::string BatchText(IN size_t rowLength)
+{
+    std::string text = "index,double,mod\r\n";
+    char buffer[64];
+    for (size_t i = 0; i < rowLength; i++)
+    {
+        sprintf(buffer, "%u,%u,%u\r\n", (unsigned int)i, (unsigned int)(2 * i), (unsigned int)(i % 3));
+        text += buffer;
+        if (i % 100 == 7)
+            text += "\r\n";
+    }
+    return text;
+}
+
+/// @brief 读取所有批次, 检查每个批次的大小和每一行的数据
+/// @param[out] indexList 按读取顺序的行号
+bool ReadAllBatch(INOUT LCSVBatchReader& reader, IN size_t batchSize, OUT std::vector<size_t>& indexList)
+{
+    indexList.clear();
+
+    LDataMatrix batch;
+    while (reader.NextBatch(batch))
+    {
+        CHECK(batch.ColumnLen == 3 && batch.RowLen > 0 && batch.RowLen <= batchSize);
+        for (size_t i = 0; i < batch.RowLen; i++)
+        {
+            const size_t index = (size_t)batch[i][0];
+            CHECK(batch[i][1] == 2.0 * index && batch[i][2] == (double)(index % 3));
+            indexList.push_back(index);
+        }
+    }
+    CHECK(!reader.Failed());
+    CHECK(batch.RowLen == 0);
+
+    return true;
+}
+
+/// @brief 测试批量读取: 顺序读取, 窗口边界, 洗牌和错误
+bool TestBatchReader()
+{
+    printf("Test Batch Reader\n");
+
+    const size_t rowLength = 1000;
+    CHECK(WriteFile(BatchText(rowLength)));
+
+    // 顺序读取, 窗口很小时行和批次都跨越多个窗口, 窗口小于一行时自动扩大
+    const size_t windowSizeList[3] = { 16 * 1024 * 1024, 100, 3 };
+    for (size_t w = 0; w < 3; w++)
+    {
+        LCSVBatchReader reader(TEST_FILE_NAME);
+        reader.SetSkipHeader(true);
+        reader.SetBatchSize(64);
+        reader.SetWindowSize(windowSizeList[w]);
+
+        std::vector<size_t> indexList;
+        CHECK(ReadAllBatch(reader, 64, indexList));
+        CHECK(indexList.size() == rowLength);
+        for (size_t i = 0; i < rowLength; i++)
+            CHECK(indexList[i] == i);
+
+        // 下一轮
+        reader.Rewind();
+        CHECK(ReadAllBatch(reader, 64, indexList));
+        CHECK(indexList.size() == rowLength);
+    }
+
+    // 洗牌: 每一行只出现一次, 并且顺序被打乱
+    LCSVBatchReader reader(TEST_FILE_NAME);
+    reader.SetSkipHeader(true);
+    reader.SetBatchSize(50);
+    reader.SetShuffleBuffer(300, 7);
+    reader.SetWindowSize(1000);
+
+    std::vector<size_t> firstList;
+    CHECK(ReadAllBatch(reader, 50, firstList));
+    CHECK(firstList.size() == rowLength);
+    std::vector<bool> found(rowLength, false);
+    size_t moved = 0;
+    for (size_t i = 0; i < rowLength; i++)
+    {
+        CHECK(firstList[i] < rowLength && !found[firstList[i]]);
+        found[firstList[i]] = true;
+        if (firstList[i] != i)
+            moved++;
+    }
+    CHECK(moved > rowLength / 2);
+
+    // 每一轮的顺序不同
+    std::vector<size_t> secondList;
+    reader.Rewind();
+    CHECK(ReadAllBatch(reader, 50, secondList));
+    CHECK(secondList.size() == rowLength && secondList != firstList);
+
+    // 文件中间的行字段数不一致
+    std::string text = BatchText(rowLength);
+    text += "1,2\n";
+    text += BatchText(10);
+    CHECK(WriteFile(text));
+    LCSVBatchReader badReader(TEST_FILE_NAME);
+    badReader.SetBatchSize(64);
+    badReader.SetSkipHeader(true);
+    LDataMatrix batch;
+    size_t batchNum = 0;
+    while (badReader.NextBatch(batch))
+        batchNum++;
+    CHECK(badReader.Failed());
+    CHECK(batchNum == rowLength / 64);
+
+    // 文件不存在
+    remove(TEST_FILE_NAME_A);
+    LCSVBatchReader missingReader(TEST_FILE_NAME);
+    CHECK(!missingReader.NextBatch(batch) && missingReader.Failed());
+
+    return true;
+}
+
+/// @brief 测试使用批次直接训练模型
+/// 批次的子矩阵视图作为样本矩阵和标记向量, 不复制数据
+bool TestBatchTrain()
+{
+    printf("Test Batch Train\n");
+
+    // 两个特征, x0 + x1 > 1时标记为1
+    std::string text;
+    char buffer[64];
+    unsigned int state = 2024u;
+    for (size_t i = 0; i < 2000; i++)
+    {
+        state = state * 1103515245u + 12345u;
+        const double x0 = (double)((state >> 8) % 1000) / 1000.0;
+        state = state * 1103515245u + 12345u;
+        const double x1 = (double)((state >> 8) % 1000) / 1000.0;
+        sprintf(buffer, "%.3f,%.3f,%d\n", x0, x1, (x0 + x1 > 1.0) ? 1 : 0);
+        text += buffer;
+    }
+    CHECK(WriteFile(text));
+
+    LCSVBatchReader reader(TEST_FILE_NAME);
+    reader.SetBatchSize(100);
+    reader.SetShuffleBuffer(1000, 1);
+
+    LLogisticRegression logistic;
+    LBPNetworkPogology pogology;
+    pogology.InputNumber = 2;
+    pogology.OutputNumber = 1;
+    pogology.HiddenLayerNumber = 1;
+    pogology.NeuronsOfHiddenLayer = 4;
+    LBPNetwork network(pogology);
+
+    LDataMatrix batch;
+    for (size_t epoch = 0; epoch < 20; epoch++)
+    {
+        reader.Rewind();
+        while (reader.NextBatch(batch))
+        {
+            const LMatrixView<double> xMatrix = batch.SubMatrix(0, batch.RowLen, 0, 2);
+            const LMatrixView<double> yVector = batch.SubMatrix(0, batch.RowLen, 2, 1);
+            CHECK(logistic.TrainModel(xMatrix, yVector, 1.0));
+            CHECK(network.Train(xMatrix, yVector, 0.5f));
+        }
+        CHECK(!reader.Failed());
+    }
+
+    LDataMatrix data;
+    LCSVParser parser(TEST_FILE_NAME);
+    CHECK(parser.LoadAllData(data));
+    const double score = logistic.Score(data.SubMatrix(0, data.RowLen, 0, 2), data.SubMatrix(0, data.RowLen, 2, 1));
+    printf("Logistic Regression Score: %f\n", score);
+    CHECK(score > 0.9);
+
+    return true;
+}
+
+/// @brief 使用缓存加载测试文件
+bool LoadCache(IN bool skipHeader, IN wchar_t delimiter, OUT LDataMatrix& data)
+{
+    LCSVParser parser(TEST_FILE_NAME);
+    parser.SetSkipHeader(skipHeader);
+    parser.SetDelimiter(delimiter);
+    parser.SetCache(true);
+    return parser.LoadAllData(data);
+}
+
+/// @brief 测试缓存文件: 生成, 映射, 失效和写时复制
+bool TestCache()
+{
+    printf("Test Cache\n");
+
+    remove(CACHE_FILE_NAME_A);
+    CHECK(WriteFile("a,b\n1,2\n3,4\n"));
+
+    // 第一次加载解析源文件并生成缓存
+    LDataMatrix data;
+    CHECK(LoadCache(true, L',', data));
+    CHECK(!data.Mapped());
+    CHECK(data.RowLen == 2 && data.ColumnLen == 2 && data[1][1] == 4.0);
+    LMatrixFileHeader header;
+    CHECK(LMatrixFile<double>::ReadHeader(CACHE_FILE_NAME, header));
+    CHECK(header.RowLen == 2 && header.ColumnLen == 2);
+
+    // 第二次加载直接映射缓存
+    LDataMatrix cached;
+    CHECK(LoadCache(true, L',', cached));
+    CHECK(cached.Mapped());
+    CHECK(cached.RowLen == 2 && cached.ColumnLen == 2);
+    CHECK(cached[0][0] == 1.0 && cached[0][1] == 2.0 && cached[1][0] == 3.0 && cached[1][1] == 4.0);
+
+    // 修改映射的矩阵不会修改缓存文件
+    cached[0][0] = 9.0;
+    CHECK(cached[0][0] == 9.0);
+    cached.Reset(0, 0);
+    CHECK(LoadCache(true, L',', cached));
+    CHECK(cached.Mapped() && cached[0][0] == 1.0);
+    cached.Reset(0, 0);
+
+    // 不使用缓存时总是解析源文件
+    LCSVParser parser(TEST_FILE_NAME);
+    parser.SetSkipHeader(true);
+    CHECK(parser.LoadAllData(data));
+    CHECK(!data.Mapped());
+
+    // 解析选项改变后缓存失效
+    CHECK(LoadCache(false, L',', data));
+    CHECK(!data.Mapped());
+    CHECK(data.RowLen == 3 && data[0][0] == 0.0 && data[2][1] == 4.0);
+    CHECK(LoadCache(false, L',', data));
+    CHECK(data.Mapped() && data.RowLen == 3);
+    data.Reset(0, 0);
+    CHECK(LoadCache(true, L',', data));
+    CHECK(!data.Mapped() && data.RowLen == 2);
+    data.Reset(0, 0);
+
+    // 源文件改变后缓存失效
+    CHECK(WriteFile("a,b\n1,2\n3,4\n5,6\n"));
+    CHECK(LoadCache(true, L',', data));
+    CHECK(!data.Mapped());
+    CHECK(data.RowLen == 3 && data[2][0] == 5.0 && data[2][1] == 6.0);
+    data.Reset(0, 0);
+
+    // 没有键值的缓存文件无效
+    CHECK(LMatrixFile<double>::Save(CACHE_FILE_NAME, LDataMatrix(1, 1, 0.0)));
+    CHECK(LoadCache(true, L',', data));
+    CHECK(!data.Mapped() && data.RowLen == 3);
+    data.Reset(0, 0);
+
+    // 解析失败时不生成缓存
+    remove(CACHE_FILE_NAME_A);
+    CHECK(WriteFile("1,2\n3\n"));
+    CHECK(!LoadCache(false, L',', data));
+    CHECK(!LMatrixFile<double>::ReadHeader(CACHE_FILE_NAME, header));
+
+    remove(CACHE_FILE_NAME_A);
+    return true;
+}
+
+/// @brief 判断两个稀疏矩阵是否完全相同
+bool SparseEqual(IN const LDataSparseMatrix& A, IN const LDataSparseMatrix& B)
+{
+    if (A.RowLen != B.RowLen || A.ColumnLen != B.ColumnLen || A.NonZeroNum() != B.NonZeroNum())
+        return false;
+
+    for (size_t i = 0; i < A.RowLen; i++)
+    {
+        const size_t nonZeroNum = A.RowNonZeroNum(i);
+        if (B.RowNonZeroNum(i) != nonZeroNum)
+            return false;
+        for (size_t j = 0; j < nonZeroNum; j++)
+        {
+            if (A.RowColumnIndex(i)[j] != B.RowColumnIndex(i)[j] || A.RowValue(i)[j] != B.RowValue(i)[j])
+                return false;
+        }
+    }
+
+    return true;
+}
+
+/// @brief 写入svmlight格式的测试文件并加载
+bool LoadSVMLight(IN const std::string& text, IN bool zeroBased, IN size_t featureNum, OUT LDataSparseMatrix& X, OUT LDataMatrix& y)
+{
+    if (!WriteFile(text))
+        return false;
+
+    LSVMLightReader reader(TEST_FILE_NAME);
+    reader.SetZeroBased(zeroBased);
+    reader.SetFeatureNum(featureNum);
+    return reader.LoadAllData(X, y);
+}
+
+/// @brief 生成svmlight格式的测试数据
+/// 第i行的标签为i % 2, 特征为(i % 7 + 1):i, (i % 7 + 3):0.5, 每隔一段插入空行和注释行
+std::string SVMLightText(IN size_t rowLength)
+{
+    std::string text = "# svmlight test\n";
+    char buffer[96];
+    for (size_t i = 0; i < rowLength; i++)
+    {
+        sprintf(buffer, "%u %u:%u %u:0.5\n", (unsigned int)(i % 2), (unsigned int)(i % 7 + 1), (unsigned int)i, (unsigned int)(i % 7 + 3));
+        text += buffer;
+        if (i % 997 == 3)
+            text += "\n# comment\n";
+    }
+    return text;
+}
+
+/// @brief 检查SVMLightText生成的数据
+bool CheckSVMLight(IN const LDataSparseMatrix& X, IN const LDataMatrix& y, IN size_t rowStart, IN size_t rowLength)
+{
+    CHECK(X.RowLen == rowLength && y.RowLen == rowLength && y.ColumnLen == 1);
+    for (size_t r = 0; r < rowLength; r++)
+    {
+        const size_t i = rowStart + r;
+        CHECK(y[r][0] == (double)(i % 2));
+        CHECK(X.RowNonZeroNum(r) == 2);
+        CHECK(X.RowColumnIndex(r)[0] == i % 7 && X.RowValue(r)[0] == (double)i);
+        CHECK(X.RowColumnIndex(r)[1] == i % 7 + 2 && X.RowValue(r)[1] == 0.5);
+    }
+    return true;
+}
+
+/// @brief 测试svmlight格式: 格式, 索引, 特征数和错误
+bool TestSVMLight()
+{
+    printf("Test SVMLight\n");
+
+    LDataSparseMatrix X;
+    LDataMatrix y;
+    CHECK(LoadSVMLight("1 1:0.5 3:2\n-1\t2:1.5 # comment\n\n# comment line\n+1 qid:3 1:1e-3 4:7\r\n0\n", false, 0, X, y));
+    CHECK(X.RowLen == 4 && X.ColumnLen == 4 && X.NonZeroNum() == 5);
+    CHECK(X.At(0, 0) == 0.5 && X.At(0, 1) == 0.0 && X.At(0, 2) == 2.0 && X.At(1, 1) == 1.5);
+    CHECK(X.At(2, 0) == 1e-3 && X.At(2, 3) == 7.0 && X.RowNonZeroNum(3) == 0);
+    CHECK(y.RowLen == 4 && y.ColumnLen == 1);
+    CHECK(y[0][0] == 1.0 && y[1][0] == -1.0 && y[2][0] == 1.0 && y[3][0] == 0.0);
+
+    // 索引从0开始
+    CHECK(LoadSVMLight("2 0:1 2:3\n", true, 0, X, y));
+    CHECK(X.RowLen == 1 && X.ColumnLen == 3 && X.At(0, 0) == 1.0 && X.At(0, 2) == 3.0 && y[0][0] == 2.0);
+
+    // 指定特征数, 索引超出特征数时出错
+    CHECK(LoadSVMLight("1 1:1 3:3\n", false, 10, X, y));
+    CHECK(X.ColumnLen == 10);
+    CHECK(!LoadSVMLight("1 1:1 4:3\n", false, 3, X, y));
+
+    // 没有特征时列数为1
+    CHECK(LoadSVMLight("1\n-1\n", false, 0, X, y));
+    CHECK(X.RowLen == 2 && X.ColumnLen == 1 && X.NonZeroNum() == 0);
+
+    // 数据格式错误
+    CHECK(!LoadSVMLight("1 2:1 1:2\n", false, 0, X, y));
+    CHECK(!LoadSVMLight("1 1:1 1:2\n", false, 0, X, y));
+    CHECK(!LoadSVMLight("1 0:1\n", false, 0, X, y));
+    CHECK(!LoadSVMLight("1 a:1\n", false, 0, X, y));
+    CHECK(!LoadSVMLight("1 1:\n", false, 0, X, y));
+    CHECK(!LoadSVMLight("1 1 :2\n", false, 0, X, y));
+    CHECK(!LoadSVMLight("1 1:2x\n", false, 0, X, y));
+    CHECK(!LoadSVMLight("abc 1:1\n", false, 0, X, y));
+    CHECK(!LoadSVMLight("1 99999999999999999999:1\n", false, 0, X, y));
+    CHECK(!LoadSVMLight("", false, 0, X, y));
+    CHECK(!LoadSVMLight("# only comment\n\n", false, 0, X, y));
+    LSVMLightReader missingReader(L"NotExist.svm");
+    CHECK(!missingReader.LoadAllData(X, y));
+
+    // 写入后读回的数据完全相同
+    LDataMatrix dense(5, 6, 0.0);
+    dense[0][0] = 0.1;
+    dense[0][5] = 1.0 / 3.0;
+    dense[2][1] = -2.5e17;
+    dense[2][2] = 1e-300;
+    dense[4][3] = 123456789.0;
+    const LDataSparseMatrix source(dense);
+    LDataMatrix label(5, 1, 0.0);
+    label[1][0] = -1.0;
+    label[3][0] = 0.7;
+    for (int zeroBased = 0; zeroBased < 2; zeroBased++)
+    {
+        CHECK(LSVMLightWriter::Save(TEST_FILE_NAME, source, label, zeroBased != 0));
+        LSVMLightReader reader(TEST_FILE_NAME);
+        reader.SetZeroBased(zeroBased != 0);
+        reader.SetFeatureNum(6);
+        CHECK(reader.LoadAllData(X, y));
+        CHECK(SparseEqual(X, source));
+        for (size_t i = 0; i < 5; i++)
+            CHECK(y[i][0] == label[i][0]);
+    }
+    CHECK(!LSVMLightWriter::Save(TEST_FILE_NAME, source, LDataMatrix(4, 1, 0.0)));
+    CHECK(!LSVMLightWriter::Save(TEST_FILE_NAME, LDataSparseMatrix(), label));
+
+    return true;
+}
+
+/// @brief 测试svmlight格式的并行加载和批量读取
+bool TestSVMLightParallel()
+{
+    printf("Test SVMLight Parallel\n");
+
+    // 大约13MB, 4个线程时分为3段
+    const size_t rowLength = 800000;
+    CHECK(WriteFile(SVMLightText(rowLength)));
+
+    const unsigned int threadNum = LThreadPool::Global().ThreadNum();
+    LDataSparseMatrix serialX;
+    LDataSparseMatrix parallelX;
+    LDataMatrix serialY;
+    LDataMatrix parallelY;
+    LSVMLightReader reader(TEST_FILE_NAME);
+    LThreadPool::Global().SetThreadNum(1);
+    bool ok = reader.LoadAllData(serialX, serialY);
+    LThreadPool::Global().SetThreadNum(4);
+    ok = reader.LoadAllData(parallelX, parallelY) && ok;
+    LThreadPool::Global().SetThreadNum(threadNum);
+    CHECK(ok);
+
+    CHECK(serialX.ColumnLen == 9);
+    CHECK(CheckSVMLight(serialX, serialY, 0, rowLength));
+    CHECK(SparseEqual(serialX, parallelX));
+    for (size_t i = 0; i < rowLength; i++)
+        CHECK(parallelY[i][0] == serialY[i][0]);
+
+    // 按批次读取, 窗口很小时行跨越窗口边界
+    CHECK(WriteFile(SVMLightText(3000)));
+    LSVMLightReader batchReader(TEST_FILE_NAME);
+    batchReader.SetBatchSize(64);
+    batchReader.SetWindowSize(256);
+    batchReader.SetFeatureNum(9);
+    LDataSparseMatrix batch;
+    LDataMatrix label;
+    for (int epoch = 0; epoch < 2; epoch++)
+    {
+        batchReader.Rewind();
+        size_t rowStart = 0;
+        while (batchReader.NextBatch(batch, label))
+        {
+            CHECK(batch.ColumnLen == 9 && batch.RowLen <= 64);
+            CHECK(CheckSVMLight(batch, label, rowStart, batch.RowLen));
+            rowStart += batch.RowLen;
+        }
+        CHECK(!batchReader.Failed() && rowStart == 3000 && batch.Empty());
+    }
+
+    // 数据格式错误和没有数据时出错
+    CHECK(WriteFile(SVMLightText(200) + "1 3:1 2:1\n"));
+    batchReader.Rewind();
+    while (batchReader.NextBatch(batch, label))
+    {
+    }
+    CHECK(batchReader.Failed());
+    CHECK(WriteFile("# comment\n"));
+    batchReader.Rewind();
+    CHECK(!batchReader.NextBatch(batch, label) && batchReader.Failed());
+
+    return true;
+}
+
+int main()
+{
+    bool ok = TestFormat();
+    ok = TestError() && ok;
+    ok = TestNumber() && ok;
+    ok = TestParallel() && ok;
+    ok = TestSchema() && ok;
+    ok = TestBatchReader() && ok;
+    ok = TestBatchTrain() && ok;
+    ok = TestCache() && ok;
+    ok = TestSVMLight() && ok;
+    ok = TestSVMLightParallel() && ok;
+
+    remove(TEST_FILE_NAME_A);
+
+    printf("CSV Parser Test: %s\n", ok ? "OK" : "Failed");
+    return ok ? 0 : 1;
+}
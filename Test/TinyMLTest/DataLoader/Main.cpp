@@ -0,0 +1,267 @@
+﻿
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../../../Src/LDataLoader.h"
+#include "../../../Src/LCSVIo.h"
+#include "../../../Src/LRegression.h"
+
+/// @brief 测试使用的文件名
+static const wchar_t* TEST_FILE_NAME = L"DataLoaderTest.csv";
+static const char* TEST_FILE_NAME_A = "DataLoaderTest.csv";
+
+/// @brief 检查条件, 失败时打印信息
+#define CHECK(condition) \
+    if (!(condition)) \
+    { \
+        printf("Check Failed: %s (Line %d)\n", #condition, __LINE__); \
+        return false; \
+    }
+
+/// @brief 测试使用的批次, 第i个批次为i行4列, 元素都为i
+typedef LMatrix<int> LTestBatch;
+
+/// @brief 测试批次的顺序, 内容和缓冲区的重复使用
+bool TestOrder(IN size_t bufferNum)
+{
+    printf("Test Order (buffers: %u)\n", (unsigned int)bufferNum);
+
+    const int batchNum = 200;
+    int produced = 0;
+    LDataLoader<LTestBatch> loader([&](LTestBatch& batch)
+    {
+        if (produced >= batchNum)
+            return false;
+
+        produced++;
+        batch.Reset((size_t)produced, 4, produced);
+        return true;
+    }, bufferNum);
+    CHECK(loader.BufferNum() == (bufferNum < 2 ? 2 : bufferNum));
+
+    // 没有开始时没有批次
+    CHECK(loader.Next() == 0);
+
+    std::vector<const LTestBatch*> addressList;
+    for (int round = 0; round < 2; round++)
+    {
+        produced = 0;
+        loader.Start();
+
+        int consumed = 0;
+        while (LTestBatch* pBatch = loader.Next())
+        {
+            consumed++;
+            CHECK(pBatch->RowLen == (size_t)consumed && pBatch->ColumnLen == 4);
+
+            // 持有的批次不会被后台线程修改
+            if (consumed % 50 == 0)
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            for (size_t i = 0; i < pBatch->RowLen; i++)
+                CHECK((*pBatch)[i][0] == consumed && (*pBatch)[i][3] == consumed);
+
+            bool found = false;
+            for (size_t i = 0; i < addressList.size(); i++)
+                found = found || addressList[i] == pBatch;
+            if (!found)
+                addressList.push_back(pBatch);
+        }
+        CHECK(consumed == batchNum);
+        CHECK(loader.Next() == 0);
+    }
+
+    // 只使用固定个数的缓冲区
+    CHECK(addressList.size() <= loader.BufferNum());
+
+    return true;
+}
+
+/// @brief 测试读取和计算重叠执行
+/// 读取和计算都需要10ms时, 串行执行需要20ms * 批次数, 重叠执行接近10ms * 批次数
+bool TestOverlap()
+{
+    printf("Test Overlap\n");
+
+    const int batchNum = 20;
+    int produced = 0;
+    LDataLoader<LTestBatch> loader([&](LTestBatch& batch)
+    {
+        if (produced >= batchNum)
+            return false;
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        produced++;
+        batch.Reset(1, 1, produced);
+        return true;
+    });
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    loader.Start();
+    int consumed = 0;
+    while (LTestBatch* pBatch = loader.Next())
+    {
+        consumed++;
+        CHECK((*pBatch)[0][0] == consumed);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    printf("Overlap Time: %.1fms (Serial: %dms)\n", ms, batchNum * 20);
+
+    CHECK(consumed == batchNum);
+    CHECK(ms < batchNum * 20 * 0.8);
+
+    return true;
+}
+
+/// @brief 测试提前停止, 重新开始和生产函数抛出异常
+bool TestStop()
+{
+    printf("Test Stop\n");
+
+    int produced = 0;
+    int throwAt = -1;
+    LDataLoader<LTestBatch> loader([&](LTestBatch& batch)
+    {
+        produced++;
+        if (produced == throwAt)
+            throw std::runtime_error("read error");
+
+        batch.Reset(1, 1, produced);
+        return true;
+    });
+
+    // 数据源没有结束, 提前停止后不再有批次, 生产函数不再被调用
+    loader.Start();
+    for (int i = 1; i <= 3; i++)
+    {
+        LTestBatch* pBatch = loader.Next();
+        CHECK(pBatch != 0 && (*pBatch)[0][0] == i);
+    }
+    loader.Stop();
+    CHECK(loader.Next() == 0);
+    const int stopProduced = produced;
+    CHECK(stopProduced >= 3 && stopProduced <= 3 + (int)loader.BufferNum());
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    CHECK(produced == stopProduced);
+
+    // 重新开始时丢弃停止前填充的批次
+    produced = 0;
+    loader.Start();
+    LTestBatch* pBatch = loader.Next();
+    CHECK(pBatch != 0 && (*pBatch)[0][0] == 1);
+
+    // 异常在调用线程中重新抛出, 之前的批次正常返回
+    produced = 0;
+    throwAt = 5;
+    loader.Start();
+    int consumed = 0;
+    bool caught = false;
+    try
+    {
+        while (loader.Next() != 0)
+            consumed++;
+    }
+    catch (const std::runtime_error&)
+    {
+        caught = true;
+    }
+    CHECK(caught && consumed == 4);
+    CHECK(loader.Next() == 0);
+
+    // 析构时停止正在加载的后台线程
+    throwAt = -1;
+    loader.Start();
+    CHECK(loader.Next() != 0);
+
+    return true;
+}
+
+/// @brief 训练使用的批次
+struct LTrainBatch
+{
+    LDataMatrix Data; ///< 读取的数据
+    LDataMatrix XMatrix; ///< 样本矩阵
+    LDataMatrix YVector; ///< 标签向量
+};
+
+/// @brief 测试使用加载器训练模型
+/// 后台线程读取CSV批次并拆分为样本矩阵和标签向量, 调用线程训练逻辑回归模型
+bool TestTrain()
+{
+    printf("Test Train\n");
+
+    // 两个特征, x0 + x1 > 1时标记为1
+    std::string text;
+    char buffer[64];
+    unsigned int state = 2024u;
+    for (size_t i = 0; i < 2000; i++)
+    {
+        state = state * 1103515245u + 12345u;
+        const double x0 = (double)((state >> 8) % 1000) / 1000.0;
+        state = state * 1103515245u + 12345u;
+        const double x1 = (double)((state >> 8) % 1000) / 1000.0;
+        sprintf(buffer, "%.3f,%.3f,%d\n", x0, x1, (x0 + x1 > 1.0) ? 1 : 0);
+        text += buffer;
+    }
+    FILE* pFile = fopen(TEST_FILE_NAME_A, "wb");
+    CHECK(pFile != 0);
+    fwrite(text.data(), 1, text.size(), pFile);
+    fclose(pFile);
+
+    LCSVBatchReader reader(TEST_FILE_NAME);
+    reader.SetBatchSize(100);
+    reader.SetShuffleBuffer(1000, 1);
+    LDataLoader<LTrainBatch> loader([&](LTrainBatch& batch)
+    {
+        if (!reader.NextBatch(batch.Data))
+            return false;
+
+        batch.Data.SubMatrix(0, batch.Data.RowLen, 0, 2, batch.XMatrix);
+        batch.Data.SubMatrix(0, batch.Data.RowLen, 2, 1, batch.YVector);
+        return true;
+    });
+
+    LLogisticRegression logistic;
+    for (size_t epoch = 0; epoch < 20; epoch++)
+    {
+        reader.Rewind();
+        loader.Start();
+
+        size_t rowLength = 0;
+        while (LTrainBatch* pBatch = loader.Next())
+        {
+            CHECK(logistic.TrainModel(pBatch->XMatrix, pBatch->YVector, 1.0));
+            rowLength += pBatch->XMatrix.RowLen;
+        }
+        CHECK(!reader.Failed() && rowLength == 2000);
+    }
+
+    LDataMatrix data;
+    LCSVParser parser(TEST_FILE_NAME);
+    CHECK(parser.LoadAllData(data));
+    const double score = logistic.Score(data.SubMatrix(0, data.RowLen, 0, 2), data.SubMatrix(0, data.RowLen, 2, 1));
+    printf("Logistic Regression Score: %f\n", score);
+    CHECK(score > 0.9);
+
+    return true;
+}
+
+int main()
+{
+    bool ok = TestOrder(0);
+    ok = TestOrder(2) && ok;
+    ok = TestOrder(4) && ok;
+    ok = TestOverlap() && ok;
+    ok = TestStop() && ok;
+    ok = TestTrain() && ok;
+
+    remove(TEST_FILE_NAME_A);
+
+    printf("Data Loader Test: %s\n", ok ? "OK" : "Failed");
+    return ok ? 0 : 1;
+}
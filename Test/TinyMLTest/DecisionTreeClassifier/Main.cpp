@@ -10,10 +10,10 @@
 /// @brief ӡ
 void MatrixPrint(IN const LDataMatrix& dataMatrix)
 {
-    printf("Matrix Row: %u  Col: %u\n", dataMatrix.RowLen, dataMatrix.ColumnLen);
-    for (unsigned int i = 0; i < dataMatrix.RowLen; i++)
+    printf("Matrix Row: %llu  Col: %llu\n", (unsigned long long)dataMatrix.RowLen, (unsigned long long)dataMatrix.ColumnLen);
+    for (size_t i = 0; i < dataMatrix.RowLen; i++)
     {
-        for (unsigned int j = 0; j < dataMatrix.ColumnLen; j++)
+        for (size_t j = 0; j < dataMatrix.ColumnLen; j++)
         {
             printf("%.2f  ", dataMatrix[i][j]);
         }
@@ -26,6 +26,7 @@ int main()
 {
     // ݼ
     LCSVParser csvParser(L"../../../DataSet/iris.csv");
+    csvParser.SetCache(true);
     csvParser.SetSkipHeader(true);
     LDataMatrix dataMatrix;
     csvParser.LoadAllData(dataMatrix);
@@ -34,7 +35,7 @@ int main()
     DoubleMatrixShuffle(0, dataMatrix);
 
     // ݼΪѵͲԼ, Լռܼϵ20%
-    unsigned int testSize = (unsigned int)(dataMatrix.RowLen * 0.2);
+    size_t testSize = (size_t)(dataMatrix.RowLen * 0.2);
     LDTMatrix testData;
     LDTMatrix trainData;
     dataMatrix.SplitRow(testSize, testData, trainData);
@@ -9,10 +9,10 @@
 /// @brief ӡ
 void MatrixPrint(IN const LDataMatrix& dataMatrix)
 {
-    printf("Matrix Row: %u  Col: %u\n", dataMatrix.RowLen, dataMatrix.ColumnLen);
-    for (unsigned int i = 0; i < dataMatrix.RowLen; i++)
+    printf("Matrix Row: %llu  Col: %llu\n", (unsigned long long)dataMatrix.RowLen, (unsigned long long)dataMatrix.ColumnLen);
+    for (size_t i = 0; i < dataMatrix.RowLen; i++)
     {
-        for (unsigned int j = 0; j < dataMatrix.ColumnLen; j++)
+        for (size_t j = 0; j < dataMatrix.ColumnLen; j++)
         {
             printf("%.2f  ", dataMatrix[i][j]);
         }
@@ -26,17 +26,19 @@ void TestDecisionTreeRegression()
 {
     // ݼ
     LCSVParser dataCSVParser(L"../../../DataSet/diabetes_data.csv");
+    dataCSVParser.SetCache(true);
     dataCSVParser.SetDelimiter(L' ');
     LDataMatrix xMatrix;
     dataCSVParser.LoadAllData(xMatrix);
     LCSVParser targetCSVParser(L"../../../DataSet/diabetes_target.csv");
+    targetCSVParser.SetCache(true);
     LDataMatrix yVector;
     targetCSVParser.LoadAllData(yVector);
 
     DoubleMatrixShuffle(0, xMatrix, yVector);
 
     // Ϊѵ֤, 20%Ϊ֤
-    unsigned int verifySampleCount = (unsigned int)(xMatrix.RowLen * 0.2);
+    size_t verifySampleCount = (size_t)(xMatrix.RowLen * 0.2);
     LDTMatrix verifyXMatrix;
     LDTMatrix trainXMatrix;
     xMatrix.SubMatrix(0, verifySampleCount, 0, xMatrix.ColumnLen, verifyXMatrix);
@@ -0,0 +1,162 @@
+﻿
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+
+#include "../../../Src/LFixedMatrix.h"
+#include "../../../Src/LSVM.h"
+
+/// @brief 检查条件, 失败时打印信息
+#define CHECK(condition) \
+    if (!(condition)) \
+    { \
+        printf("Check Failed: %s (Line %d)\n", #condition, __LINE__); \
+        return false; \
+    }
+
+/// @brief 计算固定大小矩阵和普通矩阵的最大元素差
+template<typename Type, size_t M, size_t N>
+Type MaxDiff(IN const LFixedMatrix<Type, M, N>& A, IN const LMatrix<Type>& B)
+{
+    if (B.RowLen != M || B.ColumnLen != N)
+        return (Type)1e30;
+
+    Type diff = 0;
+    for (size_t i = 0; i < M; i++)
+    {
+        for (size_t j = 0; j < N; j++)
+        {
+            if (std::fabs(A[i][j] - B[i][j]) > diff)
+                diff = std::fabs(A[i][j] - B[i][j]);
+        }
+    }
+    return diff;
+}
+
+/// @brief 生成确定的伪随机矩阵
+template<typename Type, size_t M, size_t N>
+void RandomMatrix(IN unsigned int seed, OUT LFixedMatrix<Type, M, N>& A)
+{
+    unsigned int state = seed;
+    for (size_t i = 0; i < M; i++)
+    {
+        for (size_t j = 0; j < N; j++)
+        {
+            state = state * 1103515245u + 12345u;
+            A[i][j] = (Type)((state >> 8) % 2001) / (Type)1000 - (Type)1;
+        }
+    }
+}
+
+/// @brief 测试固定大小矩阵的运算, 结果与LMatrix的运算相同
+/// M * N 大于展开阈值时测试不展开的循环
+template<typename Type, size_t M, size_t K, size_t N>
+bool TestFixedMatrix(IN Type tolerance)
+{
+    typedef LFixedMatrix<Type, M, N> FixedMatrix;
+    CHECK(FixedMatrix::RowLen == M && FixedMatrix::ColumnLen == N && FixedMatrix::Size == M * N);
+    CHECK(sizeof(FixedMatrix) == sizeof(Type) * M * N);
+
+    FixedMatrix A;
+    FixedMatrix B;
+    RandomMatrix(1, A);
+    RandomMatrix(2, B);
+    const LMatrix<Type> a(A.View());
+    const LMatrix<Type> b(B.View());
+    CHECK(MaxDiff(A, a) == (Type)0);
+
+    FixedMatrix C;
+    LMatrix<Type> c;
+    FixedMatrix::ADD(A, B, C);
+    LMatrix<Type>::ADD(a, b, c);
+    CHECK(MaxDiff(C, c) < tolerance);
+
+    FixedMatrix::SUB(A, B, C);
+    LMatrix<Type>::SUB(a, b, c);
+    CHECK(MaxDiff(C, c) < tolerance);
+
+    FixedMatrix::DOTMUL(A, B, C);
+    LMatrix<Type>::DOTMUL(a, b, c);
+    CHECK(MaxDiff(C, c) < tolerance);
+
+    // 结果矩阵和输入矩阵相同
+    FixedMatrix::SCALARMUL(C, (Type)2, C);
+    LMatrix<Type>::SCALARMUL(c, (Type)2, c);
+    CHECK(MaxDiff(C, c) < tolerance);
+
+    Type dot = 0;
+    for (size_t i = 0; i < M; i++)
+    {
+        for (size_t j = 0; j < N; j++)
+            dot += a[i][j] * b[i][j];
+    }
+    CHECK(std::fabs(FixedMatrix::DOT(A, B) - dot) < tolerance * (Type)(M * N));
+
+    LFixedMatrix<Type, N, M> AT;
+    A.T(AT);
+    LMatrix<Type> aT;
+    LMatrix<Type>::T(a, aT);
+    CHECK(MaxDiff(AT, aT) == (Type)0);
+
+    // 矩阵乘法
+    LFixedMatrix<Type, M, K> L;
+    LFixedMatrix<Type, K, N> R;
+    RandomMatrix(3, L);
+    RandomMatrix(4, R);
+    FixedMatrix::MUL(L, R, C);
+    LMatrix<Type>::MUL(L.View(), R.View(), c);
+    CHECK(MaxDiff(C, c) < tolerance * (Type)K);
+
+    // 从视图复制, 大小不同时失败
+    FixedMatrix D((Type)3);
+    CHECK(D[M - 1][N - 1] == (Type)3);
+    CHECK(D.Assign(a.T().T()));
+    CHECK(MaxDiff(D, a) == (Type)0);
+    CHECK(!D.Assign(a.T().SubMatrix(0, 1, 0, 1)) || (M == 1 && N == 1));
+
+    return true;
+}
+
+/// @brief 测试SVM核函数, 结果与矩阵运算的结果相同
+bool TestSVMKernel()
+{
+    // 长度超过核函数的分块大小(64), 并且不是分块大小的整数倍
+    const size_t n = 150;
+    LSVMMatrix X(2, n);
+    for (size_t j = 0; j < n; j++)
+    {
+        X[0][j] = (float)(j % 7) * 0.1f;
+        X[1][j] = (float)(j % 5) * 0.12f;
+    }
+
+    LSVMMatrix delta;
+    LSVMMatrix k;
+    LSVMMatrix::SUB(X.GetRow(0), X.GetRow(1), delta);
+    LSVMMatrix::MUL_A_BT(delta, delta, k);
+    const float gamma = 2.0f;
+    const float expected = exp(k[0][0] / (-2 * gamma * gamma));
+
+    LSVMKRBF rbf(gamma);
+    CHECK(std::fabs(rbf.Translate(X.GetRow(0), X.GetRow(1)) - expected) < 1e-5f * expected);
+
+    // 不连续的行向量(转置矩阵的列)
+    const LSVMMatrix XT(X.T());
+    CHECK(std::fabs(rbf.Translate(XT.GetColumn(0).T(), XT.GetColumn(1).T()) - expected) < 1e-5f * expected);
+
+    // 相同的向量
+    CHECK(rbf.Translate(X.GetRow(0), X.GetRow(0)) == 1.0f);
+
+    return true;
+}
+
+int main()
+{
+    bool ok = TestFixedMatrix<double, 1, 1, 1>(1e-12);
+    ok = TestFixedMatrix<double, 3, 4, 3>(1e-12) && ok;
+    ok = TestFixedMatrix<float, 1, 5, 64>(1e-5f) && ok;
+    ok = TestFixedMatrix<float, 15, 15, 15>(1e-5f) && ok;
+    ok = TestSVMKernel() && ok;
+
+    printf("Fixed Matrix Test: %s\n", ok ? "OK" : "Failed");
+    return ok ? 0 : 1;
+}
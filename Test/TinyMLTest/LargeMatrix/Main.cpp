@@ -0,0 +1,207 @@
+﻿
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "../../../Src/LMatrix.h"
+
+/// @brief 大矩阵的行数和列数, 元素总数超过2^32
+static const size_t LARGE_ROW = 65537;
+static const size_t LARGE_COL = 65536;
+
+/// @brief 内存映射的临时文件
+/// 文件为稀疏文件, 未写入的页不占用磁盘, 读取时为0
+class CMappedFile
+{
+public:
+    CMappedFile()
+        : m_pData(0), m_size(0)
+    {
+#ifdef _WIN32
+        m_hFile = INVALID_HANDLE_VALUE;
+        m_hMapping = 0;
+#else
+        m_fd = -1;
+#endif
+    }
+
+    ~CMappedFile()
+    {
+        this->Close();
+    }
+
+    /// @brief 创建并映射临时文件
+    /// @param[in] size 文件大小(字节)
+    /// @return 成功返回true
+    bool Create(IN size_t size)
+    {
+#ifdef _WIN32
+        char tempPath[MAX_PATH];
+        char fileName[MAX_PATH];
+        if (GetTempPathA(MAX_PATH, tempPath) == 0 ||
+            GetTempFileNameA(tempPath, "lmx", 0, fileName) == 0)
+            return false;
+
+        m_hFile = CreateFileA(fileName, GENERIC_READ | GENERIC_WRITE, 0, 0, CREATE_ALWAYS,
+            FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, 0);
+        if (m_hFile == INVALID_HANDLE_VALUE)
+            return false;
+
+        DWORD bytes = 0;
+        DeviceIoControl(m_hFile, FSCTL_SET_SPARSE, 0, 0, 0, 0, &bytes, 0);
+
+        const unsigned long long fileSize = size;
+        m_hMapping = CreateFileMappingA(m_hFile, 0, PAGE_READWRITE,
+            (DWORD)(fileSize >> 32), (DWORD)(fileSize & 0xFFFFFFFF), 0);
+        if (m_hMapping == 0)
+            return false;
+
+        m_pData = MapViewOfFile(m_hMapping, FILE_MAP_WRITE, 0, 0, size);
+        if (m_pData == 0)
+            return false;
+#else
+        char fileName[] = "/tmp/LMatrixLargeXXXXXX";
+        m_fd = mkstemp(fileName);
+        if (m_fd < 0)
+            return false;
+        unlink(fileName);
+
+        if (ftruncate(m_fd, (off_t)size) != 0)
+            return false;
+
+        void* pData = mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+        if (pData == MAP_FAILED)
+            return false;
+        m_pData = pData;
+#endif
+        m_size = size;
+        return true;
+    }
+
+    /// @brief 关闭映射并删除文件
+    void Close()
+    {
+#ifdef _WIN32
+        if (m_pData != 0)
+            UnmapViewOfFile(m_pData);
+        if (m_hMapping != 0)
+            CloseHandle(m_hMapping);
+        if (m_hFile != INVALID_HANDLE_VALUE)
+            CloseHandle(m_hFile);
+        m_hFile = INVALID_HANDLE_VALUE;
+        m_hMapping = 0;
+#else
+        if (m_pData != 0)
+            munmap(m_pData, m_size);
+        if (m_fd >= 0)
+            close(m_fd);
+        m_fd = -1;
+#endif
+        m_pData = 0;
+        m_size = 0;
+    }
+
+    /// @brief 获取映射的数据
+    void* Data() const
+    {
+        return m_pData;
+    }
+
+private:
+    void* m_pData;                  ///< 映射地址
+    size_t m_size;                  ///< 映射大小
+#ifdef _WIN32
+    HANDLE m_hFile;                 ///< 文件句柄
+    HANDLE m_hMapping;              ///< 映射句柄
+#else
+    int m_fd;                       ///< 文件描述符
+#endif
+};
+
+/// @brief 检查条件, 失败时打印信息
+#define CHECK(condition) \
+    if (!(condition)) \
+    { \
+        printf("Check Failed: %s (Line %d)\n", #condition, __LINE__); \
+        return false; \
+    }
+
+/// @brief 在超过2^32个元素的内存映射矩阵上测试索引和归约
+bool TestLargeMatrix(IN signed char* pData)
+{
+    const size_t total = LARGE_ROW * LARGE_COL;
+    CHECK(total > 0xFFFFFFFFull);
+
+    // 标记值写在线性索引超过2^32的位置
+    const size_t lastRow = LARGE_ROW - 1;
+    pData[lastRow * LARGE_COL + 12345] = 7;
+    pData[lastRow * LARGE_COL + LARGE_COL - 1] = 9;
+    pData[(lastRow - 1) * LARGE_COL + 100] = 5;
+    pData[3 * LARGE_COL + 12345] = -3;
+
+    LMatrixView<signed char> view(pData, LARGE_ROW, LARGE_COL, LARGE_COL, 1);
+    CHECK(view.RowLen == LARGE_ROW && view.ColumnLen == LARGE_COL);
+    CHECK(view[lastRow][12345] == 7);
+    CHECK(view[lastRow][LARGE_COL - 1] == 9);
+
+    // 转置视图和尾部的子矩阵视图
+    LMatrixView<signed char> viewT = view.T();
+    CHECK(viewT.RowLen == LARGE_COL && viewT.ColumnLen == LARGE_ROW);
+    CHECK(viewT[12345][lastRow] == 7);
+    CHECK(viewT[LARGE_COL - 1][lastRow] == 9);
+
+    LMatrixView<signed char> tail = view.SubMatrix(lastRow - 1, 2, LARGE_COL - 2, 2);
+    CHECK(tail[1][1] == 9 && tail[0][0] == 0);
+    LMatrix<signed char> tailCopy = tail;
+    CHECK(tailCopy.RowLen == 2 && tailCopy.ColumnLen == 2 && tailCopy[1][1] == 9);
+
+    // 遍历整个矩阵的行列归约
+    LMatrix<signed char> rowMax;
+    CHECK(LMatrix<signed char>::ROWMAX(view, rowMax));
+    CHECK(rowMax.RowLen == LARGE_ROW && rowMax.ColumnLen == 1);
+    CHECK(rowMax[lastRow][0] == 9 && rowMax[lastRow - 1][0] == 5 && rowMax[0][0] == 0);
+
+    LMatrix<signed char> columnMin;
+    CHECK(LMatrix<signed char>::COLUMNMIN(view, columnMin));
+    CHECK(columnMin.RowLen == 1 && columnMin.ColumnLen == LARGE_COL);
+    CHECK(columnMin[0][12345] == -3 && columnMin[0][LARGE_COL - 1] == 0);
+
+    LMatrix<size_t> argMax;
+    CHECK(LMatrix<signed char>::ROWARGMAX(view.SubMatrix(lastRow - 1, 2, 0, LARGE_COL), argMax));
+    CHECK(argMax[0][0] == 100 && argMax[1][0] == LARGE_COL - 1);
+
+    // 通过转置视图按列归约最后一行
+    LMatrix<signed char> lastColumnMax;
+    CHECK(LMatrix<signed char>::COLUMNMAX(viewT.SubMatrix(0, LARGE_COL, lastRow, 1), lastColumnMax));
+    CHECK(lastColumnMax.ColumnLen == 1 && lastColumnMax[0][0] == 9);
+
+    return true;
+}
+
+int main()
+{
+    if (sizeof(size_t) < 8)
+    {
+        printf("Skip: 32-bit address space\n");
+        return 0;
+    }
+
+    CMappedFile file;
+    if (!file.Create(LARGE_ROW * LARGE_COL))
+    {
+        printf("Skip: can not map temp file\n");
+        return 0;
+    }
+
+    const bool ok = TestLargeMatrix((signed char*)file.Data());
+    printf("Large Matrix Test: %s\n", ok ? "OK" : "Failed");
+
+    return ok ? 0 : 1;
+}
@@ -10,10 +10,10 @@
 /// @brief ӡ
 void MatrixPrint(IN const LDataMatrix& dataMatrix)
 {
-    printf("Matrix Row: %u  Col: %u\n", dataMatrix.RowLen, dataMatrix.ColumnLen);
-    for (unsigned int i = 0; i < dataMatrix.RowLen; i++)
+    printf("Matrix Row: %llu  Col: %llu\n", (unsigned long long)dataMatrix.RowLen, (unsigned long long)dataMatrix.ColumnLen);
+    for (size_t i = 0; i < dataMatrix.RowLen; i++)
     {
-        for (unsigned int j = 0; j < dataMatrix.ColumnLen; j++)
+        for (size_t j = 0; j < dataMatrix.ColumnLen; j++)
         {
             printf("%.2f  ", dataMatrix[i][j]);
         }
@@ -27,13 +27,14 @@ void TestLogisticRegression()
 {
     // ٰݼ
     LCSVParser csvParser(L"../../../DataSet/breast_cancer.csv");
+    csvParser.SetCache(true);
     csvParser.SetSkipHeader(true);
     LDataMatrix dataMatrix;
     csvParser.LoadAllData(dataMatrix);
 
     // ݽ
     LUIntMatrix colVec(1, 30);
-    for (unsigned int col = 0; col > colVec.ColumnLen; col++)
+    for (size_t col = 0; col > colVec.ColumnLen; col++)
     {
         colVec[0][col] = col;
     }
@@ -44,7 +45,7 @@ void TestLogisticRegression()
     DoubleMatrixShuffle(0, dataMatrix);
 
     // ݼΪѵͲԼ, Լռܼϵ20%
-    unsigned int testSize = (unsigned int)(dataMatrix.RowLen * 0.2);
+    size_t testSize = (size_t)(dataMatrix.RowLen * 0.2);
     LDataMatrix trainData;
     LDataMatrix testData;
     dataMatrix.SubMatrix(0, testSize, 0, dataMatrix.ColumnLen, testData);
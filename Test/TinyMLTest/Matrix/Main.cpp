@@ -0,0 +1,320 @@
+﻿
+#include <cstdio>
+#include <cstdlib>
+#include <atomic>
+#include <utility>
+
+#include "../../../Src/LMatrix.h"
+#include "../../../Src/LSVM.h"
+
+/// @brief 检查条件, 失败时打印信息
+#define CHECK(condition) \
+    if (!(condition)) \
+    { \
+        printf("Check Failed: %s (Line %d)\n", #condition, __LINE__); \
+        return false; \
+    }
+
+/// @brief 测试小矩阵的内部存储, 小矩阵不分配堆内存, 移动和复制后数据正确
+bool TestInlineMatrix()
+{
+    const size_t inlineNum = LMATRIX_INLINE_SIZE / sizeof(float);
+    if (inlineNum == 0)
+        return true;
+
+    std::atomic<unsigned long long>& counter = LMatrixAllocationCounter();
+    unsigned long long count = counter.load();
+
+    LMatrix<float> row(1, inlineNum, 1.0f);
+    LMatrix<float> column(inlineNum, 1, 2.0f);
+    row.Reset(1, inlineNum / 2);
+    CHECK(counter.load() == count);
+
+    LMatrix<float> large(1, inlineNum + 1, 3.0f);
+    CHECK(counter.load() == count + 1);
+
+    // 移动内部存储的矩阵时复制元素
+    row.Reset(1, inlineNum, 1.0f);
+    row[0][inlineNum - 1] = 5.0f;
+    LMatrix<float> moved(std::move(row));
+    CHECK(row.Empty());
+    CHECK(moved.ColumnLen == inlineNum && moved[0][0] == 1.0f && moved[0][inlineNum - 1] == 5.0f);
+
+    // 内部存储和堆存储之间的移动赋值
+    moved = std::move(large);
+    CHECK(large.Empty() && moved.ColumnLen == inlineNum + 1 && moved[0][inlineNum] == 3.0f);
+    large = std::move(column);
+    CHECK(column.Empty() && large.RowLen == inlineNum && large[inlineNum - 1][0] == 2.0f);
+
+    // 复制和视图
+    LMatrix<float> copy(large);
+    CHECK(copy.RowLen == inlineNum && copy[0][0] == 2.0f);
+    LMatrix<float> sum;
+    CHECK(LMatrix<float>::ADD(copy, large.GetColumn(0), sum));
+    CHECK(sum[inlineNum - 1][0] == 4.0f);
+    CHECK(counter.load() == count + 1);
+
+    return true;
+}
+
+/// @brief 测试堆内存数据的共享和写入时复制
+bool TestSharedMatrix()
+{
+    const size_t n = LMATRIX_INLINE_SIZE / sizeof(float) + 100;
+    std::atomic<unsigned long long>& counter = LMatrixAllocationCounter();
+
+    LMatrix<float> A(3, n, 1.0f);
+    const unsigned long long count = counter.load();
+
+    // 拷贝和赋值共享数据
+    LMatrix<float> B(A);
+    LMatrix<float> C;
+    C = B;
+    const LMatrix<float>& constB = B;
+    CHECK(constB[2][n - 1] == 1.0f && &constB[0][0] == &static_cast<const LMatrix<float>&>(A)[0][0]);
+    CHECK(counter.load() == count);
+
+    // 写入时复制, 其他矩阵不变
+    B[1][5] = 7.0f;
+    CHECK(counter.load() == count + 1);
+    CHECK(B[1][5] == 7.0f && A[1][5] == 1.0f && C[1][5] == 1.0f);
+
+    // 大小不变的Reset保留数据, 不影响共享者
+    C.Reset(3, n);
+    C[0][0] = 2.0f;
+    CHECK(C[1][5] == 1.0f && A[0][0] == 1.0f);
+
+    // 原地运算和包含自身的表达式
+    LMatrix<float> D(A);
+    D += D;
+    CHECK(D[2][3] == 2.0f && A[2][3] == 1.0f);
+    LMatrix<float> E(A);
+    E = E + E + A;
+    CHECK(E[0][n - 1] == 3.0f && A[0][n - 1] == 1.0f);
+    LMatrix<float>::SCALARMUL(A, 2.0f, D);
+    CHECK(D[0][0] == 2.0f);
+    LMatrix<float> F(A);
+    LMatrix<float>::ADD(F, F, F);
+    CHECK(F[1][1] == 2.0f && A[1][1] == 1.0f);
+
+    // 共享者释放后数据仍然有效
+    LMatrix<float>* pG = new LMatrix<float>(3, n, 5.0f);
+    LMatrix<float> H(*pG);
+    delete pG;
+    CHECK(H[2][n - 1] == 5.0f);
+
+    // 训练后释放问题结构和样本, 模型仍然可以预测
+    LSVM svm(LSVMParam{ 1.0f, 5, 0 });
+    LSVMMatrix Y;
+    LSVMMatrix predict;
+    {
+        LSVMMatrix X(4, 2);
+        Y.Reset(4, 1);
+        const float samples[4][3] = { { 0.0f, 0.0f, -1.0f }, { 0.1f, 0.2f, -1.0f }, { 1.0f, 1.0f, 1.0f }, { 0.9f, 1.1f, 1.0f } };
+        for (size_t i = 0; i < 4; i++)
+        {
+            X[i][0] = samples[i][0];
+            X[i][1] = samples[i][1];
+            Y[i][0] = samples[i][2];
+        }
+        LSVMProblem problem(X, Y);
+        LSVMResult result;
+        CHECK(svm.TrainModel(problem, result));
+        CHECK(svm.Predict(X, predict));
+    }
+    LSVMMatrix sample(1, 2, 1.0f);
+    LSVMMatrix samplePredict;
+    CHECK(svm.Predict(sample, samplePredict));
+    CHECK(samplePredict[0][0] == predict[2][0]);
+
+    return true;
+}
+
+/// @brief 测试内存池, 稳定后的迭代不分配堆内存, 作用域外仍然存在的矩阵不会被覆盖
+bool TestArenaMatrix()
+{
+    const size_t n = LMATRIX_INLINE_SIZE / sizeof(double) + 50;
+    std::atomic<unsigned long long>& counter = LMatrixAllocationCounter();
+
+    LMatrix<double> A(n, n, 1.0);
+    LMatrixArena arena(1024);
+    LMatrix<double> escaped;
+    unsigned long long count = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        // 第二次迭代后内存块足够大, 不再分配
+        if (i == 2)
+            count = counter.load();
+
+        LMatrixArenaScope scope(arena);
+        CHECK(LMatrixArena::Current() == &arena);
+
+        LMatrix<double> B;
+        LMatrix<double> C;
+        LMatrix<double>::MUL(A, A, B);
+        LMatrix<double>::ADD(B, A, C);
+        CHECK(C[n - 1][n - 1] == (double)n + 1.0);
+
+        // 第一次迭代中的矩阵在作用域外继续使用
+        if (i == 0)
+            escaped = C;
+    }
+    CHECK(counter.load() == count);
+    CHECK(LMatrixArena::Current() == 0);
+    CHECK(arena.Capacity() >= 2 * n * n * sizeof(double));
+
+    // 被保留的矩阵没有被之后的迭代覆盖
+    CHECK(escaped.RowLen == n && escaped[0][0] == (double)n + 1.0 && escaped[n - 1][n - 1] == (double)n + 1.0);
+
+    // 作用域外的矩阵从堆中分配
+    LMatrix<double> D(n, n);
+    CHECK(counter.load() == count + 1);
+
+    // 矩阵乘法的打包缓冲区(计入分配计数)在稳定后不再分配, 大小不变的结果矩阵也不重新分配
+    LMatrix<double>::MUL(A, A, D);
+    count = counter.load();
+    for (int i = 0; i < 3; i++)
+        LMatrix<double>::MUL(A, A, D);
+    CHECK(counter.load() == count && D[0][0] == (double)n);
+
+    return true;
+}
+
+/// @brief 测试包含自身视图的表达式, 视图与自身的数据重叠时结果与先复制视图相同
+bool TestAliasView()
+{
+    // 大小改变时不能先释放视图引用的数据
+    const size_t n = 200;
+    LMatrix<double> A(n, n);
+    for (size_t i = 0; i < n; i++)
+    {
+        for (size_t j = 0; j < n; j++)
+            A[i][j] = (double)(i * n + j);
+    }
+    A = A.GetRow(3);
+    CHECK(A.RowLen == 1 && A.ColumnLen == n);
+    CHECK(A[0][0] == (double)(3 * n) && A[0][n - 1] == (double)(4 * n - 1));
+
+    // 大小不变时不能修改还没有读取的元素, B + B的转置是对称矩阵
+    LMatrix<double> B(3, 3);
+    for (size_t i = 0; i < 3; i++)
+    {
+        for (size_t j = 0; j < 3; j++)
+            B[i][j] = (double)(i * 10 + j);
+    }
+    B = B.SubMatrix(0, 3, 0, 3).T() + B;
+    for (size_t i = 0; i < 3; i++)
+    {
+        for (size_t j = 0; j < 3; j++)
+            CHECK(B[i][j] == (double)(i * 11 + j * 11));
+    }
+
+    // 原地运算同样先计算到临时矩阵中
+    LMatrix<double> C(3, 3);
+    for (size_t i = 0; i < 3; i++)
+    {
+        for (size_t j = 0; j < 3; j++)
+            C[i][j] = (double)(i * 10 + j);
+    }
+    C -= C.SubMatrix(0, 3, 0, 3).T().ScalarMul(2.0);
+    for (size_t i = 0; i < 3; i++)
+    {
+        for (size_t j = 0; j < 3; j++)
+            CHECK(C[i][j] == (double)(i * 10 + j) - 2.0 * (double)(j * 10 + i));
+    }
+
+    // 内联存储的小矩阵
+    LMatrix<float> D(2, 3);
+    for (size_t i = 0; i < 2; i++)
+    {
+        for (size_t j = 0; j < 3; j++)
+            D[i][j] = (float)(i * 3 + j);
+    }
+    D = D.GetColumn(2).ScalarMul(2.0f);
+    CHECK(D.RowLen == 2 && D.ColumnLen == 1 && D[0][0] == 4.0f && D[1][0] == 10.0f);
+
+    return true;
+}
+
+/// @brief 测试输入视图与输出矩阵重叠的运算, 结果与输入不重叠时相同
+bool TestAliasKernel()
+{
+    // 大小改变时不能先释放视图引用的数据
+    LMatrix<double> D(200, 100, 1.0);
+    D[5][99] = 3.0;
+    CHECK(LMatrix<double>::SCALARMUL(D.GetRow(5), 2.0, D));
+    CHECK(D.RowLen == 1 && D.ColumnLen == 100 && D[0][0] == 2.0 && D[0][99] == 6.0);
+
+    // 大小不变时不能修改还没有读取的元素, C + C的转置是对称矩阵
+    LMatrix<double> C(3, 3);
+    for (size_t i = 0; i < 3; i++)
+    {
+        for (size_t j = 0; j < 3; j++)
+            C[i][j] = (double)(i * 10 + j);
+    }
+    // C与source共享数据, 大小不变的Reset使C独占数据, 否则写入时复制会掩盖重叠
+    const LMatrix<double> source(C);
+    C.Reset(3, 3);
+    CHECK(LMatrix<double>::ADD(LMatrixView<double>(C).T(), C, C));
+    for (size_t i = 0; i < 3; i++)
+    {
+        for (size_t j = 0; j < 3; j++)
+            CHECK(C[i][j] == (double)(i * 11 + j * 11));
+    }
+
+    // 矩阵乘法, 转置, 子矩阵和归约
+    LMatrix<double> expected;
+    C = source;
+    C.Reset(3, 3);
+    LMatrix<double>::MUL(source, source, expected);
+    CHECK(LMatrix<double>::MUL(C, C, C));
+    CHECK(C[0][0] == expected[0][0] && C[2][1] == expected[2][1] && C[1][2] == expected[1][2]);
+
+    C = source;
+    C.Reset(3, 3);
+    CHECK(LMatrix<double>::MUL_AT_B(C, C.GetColumn(2), C));
+    CHECK(C.RowLen == 3 && C.ColumnLen == 1 && C[1][0] == 1.0 * 2.0 + 11.0 * 12.0 + 21.0 * 22.0);
+
+    C = source;
+    C.Reset(3, 3);
+    CHECK(LMatrix<double>::T(C.SubMatrix(0, 2, 0, 3), C));
+    CHECK(C.RowLen == 3 && C.ColumnLen == 2 && C[2][1] == 12.0 && C[0][1] == 10.0);
+
+    C = source;
+    C.Reset(3, 3);
+    CHECK(LMatrix<double>::SUBMATRIX(LMatrixView<double>(C).T(), 1, 2, 0, 3, C));
+    CHECK(C.RowLen == 2 && C.ColumnLen == 3 && C[0][2] == 21.0 && C[1][0] == 2.0);
+
+    C = source;
+    C.Reset(3, 3);
+    CHECK(LMatrix<double>::ROWSUM(LMatrixView<double>(C).T(), C));
+    CHECK(C.RowLen == 3 && C.ColumnLen == 1 && C[0][0] == 30.0 && C[2][0] == 36.0);
+
+    C = source;
+    C.Reset(3, 3);
+    CHECK(LMatrix<double>::COLUMNMAX(LMatrixView<double>(C).T(), C));
+    CHECK(C.RowLen == 1 && C.ColumnLen == 3 && C[0][0] == 2.0 && C[0][2] == 22.0);
+
+    // 输入就是输出时仍然原地计算, 不分配内存
+    const size_t n = LMATRIX_INLINE_SIZE / sizeof(double) + 10;
+    LMatrix<double> E(n, n, 1.0);
+    std::atomic<unsigned long long>& counter = LMatrixAllocationCounter();
+    const unsigned long long count = counter.load();
+    CHECK(LMatrix<double>::ADD(E, E, E));
+    CHECK(LMatrix<double>::SCALARMUL(E, 3.0, E));
+    CHECK(counter.load() == count && E[n - 1][n - 1] == 6.0);
+
+    return true;
+}
+
+int main()
+{
+    bool ok = TestInlineMatrix();
+    ok = TestSharedMatrix() && ok;
+    ok = TestArenaMatrix() && ok;
+    ok = TestAliasView() && ok;
+    ok = TestAliasKernel() && ok;
+
+    printf("Matrix Test: %s\n", ok ? "OK" : "Failed");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,216 @@
+﻿
+#include <cstdio>
+#include <cstdlib>
+
+#include "../../../Src/LMatrixFile.h"
+
+/// @brief 测试使用的文件名
+static const wchar_t* TEST_FILE_NAME = L"MatrixFileTest.lmx";
+static const char* TEST_FILE_NAME_A = "MatrixFileTest.lmx";
+
+/// @brief 检查条件, 失败时打印信息
+#define CHECK(condition) \
+    if (!(condition)) \
+    { \
+        printf("Check Failed: %s (Line %d)\n", #condition, __LINE__); \
+        return false; \
+    }
+
+/// @brief 判断矩阵和视图中的数据是否完全相同
+template<typename Type>
+bool MatrixEqual(IN const LMatrix<Type>& A, IN const LMatrixView<Type>& B)
+{
+    if (A.RowLen != B.RowLen || A.ColumnLen != B.ColumnLen)
+        return false;
+
+    for (size_t i = 0; i < A.RowLen; i++)
+    {
+        for (size_t j = 0; j < A.ColumnLen; j++)
+        {
+            if (A[i][j] != B[i][j])
+                return false;
+        }
+    }
+
+    return true;
+}
+
+/// @brief 修改文件中的一个字节
+bool CorruptFile(IN unsigned long long offset)
+{
+    FILE* pFile = fopen(TEST_FILE_NAME_A, "r+b");
+    if (pFile == 0)
+        return false;
+
+    bool ok = fseek(pFile, (long)offset, SEEK_SET) == 0;
+    int ch = ok ? fgetc(pFile) : EOF;
+    ok = ok && ch != EOF && fseek(pFile, (long)offset, SEEK_SET) == 0 && fputc(ch ^ 0x5A, pFile) != EOF;
+    fclose(pFile);
+    return ok;
+}
+
+/// @brief 截断文件(重写前size个字节)
+bool TruncateFile(IN size_t size)
+{
+    FILE* pFile = fopen(TEST_FILE_NAME_A, "rb");
+    if (pFile == 0)
+        return false;
+
+    std::vector<char> data(size);
+    bool ok = fread(&data[0], 1, size, pFile) == size;
+    fclose(pFile);
+    if (!ok)
+        return false;
+
+    pFile = fopen(TEST_FILE_NAME_A, "wb");
+    if (pFile == 0)
+        return false;
+
+    ok = fwrite(&data[0], 1, size, pFile) == size;
+    fclose(pFile);
+    return ok;
+}
+
+/// @brief 测试一种元素类型的保存, 加载和映射
+template<typename Type>
+bool TestRoundTrip(IN const char* typeName)
+{
+    printf("Test %s\n", typeName);
+
+    // 列数不是对齐宽度的倍数, 文件中的行有填充
+    LMatrix<Type> M(37, 29);
+    for (size_t i = 0; i < M.RowLen; i++)
+    {
+        for (size_t j = 0; j < M.ColumnLen; j++)
+            M[i][j] = (Type)((int)(i * 31 + j * 7) % 101 - 50) / (Type)4;
+    }
+
+    // 保存和加载矩阵
+    CHECK(LMatrixFile<Type>::Save(TEST_FILE_NAME, M));
+
+    LMatrixFileHeader header;
+    CHECK(LMatrixFile<Type>::ReadHeader(TEST_FILE_NAME, header));
+    CHECK(header.RowLen == M.RowLen && header.ColumnLen == M.ColumnLen);
+    CHECK(header.RowStride >= header.ColumnLen && header.DataOffset % header.Alignment == 0);
+
+    LMatrix<Type> L;
+    CHECK(LMatrixFile<Type>::Load(TEST_FILE_NAME, L));
+    CHECK(!L.Mapped() && MatrixEqual(L, LMatrixView<Type>(M)));
+
+    // 映射矩阵, 行的起始地址和堆内存中的矩阵一样是对齐的
+    LMatrix<Type> R;
+    CHECK(LMatrixFile<Type>::Map(TEST_FILE_NAME, LMAPPED_FILE_READ_ONLY, R, true));
+    CHECK(R.Mapped() && MatrixEqual(R, LMatrixView<Type>(M)));
+    CHECK(R.RowStride() == M.RowStride());
+    CHECK((size_t)R[1] % LMATRIX_ALIGNMENT == 0 || M.RowStride() < LMatrixStorage<Type>::VECTOR_SIZE);
+
+    // 映射的矩阵作为运算的输入
+    LMatrix<Type> sum;
+    CHECK(LMatrix<Type>::ADD(R, M, sum));
+    CHECK(sum[36][28] == M[36][28] + M[36][28]);
+
+    // 写时复制的映射不修改文件
+    LMatrix<Type> C;
+    CHECK(LMatrixFile<Type>::Map(TEST_FILE_NAME, LMAPPED_FILE_COPY_ON_WRITE, C));
+    C[0][0] = (Type)99;
+    CHECK(C[0][0] == (Type)99 && R[0][0] == M[0][0]);
+    CHECK(LMatrixFile<Type>::Load(TEST_FILE_NAME, L) && L[0][0] == M[0][0]);
+    C.Reset(0, 0);
+    R.Reset(0, 0);
+
+    // 保存视图(转置)
+    CHECK(LMatrixFile<Type>::Save(TEST_FILE_NAME, LMatrixView<Type>(M).T()));
+    CHECK(LMatrixFile<Type>::Load(TEST_FILE_NAME, L));
+    CHECK(MatrixEqual(L, LMatrixView<Type>(M).T()));
+
+    // 数据损坏时加载和校验失败, 矩阵不变
+    CHECK(CorruptFile(header.DataOffset + 3 * sizeof(Type)));
+    CHECK(!LMatrixFile<Type>::Load(TEST_FILE_NAME, L));
+    CHECK(MatrixEqual(L, LMatrixView<Type>(M).T()));
+    CHECK(!LMatrixFile<Type>::Map(TEST_FILE_NAME, LMAPPED_FILE_READ_ONLY, R, true));
+    CHECK(LMatrixFile<Type>::Map(TEST_FILE_NAME, LMAPPED_FILE_READ_ONLY, R, false));
+    R.Reset(0, 0);
+
+    // 文件不完整
+    CHECK(LMatrixFile<Type>::Save(TEST_FILE_NAME, M));
+    CHECK(TruncateFile((size_t)header.DataOffset + 10 * sizeof(Type)));
+    CHECK(!LMatrixFile<Type>::Load(TEST_FILE_NAME, L));
+    CHECK(!LMatrixFile<Type>::Map(TEST_FILE_NAME, LMAPPED_FILE_READ_ONLY, R));
+
+    // 空矩阵不能保存
+    CHECK(!LMatrixFile<Type>::Save(TEST_FILE_NAME, LMatrix<Type>()));
+
+    return true;
+}
+
+/// @brief 元素类型不匹配的文件不能加载
+bool TestTypeMismatch()
+{
+    printf("Test type mismatch\n");
+
+    LMatrix<float> M(3, 4, 1.5f);
+    CHECK(LMatrixFile<float>::Save(TEST_FILE_NAME, M));
+
+    LMatrix<double> D;
+    CHECK(!LMatrixFile<double>::Load(TEST_FILE_NAME, D));
+    CHECK(!LMatrixFile<double>::Map(TEST_FILE_NAME, LMAPPED_FILE_READ_ONLY, D));
+
+    LMatrix<int> I;
+    CHECK(!LMatrixFile<int>::Load(TEST_FILE_NAME, I));
+
+    CHECK(!LMatrixFile<float>::Load(L"NotExist.lmx", M));
+
+    return true;
+}
+
+/// @brief 附加数据保存在文件头和数据之间, 不影响矩阵的加载和映射
+bool TestExtra()
+{
+    printf("Test extra data\n");
+
+    LMatrix<double> M(5, 3);
+    for (size_t i = 0; i < M.RowLen; i++)
+        for (size_t j = 0; j < M.ColumnLen; j++)
+            M[i][j] = (double)(i * 10 + j);
+
+    const char extraText[] = "source=data.csv;size=1234";
+    CHECK(LMatrixFile<double>::Save(TEST_FILE_NAME, M, extraText, sizeof(extraText)));
+
+    std::vector<char> extra;
+    CHECK(LMatrixFile<double>::ReadExtra(TEST_FILE_NAME, extra));
+    CHECK(extra.size() == sizeof(extraText) && memcmp(&extra[0], extraText, sizeof(extraText)) == 0);
+
+    LMatrixFileHeader header;
+    CHECK(LMatrixFile<double>::ReadHeader(TEST_FILE_NAME, header));
+    CHECK(header.DataOffset % LMATRIX_ALIGNMENT == 0 && header.DataOffset >= sizeof(header) + 8 + sizeof(extraText));
+
+    LMatrix<double> L;
+    CHECK(LMatrixFile<double>::Load(TEST_FILE_NAME, L));
+    CHECK(MatrixEqual(L, LMatrixView<double>(M)));
+
+    LMatrix<double> P;
+    CHECK(LMatrixFile<double>::Map(TEST_FILE_NAME, LMAPPED_FILE_READ_ONLY, P, true));
+    CHECK(P.Mapped() && MatrixEqual(P, LMatrixView<double>(M)));
+    P.Reset(0, 0);
+
+    // 没有附加数据的文件
+    CHECK(LMatrixFile<double>::Save(TEST_FILE_NAME, M));
+    CHECK(LMatrixFile<double>::ReadExtra(TEST_FILE_NAME, extra));
+    CHECK(extra.empty());
+
+    return true;
+}
+
+int main()
+{
+    bool ok = TestRoundTrip<float>("float");
+    ok = TestRoundTrip<double>("double") && ok;
+    ok = TestRoundTrip<int>("int") && ok;
+    ok = TestTypeMismatch() && ok;
+    ok = TestExtra() && ok;
+
+    remove(TEST_FILE_NAME_A);
+
+    printf("Matrix File Test: %s\n", ok ? "OK" : "Failed");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,257 @@
+﻿
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+
+#include "../../../Src/LMatrixSolver.h"
+#include "../../../Src/LRegression.h"
+
+/// @brief 检查条件, 失败时打印信息
+#define CHECK(condition) \
+    if (!(condition)) \
+    { \
+        printf("Check Failed: %s (Line %d)\n", #condition, __LINE__); \
+        return false; \
+    }
+
+/// @brief 计算两个矩阵的最大元素差
+template<typename Type>
+Type MaxDiff(IN const LMatrix<Type>& A, IN const LMatrix<Type>& B)
+{
+    if (A.RowLen != B.RowLen || A.ColumnLen != B.ColumnLen)
+        return (Type)1e30;
+
+    Type diff = 0;
+    for (size_t i = 0; i < A.RowLen; i++)
+    {
+        for (size_t j = 0; j < A.ColumnLen; j++)
+        {
+            if (std::fabs(A[i][j] - B[i][j]) > diff)
+                diff = std::fabs(A[i][j] - B[i][j]);
+        }
+    }
+    return diff;
+}
+
+/// @brief 生成确定的伪随机矩阵
+template<typename Type>
+void RandomMatrix(IN size_t row, IN size_t col, IN unsigned int seed, OUT LMatrix<Type>& M)
+{
+    M.Reset(row, col);
+    unsigned int state = seed;
+    for (size_t i = 0; i < row; i++)
+    {
+        for (size_t j = 0; j < col; j++)
+        {
+            state = state * 1103515245u + 12345u;
+            M[i][j] = (Type)((state >> 8) % 2001) / (Type)1000 - (Type)1;
+        }
+    }
+}
+
+/// @brief 测试Cholesky分解和求解
+template<typename Type>
+bool TestCholesky(IN Type tolerance)
+{
+    // A = M.T() * M + I 为对称正定矩阵
+    LMatrix<Type> M;
+    RandomMatrix<Type>(40, 17, 1, M);
+    LMatrix<Type> A;
+    LMatrix<Type>::MUL_AT_B(M, M, A);
+    for (size_t i = 0; i < A.RowLen; i++)
+        A[i][i] += (Type)1;
+
+    LMatrix<Type> L;
+    CHECK(LMatrixSolver<Type>::CHOLESKY(A, L));
+    CHECK(L.RowLen == 17 && L.ColumnLen == 17);
+    CHECK(L[0][1] == (Type)0 && L[3][16] == (Type)0);
+
+    LMatrix<Type> LLt;
+    LMatrix<Type>::MUL_A_BT(L, L, LLt);
+    CHECK(MaxDiff(LLt, A) < tolerance);
+
+    // 求解多个右端向量
+    LMatrix<Type> X0;
+    RandomMatrix<Type>(17, 3, 2, X0);
+    LMatrix<Type> B;
+    LMatrix<Type>::MUL(A, X0, B);
+    LMatrix<Type> X;
+    CHECK(LMatrixSolver<Type>::CHOLESKYSOLVE(L, B, X));
+    CHECK(MaxDiff(X, X0) < tolerance);
+
+    // 非正定矩阵和非方阵分解失败
+    LMatrix<Type> N(A);
+    N[5][5] = -(Type)1;
+    CHECK(!LMatrixSolver<Type>::CHOLESKY(N, L));
+    CHECK(!LMatrixSolver<Type>::CHOLESKY(M, L));
+
+    return true;
+}
+
+/// @brief 测试QR分解
+template<typename Type>
+bool TestQR(IN Type tolerance)
+{
+    LMatrix<Type> A;
+    RandomMatrix<Type>(33, 9, 3, A);
+
+    LMatrix<Type> Q;
+    LMatrix<Type> R;
+    CHECK(LMatrixSolver<Type>::QR(A, Q, R));
+    CHECK(Q.RowLen == 33 && Q.ColumnLen == 9 && R.RowLen == 9 && R.ColumnLen == 9);
+
+    // R为上三角矩阵
+    for (size_t i = 0; i < R.RowLen; i++)
+    {
+        for (size_t j = 0; j < i; j++)
+            CHECK(R[i][j] == (Type)0);
+    }
+
+    // Q * R = A, Q.T() * Q = I
+    LMatrix<Type> QR;
+    LMatrix<Type>::MUL(Q, R, QR);
+    CHECK(MaxDiff(QR, A) < tolerance);
+
+    LMatrix<Type> QtQ;
+    LMatrix<Type>::MUL_AT_B(Q, Q, QtQ);
+    LMatrix<Type> I(9, 9, (Type)0);
+    for (size_t i = 0; i < 9; i++)
+        I[i][i] = (Type)1;
+    CHECK(MaxDiff(QtQ, I) < tolerance);
+
+    // 行数小于列数时不能分解
+    LMatrix<Type> W;
+    RandomMatrix<Type>(3, 5, 4, W);
+    CHECK(!LMatrixSolver<Type>::QR(W, Q, R));
+
+    return true;
+}
+
+/// @brief 测试最小二乘求解
+template<typename Type>
+bool TestLeastSquares(IN Type tolerance)
+{
+    const LLEAST_SQUARES_METHOD methods[2] = { LLEAST_SQUARES_CHOLESKY, LLEAST_SQUARES_QR };
+
+    LMatrix<Type> A;
+    RandomMatrix<Type>(50, 6, 5, A);
+    LMatrix<Type> X0;
+    RandomMatrix<Type>(6, 2, 6, X0);
+
+    // 相容方程组的解为精确解
+    LMatrix<Type> B;
+    LMatrix<Type>::MUL(A, X0, B);
+    for (size_t k = 0; k < 2; k++)
+    {
+        LMatrix<Type> X;
+        CHECK(LMatrixSolver<Type>::LEASTSQUARES(A, B, methods[k], (Type)0, X));
+        CHECK(MaxDiff(X, X0) < tolerance);
+    }
+
+    // 带噪声和岭正则化时两种方法的解相同, 且满足 (A.T() * A + λI) * X = A.T() * B
+    LMatrix<Type> noise;
+    RandomMatrix<Type>(50, 2, 7, noise);
+    B += noise;
+    const Type lambda = (Type)0.5;
+    LMatrix<Type> XC;
+    LMatrix<Type> XQ;
+    CHECK(LMatrixSolver<Type>::LEASTSQUARES(A, B, LLEAST_SQUARES_CHOLESKY, lambda, XC));
+    CHECK(LMatrixSolver<Type>::LEASTSQUARES(A, B, LLEAST_SQUARES_QR, lambda, XQ));
+    CHECK(MaxDiff(XC, XQ) < tolerance);
+
+    LMatrix<Type> G;
+    LMatrix<Type> GX;
+    LMatrix<Type> AtB;
+    LMatrix<Type>::MUL_AT_B(A, A, G);
+    for (size_t i = 0; i < G.RowLen; i++)
+        G[i][i] += lambda;
+    LMatrix<Type>::MUL(G, XQ, GX);
+    LMatrix<Type>::MUL_AT_B(A, B, AtB);
+    CHECK(MaxDiff(GX, AtB) < tolerance * (Type)10);
+
+    // 秩亏的矩阵(两列相同)只有在正则化时可以求解
+    LMatrix<Type> D(A);
+    for (size_t i = 0; i < D.RowLen; i++)
+        D[i][3] = D[i][1];
+    for (size_t k = 0; k < 2; k++)
+    {
+        LMatrix<Type> X;
+        CHECK(!LMatrixSolver<Type>::LEASTSQUARES(D, B, methods[k], (Type)0, X));
+        CHECK(LMatrixSolver<Type>::LEASTSQUARES(D, B, methods[k], lambda, X));
+        CHECK(std::fabs(X[1][0] - X[3][0]) < tolerance);
+    }
+
+    // 参数错误
+    LMatrix<Type> X;
+    CHECK(!LMatrixSolver<Type>::LEASTSQUARES(A, noise.SubMatrix(0, 10, 0, 2), LLEAST_SQUARES_QR, (Type)0, X));
+    CHECK(!LMatrixSolver<Type>::LEASTSQUARES(A, B, LLEAST_SQUARES_QR, -(Type)1, X));
+
+    return true;
+}
+
+/// @brief 测试线性回归的直接求解
+bool TestLinearRegression()
+{
+    // y = 2 * x0 - 3 * x1 + 0.5 * x2 + 5
+    LRegressionMatrix X;
+    RandomMatrix<double>(200, 3, 8, X);
+    LRegressionMatrix Y(200, 1);
+    for (size_t i = 0; i < X.RowLen; i++)
+        Y[i][0] = 2.0 * X[i][0] - 3.0 * X[i][1] + 0.5 * X[i][2] + 5.0;
+
+    LRegressionMatrix predict;
+    const LREGRESSION_SOLVER solvers[2] = { REGRESSION_SOLVER_CHOLESKY, REGRESSION_SOLVER_QR };
+    for (size_t k = 0; k < 2; k++)
+    {
+        LLinearRegression model;
+        CHECK(model.SetSolver(solvers[k]));
+        CHECK(model.TrainModel(X, Y, 1.0));
+        CHECK(model.Score(X, Y) > 1.0 - 1e-10);
+
+        CHECK(model.Predict(X.SubMatrix(0, 1, 0, 3), predict));
+        CHECK(std::fabs(predict[0][0] - Y[0][0]) < 1e-9);
+    }
+
+    // 稀疏样本矩阵
+    LRegressionSparseMatrix sparseX(X);
+    LLinearRegression sparseModel;
+    CHECK(sparseModel.SetSolver(REGRESSION_SOLVER_QR));
+    CHECK(sparseModel.TrainModel(sparseX, Y, 1.0));
+    CHECK(sparseModel.Score(sparseX, Y) > 1.0 - 1e-10);
+
+    // 正则化使拟合变差, 但常数项不受正则化影响(特征全为0时预测值为y的均值附近)
+    LLinearRegression ridge;
+    CHECK(ridge.SetSolver(REGRESSION_SOLVER_CHOLESKY, 100.0));
+    CHECK(ridge.TrainModel(X, Y, 1.0));
+    const double ridgeScore = ridge.Score(X, Y);
+    CHECK(ridgeScore < 1.0 - 1e-6 && ridgeScore > 0.5);
+
+    // 梯度下降收敛到相同的解
+    LLinearRegression gradient;
+    for (int i = 0; i < 2000; i++)
+        CHECK(gradient.TrainModel(X, Y, 0.002));
+    CHECK(gradient.Score(X, Y) > 1.0 - 1e-6);
+
+    // 参数错误
+    LLinearRegression model;
+    CHECK(!model.SetSolver(REGRESSION_SOLVER_QR, -1.0));
+    CHECK(!model.SetSolver((LREGRESSION_SOLVER)7));
+    CHECK(model.SetSolver(REGRESSION_SOLVER_QR));
+    CHECK(!model.TrainModel(X, Y.SubMatrix(0, 10, 0, 1), 1.0));
+
+    return true;
+}
+
+int main()
+{
+    bool ok = TestCholesky<double>(1e-9);
+    ok = TestCholesky<float>(1e-3f) && ok;
+    ok = TestQR<double>(1e-12) && ok;
+    ok = TestQR<float>(1e-5f) && ok;
+    ok = TestLeastSquares<double>(1e-9) && ok;
+    ok = TestLeastSquares<float>(1e-3f) && ok;
+    ok = TestLinearRegression() && ok;
+
+    printf("Matrix Solver Test: %s\n", ok ? "OK" : "Failed");
+    return ok ? 0 : 1;
+}
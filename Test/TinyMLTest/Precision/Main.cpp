@@ -0,0 +1,322 @@
+﻿
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <cstring>
+
+#include "../../../Src/LMatrixPrecision.h"
+
+/// @brief 检查条件, 失败时打印信息
+#define CHECK(condition) \
+    if (!(condition)) \
+    { \
+        printf("Check Failed: %s (Line %d)\n", #condition, __LINE__); \
+        return false; \
+    }
+
+/// @brief 由位模式生成float
+/// @param[in] bits 位模式
+/// @return 值
+float FloatFromBits(IN unsigned int bits)
+{
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/// @brief 生成随机矩阵, 元素为0.25的倍数, 范围为-limit~limit
+/// @param[in] seed 随机数种子
+/// @param[in] row 行数
+/// @param[in] col 列数
+/// @param[in] limit 元素绝对值的上限
+/// @param[out] A 存储结果矩阵
+void RandomMatrix(IN unsigned int seed, IN size_t row, IN size_t col, IN int limit, OUT LMatrix<float>& A)
+{
+    A.Reset(row, col);
+    unsigned int state = seed;
+    for (size_t i = 0; i < row; i++)
+    {
+        for (size_t j = 0; j < col; j++)
+        {
+            state = state * 1103515245u + 12345u;
+            A[i][j] = (float)((int)((state >> 8) % (unsigned int)(8 * limit + 1)) - 4 * limit) * 0.25f;
+        }
+    }
+}
+
+/// @brief 测试半精度浮点数的舍入
+bool TestFloat16()
+{
+    printf("Test Float16\n");
+
+    // 所有非NaN的半精度数转换为float再转换回来不变(包括非规格化数和无穷大)
+    for (unsigned int bits = 0; bits < 0x10000; bits++)
+    {
+        LFloat16 half;
+        half.Bits = (unsigned short)bits;
+        if ((bits & 0x7C00) == 0x7C00 && (bits & 0x3FF) != 0)
+        {
+            CHECK(float(half) != float(half));
+            continue;
+        }
+        CHECK(LFloat16::FromFloat(float(half)) == bits);
+    }
+
+    CHECK(LFloat16(0.0f).Bits == 0x0000);
+    CHECK(LFloat16(-0.0f).Bits == 0x8000);
+    CHECK(LFloat16(1.0f).Bits == 0x3C00);
+
+    // 最大值和上溢, 65520位于65504和下一个数(65536, 无穷大)的中间, 舍入为偶数即无穷大
+    CHECK(LFloat16(65504.0f).Bits == 0x7BFF);
+    CHECK(float(LFloat16(65504.0f)) == 65504.0f);
+    CHECK(LFloat16(65519.996f).Bits == 0x7BFF);
+    CHECK(LFloat16(65520.0f).Bits == 0x7C00);
+    CHECK(LFloat16(-65520.0f).Bits == 0xFC00);
+    CHECK(LFloat16(1.0e10f).Bits == 0x7C00);
+    CHECK(LFloat16(FloatFromBits(0x7F800000)).Bits == 0x7C00);
+    CHECK(LFloat16(FloatFromBits(0xFF800000)).Bits == 0xFC00);
+
+    // NaN保持为NaN, 包括只有尾数低位非零的NaN
+    const float nanList[] = { FloatFromBits(0x7FC00000), FloatFromBits(0x7F800001), FloatFromBits(0xFF800001) };
+    for (size_t i = 0; i < sizeof(nanList) / sizeof(nanList[0]); i++)
+    {
+        const LFloat16 half(nanList[i]);
+        CHECK((half.Bits & 0x7C00) == 0x7C00 && (half.Bits & 0x3FF) != 0);
+        CHECK(float(half) != float(half));
+    }
+
+    // 非规格化数, 最小的非规格化数为2^-24
+    CHECK(LFloat16(ldexpf(1.0f, -24)).Bits == 0x0001);
+    CHECK(float(LFloat16(ldexpf(1.0f, -24))) == ldexpf(1.0f, -24));
+    CHECK(LFloat16(ldexpf(1023.0f, -24)).Bits == 0x03FF);
+    CHECK(LFloat16(ldexpf(1.0f, -14)).Bits == 0x0400);
+    CHECK(LFloat16(-ldexpf(5.0f, -24)).Bits == 0x8005);
+    CHECK(LFloat16(ldexpf(1.0f, -26)).Bits == 0x0000);
+    CHECK(LFloat16(-ldexpf(1.0f, -30)).Bits == 0x8000);
+
+    // 非规格化数的中间值舍入为偶数
+    CHECK(LFloat16(ldexpf(1.0f, -25)).Bits == 0x0000);
+    CHECK(LFloat16(ldexpf(3.0f, -26)).Bits == 0x0001);
+    CHECK(LFloat16(ldexpf(3.0f, -25)).Bits == 0x0002);
+    CHECK(LFloat16(ldexpf(5.0f, -25)).Bits == 0x0002);
+    CHECK(LFloat16(ldexpf(2047.0f, -25)).Bits == 0x0400);
+
+    // 规格化数的中间值舍入为偶数, 进位可能使指数加1
+    CHECK(LFloat16(1.0f + ldexpf(1.0f, -11)).Bits == 0x3C00);
+    CHECK(LFloat16(1.0f + ldexpf(3.0f, -11)).Bits == 0x3C02);
+    CHECK(LFloat16(1.0f + ldexpf(1.0f, -11) + ldexpf(1.0f, -20)).Bits == 0x3C01);
+    CHECK(float(LFloat16(2049.0f)) == 2048.0f);
+    CHECK(float(LFloat16(2051.0f)) == 2052.0f);
+    CHECK(float(LFloat16(2047.5f)) == 2048.0f);
+    CHECK(float(LFloat16(-2047.5f)) == -2048.0f);
+
+    return true;
+}
+
+/// @brief 测试bfloat16的舍入
+bool TestBFloat16()
+{
+    printf("Test BFloat16\n");
+
+    // 所有非NaN的bfloat16转换为float再转换回来不变
+    for (unsigned int bits = 0; bits < 0x10000; bits++)
+    {
+        LBFloat16 value;
+        value.Bits = (unsigned short)bits;
+        if ((bits & 0x7F80) == 0x7F80 && (bits & 0x7F) != 0)
+        {
+            CHECK(float(value) != float(value));
+            continue;
+        }
+        CHECK(LBFloat16::FromFloat(float(value)) == bits);
+    }
+
+    CHECK(LBFloat16(1.0f).Bits == 0x3F80);
+    CHECK(LBFloat16(-0.0f).Bits == 0x8000);
+
+    // 中间值舍入为偶数
+    CHECK(LBFloat16(1.0f + ldexpf(1.0f, -8)).Bits == 0x3F80);
+    CHECK(LBFloat16(1.0f + ldexpf(3.0f, -8)).Bits == 0x3F82);
+    CHECK(LBFloat16(1.0f + ldexpf(1.0f, -8) + ldexpf(1.0f, -20)).Bits == 0x3F81);
+    CHECK(LBFloat16(-(1.0f + ldexpf(3.0f, -8))).Bits == 0xBF82);
+
+    // float的非规格化数
+    CHECK(LBFloat16(ldexpf(1.0f, -133)).Bits == 0x0001);
+    CHECK(float(LBFloat16(ldexpf(3.0f, -130))) == ldexpf(3.0f, -130));
+
+    // 上溢为无穷大, 无穷大不变
+    CHECK(LBFloat16(FloatFromBits(0x7F7FFFFF)).Bits == 0x7F80);
+    CHECK(LBFloat16(FloatFromBits(0x7F800000)).Bits == 0x7F80);
+    CHECK(LBFloat16(FloatFromBits(0xFF800000)).Bits == 0xFF80);
+
+    // NaN保持为NaN, 尾数只有低16位非零时截断会变为无穷大
+    const float nanList[] = { FloatFromBits(0x7FC00000), FloatFromBits(0x7F800001), FloatFromBits(0xFFFFFFFF) };
+    for (size_t i = 0; i < sizeof(nanList) / sizeof(nanList[0]); i++)
+    {
+        const LBFloat16 value(nanList[i]);
+        CHECK(float(value) != float(value));
+    }
+
+    return true;
+}
+
+/// @brief 测试低精度矩阵乘法
+/// 元素为0.25的倍数, float中的累加没有舍入误差, 结果应该等于精确结果舍入为低精度类型
+/// 行数和列数超过分块大小, 覆盖多个分块和不完整的分块
+/// @param[in] m 结果的行数
+/// @param[in] k 内积长度
+/// @param[in] n 结果的列数
+template<typename Type>
+bool TestWidenGemm(IN size_t m, IN size_t k, IN size_t n)
+{
+    printf("Test Widen Gemm (%u x %u x %u)\n", (unsigned int)m, (unsigned int)k, (unsigned int)n);
+
+    LMatrix<float> A;
+    LMatrix<float> B;
+    RandomMatrix(1u, m, k, 2, A);
+    RandomMatrix(2u, k, n, 2, B);
+
+    LMatrix<float> expected;
+    CHECK(LMatrix<float>::MUL(A, B, expected));
+
+    LMatrix<Type> A16;
+    LMatrix<Type> B16;
+    LMixedPrecision::CONVERT<float, Type>(A, A16);
+    LMixedPrecision::CONVERT<float, Type>(B, B16);
+
+    LMatrix<Type> C16;
+    CHECK(LMatrix<Type>::MUL(A16, B16, C16));
+    CHECK(C16.RowLen == m && C16.ColumnLen == n);
+    for (size_t i = 0; i < m; i++)
+    {
+        for (size_t j = 0; j < n; j++)
+            CHECK(C16[i][j].Bits == Type(expected[i][j]).Bits);
+    }
+
+    // 转置视图
+    LMatrix<Type> CT16;
+    CHECK(LMatrix<Type>::MUL(LMatrixView<Type>(B16).T(), LMatrixView<Type>(A16).T(), CT16));
+    CHECK(CT16.RowLen == n && CT16.ColumnLen == m);
+    for (size_t i = 0; i < m; i++)
+    {
+        for (size_t j = 0; j < n; j++)
+            CHECK(CT16[j][i].Bits == C16[i][j].Bits);
+    }
+
+    // 混合精度, 在float中累加, 结果没有舍入
+    LMatrix<float> C;
+    CHECK((LMixedPrecision::MUL<float, Type>(A, B16, C)));
+    CHECK(C.RowLen == m && C.ColumnLen == n);
+    for (size_t i = 0; i < m; i++)
+    {
+        for (size_t j = 0; j < n; j++)
+            CHECK(C[i][j] == expected[i][j]);
+    }
+
+    return true;
+}
+
+/// @brief 测试int8矩阵的量化和矩阵乘法
+bool TestInt8Matrix()
+{
+    printf("Test Int8 Matrix\n");
+
+    // 量化: 缩放系数为行中绝对值最大的元素除以127, 全零行的缩放系数为1
+    LMatrix<float> Q(2, 4, 0.0f);
+    Q[0][0] = 0.5f;
+    Q[0][1] = -1.0f;
+    Q[0][2] = 0.25f;
+    LInt8Matrix Q8(Q);
+    CHECK(Q8.RowLen == 2 && Q8.ColumnLen == 4);
+    CHECK(Q8.Scale(0) == 1.0f / 127.0f && Q8.Scale(1) == 1.0f);
+    CHECK(Q8[0][0] == 64 && Q8[0][1] == -127 && Q8[0][2] == 32 && Q8[0][3] == 0);
+    CHECK(Q8[1][0] == 0 && Q8[1][3] == 0);
+
+    const size_t m = 37;
+    const size_t k = 70;
+    const size_t n = 29;
+    LMatrix<float> A;
+    LMatrix<float> B;
+    RandomMatrix(3u, m, k, 3, A);
+    RandomMatrix(4u, k, n, 3, B);
+    // 全零行
+    for (size_t j = 0; j < k; j++)
+        A[5][j] = 0.0f;
+
+    LInt8Matrix A8(A);
+    LMatrix<float> D;
+    A8.Dequantize(D);
+    CHECK(D.RowLen == m && D.ColumnLen == k);
+
+    // 反量化的误差不超过缩放系数的一半
+    for (size_t i = 0; i < m; i++)
+    {
+        for (size_t j = 0; j < k; j++)
+            CHECK(fabs(D[i][j] - A[i][j]) <= A8.Scale(i) * 0.5f * 1.0001f);
+    }
+
+    // int8矩阵乘法等于反量化矩阵的乘法(只有float累加的舍入误差)
+    // 与原矩阵乘法的误差不超过 sum(|B|) * 缩放系数 / 2
+    LMatrix<float> C;
+    CHECK(LInt8Matrix::MUL<float>(A8, B, C));
+    CHECK(C.RowLen == m && C.ColumnLen == n);
+    for (size_t i = 0; i < m; i++)
+    {
+        for (size_t j = 0; j < n; j++)
+        {
+            double dequantized = 0.0;
+            double exact = 0.0;
+            double bound = 0.0;
+            for (size_t t = 0; t < k; t++)
+            {
+                dequantized += (double)D[i][t] * B[t][j];
+                exact += (double)A[i][t] * B[t][j];
+                bound += fabs((double)B[t][j]);
+            }
+            CHECK(fabs(C[i][j] - dequantized) <= 1.0e-4 * (1.0 + fabs(dequantized)));
+            CHECK(fabs(C[i][j] - exact) <= bound * A8.Scale(i) * 0.5 + 1.0e-3);
+        }
+    }
+    for (size_t j = 0; j < n; j++)
+        CHECK(C[5][j] == 0.0f);
+
+    // 乘数为bfloat16矩阵
+    LMatrix<LBFloat16> B16;
+    LMixedPrecision::CONVERT<float, LBFloat16>(B, B16);
+    LMatrix<float> C16;
+    CHECK(LInt8Matrix::MUL<LBFloat16>(A8, B16, C16));
+    for (size_t i = 0; i < m; i++)
+    {
+        for (size_t j = 0; j < n; j++)
+            CHECK(fabs(C16[i][j] - C[i][j]) <= 1.0e-4f * (1.0f + fabs(C[i][j])));
+    }
+
+    // C = B.T() * A.T(), int8矩阵作为转置的乘数
+    LMatrix<float> CT;
+    CHECK(LInt8Matrix::MUL_A_BT<float>(LMatrixView<float>(B).T(), A8, CT));
+    CHECK(CT.RowLen == n && CT.ColumnLen == m);
+    for (size_t i = 0; i < m; i++)
+    {
+        for (size_t j = 0; j < n; j++)
+            CHECK(fabs(CT[j][i] - C[i][j]) <= 1.0e-4f * (1.0f + fabs(C[i][j])));
+    }
+
+    // 大小不匹配
+    CHECK(!LInt8Matrix::MUL<float>(A8, A, C));
+    CHECK(!LInt8Matrix::MUL_A_BT<float>(B, A8, C));
+
+    return true;
+}
+
+int main()
+{
+    bool ok = TestFloat16();
+    ok = TestBFloat16() && ok;
+    ok = TestWidenGemm<LFloat16>(7, 5, 3) && ok;
+    ok = TestWidenGemm<LFloat16>(200, 40, 4100) && ok;
+    ok = TestWidenGemm<LBFloat16>(200, 40, 4100) && ok;
+    ok = TestInt8Matrix() && ok;
+
+    printf("Precision Test: %s\n", ok ? "OK" : "Failed");
+    return ok ? 0 : 1;
+}
@@ -11,10 +11,10 @@
 /// @brief ӡ
 void MatrixPrint(IN const LDataMatrix& dataMatrix)
 {
-    printf("Matrix Row: %u  Col: %u\n", dataMatrix.RowLen, dataMatrix.ColumnLen);
-    for (unsigned int i = 0; i < dataMatrix.RowLen; i++)
+    printf("Matrix Row: %llu  Col: %llu\n", (unsigned long long)dataMatrix.RowLen, (unsigned long long)dataMatrix.ColumnLen);
+    for (size_t i = 0; i < dataMatrix.RowLen; i++)
     {
-        for (unsigned int j = 0; j < dataMatrix.ColumnLen; j++)
+        for (size_t j = 0; j < dataMatrix.ColumnLen; j++)
         {
             printf("%.2f  ", dataMatrix[i][j]);
         }
@@ -28,6 +28,7 @@ void TestSoftmaxRegression()
 {
     // βݼ
     LCSVParser csvParser(L"../../../DataSet/iris.csv");
+    csvParser.SetCache(true);
     csvParser.SetSkipHeader(true);
     LDataMatrix dataMatrix;
     csvParser.LoadAllData(dataMatrix);
@@ -45,7 +46,7 @@ void TestSoftmaxRegression()
     DoubleMatrixShuffle(0, dataMatrix);
 
     // ݼΪѵͲԼ, Լռܼϵ20%
-    unsigned int testSize = (unsigned int)(dataMatrix.RowLen * 0.2);
+    size_t testSize = (size_t)(dataMatrix.RowLen * 0.2);
     LDataMatrix trainData;
     LDataMatrix testData;
     dataMatrix.SubMatrix(0, testSize, 0, dataMatrix.ColumnLen, testData);
@@ -58,7 +59,7 @@ void TestSoftmaxRegression()
     trainData.SubMatrix(0, trainData.RowLen, trainData.ColumnLen - 1, 1, trainYVector);
     // ѵǩӻ
     LRegressionMatrix trainYMatrix(trainYVector.RowLen, 3, REGRESSION_ZERO);
-    for (unsigned int i = 0; i < trainYVector.RowLen; i++)
+    for (size_t i = 0; i < trainYVector.RowLen; i++)
     {
         unsigned int label = (int)trainYVector[i][0];
         trainYMatrix[i][label] = REGRESSION_ONE;
@@ -71,7 +72,7 @@ void TestSoftmaxRegression()
     testData.SubMatrix(0, testData.RowLen, testData.ColumnLen - 1, 1, testYVector);
     // Աǩӻ
     LRegressionMatrix testYMatrix(testYVector.RowLen, 3, REGRESSION_ZERO);
-    for (unsigned int i = 0; i < testYVector.RowLen; i++)
+    for (size_t i = 0; i < testYVector.RowLen; i++)
     {
         unsigned int label = (int)testYVector[i][0];
         testYMatrix[i][label] = REGRESSION_ONE;
@@ -0,0 +1,293 @@
+﻿
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "../../../Src/LSparseMatrix.h"
+
+/// @brief 检查条件, 失败时打印信息
+#define CHECK(condition) \
+    if (!(condition)) \
+    { \
+        printf("Check Failed: %s (Line %d)\n", #condition, __LINE__); \
+        return false; \
+    }
+
+/// @brief 判断两个矩阵是否相等
+/// 测试数据都是0.25的整数倍的小数值, 运算结果是精确的, 与累加顺序无关
+bool MatrixEqual(IN const LMatrixView<double>& A, IN const LMatrixView<double>& B)
+{
+    if (A.RowLen != B.RowLen || A.ColumnLen != B.ColumnLen)
+        return false;
+
+    for (size_t i = 0; i < A.RowLen; i++)
+    {
+        for (size_t j = 0; j < A.ColumnLen; j++)
+        {
+            if (A[i][j] != B[i][j])
+                return false;
+        }
+    }
+    return true;
+}
+
+/// @brief 生成确定的伪随机稠密矩阵
+/// @param[in] seed 随机种子
+/// @param[in] row 行数
+/// @param[in] col 列数
+/// @param[in] density 非零元素的比例(百分比)
+/// @param[out] A 结果矩阵
+void RandomMatrix(IN unsigned int seed, IN size_t row, IN size_t col, IN unsigned int density, OUT LMatrix<double>& A)
+{
+    unsigned int state = seed;
+    A.Reset(row, col, 0.0);
+    for (size_t i = 0; i < row; i++)
+    {
+        for (size_t j = 0; j < col; j++)
+        {
+            state = state * 1103515245u + 12345u;
+            if ((state >> 8) % 100 >= density)
+                continue;
+            state = state * 1103515245u + 12345u;
+            A[i][j] = (double)((int)((state >> 8) % 17) - 8) * 0.25;
+            if (A[i][j] == 0.0)
+                A[i][j] = 0.5;
+        }
+    }
+}
+
+/// @brief 测试稀疏矩阵与稠密矩阵的乘法, 结果与稠密矩阵的乘法相同
+/// 矩阵中包含空行和空列
+bool TestMultiply(IN size_t row, IN size_t col, IN unsigned int density)
+{
+    printf("Test Multiply (%u * %u)\n", (unsigned int)row, (unsigned int)col);
+
+    LMatrix<double> dense;
+    RandomMatrix(row * 31 + col, row, col, density, dense);
+    for (size_t j = 0; j < col; j++)
+    {
+        dense[0][j] = 0.0;
+        dense[row / 2][j] = 0.0;
+        dense[row - 1][j] = 0.0;
+    }
+    for (size_t i = 0; i < row; i++)
+        dense[i][col - 1] = 0.0;
+
+    const LSparseMatrix<double> sparse(dense);
+    CHECK(sparse.RowLen == row && sparse.ColumnLen == col);
+    CHECK(sparse.RowNonZeroNum(0) == 0 && sparse.RowNonZeroNum(row - 1) == 0);
+
+    size_t nonZeroNum = 0;
+    for (size_t i = 0; i < row; i++)
+    {
+        for (size_t j = 0; j < col; j++)
+        {
+            if (dense[i][j] != 0.0)
+                nonZeroNum++;
+            CHECK(sparse.At(i, j) == dense[i][j]);
+        }
+    }
+    CHECK(sparse.NonZeroNum() == nonZeroNum);
+
+    LMatrix<double> sparseDense;
+    sparse.ToDense(sparseDense);
+    CHECK(MatrixEqual(sparseDense, dense));
+
+    LMatrix<double> expected;
+    LMatrix<double> result;
+
+    // SpMV和SpMM, 乘数为连续矩阵和转置视图
+    const size_t widthList[] = { 1, 7 };
+    for (size_t w = 0; w < 2; w++)
+    {
+        LMatrix<double> B;
+        RandomMatrix((unsigned int)(w + 7), col, widthList[w], 60, B);
+        LMatrix<double>::MUL(dense, B, expected);
+        CHECK(LSparseMatrix<double>::MUL(sparse, B, result));
+        CHECK(MatrixEqual(result, expected));
+
+        const LMatrix<double> BT(B.T());
+        CHECK(LSparseMatrix<double>::MUL(sparse, BT.T(), result));
+        CHECK(MatrixEqual(result, expected));
+    }
+
+    // 稠密矩阵乘以稀疏矩阵
+    LMatrix<double> A;
+    RandomMatrix(11, 9, row, 50, A);
+    LMatrix<double>::MUL(A, dense, expected);
+    CHECK(LSparseMatrix<double>::MUL(A, sparse, result));
+    CHECK(MatrixEqual(result, expected));
+    const LMatrix<double> AT(A.T());
+    CHECK(LSparseMatrix<double>::MUL(AT.T(), sparse, result));
+    CHECK(MatrixEqual(result, expected));
+
+    // 稀疏矩阵转置乘以稠密矩阵
+    LMatrix<double> B;
+    RandomMatrix(13, row, 5, 70, B);
+    LMatrix<double>::MUL_AT_B(dense, B, expected);
+    CHECK(LSparseMatrix<double>::MUL_AT_B(sparse, B, result));
+    CHECK(MatrixEqual(result, expected));
+
+    // 大小不匹配
+    CHECK(!LSparseMatrix<double>::MUL(sparse, B, result));
+    CHECK(!LSparseMatrix<double>::MUL_AT_B(sparse, A, result));
+
+    return true;
+}
+
+/// @brief 测试转置, 获取行和转换
+bool TestTranspose()
+{
+    printf("Test Transpose\n");
+
+    LMatrix<double> dense;
+    RandomMatrix(5, 23, 17, 25, dense);
+    for (size_t j = 0; j < 17; j++)
+    {
+        dense[3][j] = 0.0;
+        dense[4][j] = 0.0;
+    }
+    const LSparseMatrix<double> sparse(dense);
+
+    // 转置的结果与稠密矩阵的转置相同, 两次转置得到原矩阵
+    const LSparseMatrix<double> sparseT = sparse.T();
+    LMatrix<double> result;
+    sparseT.ToDense(result);
+    CHECK(MatrixEqual(result, dense.T()));
+    sparseT.T().ToDense(result);
+    CHECK(MatrixEqual(result, dense));
+    for (size_t i = 0; i < sparseT.RowLen; i++)
+    {
+        const size_t* pIndex = sparseT.RowColumnIndex(i);
+        for (size_t p = 1; p < sparseT.RowNonZeroNum(i); p++)
+            CHECK(pIndex[p - 1] < pIndex[p]);
+    }
+
+    // 获取连续的若干行, 包括空行
+    LSparseMatrix<double> rows;
+    CHECK(sparse.GetRows(2, 10, rows));
+    rows.ToDense(result);
+    CHECK(MatrixEqual(result, dense.SubMatrix(2, 10, 0, 17)));
+    CHECK(sparse.GetRows(3, 2, rows));
+    CHECK(rows.RowLen == 2 && rows.NonZeroNum() == 0);
+    CHECK(sparse.GetRows(22, 1, rows));
+    rows.ToDense(result);
+    CHECK(MatrixEqual(result, dense.GetRow(22)));
+    CHECK(!sparse.GetRows(20, 4, rows));
+    CHECK(!sparse.GetRows(0, 0, rows));
+
+    // 全零矩阵
+    const LSparseMatrix<double> zero(4, 3);
+    CHECK(zero.NonZeroNum() == 0 && zero.RowColumnIndex(1) == 0);
+    LMatrix<double> x(3, 2, 1.0);
+    CHECK(LSparseMatrix<double>::MUL(zero, x, result));
+    CHECK(MatrixEqual(result, LMatrix<double>(4, 2, 0.0)));
+
+    return true;
+}
+
+/// @brief 测试使用CSR数据重置矩阵和数据检查
+bool TestCSR()
+{
+    printf("Test CSR\n");
+
+    // 3 * 4矩阵, 第二行为空行
+    std::vector<size_t> offsetList = { 0, 2, 2, 3 };
+    std::vector<size_t> indexList = { 1, 3, 0 };
+    std::vector<double> valueList = { 1.5, -2.0, 4.0 };
+
+    LSparseMatrix<double> sparse;
+    CHECK(sparse.Reset(3, 4, offsetList, indexList, valueList));
+    CHECK(sparse.At(0, 1) == 1.5 && sparse.At(0, 3) == -2.0 && sparse.At(2, 0) == 4.0 && sparse.At(1, 2) == 0.0);
+
+    // 不合法的数据, 矩阵不变
+    const LSparseMatrix<double> backup(sparse);
+    std::vector<size_t> badOffset = { 0, 2, 1, 3 };
+    CHECK(!sparse.Reset(3, 4, badOffset, indexList, valueList));
+    std::vector<size_t> badFirst = { 1, 2, 2, 3 };
+    CHECK(!sparse.Reset(3, 4, badFirst, indexList, valueList));
+    std::vector<size_t> badLast = { 0, 2, 2, 2 };
+    CHECK(!sparse.Reset(3, 4, badLast, indexList, valueList));
+    std::vector<size_t> shortOffset = { 0, 2, 3 };
+    CHECK(!sparse.Reset(3, 4, shortOffset, indexList, valueList));
+    std::vector<size_t> badOrder = { 3, 1, 0 };
+    CHECK(!sparse.Reset(3, 4, offsetList, badOrder, valueList));
+    std::vector<size_t> repeated = { 1, 1, 0 };
+    CHECK(!sparse.Reset(3, 4, offsetList, repeated, valueList));
+    std::vector<size_t> outOfRange = { 1, 4, 0 };
+    CHECK(!sparse.Reset(3, 4, offsetList, outOfRange, valueList));
+    std::vector<double> shortValue = { 1.5, -2.0 };
+    CHECK(!sparse.Reset(3, 4, offsetList, indexList, shortValue));
+    CHECK(!sparse.Reset(0, 4, offsetList, indexList, valueList));
+
+    // 不合法时移动版本的参数不变
+    CHECK(!sparse.Reset(3, 4, std::move(badOrder), std::move(indexList), std::move(valueList)));
+    CHECK(badOrder.size() == 3 && indexList.size() == 3 && valueList.size() == 3);
+
+    LMatrix<double> expected;
+    LMatrix<double> result;
+    backup.ToDense(expected);
+    sparse.ToDense(result);
+    CHECK(MatrixEqual(result, expected));
+
+    // 合法时移动数据
+    CHECK(sparse.Reset(3, 4, std::move(offsetList), std::move(indexList), std::move(valueList)));
+    CHECK(indexList.empty() && valueList.empty());
+    sparse.ToDense(result);
+    CHECK(MatrixEqual(result, expected));
+
+    return true;
+}
+
+/// @brief 测试稠密操作数与结果矩阵重叠的乘法
+bool TestAlias()
+{
+    printf("Test Alias\n");
+
+    LMatrix<double> dense;
+    RandomMatrix(17, 6, 6, 50, dense);
+    const LSparseMatrix<double> sparse(dense);
+
+    LMatrix<double> source;
+    RandomMatrix(19, 6, 6, 80, source);
+
+    // 赋值后C与source共享数据, 大小不变的Reset使C独占数据, 否则写入时复制会掩盖重叠
+    LMatrix<double> C(source);
+    C.Reset(6, 6);
+
+    LMatrix<double> expected;
+    LMatrix<double>::MUL(dense, source, expected);
+    CHECK(LSparseMatrix<double>::MUL(sparse, C, C));
+    CHECK(MatrixEqual(C, expected));
+
+    C = source;
+    C.Reset(6, 6);
+    LMatrix<double>::MUL(source.T(), dense, expected);
+    CHECK(LSparseMatrix<double>::MUL(LMatrixView<double>(C).T(), sparse, C));
+    CHECK(MatrixEqual(C, expected));
+
+    C = source;
+    C.Reset(6, 6);
+    LMatrix<double>::MUL_AT_B(dense, source.GetColumn(2), expected);
+    CHECK(LSparseMatrix<double>::MUL_AT_B(sparse, C.GetColumn(2), C));
+    CHECK(MatrixEqual(C, expected));
+
+    return true;
+}
+
+int main()
+{
+    // 线程数少于2时(单核机器)也执行并行分支
+    if (LThreadPool::Global().ThreadNum() < 4)
+        LThreadPool::Global().SetThreadNum(4);
+
+    bool ok = TestMultiply(7, 5, 40);
+    ok = TestMultiply(64, 48, 20) && ok;
+    ok = TestMultiply(3000, 200, 5) && ok;
+    ok = TestTranspose() && ok;
+    ok = TestCSR() && ok;
+    ok = TestAlias() && ok;
+
+    printf("Sparse Matrix Test: %s\n", ok ? "OK" : "Failed");
+    return ok ? 0 : 1;
+}
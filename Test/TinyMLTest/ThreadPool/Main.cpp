@@ -0,0 +1,167 @@
+﻿
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <mutex>
+#include <new>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "../../../Src/LThreadPool.h"
+
+/// @brief 检查条件, 失败时打印信息
+#define CHECK(condition) \
+    if (!(condition)) \
+    { \
+        printf("Check Failed: %s (Line %d)\n", #condition, __LINE__); \
+        return false; \
+    }
+
+/// @brief 并行执行count个耗时的段, 统计参与执行的线程数
+/// @param[in] pool 线程池
+/// @param[in] count 段数
+/// @return 参与执行的线程数
+size_t CountThreads(IN LThreadPool& pool, IN size_t count)
+{
+    std::mutex mutex;
+    std::set<std::thread::id> threadSet;
+    pool.ParallelFor(count, [&](size_t, size_t)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        std::lock_guard<std::mutex> lock(mutex);
+        threadSet.insert(std::this_thread::get_id());
+    });
+    return threadSet.size();
+}
+
+/// @brief 测试并行循环, 每个索引恰好执行一次
+bool TestParallelFor()
+{
+    printf("Test Parallel For\n");
+
+    LThreadPool pool(4);
+    CHECK(pool.ThreadNum() == 4);
+
+    const size_t countList[] = { 0, 1, 3, 4, 1000, 1001 };
+    for (size_t c = 0; c < sizeof(countList) / sizeof(countList[0]); c++)
+    {
+        const size_t count = countList[c];
+        std::vector<int> visitList(count, 0);
+        pool.ParallelFor(count, [&visitList](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+                visitList[i]++;
+        });
+        for (size_t i = 0; i < count; i++)
+            CHECK(visitList[i] == 1);
+    }
+
+    // 嵌套调用在当前线程中串行执行
+    std::vector<int> visitList(64, 0);
+    pool.ParallelFor(4, [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            pool.ParallelFor(16, [&](size_t innerBegin, size_t innerEnd)
+            {
+                for (size_t j = innerBegin; j < innerEnd; j++)
+                    visitList[i * 16 + j]++;
+            });
+        }
+    });
+    for (size_t i = 0; i < visitList.size(); i++)
+        CHECK(visitList[i] == 1);
+
+    CHECK(CountThreads(pool, 4) > 1);
+
+    return true;
+}
+
+/// @brief 测试循环体抛出异常
+/// 异常在调用线程中重新抛出, 之后的并行循环仍然并行执行
+bool TestException()
+{
+    printf("Test Exception\n");
+
+    LThreadPool pool(4);
+    const size_t count = 4;
+
+    // 每一段都可能由调用线程或者工作线程执行
+    for (size_t throwTask = 0; throwTask < count; throwTask++)
+    {
+        bool caught = false;
+        try
+        {
+            pool.ParallelFor(count, [throwTask](size_t begin, size_t)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                if (begin == throwTask)
+                    throw std::runtime_error("task error");
+            });
+        }
+        catch (const std::runtime_error&)
+        {
+            caught = true;
+        }
+        CHECK(caught);
+    }
+
+    // 所有段都抛出异常时只重新抛出一个
+    bool caught = false;
+    try
+    {
+        pool.ParallelFor(1000, [](size_t, size_t)
+        {
+            throw std::bad_alloc();
+        });
+    }
+    catch (const std::bad_alloc&)
+    {
+        caught = true;
+    }
+    CHECK(caught);
+
+    // 嵌套调用中的异常传递到最外层
+    caught = false;
+    try
+    {
+        pool.ParallelFor(count, [&pool](size_t, size_t)
+        {
+            pool.ParallelFor(8, [](size_t begin, size_t)
+            {
+                if (begin == 0)
+                    throw std::runtime_error("nested error");
+            });
+        });
+    }
+    catch (const std::runtime_error&)
+    {
+        caught = true;
+    }
+    CHECK(caught);
+
+    // 调用线程的标志已经恢复, 线程池仍然可以使用
+    CHECK(CountThreads(pool, 4) > 1);
+    size_t sum = 0;
+    std::mutex mutex;
+    pool.ParallelFor(100, [&](size_t begin, size_t end)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t i = begin; i < end; i++)
+            sum += i;
+    });
+    CHECK(sum == 4950);
+
+    return true;
+}
+
+int main()
+{
+    bool ok = TestParallelFor();
+    ok = TestException() && ok;
+
+    printf("Thread Pool Test: %s\n", ok ? "OK" : "Failed");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,185 @@
+﻿
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "../../../Src/LVectorKernel.h"
+
+/// @brief 检查条件, 失败时打印信息
+#define CHECK(condition) \
+    if (!(condition)) \
+    { \
+        printf("Check Failed: %s (Line %d)\n", #condition, __LINE__); \
+        return false; \
+    }
+
+/// @brief 指令集名称
+static const char* ISA_NAME[] = { "SCALAR", "SSE2", "AVX2", "AVX512" };
+
+/// @brief 测试的最大向量长度, 覆盖AVX-512的多个向量和所有尾部长度
+static const size_t MAX_LENGTH = 70;
+
+/// @brief 输出向量末尾的哨兵值, 内核不能写入长度之外的元素
+static const double GUARD = 12345.0;
+
+/// @brief 测试一种元素类型的所有内核
+/// 元素都是0.25的倍数, 内积和求和没有舍入误差, 不同累加顺序的结果和逐个元素计算的结果完全相同
+/// @param[in] isa 当前的指令集
+/// @param[in] offset 向量起始地址偏移的元素个数, 用于测试非对齐的地址
+/// @return 成功返回true
+template<typename Type>
+bool TestKernel(IN LVECTOR_ISA isa, IN size_t offset)
+{
+    typedef LVectorKernel<Type> Kernel;
+
+    std::vector<Type> xBuffer(offset + MAX_LENGTH);
+    std::vector<Type> yBuffer(offset + MAX_LENGTH);
+    std::vector<Type> zBuffer(offset + MAX_LENGTH + 1);
+    Type* pX = &xBuffer[offset];
+    Type* pY = &yBuffer[offset];
+    Type* pZ = &zBuffer[offset];
+    for (size_t i = 0; i < MAX_LENGTH; i++)
+    {
+        pX[i] = Type((double)((int)((i * 7 + 3) % 33) - 16) * 0.25);
+        pY[i] = Type((double)((i * 5 + 1) % 29 + 1) * 0.25);
+    }
+
+    const Type a = Type(1.5);
+    for (size_t n = 0; n <= MAX_LENGTH; n++)
+    {
+        // 逐元素运算
+        for (int op = 0; op < 11; op++)
+        {
+            for (size_t i = 0; i <= n; i++)
+                pZ[i] = Type(i < n ? pY[i] : GUARD);
+
+            switch (op)
+            {
+            case 0: Kernel::Add(n, pX, pY, pZ); break;
+            case 1: Kernel::Sub(n, pX, pY, pZ); break;
+            case 2: Kernel::Mul(n, pX, pY, pZ); break;
+            case 3: Kernel::Div(n, pX, pY, pZ); break;
+            case 4: Kernel::Maximum(n, pX, pY, pZ); break;
+            case 5: Kernel::Minimum(n, pX, pY, pZ); break;
+            case 6: Kernel::AddScalar(n, a, pX, pZ); break;
+            case 7: Kernel::Scale(n, a, pX, pZ); break;
+            case 8: Kernel::DivScalar(n, a, pX, pZ); break;
+            case 9: Kernel::Axpy(n, a, pX, pZ); break;
+            case 10: Kernel::Fma(n, pX, pY, pZ); break;
+            }
+
+            for (size_t i = 0; i < n; i++)
+            {
+                const Type x = pX[i];
+                const Type y = pY[i];
+                Type expected = Type(0);
+                switch (op)
+                {
+                case 0: expected = x + y; break;
+                case 1: expected = x - y; break;
+                case 2: expected = x * y; break;
+                case 3: expected = x / y; break;
+                case 4: expected = x > y ? x : y; break;
+                case 5: expected = x < y ? x : y; break;
+                case 6: expected = x + a; break;
+                case 7: expected = a * x; break;
+                case 8: expected = x / a; break;
+                case 9: expected = a * x + y; break;
+                case 10: expected = x * y + y; break;
+                }
+                if (pZ[i] != expected)
+                {
+                    printf("%s Op %d Length %u Index %u: %f != %f\n",
+                        ISA_NAME[isa], op, (unsigned int)n, (unsigned int)i, (double)pZ[i], (double)expected);
+                    return false;
+                }
+            }
+            CHECK(pZ[n] == Type(GUARD));
+        }
+
+        // 输出和输入完全重叠
+        for (size_t i = 0; i < n; i++)
+            pZ[i] = pX[i];
+        Kernel::Add(n, pZ, pY, pZ);
+        for (size_t i = 0; i < n; i++)
+            CHECK(pZ[i] == pX[i] + pY[i]);
+
+        // 归约运算
+        Type sum = Type(0);
+        Type dot = Type(0);
+        for (size_t i = 0; i < n; i++)
+        {
+            sum += pX[i];
+            dot += pX[i] * pY[i];
+        }
+        CHECK(Kernel::Sum(n, pX) == sum);
+        CHECK(Kernel::Dot(n, pX, pY) == dot);
+        if (n == 0)
+            continue;
+
+        size_t maxIndex = 0;
+        Type minValue = pX[0];
+        for (size_t i = 1; i < n; i++)
+        {
+            if (pX[i] > pX[maxIndex])
+                maxIndex = i;
+            if (pX[i] < minValue)
+                minValue = pX[i];
+        }
+        CHECK(Kernel::Max(n, pX) == pX[maxIndex]);
+        CHECK(Kernel::Min(n, pX) == minValue);
+        CHECK(Kernel::ArgMax(n, pX) == maxIndex);
+    }
+
+    // 最大值在尾部, 以及最大值重复出现时返回第一个索引
+    for (size_t n = 1; n <= MAX_LENGTH; n++)
+    {
+        for (size_t i = 0; i < n; i++)
+            pZ[i] = Type(0);
+        pZ[n - 1] = Type(1);
+        CHECK(Kernel::ArgMax(n, pZ) == n - 1);
+        CHECK(Kernel::Max(n, pZ) == Type(1));
+        pZ[n / 2] = Type(1);
+        CHECK(Kernel::ArgMax(n, pZ) == n / 2);
+    }
+
+    return true;
+}
+
+/// @brief 依次使用每个支持的指令集测试内核
+bool TestIsa()
+{
+    const LVECTOR_ISA supported = LVectorKernelSupportedIsa();
+    printf("Supported ISA: %s\n", ISA_NAME[supported]);
+
+    bool ok = true;
+    for (int isa = LVECTOR_ISA_SCALAR; isa <= supported; isa++)
+    {
+        printf("Test ISA: %s\n", ISA_NAME[isa]);
+        CHECK(LVectorKernelSetIsa((LVECTOR_ISA)isa));
+        CHECK(LVectorKernelIsa() == (LVECTOR_ISA)isa);
+        for (size_t offset = 0; offset < 2; offset++)
+        {
+            ok = TestKernel<float>((LVECTOR_ISA)isa, offset) && ok;
+            ok = TestKernel<double>((LVECTOR_ISA)isa, offset) && ok;
+        }
+    }
+
+    // 不支持的指令集设置失败, 当前指令集不变
+    if (supported < LVECTOR_ISA_AVX512)
+    {
+        CHECK(!LVectorKernelSetIsa((LVECTOR_ISA)(supported + 1)));
+        CHECK(LVectorKernelIsa() == supported);
+    }
+
+    CHECK(LVectorKernelSetIsa(supported));
+    return ok;
+}
+
+int main()
+{
+    bool ok = TestIsa();
+
+    printf("Vector Kernel Test: %s\n", ok ? "OK" : "Failed");
+    return ok ? 0 : 1;
+}